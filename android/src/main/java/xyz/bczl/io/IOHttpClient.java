@@ -11,16 +11,18 @@ package xyz.bczl.io;
 
 import java.io.BufferedInputStream;
 import java.io.File;
-import java.io.FileInputStream;
 import java.io.FileOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
+import java.io.InterruptedIOException;
 import java.io.OutputStream;
 import java.net.HttpURLConnection;
 import java.net.URL;
+import java.nio.ByteBuffer;
 import java.nio.channels.Channels;
 import java.nio.channels.FileChannel;
 import java.nio.channels.ReadableByteChannel;
+import java.nio.channels.WritableByteChannel;
 import java.util.HashMap;
 import java.util.Map;
 
@@ -31,6 +33,8 @@ import java.util.Map;
 public class IOHttpClient {
     
     private static final int BUFFER_SIZE = 8192;
+    private static final long CANCEL_CHUNK_SIZE = 256 * 1024;
+    private static final int STREAM_CHUNK_SIZE = 64 * 1024;
     
     // ========================================================================
     // Response Data Class
@@ -90,9 +94,14 @@ public class IOHttpClient {
      * @param method          HTTP method (GET, POST, PUT, DELETE, etc.)
      * @param headerKeys      Request header keys
      * @param headerValues    Request header values
-     * @param body            Request body (can be null)
+     * @param body            Request body as a direct buffer over native memory (can be null)
      * @param timeoutMs       Timeout in milliseconds
      * @param followRedirects Whether to follow redirects
+     * @param nativeBodyBuffer Native memory the response body is read into
+     *                        (see nativeBodyWindow); 0 = return it in HttpResult.body
+     * @param nativeBodySink  Native chunk receiver; when set each chunk read into
+     *                        nativeBodyBuffer is handed to it instead of kept (0 = none)
+     * @param nativeCancelCheck Native cancel check polled between chunks (0 = none)
      * @return HttpResult containing response data
      */
     public static HttpResult request(
@@ -100,9 +109,12 @@ public class IOHttpClient {
             String method,
             String[] headerKeys,
             String[] headerValues,
-            byte[] body,
+            ByteBuffer body,
             int timeoutMs,
-            boolean followRedirects) {
+            boolean followRedirects,
+            long nativeBodyBuffer,
+            long nativeBodySink,
+            long nativeCancelCheck) {
         
         HttpResult result = new HttpResult();
         HttpURLConnection connection = null;
@@ -125,11 +137,15 @@ public class IOHttpClient {
             }
             
             // Write body if present
-            if (body != null && body.length > 0) {
+            if (body != null && body.remaining() > 0) {
                 connection.setDoOutput(true);
-                connection.setFixedLengthStreamingMode(body.length);
+                connection.setFixedLengthStreamingMode(body.remaining());
                 try (OutputStream os = connection.getOutputStream()) {
-                    os.write(body);
+                    // Copies through a small buffer, never the whole body onto the Java heap
+                    WritableByteChannel channel = Channels.newChannel(os);
+                    while (body.hasRemaining()) {
+                        channel.write(body);
+                    }
                     os.flush();
                 }
             }
@@ -155,16 +171,23 @@ public class IOHttpClient {
             result.headerKeys = headers.keySet().toArray(new String[0]);
             result.headerValues = headers.values().toArray(new String[0]);
             
-            // Read body
-            result.body = readResponseBody(connection);
+            // Read body (native code decodes any encoding it asked for)
+            if (nativeBodyBuffer != 0) {
+                nativeBodyEncoding(nativeBodyBuffer, connection.getContentEncoding());
+            }
+            if (nativeBodyBuffer == 0) {
+                result.body = readResponseBody(connection);
+            } else if (nativeBodySink != 0) {
+                streamResponseBody(connection, nativeBodyBuffer, nativeBodySink, nativeCancelCheck);
+            } else {
+                readResponseBodyNative(connection, nativeBodyBuffer, nativeCancelCheck);
+            }
             result.success = true;
             
         } catch (Exception e) {
             result.errorMessage = e.getClass().getSimpleName() + ": " + e.getMessage();
         } finally {
-            if (connection != null) {
-                connection.disconnect();
-            }
+            release(connection, result.success);
         }
         
         return result;
@@ -183,6 +206,8 @@ public class IOHttpClient {
      * @param headerValues    Request header values
      * @param timeoutMs       Timeout in milliseconds
      * @param resumable       Whether to resume from existing file
+     * @param nativeProgress  Native DownloadProgressCallback called after each chunk (0 = none)
+     * @param nativeCancelCheck Native cancel check polled between chunks (0 = none)
      * @return DownloadResult containing download status
      */
     public static DownloadResult download(
@@ -191,7 +216,9 @@ public class IOHttpClient {
             String[] headerKeys,
             String[] headerValues,
             int timeoutMs,
-            boolean resumable) {
+            boolean resumable,
+            long nativeProgress,
+            long nativeCancelCheck) {
         
         DownloadResult result = new DownloadResult();
         HttpURLConnection connection = null;
@@ -230,6 +257,8 @@ public class IOHttpClient {
             }
             
             long contentLength = connection.getContentLengthLong();
+            long totalSize = contentLength < 0 ? -1
+                    : (result.statusCode == 206 ? startPosition + contentLength : contentLength);
             
             // Use NIO for efficient transfer
             try (InputStream is = connection.getInputStream();
@@ -238,8 +267,28 @@ public class IOHttpClient {
                 ReadableByteChannel srcChannel = Channels.newChannel(is);
                 FileChannel destChannel = fos.getChannel();
                 
-                long transferred = destChannel.transferFrom(srcChannel, startPosition,
-                        contentLength > 0 ? contentLength : Long.MAX_VALUE);
+                long remaining = contentLength > 0 ? contentLength : Long.MAX_VALUE;
+                long transferred = 0;
+                if (nativeCancelCheck == 0 && nativeProgress == 0) {
+                    transferred = destChannel.transferFrom(srcChannel, startPosition, remaining);
+                } else {
+                    // Transfer in chunks so cancellation and progress are noticed between them;
+                    // native code rate-limits the reports
+                    while (transferred < remaining) {
+                        throwIfCancelled(nativeCancelCheck);
+                        long chunk = destChannel.transferFrom(srcChannel, startPosition + transferred,
+                                Math.min(CANCEL_CHUNK_SIZE, remaining - transferred));
+                        if (chunk <= 0) {
+                            break;
+                        }
+                        transferred += chunk;
+                        if (nativeProgress != 0) {
+                            long received = startPosition + transferred;
+                            double progress = totalSize > 0 ? (double) received / totalSize : 0.0;
+                            nativeDownloadProgress(nativeProgress, received, totalSize, progress);
+                        }
+                    }
+                }
                 
                 srcChannel.close();
                 destChannel.close();
@@ -253,97 +302,7 @@ public class IOHttpClient {
         } catch (Exception e) {
             result.errorMessage = e.getClass().getSimpleName() + ": " + e.getMessage();
         } finally {
-            if (connection != null) {
-                connection.disconnect();
-            }
-        }
-        
-        return result;
-    }
-    
-    /**
-     * Download a file with progress callback (for JNI native callback).
-     * This version uses manual loop for progress reporting.
-     */
-    public static DownloadResult downloadWithProgress(
-            String url,
-            String destinationPath,
-            String[] headerKeys,
-            String[] headerValues,
-            int timeoutMs,
-            boolean resumable,
-            long nativeCallback) {
-        
-        DownloadResult result = new DownloadResult();
-        HttpURLConnection connection = null;
-        
-        try {
-            URL urlObj = new URL(url);
-            connection = (HttpURLConnection) urlObj.openConnection();
-            
-            connection.setRequestMethod("GET");
-            connection.setConnectTimeout(timeoutMs);
-            connection.setReadTimeout(timeoutMs);
-            connection.setDoInput(true);
-            
-            if (headerKeys != null && headerValues != null) {
-                for (int i = 0; i < headerKeys.length && i < headerValues.length; i++) {
-                    connection.setRequestProperty(headerKeys[i], headerValues[i]);
-                }
-            }
-            
-            long startPosition = 0;
-            File destFile = new File(destinationPath);
-            if (resumable && destFile.exists()) {
-                startPosition = destFile.length();
-                connection.setRequestProperty("Range", "bytes=" + startPosition + "-");
-            }
-            
-            connection.connect();
-            
-            result.statusCode = connection.getResponseCode();
-            
-            if (result.statusCode != 200 && result.statusCode != 206) {
-                result.errorMessage = "HTTP error: " + result.statusCode;
-                return result;
-            }
-            
-            long contentLength = connection.getContentLengthLong();
-            long totalSize = (result.statusCode == 206) ? 
-                    contentLength + startPosition : contentLength;
-            
-            try (InputStream is = new BufferedInputStream(connection.getInputStream());
-                 FileOutputStream fos = new FileOutputStream(destinationPath, resumable)) {
-                
-                byte[] buffer = new byte[BUFFER_SIZE];
-                long totalBytesRead = startPosition;
-                int bytesRead;
-                
-                while ((bytesRead = is.read(buffer)) != -1) {
-                    fos.write(buffer, 0, bytesRead);
-                    totalBytesRead += bytesRead;
-                    
-                    // Call native progress callback
-                    if (nativeCallback != 0) {
-                        double progress = totalSize > 0 ? 
-                                (double) totalBytesRead / totalSize : 0.0;
-                        nativeDownloadProgress(nativeCallback, totalBytesRead, totalSize, progress);
-                    }
-                }
-                
-                fos.flush();
-                result.fileSize = totalBytesRead;
-            }
-            
-            result.filePath = destinationPath;
-            result.success = true;
-            
-        } catch (Exception e) {
-            result.errorMessage = e.getClass().getSimpleName() + ": " + e.getMessage();
-        } finally {
-            if (connection != null) {
-                connection.disconnect();
-            }
+            release(connection, result.success);
         }
         
         return result;
@@ -354,158 +313,38 @@ public class IOHttpClient {
     // ========================================================================
     
     /**
-     * Upload a file using multipart/form-data.
+     * Upload a request body produced by native code (multipart/form-data).
+     *
+     * The body is pulled from native code in STREAM_CHUNK_SIZE pieces into
+     * one direct buffer and sent in fixed-length streaming mode, so neither
+     * the files nor the body are ever held in memory as a whole.
      *
      * @param url           Upload URL
-     * @param filePath      Local file path to upload
-     * @param fieldName     Form field name for the file
-     * @param fileName      File name in the form
-     * @param mimeType      MIME type of the file
+     * @param contentType   Content-Type of the body (carries the boundary)
+     * @param contentLength Exact body size in bytes
      * @param headerKeys    Request header keys
      * @param headerValues  Request header values
-     * @param formKeys      Additional form field keys
-     * @param formValues    Additional form field values
      * @param timeoutMs     Timeout in milliseconds
+     * @param nativeBodySource Native body producer (see nativeUploadRead)
+     * @param nativeProgress Native progress callback (0 = none)
+     * @param nativeCancelCheck Native cancel check polled between chunks (0 = none)
      * @return UploadResult containing upload status
      */
     public static UploadResult upload(
             String url,
-            String filePath,
-            String fieldName,
-            String fileName,
-            String mimeType,
+            String contentType,
+            long contentLength,
             String[] headerKeys,
             String[] headerValues,
-            String[] formKeys,
-            String[] formValues,
-            int timeoutMs) {
-        
-        UploadResult result = new UploadResult();
-        HttpURLConnection connection = null;
-        
-        try {
-            File file = new File(filePath);
-            if (!file.exists()) {
-                result.errorMessage = "File not found: " + filePath;
-                return result;
-            }
-            
-            long fileSize = file.length();
-            String boundary = "----IOHttpClientBoundary" + System.currentTimeMillis();
-            
-            URL urlObj = new URL(url);
-            connection = (HttpURLConnection) urlObj.openConnection();
-            
-            connection.setRequestMethod("POST");
-            connection.setConnectTimeout(timeoutMs);
-            connection.setReadTimeout(timeoutMs);
-            connection.setDoOutput(true);
-            connection.setDoInput(true);
-            connection.setRequestProperty("Content-Type", "multipart/form-data; boundary=" + boundary);
-            
-            // Set additional headers
-            if (headerKeys != null && headerValues != null) {
-                for (int i = 0; i < headerKeys.length && i < headerValues.length; i++) {
-                    connection.setRequestProperty(headerKeys[i], headerValues[i]);
-                }
-            }
-            
-            // Resolve file name
-            String actualFileName = (fileName == null || fileName.isEmpty()) ? 
-                    file.getName() : fileName;
-            String actualMimeType = (mimeType == null || mimeType.isEmpty()) ? 
-                    "application/octet-stream" : mimeType;
-            
-            // Build prefix
-            StringBuilder prefixBuilder = new StringBuilder();
-            
-            // Add form fields
-            if (formKeys != null && formValues != null) {
-                for (int i = 0; i < formKeys.length && i < formValues.length; i++) {
-                    prefixBuilder.append("--").append(boundary).append("\r\n");
-                    prefixBuilder.append("Content-Disposition: form-data; name=\"")
-                            .append(formKeys[i]).append("\"\r\n\r\n");
-                    prefixBuilder.append(formValues[i]).append("\r\n");
-                }
-            }
-            
-            // Add file part header
-            prefixBuilder.append("--").append(boundary).append("\r\n");
-            prefixBuilder.append("Content-Disposition: form-data; name=\"")
-                    .append(fieldName).append("\"; filename=\"")
-                    .append(actualFileName).append("\"\r\n");
-            prefixBuilder.append("Content-Type: ").append(actualMimeType).append("\r\n\r\n");
-            
-            byte[] prefix = prefixBuilder.toString().getBytes("UTF-8");
-            byte[] suffix = ("\r\n--" + boundary + "--\r\n").getBytes("UTF-8");
-            
-            long totalSize = prefix.length + fileSize + suffix.length;
-            connection.setFixedLengthStreamingMode(totalSize);
-            
-            connection.connect();
-            
-            try (OutputStream os = connection.getOutputStream();
-                 FileInputStream fis = new FileInputStream(file)) {
-                
-                // Write prefix
-                os.write(prefix);
-                
-                // Write file content
-                byte[] buffer = new byte[BUFFER_SIZE];
-                int bytesRead;
-                while ((bytesRead = fis.read(buffer)) != -1) {
-                    os.write(buffer, 0, bytesRead);
-                }
-                
-                // Write suffix
-                os.write(suffix);
-                os.flush();
-            }
-            
-            result.statusCode = connection.getResponseCode();
-            result.responseBody = readResponseBody(connection);
-            result.success = (result.statusCode >= 200 && result.statusCode < 300);
-            
-        } catch (Exception e) {
-            result.errorMessage = e.getClass().getSimpleName() + ": " + e.getMessage();
-        } finally {
-            if (connection != null) {
-                connection.disconnect();
-            }
-        }
-        
-        return result;
-    }
-    
-    /**
-     * Upload with progress callback.
-     */
-    public static UploadResult uploadWithProgress(
-            String url,
-            String filePath,
-            String fieldName,
-            String fileName,
-            String mimeType,
-            String[] headerKeys,
-            String[] headerValues,
-            String[] formKeys,
-            String[] formValues,
             int timeoutMs,
-            long nativeCallback) {
+            long nativeBodySource,
+            long nativeProgress,
+            long nativeCancelCheck) {
         
         UploadResult result = new UploadResult();
         HttpURLConnection connection = null;
         
         try {
-            File file = new File(filePath);
-            if (!file.exists()) {
-                result.errorMessage = "File not found: " + filePath;
-                return result;
-            }
-            
-            long fileSize = file.length();
-            String boundary = "----IOHttpClientBoundary" + System.currentTimeMillis();
-            
             URL urlObj = new URL(url);
             connection = (HttpURLConnection) urlObj.openConnection();
             
@@ -514,68 +353,38 @@ public class IOHttpClient {
             connection.setReadTimeout(timeoutMs);
             connection.setDoOutput(true);
             connection.setDoInput(true);
-            connection.setRequestProperty("Content-Type", "multipart/form-data; boundary=" + boundary);
+            connection.setRequestProperty("Content-Type", contentType);
             
+            // Set additional headers
             if (headerKeys != null && headerValues != null) {
                 for (int i = 0; i < headerKeys.length && i < headerValues.length; i++) {
                     connection.setRequestProperty(headerKeys[i], headerValues[i]);
                 }
             }
             
-            String actualFileName = (fileName == null || fileName.isEmpty()) ? 
-                    file.getName() : fileName;
-            String actualMimeType = (mimeType == null || mimeType.isEmpty()) ? 
-                    "application/octet-stream" : mimeType;
-            
-            StringBuilder prefixBuilder = new StringBuilder();
-            
-            if (formKeys != null && formValues != null) {
-                for (int i = 0; i < formKeys.length && i < formValues.length; i++) {
-                    prefixBuilder.append("--").append(boundary).append("\r\n");
-                    prefixBuilder.append("Content-Disposition: form-data; name=\"")
-                            .append(formKeys[i]).append("\"\r\n\r\n");
-                    prefixBuilder.append(formValues[i]).append("\r\n");
-                }
-            }
-            
-            prefixBuilder.append("--").append(boundary).append("\r\n");
-            prefixBuilder.append("Content-Disposition: form-data; name=\"")
-                    .append(fieldName).append("\"; filename=\"")
-                    .append(actualFileName).append("\"\r\n");
-            prefixBuilder.append("Content-Type: ").append(actualMimeType).append("\r\n\r\n");
-            
-            byte[] prefix = prefixBuilder.toString().getBytes("UTF-8");
-            byte[] suffix = ("\r\n--" + boundary + "--\r\n").getBytes("UTF-8");
-            
-            long totalSize = prefix.length + fileSize + suffix.length;
-            connection.setFixedLengthStreamingMode(totalSize);
-            
+            connection.setFixedLengthStreamingMode(contentLength);
             connection.connect();
             
-            try (OutputStream os = connection.getOutputStream();
-                 FileInputStream fis = new FileInputStream(file)) {
-                
-                long totalBytesWritten = 0;
-                
-                // Write prefix
-                os.write(prefix);
-                totalBytesWritten += prefix.length;
-                
-                // Write file content with progress
-                byte[] buffer = new byte[BUFFER_SIZE];
-                int bytesRead;
-                while ((bytesRead = fis.read(buffer)) != -1) {
-                    os.write(buffer, 0, bytesRead);
-                    totalBytesWritten += bytesRead;
-                    
-                    if (nativeCallback != 0) {
-                        double progress = (double) totalBytesWritten / totalSize;
-                        nativeUploadProgress(nativeCallback, totalBytesWritten, totalSize, progress);
+            try (OutputStream os = connection.getOutputStream()) {
+                WritableByteChannel channel = Channels.newChannel(os);
+                ByteBuffer window = ByteBuffer.allocateDirect(STREAM_CHUNK_SIZE);
+                long sent = 0;
+                while (sent < contentLength) {
+                    throwIfCancelled(nativeCancelCheck);
+                    window.clear();
+                    int length = nativeUploadRead(nativeBodySource, window);
+                    if (length <= 0) {
+                        throw new IOException("Upload body ended early");
+                    }
+                    window.limit(length);
+                    while (window.hasRemaining()) {
+                        channel.write(window);
+                    }
+                    sent += length;
+                    if (nativeProgress != 0) {
+                        nativeUploadProgress(nativeProgress, sent, contentLength, (double) sent / contentLength);
                     }
                 }
-                
-                // Write suffix
-                os.write(suffix);
                 os.flush();
             }
             
@@ -586,9 +395,7 @@ public class IOHttpClient {
         } catch (Exception e) {
             result.errorMessage = e.getClass().getSimpleName() + ": " + e.getMessage();
         } finally {
-            if (connection != null) {
-                connection.disconnect();
-            }
+            release(connection, result.success);
         }
         
         return result;
@@ -598,6 +405,30 @@ public class IOHttpClient {
     // Helper Methods
     // ========================================================================
     
+    /**
+     * Abort a transfer once its native cancel check reports cancellation.
+     */
+    private static void throwIfCancelled(long nativeCancelCheck) throws InterruptedIOException {
+        if (nativeCancelCheck != 0 && nativeIsCancelled(nativeCancelCheck)) {
+            throw new InterruptedIOException("Operation cancelled");
+        }
+    }
+
+    /**
+     * Finish with a connection.
+     *
+     * HttpURLConnection keeps one process-wide keep-alive pool: once a
+     * response has been read to the end and its stream closed, the socket
+     * goes back to the pool and the next request to the same host skips the
+     * TCP and TLS handshakes. disconnect() would close the socket instead, so
+     * it is only called when the response may not have been consumed.
+     */
+    private static void release(HttpURLConnection connection, boolean consumed) {
+        if (connection != null && !consumed) {
+            connection.disconnect();
+        }
+    }
+
     /**
      * Read response body from connection (handles both success and error streams).
      */
@@ -624,10 +455,99 @@ public class IOHttpClient {
         }
     }
     
+    private static InputStream responseStream(HttpURLConnection connection) {
+        try {
+            return connection.getInputStream();
+        } catch (IOException e) {
+            return connection.getErrorStream();
+        }
+    }
+    
+    /**
+     * Read the response body straight into native memory.
+     *
+     * The body is read into direct buffers over a native vector that later
+     * becomes the JS ArrayBuffer, so it is never held on the Java heap. With a
+     * Content-Length the vector is sized once up front.
+     */
+    private static void readResponseBodyNative(HttpURLConnection connection, long nativeBodyBuffer,
+                                               long nativeCancelCheck) throws IOException {
+        InputStream is = responseStream(connection);
+        if (is == null) {
+            return;
+        }
+        
+        long length = connection.getContentLengthLong();
+        long committed = 0;
+        try (ReadableByteChannel channel = Channels.newChannel(is)) {
+            ByteBuffer window = nativeBodyWindow(nativeBodyBuffer, 0,
+                    length > 0 ? length : STREAM_CHUNK_SIZE);
+            while (length < 0 || committed + window.position() < length) {
+                throwIfCancelled(nativeCancelCheck);
+                if (!window.hasRemaining()) {
+                    committed += window.position();
+                    window = nativeBodyWindow(nativeBodyBuffer, committed, Math.max(committed, STREAM_CHUNK_SIZE));
+                }
+                if (channel.read(window) < 0) {
+                    break;
+                }
+            }
+            committed += window.position();
+        } finally {
+            nativeBodyWindow(nativeBodyBuffer, committed, 0);
+        }
+    }
+    
+    /**
+     * Hand the response body to native code as it arrives.
+     *
+     * Each read() returns what the socket has, so the first bytes reach the
+     * sink without waiting for the rest. Chunks are read into native memory and
+     * moved to the sink without a copy. The sink may block, which stops
+     * reading and lets TCP flow control slow the server down.
+     */
+    private static void streamResponseBody(HttpURLConnection connection, long nativeBodyBuffer,
+                                           long nativeBodySink, long nativeCancelCheck) throws IOException {
+        InputStream is = responseStream(connection);
+        if (is == null) {
+            return;
+        }
+
+        try (ReadableByteChannel channel = Channels.newChannel(is)) {
+            while (true) {
+                ByteBuffer window = nativeBodyWindow(nativeBodyBuffer, 0, STREAM_CHUNK_SIZE);
+                int bytesRead = channel.read(window);
+                if (bytesRead < 0) {
+                    break;
+                }
+                throwIfCancelled(nativeCancelCheck);
+                if (bytesRead > 0 && !nativeBodyChunk(nativeBodySink, nativeBodyBuffer, bytesRead)) {
+                    throw new InterruptedIOException("Operation cancelled");
+                }
+            }
+        }
+    }
+
     // ========================================================================
     // Native Progress Callbacks (implemented in C++)
     // ========================================================================
     
     private static native void nativeDownloadProgress(long callback, long current, long total, double progress);
     private static native void nativeUploadProgress(long callback, long current, long total, double progress);
+    private static native boolean nativeIsCancelled(long cancelCheck);
+    /**
+     * Commit the first {@code committed} bytes of a native body buffer and
+     * return a direct buffer over at least {@code want} free bytes after them
+     * (null when want is 0). Earlier windows must not be used afterwards.
+     */
+    private static native ByteBuffer nativeBodyWindow(long buffer, long committed, long want);
+    /** Move the first {@code length} bytes of a native body buffer to the sink */
+    private static native boolean nativeBodyChunk(long sink, long buffer, int length);
+    /**
+     * Fill a direct buffer from its start with the next bytes of a native
+     * upload body; returns the byte count, 0 at the end, -1 on a read error.
+     */
+    private static native int nativeUploadRead(long source, ByteBuffer window);
+    /** Tell native code the Content-Encoding of the body about to be read (may be null) */
+    private static native void nativeBodyEncoding(long buffer, String encoding);
 }
@@ -0,0 +1,86 @@
+/**
+ * @file main.cpp
+ * @brief Host benchmark runner: io_bench [--quick] [--suite NAME]... [--dir PATH] [--out FILE]
+ *
+ * Prints the JSON report of BenchmarkRunner to stdout, or writes it to
+ * --out. Suites are fs, list, hash and codec; all run by default.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "IOBenchmark.hpp"
+
+namespace {
+
+auto usage() -> int {
+    std::fprintf(stderr, "usage: io_bench [--quick] [--suite fs|list|hash|codec]... [--dir PATH] [--out FILE]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    rct_io::BenchmarkOptions options;
+    options.directory = std::filesystem::temp_directory_path().string();
+    std::string out;
+
+    for (int i = 1; i < argc; ++i) {
+        auto needsValue = [&] { return i + 1 < argc; };
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            options.quick = true;
+        } else if (std::strcmp(argv[i], "--suite") == 0 && needsValue()) {
+            options.suites.emplace_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--dir") == 0 && needsValue()) {
+            options.directory = argv[++i];
+        } else if (std::strcmp(argv[i], "--out") == 0 && needsValue()) {
+            out = argv[++i];
+        } else {
+            return usage();
+        }
+    }
+
+    try {
+        rct_io::BenchmarkRunner runner(options);
+        runner.run();
+        auto json = runner.toJson();
+        if (out.empty()) {
+            std::printf("%s\n", json.c_str());
+        } else {
+            std::ofstream file(out, std::ios::binary | std::ios::trunc);
+            file << json << '\n';
+            if (!file) {
+                std::fprintf(stderr, "io_bench: cannot write %s\n", out.c_str());
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "io_bench: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
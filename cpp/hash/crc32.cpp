@@ -5,6 +5,7 @@
 //
 
 #include "crc32.h"
+#include "hash_hw.h"
 
 // big endian architectures need #define __BYTE_ORDER __BIG_ENDIAN
 #ifndef _MSC_VER
@@ -341,6 +342,14 @@ void CRC32::add(const void* data, size_t numBytes)
   uint32_t* current = (uint32_t*) data;
   uint32_t crc = ~m_hash;
 
+  // CRC32 instructions / carry-less multiplication, if available
+  if (hash_hw::hasCRC32())
+  {
+    size_t processed = hash_hw::crc32Update(crc, (const uint8_t*) data, numBytes);
+    current   = (uint32_t*) ((const uint8_t*) data + processed);
+    numBytes -= processed;
+  }
+
   // process eight bytes at once
   while (numBytes >= 8)
   {
@@ -379,6 +388,45 @@ void CRC32::add(const void* data, size_t numBytes)
 }
 
 
+namespace
+{
+  /// zlib polynomial, bit-reflected
+  const uint32_t Polynomial = 0xEDB88320;
+
+  /// multiply two polynomials modulo Polynomial (bit-reflected, x^0 is the highest bit)
+  uint32_t multiplyModP(uint32_t a, uint32_t b)
+  {
+    uint32_t product = 0;
+    for (uint32_t mask = 1u << 31; mask != 0; mask >>= 1)
+    {
+      if (a & mask)
+        product ^= b;
+      // b *= x
+      b = (b & 1) ? (b >> 1) ^ Polynomial : b >> 1;
+    }
+    return product;
+  }
+}
+
+
+/// CRC32 of A+B given CRC32(A), CRC32(B) and the length of B in bytes (same as zlib's crc32_combine)
+uint32_t CRC32::combine(uint32_t crcA, uint32_t crcB, size_t lengthB)
+{
+  // appending lengthB bytes multiplies crcA by x^(8*lengthB) mod Polynomial,
+  // computed by square-and-multiply over the bits of lengthB
+  uint32_t shift  = 1u << 31;  // x^0
+  uint32_t square = 1u << 23;  // x^8, one byte
+  for (; lengthB != 0; lengthB >>= 1)
+  {
+    if (lengthB & 1)
+      shift = multiplyModP(square, shift);
+    square = multiplyModP(square, square);
+  }
+
+  return multiplyModP(shift, crcA) ^ crcB;
+}
+
+
 /// return latest hash as 8 hex characters
 std::string CRC32::getHash()
 {
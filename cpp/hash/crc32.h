@@ -33,10 +33,15 @@ typedef unsigned __int32 uint32_t;
       crc32.add(pointer to fresh data, number of new bytes);
     std::string myHash3 = crc32.getHash();
 
+    // chunks hashed independently can be merged:
+    uint32_t crcAB = CRC32::combine(crcA, crcB, lengthOfB);
+
     Note:
     You can find code for the faster Slicing-by-16 algorithm on my website, too:
     http://create.stephan-brumme.com/crc32/
     Its unrolled version is about twice as fast but its look-up table doubled in size as well.
+    If the CPU supports it, add() uses the ARMv8 CRC32 instructions or PMULL / PCLMULQDQ
+    folding instead of the look-up table (see hash_hw.h).
   */
 class CRC32 //: public Hash
 {
@@ -63,6 +68,9 @@ public:
   /// restart
   void reset();
 
+  /// CRC32 of A+B given CRC32(A), CRC32(B) and the length of B in bytes (same as zlib's crc32_combine)
+  static uint32_t combine(uint32_t crcA, uint32_t crcB, size_t lengthB);
+
 private:
   /// hash
   uint32_t m_hash;
@@ -0,0 +1,667 @@
+// //////////////////////////////////////////////////////////
+// hash_hw.cpp
+// Copyright (c) 2025 arcticfox
+// Hardware-accelerated block functions for the hash library
+//
+
+#include "hash_hw.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define HASH_HW_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#define HASH_HW_ARM 1
+#include <arm_neon.h>
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sys/auxv.h>
+#ifndef HWCAP_SHA1
+#define HWCAP_SHA1 (1 << 5)
+#endif
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)
+#endif
+#ifndef HWCAP_PMULL
+#define HWCAP_PMULL (1 << 4)
+#endif
+#endif
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define HASH_HW_ARM_CRC 1
+#include <arm_acle.h>
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sys/auxv.h>
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+#endif
+#endif
+
+
+namespace
+{
+  /// SHA256 round constants
+  alignas(16) const uint32_t K256[64] =
+  {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+
+  /// CRC32 folding constants (bit-reflected, zlib polynomial 0xEDB88320)
+  /** see Gopal et al., "Fast CRC Computation for Generic Polynomials Using
+      PCLMULQDQ Instruction", Intel 2009:
+      k1 = x^(4*128+32) mod P, k2 = x^(4*128-32) mod P  (fold by 4 x 128 bits)
+      k3 = x^(128+32)   mod P, k4 = x^(128-32)   mod P  (fold by 128 bits)
+      k5 = x^64 mod P, followed by P and mu = x^64 / P  (Barrett reduction) */
+  alignas(16) const uint64_t CrcK1K2[2] = { 0x0154442bd4ULL, 0x01c6e41596ULL };
+  alignas(16) const uint64_t CrcK3K4[2] = { 0x01751997d0ULL, 0x00ccaa009eULL };
+  alignas(16) const uint64_t CrcK5K0[2] = { 0x0163cd6124ULL, 0 };
+  alignas(16) const uint64_t CrcPoly[2] = { 0x01db710641ULL, 0x01f7011641ULL };
+
+  /// folding needs at least four 128 bit lanes
+  const size_t CrcFoldMinimum = 64;
+  /// below this size the ARMv8 CRC32 instructions are faster than PMULL folding
+  const size_t CrcFoldMinimumArm = 1024;
+
+#ifdef HASH_HW_X86
+  // ----------------------------------------------------------
+  // x86 SHA-NI
+  // ----------------------------------------------------------
+
+  bool detectShaNi()
+  {
+    unsigned int eax, ebx, ecx, edx;
+    // SSSE3 and SSE4.1 (leaf 1, ECX bits 9 and 19)
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+      return false;
+    if (!(ecx & (1u << 9)) || !(ecx & (1u << 19)))
+      return false;
+    // SHA (leaf 7, EBX bit 29)
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+      return false;
+    return (ebx & (1u << 29)) != 0;
+  }
+
+  __attribute__((target("sha,sse4.1,ssse3")))
+  void sha256BlocksX86(uint32_t state[8], const uint8_t* data, size_t numBlocks)
+  {
+    const __m128i SHUF_MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // state is kept as ABEF / CDGH, the layout sha256rnds2 works on
+    __m128i tmp    = _mm_loadu_si128((const __m128i*) &state[0]);
+    __m128i state1 = _mm_loadu_si128((const __m128i*) &state[4]);
+    tmp    = _mm_shuffle_epi32(tmp,    0xB1); // CDAB
+    state1 = _mm_shuffle_epi32(state1, 0x1B); // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);    // ABEF
+    state1         = _mm_blend_epi16(state1, tmp, 0xF0); // CDGH
+
+    for (; numBlocks > 0; numBlocks--, data += 64)
+    {
+      __m128i abefSave = state0;
+      __m128i cdghSave = state1;
+
+      __m128i w[4];
+      for (int i = 0; i < 16; i++)
+      {
+        // message schedule, four words at a time
+        if (i < 4)
+          w[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 16 * i)), SHUF_MASK);
+        else
+        {
+          __m128i next = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+          next = _mm_add_epi32(next, _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+          w[i & 3] = _mm_sha256msg2_epu32(next, w[(i + 3) & 3]);
+        }
+
+        // four rounds
+        __m128i msg = _mm_add_epi32(w[i & 3], _mm_load_si128((const __m128i*) &K256[4 * i]));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg    = _mm_shuffle_epi32(msg, 0x0E);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      }
+
+      state0 = _mm_add_epi32(state0, abefSave);
+      state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    tmp    = _mm_shuffle_epi32(state0, 0x1B);    // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);    // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0); // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);    // ABEF
+    _mm_storeu_si128((__m128i*) &state[0], state0);
+    _mm_storeu_si128((__m128i*) &state[4], state1);
+  }
+
+  __attribute__((target("sha,sse4.1,ssse3")))
+  void sha1BlocksX86(uint32_t state[5], const uint8_t* data, size_t numBlocks)
+  {
+    const __m128i SHUF_MASK = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) state), 0x1B);
+    __m128i e0   = _mm_set_epi32((int) state[4], 0, 0, 0);
+
+    for (; numBlocks > 0; numBlocks--, data += 64)
+    {
+      __m128i abcdSave = abcd;
+      __m128i e0Save   = e0;
+      __m128i prev     = abcd;
+
+      __m128i w[4];
+      for (int i = 0; i < 20; i++)
+      {
+        if (i < 4)
+          w[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 16 * i)), SHUF_MASK);
+        else
+        {
+          __m128i next = _mm_sha1msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+          next = _mm_xor_si128(next, w[(i + 2) & 3]);
+          w[i & 3] = _mm_sha1msg2_epu32(next, w[(i + 3) & 3]);
+        }
+
+        // e for these four rounds is derived from a four rounds ago
+        __m128i e = (i == 0) ? _mm_add_epi32(e0, w[0]) : _mm_sha1nexte_epu32(prev, w[i & 3]);
+        prev = abcd;
+        switch (i / 5)
+        {
+          case 0:  abcd = _mm_sha1rnds4_epu32(abcd, e, 0); break;
+          case 1:  abcd = _mm_sha1rnds4_epu32(abcd, e, 1); break;
+          case 2:  abcd = _mm_sha1rnds4_epu32(abcd, e, 2); break;
+          default: abcd = _mm_sha1rnds4_epu32(abcd, e, 3); break;
+        }
+      }
+
+      e0   = _mm_sha1nexte_epu32(prev, e0Save);
+      abcd = _mm_add_epi32(abcd, abcdSave);
+    }
+
+    abcd = _mm_shuffle_epi32(abcd, 0x1B);
+    _mm_storeu_si128((__m128i*) state, abcd);
+    state[4] = (uint32_t) _mm_extract_epi32(e0, 3);
+  }
+
+  // ----------------------------------------------------------
+  // x86 PCLMULQDQ (CRC32 folding)
+  // ----------------------------------------------------------
+  // Note: the SSE4.2 crc32 instruction computes CRC32C (Castagnoli),
+  //       not the zlib polynomial, so only carry-less folding helps here.
+
+  bool detectPclmul()
+  {
+    unsigned int eax, ebx, ecx, edx;
+    // PCLMULQDQ and SSE4.1 (leaf 1, ECX bits 1 and 19)
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+      return false;
+    return (ecx & (1u << 1)) && (ecx & (1u << 19));
+  }
+
+  /// fold numBytes (>= 64, multiple of 16) into crc (internal, i.e. inverted, register)
+  __attribute__((target("pclmul,sse4.1")))
+  uint32_t crc32FoldX86(uint32_t crc, const uint8_t* data, size_t numBytes)
+  {
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+    x1 = _mm_loadu_si128((const __m128i*) (data + 0x00));
+    x2 = _mm_loadu_si128((const __m128i*) (data + 0x10));
+    x3 = _mm_loadu_si128((const __m128i*) (data + 0x20));
+    x4 = _mm_loadu_si128((const __m128i*) (data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) crc));
+    data     += 64;
+    numBytes -= 64;
+
+    // fold four lanes in parallel
+    x0 = _mm_load_si128((const __m128i*) CrcK1K2);
+    for (; numBytes >= 64; numBytes -= 64, data += 64)
+    {
+      x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+      x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+      x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+      x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+      x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+      x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+      x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+      x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+      x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*) (data + 0x00)));
+      x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*) (data + 0x10)));
+      x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*) (data + 0x20)));
+      x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*) (data + 0x30)));
+    }
+
+    // fold four lanes into one
+    x0 = _mm_load_si128((const __m128i*) CrcK3K4);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // remaining 16 byte blocks
+    for (; numBytes >= 16; numBytes -= 16, data += 16)
+    {
+      x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+      x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+      x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*) data));
+    }
+
+    // 128 => 64 bits
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x0 = _mm_loadl_epi64((const __m128i*) CrcK5K0);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction 64 => 32 bits
+    x0 = _mm_load_si128((const __m128i*) CrcPoly);
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (uint32_t) _mm_extract_epi32(x1, 1);
+  }
+#endif // HASH_HW_X86
+
+
+#ifdef HASH_HW_ARM
+  // ----------------------------------------------------------
+  // ARMv8 Crypto Extensions
+  // ----------------------------------------------------------
+
+  bool detectArmSha1()
+  {
+#if defined(__APPLE__)
+    return true; // every Apple arm64 CPU has the crypto extensions
+#elif defined(__linux__) || defined(__ANDROID__)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA1) != 0;
+#else
+    return false;
+#endif
+  }
+
+  bool detectArmSha2()
+  {
+#if defined(__APPLE__)
+    return true;
+#elif defined(__linux__) || defined(__ANDROID__)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+    return false;
+#endif
+  }
+
+  inline uint32x4_t loadBigEndian(const uint8_t* data)
+  {
+    return vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data)));
+  }
+
+  void sha256BlocksArm(uint32_t state[8], const uint8_t* data, size_t numBlocks)
+  {
+    uint32x4_t state0 = vld1q_u32(&state[0]);
+    uint32x4_t state1 = vld1q_u32(&state[4]);
+
+    for (; numBlocks > 0; numBlocks--, data += 64)
+    {
+      uint32x4_t abcdSave = state0;
+      uint32x4_t efghSave = state1;
+
+      uint32x4_t w[4];
+      for (int i = 0; i < 16; i++)
+      {
+        if (i < 4)
+          w[i] = loadBigEndian(data + 16 * i);
+        else
+          w[i & 3] = vsha256su1q_u32(vsha256su0q_u32(w[i & 3], w[(i + 1) & 3]),
+                                     w[(i + 2) & 3], w[(i + 3) & 3]);
+
+        uint32x4_t msg  = vaddq_u32(w[i & 3], vld1q_u32(&K256[4 * i]));
+        uint32x4_t save = state0;
+        state0 = vsha256hq_u32 (state0, state1, msg);
+        state1 = vsha256h2q_u32(state1, save,   msg);
+      }
+
+      state0 = vaddq_u32(state0, abcdSave);
+      state1 = vaddq_u32(state1, efghSave);
+    }
+
+    vst1q_u32(&state[0], state0);
+    vst1q_u32(&state[4], state1);
+  }
+
+  void sha1BlocksArm(uint32_t state[5], const uint8_t* data, size_t numBlocks)
+  {
+    const uint32x4_t K[4] =
+    {
+      vdupq_n_u32(0x5a827999), vdupq_n_u32(0x6ed9eba1),
+      vdupq_n_u32(0x8f1bbcdc), vdupq_n_u32(0xca62c1d6)
+    };
+
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32_t   e    = state[4];
+
+    for (; numBlocks > 0; numBlocks--, data += 64)
+    {
+      uint32x4_t abcdSave = abcd;
+      uint32_t   eSave    = e;
+
+      uint32x4_t w[4];
+      for (int i = 0; i < 20; i++)
+      {
+        if (i < 4)
+          w[i] = loadBigEndian(data + 16 * i);
+        else
+          w[i & 3] = vsha1su1q_u32(vsha1su0q_u32(w[i & 3], w[(i + 1) & 3], w[(i + 2) & 3]),
+                                   w[(i + 3) & 3]);
+
+        uint32x4_t msg   = vaddq_u32(w[i & 3], K[i / 5]);
+        uint32_t   eNext = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+        switch (i / 5)
+        {
+          case 0:  abcd = vsha1cq_u32(abcd, e, msg); break; // choose
+          case 2:  abcd = vsha1mq_u32(abcd, e, msg); break; // majority
+          default: abcd = vsha1pq_u32(abcd, e, msg); break; // parity
+        }
+        e = eNext;
+      }
+
+      abcd = vaddq_u32(abcd, abcdSave);
+      e   += eSave;
+    }
+
+    vst1q_u32(state, abcd);
+    state[4] = e;
+  }
+
+  // ----------------------------------------------------------
+  // ARMv8 PMULL (CRC32 folding)
+  // ----------------------------------------------------------
+
+  bool detectArmPmull()
+  {
+#if defined(__APPLE__)
+    return true;
+#elif defined(__linux__) || defined(__ANDROID__)
+    return (getauxval(AT_HWCAP) & HWCAP_PMULL) != 0;
+#else
+    return false;
+#endif
+  }
+
+  /// carry-less multiply of the selected 64 bit lanes of a and b
+  template <int LaneA, int LaneB>
+  inline uint64x2_t clmul(uint64x2_t a, uint64x2_t b)
+  {
+    return vreinterpretq_u64_p128(vmull_p64(vgetq_lane_p64(vreinterpretq_p64_u64(a), LaneA),
+                                            vgetq_lane_p64(vreinterpretq_p64_u64(b), LaneB)));
+  }
+
+  /// shift a 128 bit register right by Bytes bytes
+  template <int Bytes>
+  inline uint64x2_t shiftRight(uint64x2_t x)
+  {
+    return vreinterpretq_u64_u8(vextq_u8(vreinterpretq_u8_u64(x), vdupq_n_u8(0), Bytes));
+  }
+
+  inline uint64x2_t load128(const uint8_t* data)
+  {
+    return vreinterpretq_u64_u8(vld1q_u8(data));
+  }
+
+  /// fold numBytes (>= 64, multiple of 16) into crc (internal, i.e. inverted, register)
+  uint32_t crc32FoldArm(uint32_t crc, const uint8_t* data, size_t numBytes)
+  {
+    uint64x2_t x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+    x1 = load128(data + 0x00);
+    x2 = load128(data + 0x10);
+    x3 = load128(data + 0x20);
+    x4 = load128(data + 0x30);
+    x1 = veorq_u64(x1, vsetq_lane_u64((uint64_t) crc, vdupq_n_u64(0), 0));
+    data     += 64;
+    numBytes -= 64;
+
+    // fold four lanes in parallel
+    x0 = vld1q_u64(CrcK1K2);
+    for (; numBytes >= 64; numBytes -= 64, data += 64)
+    {
+      x5 = clmul<0, 0>(x1, x0);
+      x6 = clmul<0, 0>(x2, x0);
+      x7 = clmul<0, 0>(x3, x0);
+      x8 = clmul<0, 0>(x4, x0);
+      x1 = clmul<1, 1>(x1, x0);
+      x2 = clmul<1, 1>(x2, x0);
+      x3 = clmul<1, 1>(x3, x0);
+      x4 = clmul<1, 1>(x4, x0);
+      x1 = veorq_u64(veorq_u64(x1, x5), load128(data + 0x00));
+      x2 = veorq_u64(veorq_u64(x2, x6), load128(data + 0x10));
+      x3 = veorq_u64(veorq_u64(x3, x7), load128(data + 0x20));
+      x4 = veorq_u64(veorq_u64(x4, x8), load128(data + 0x30));
+    }
+
+    // fold four lanes into one
+    x0 = vld1q_u64(CrcK3K4);
+    x5 = clmul<0, 0>(x1, x0);
+    x1 = clmul<1, 1>(x1, x0);
+    x1 = veorq_u64(veorq_u64(x1, x2), x5);
+    x5 = clmul<0, 0>(x1, x0);
+    x1 = clmul<1, 1>(x1, x0);
+    x1 = veorq_u64(veorq_u64(x1, x3), x5);
+    x5 = clmul<0, 0>(x1, x0);
+    x1 = clmul<1, 1>(x1, x0);
+    x1 = veorq_u64(veorq_u64(x1, x4), x5);
+
+    // remaining 16 byte blocks
+    for (; numBytes >= 16; numBytes -= 16, data += 16)
+    {
+      x5 = clmul<0, 0>(x1, x0);
+      x1 = clmul<1, 1>(x1, x0);
+      x1 = veorq_u64(veorq_u64(x1, x5), load128(data));
+    }
+
+    // 128 => 64 bits
+    x2 = clmul<0, 1>(x1, x0);
+    x3 = vdupq_n_u64(0xFFFFFFFFULL);
+    x1 = veorq_u64(shiftRight<8>(x1), x2);
+    x0 = vld1q_u64(CrcK5K0);
+    x2 = shiftRight<4>(x1);
+    x1 = vandq_u64(x1, x3);
+    x1 = clmul<0, 0>(x1, x0);
+    x1 = veorq_u64(x1, x2);
+
+    // Barrett reduction 64 => 32 bits
+    x0 = vld1q_u64(CrcPoly);
+    x2 = vandq_u64(x1, x3);
+    x2 = clmul<0, 1>(x2, x0);
+    x2 = vandq_u64(x2, x3);
+    x2 = clmul<0, 0>(x2, x0);
+    x1 = veorq_u64(x1, x2);
+
+    return vgetq_lane_u32(vreinterpretq_u32_u64(x1), 1);
+  }
+#endif // HASH_HW_ARM
+
+
+#ifdef HASH_HW_ARM_CRC
+  // ----------------------------------------------------------
+  // ARMv8 CRC32 instructions (same polynomial as zlib)
+  // ----------------------------------------------------------
+
+  bool detectArmCrc32()
+  {
+#if defined(__APPLE__)
+    return true;
+#elif defined(__linux__) || defined(__ANDROID__)
+    return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#else
+    return false;
+#endif
+  }
+
+  /// process all bytes, crc is the internal (inverted) register
+  uint32_t crc32Arm(uint32_t crc, const uint8_t* data, size_t numBytes)
+  {
+    // align to 8 bytes
+    while (numBytes > 0 && ((uintptr_t) data & 7) != 0)
+    {
+      crc = __crc32b(crc, *data++);
+      numBytes--;
+    }
+
+    // 32 bytes per iteration
+    const uint64_t* current = (const uint64_t*) data;
+    for (; numBytes >= 32; numBytes -= 32, current += 4)
+    {
+      crc = __crc32d(crc, current[0]);
+      crc = __crc32d(crc, current[1]);
+      crc = __crc32d(crc, current[2]);
+      crc = __crc32d(crc, current[3]);
+    }
+    for (; numBytes >= 8; numBytes -= 8)
+      crc = __crc32d(crc, *current++);
+
+    data = (const uint8_t*) current;
+    if (numBytes >= 4)
+    {
+      crc = __crc32w(crc, *(const uint32_t*) data);
+      data     += 4;
+      numBytes -= 4;
+    }
+    if (numBytes >= 2)
+    {
+      crc = __crc32h(crc, *(const uint16_t*) data);
+      data     += 2;
+      numBytes -= 2;
+    }
+    if (numBytes > 0)
+      crc = __crc32b(crc, *data);
+
+    return crc;
+  }
+#endif // HASH_HW_ARM_CRC
+}
+
+
+/// true if sha1Blocks() can be used on this CPU
+bool hash_hw::hasSHA1()
+{
+#if defined(HASH_HW_X86)
+  static const bool available = detectShaNi();
+  return available;
+#elif defined(HASH_HW_ARM)
+  static const bool available = detectArmSha1();
+  return available;
+#else
+  return false;
+#endif
+}
+
+
+/// true if sha256Blocks() can be used on this CPU
+bool hash_hw::hasSHA256()
+{
+#if defined(HASH_HW_X86)
+  static const bool available = detectShaNi();
+  return available;
+#elif defined(HASH_HW_ARM)
+  static const bool available = detectArmSha2();
+  return available;
+#else
+  return false;
+#endif
+}
+
+
+/// process numBlocks consecutive 64-byte blocks, updating state[5]
+void hash_hw::sha1Blocks(uint32_t state[5], const uint8_t* data, size_t numBlocks)
+{
+#if defined(HASH_HW_X86)
+  sha1BlocksX86(state, data, numBlocks);
+#elif defined(HASH_HW_ARM)
+  sha1BlocksArm(state, data, numBlocks);
+#else
+  (void) state; (void) data; (void) numBlocks;
+#endif
+}
+
+
+/// process numBlocks consecutive 64-byte blocks, updating state[8]
+void hash_hw::sha256Blocks(uint32_t state[8], const uint8_t* data, size_t numBlocks)
+{
+#if defined(HASH_HW_X86)
+  sha256BlocksX86(state, data, numBlocks);
+#elif defined(HASH_HW_ARM)
+  sha256BlocksArm(state, data, numBlocks);
+#else
+  (void) state; (void) data; (void) numBlocks;
+#endif
+}
+
+
+/// true if crc32Update() can process (part of) a buffer on this CPU
+bool hash_hw::hasCRC32()
+{
+#if defined(HASH_HW_X86)
+  static const bool available = detectPclmul();
+  return available;
+#else
+  bool available = false;
+#if defined(HASH_HW_ARM_CRC)
+  static const bool crcInstructions = detectArmCrc32();
+  available = available || crcInstructions;
+#endif
+#if defined(HASH_HW_ARM)
+  static const bool pmull = detectArmPmull();
+  available = available || pmull;
+#endif
+  return available;
+#endif
+}
+
+
+/// update CRC32 state, return number of bytes processed from the start of data
+size_t hash_hw::crc32Update(uint32_t& crc, const uint8_t* data, size_t numBytes)
+{
+#if defined(HASH_HW_X86)
+  if (numBytes < CrcFoldMinimum)
+    return 0;
+  size_t numFolded = numBytes & ~(size_t) 15;
+  crc = crc32FoldX86(crc, data, numFolded);
+  return numFolded;
+#else
+  size_t processed = 0;
+#if defined(HASH_HW_ARM)
+  // PMULL folding beats the CRC32 instructions on large buffers only
+  static const bool pmull = detectArmPmull();
+  if (pmull && numBytes >= CrcFoldMinimumArm)
+  {
+    processed = numBytes & ~(size_t) 15;
+    crc = crc32FoldArm(crc, data, processed);
+  }
+#endif
+#if defined(HASH_HW_ARM_CRC)
+  static const bool crcInstructions = detectArmCrc32();
+  if (crcInstructions)
+  {
+    crc = crc32Arm(crc, data + processed, numBytes - processed);
+    processed = numBytes;
+  }
+#endif
+  (void) crc; (void) data; (void) numBytes;
+  return processed;
+#endif
+}
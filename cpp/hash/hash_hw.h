@@ -0,0 +1,40 @@
+// //////////////////////////////////////////////////////////
+// hash_hw.h
+// Copyright (c) 2025 arcticfox
+// Hardware-accelerated block functions for the hash library
+//
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// CPU-specific kernels used by SHA1, SHA256 and CRC32 when the CPU supports them
+/** Kernels are compiled only for targets that can run them:
+    - x86 / x86_64: SHA-NI and PCLMULQDQ (GCC/Clang, enabled per function)
+    - AArch64:      ARMv8 Crypto Extensions and CRC32 instructions
+                    (needs +crc+crypto for hash_hw.cpp)
+
+    Availability is detected once at runtime; callers must check has*()
+    before calling the matching *Blocks() function.
+  */
+namespace hash_hw
+{
+  /// true if sha1Blocks() can be used on this CPU
+  bool hasSHA1();
+  /// true if sha256Blocks() can be used on this CPU
+  bool hasSHA256();
+
+  /// process numBlocks consecutive 64-byte blocks, updating state[5]
+  void sha1Blocks(uint32_t state[5], const uint8_t* data, size_t numBlocks);
+  /// process numBlocks consecutive 64-byte blocks, updating state[8]
+  void sha256Blocks(uint32_t state[8], const uint8_t* data, size_t numBlocks);
+
+  /// true if crc32Update() can be used on this CPU
+  bool hasCRC32();
+  /// update the internal (inverted) CRC32 register with a prefix of data
+  /** Returns the number of bytes consumed; the caller processes the rest.
+      Short buffers may not be consumed at all (returns 0). */
+  size_t crc32Update(uint32_t& crc, const uint8_t* data, size_t numBytes);
+}
@@ -5,6 +5,7 @@
 //
 
 #include "sha1.h"
+#include "hash_hw.h"
 
 // big endian architectures need #define __BYTE_ORDER __BIG_ENDIAN
 #ifndef _MSC_VER
@@ -77,6 +78,13 @@ namespace
 /// process 64 bytes
 void SHA1::processBlock(const void* data)
 {
+  // use CPU instructions if available
+  if (hash_hw::hasSHA1())
+  {
+    hash_hw::sha1Blocks(m_hash, (const uint8_t*) data, 1);
+    return;
+  }
+
   // get last hash
   uint32_t a = m_hash[0];
   uint32_t b = m_hash[1];
@@ -179,6 +187,15 @@ void SHA1::add(const void* data, size_t numBytes)
     return;
 
   // process full blocks
+  if (hash_hw::hasSHA1())
+  {
+    // hand all blocks to the CPU kernel at once (state stays in registers)
+    size_t numBlocks = numBytes / BlockSize;
+    hash_hw::sha1Blocks(m_hash, current, numBlocks);
+    current    += numBlocks * BlockSize;
+    m_numBytes += numBlocks * BlockSize;
+    numBytes   -= numBlocks * BlockSize;
+  }
   while (numBytes >= BlockSize)
   {
     processBlock(current);
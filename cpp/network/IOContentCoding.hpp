@@ -0,0 +1,222 @@
+/**
+ * @file IOContentCoding.hpp
+ * @brief HTTP content codings (gzip, deflate) in native code
+ *
+ * Decodes compressed response bodies incrementally, so both buffered and
+ * streamed bodies can be decoded on the transfer thread as they arrive,
+ * and gzip-encodes request bodies. Built on zlib, which every platform
+ * already links.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace rct_io::network {
+
+/// Accept-Encoding sent by clients that decode natively
+inline constexpr const char* kNativeAcceptEncoding = "gzip, deflate";
+
+/**
+ * @brief Streaming decoder of one Content-Encoding
+ *
+ * Output is delivered in blocks of at most kBlockSize bytes.
+ */
+class ContentDecoder {
+public:
+    using Output = std::function<bool(const uint8_t* data, size_t size)>;
+
+    static constexpr size_t kBlockSize = 64 * 1024;
+
+private:
+    z_stream stream_{};
+    bool ready_ = false;      // inflateInit2 done (deflate waits for its first bytes)
+    bool started_ = false;    // Some output was produced
+    bool ended_ = false;
+    std::string name_;
+    std::vector<uint8_t> block_;
+    std::vector<uint8_t> head_;  // First bytes of a deflate body, until sniffed
+
+    auto init(int windowBits) -> void {
+        if (inflateInit2(&stream_, windowBits) != Z_OK) {
+            throw std::runtime_error("Cannot initialize " + name_ + " decoder");
+        }
+        ready_ = true;
+    }
+
+    explicit ContentDecoder(std::string name) : name_(std::move(name)), block_(kBlockSize) {}
+
+    ContentDecoder(std::string name, int windowBits) : ContentDecoder(std::move(name)) {
+        init(windowBits);
+    }
+
+    /**
+     * @brief Pick zlib or raw deflate from the first two bytes
+     *
+     * Some servers send "deflate" as a bare deflate stream without the zlib
+     * header. A zlib header has CM = 8 and a 16-bit value divisible by 31.
+     */
+    auto initDeflate(const uint8_t* header) -> void {
+        bool zlib = (header[0] & 0x0f) == Z_DEFLATED
+            && ((static_cast<unsigned>(header[0]) << 8) | header[1]) % 31 == 0;
+        init(zlib ? 15 : -15);
+    }
+
+    auto inflateInput(const uint8_t* data, size_t size, const Output& out) -> bool {
+        stream_.next_in = const_cast<Bytef*>(data);
+        stream_.avail_in = static_cast<uInt>(size);
+        // Keep going while input is left or the last call filled the block,
+        // in which case zlib may still hold output
+        bool blockFull = false;
+        while (!ended_ && (stream_.avail_in > 0 || blockFull)) {
+            stream_.next_out = block_.data();
+            stream_.avail_out = static_cast<uInt>(block_.size());
+            auto status = inflate(&stream_, Z_NO_FLUSH);
+            if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) {
+                throw std::runtime_error("Invalid " + name_ + " response body"
+                    + (stream_.msg ? std::string(": ") + stream_.msg : std::string()));
+            }
+            auto produced = block_.size() - stream_.avail_out;
+            if (produced > 0) {
+                started_ = true;
+                if (!out(block_.data(), produced)) {
+                    return false;
+                }
+            }
+            if (status == Z_STREAM_END) {
+                ended_ = true;  // Trailing bytes after the stream are ignored
+            } else if (status == Z_BUF_ERROR) {
+                break;  // No progress possible until more input arrives
+            }
+            blockFull = stream_.avail_out == 0;
+        }
+        return true;
+    }
+
+public:
+    ~ContentDecoder() {
+        if (ready_) {
+            inflateEnd(&stream_);
+        }
+    }
+    ContentDecoder(const ContentDecoder&) = delete;
+    ContentDecoder& operator=(const ContentDecoder&) = delete;
+
+    /**
+     * @brief Decoder of a Content-Encoding header value
+     * @return nullptr for identity or a coding this build cannot decode
+     *         (the body is then passed on as received)
+     */
+    static auto create(std::string encoding) -> std::unique_ptr<ContentDecoder> {
+        std::transform(encoding.begin(), encoding.end(), encoding.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        encoding.erase(0, encoding.find_first_not_of(" \t"));
+        encoding.erase(encoding.find_last_not_of(" \t") + 1);
+        if (encoding == "gzip" || encoding == "x-gzip") {
+            return std::unique_ptr<ContentDecoder>(new ContentDecoder("gzip", 15 + 16));
+        }
+        if (encoding == "deflate") {
+            return std::unique_ptr<ContentDecoder>(new ContentDecoder("deflate"));
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] auto name() const -> const std::string& { return name_; }
+
+    /**
+     * @brief Decode the next piece of the body
+     * @return false if out returned false
+     * @throws std::runtime_error on corrupt data
+     */
+    auto decode(const uint8_t* data, size_t size, const Output& out) -> bool {
+        if (ready_) {
+            return inflateInput(data, size, out);
+        }
+        // deflate: hold the first bytes back until the header can be sniffed
+        head_.insert(head_.end(), data, data + size);
+        if (head_.size() < 2) {
+            return true;
+        }
+        initDeflate(head_.data());
+        auto head = std::move(head_);
+        head_.clear();
+        return inflateInput(head.data(), head.size(), out);
+    }
+
+    /**
+     * @brief Check the body was complete
+     * @throws std::runtime_error if the compressed stream was cut short
+     */
+    auto finish() const -> void {
+        if ((started_ && !ended_) || !head_.empty()) {
+            throw std::runtime_error("Truncated " + name_ + " response body");
+        }
+    }
+
+    /** @brief Decode a whole body at once */
+    auto decodeAll(std::span<const uint8_t> body) -> std::vector<uint8_t> {
+        std::vector<uint8_t> decoded;
+        decoded.reserve(body.size() * 4);
+        decode(body.data(), body.size(), [&decoded](const uint8_t* data, size_t size) {
+            decoded.insert(decoded.end(), data, data + size);
+            return true;
+        });
+        finish();
+        return decoded;
+    }
+};
+
+/**
+ * @brief gzip-encode a request body
+ * @param level zlib level (-1 = default, 1 fastest ... 9 smallest)
+ */
+inline auto gzipEncode(std::span<const uint8_t> data, int level = Z_DEFAULT_COMPRESSION) -> std::vector<uint8_t> {
+    z_stream stream{};
+    if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("Cannot initialize gzip encoder");
+    }
+    std::vector<uint8_t> encoded(deflateBound(&stream, static_cast<uLong>(data.size())));
+    stream.next_in = const_cast<Bytef*>(data.data());
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = encoded.data();
+    stream.avail_out = static_cast<uInt>(encoded.size());
+    auto status = deflate(&stream, Z_FINISH);
+    encoded.resize(stream.total_out);
+    deflateEnd(&stream);
+    if (status != Z_STREAM_END) {
+        throw std::runtime_error("gzip encoding of the request body failed");
+    }
+    return encoded;
+}
+
+} // namespace rct_io::network
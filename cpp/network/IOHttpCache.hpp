@@ -0,0 +1,691 @@
+/**
+ * @file IOHttpCache.hpp
+ * @brief Opt-in on-disk HTTP cache with a memory tier
+ *
+ * A private (single-user) cache of GET responses in front of IOHttpClient.
+ * Fresh entries are served without touching the network; stale entries
+ * with an ETag or Last-Modified are revalidated with If-None-Match /
+ * If-Modified-Since, and a 304 is answered from the stored body. Entries
+ * live as one file each in the cache directory, bounded by total size with
+ * least-recently-used eviction; small entries are also kept in memory.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "IOHttpClient.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+namespace rct_io::network {
+
+/**
+ * @brief Size bounds of the HTTP cache (0 disk bytes = disabled)
+ */
+struct HttpCacheLimits {
+    uint64_t maxDiskBytes = 0;
+    uint64_t maxMemoryBytes = 1024 * 1024;
+};
+
+namespace http_cache {
+
+inline constexpr const char* kEntryMagic = "rnio-http-cache 1";
+inline constexpr const char* kEntrySuffix = ".rnio-cache";
+
+/// Largest body the memory tier keeps (also bounded by a quarter of its size)
+inline constexpr uint64_t kMaxMemoryEntry = 256 * 1024;
+
+/// Cap of the heuristic lifetime of responses with only Last-Modified
+inline constexpr int64_t kMaxHeuristicLifetime = 24 * 60 * 60;
+
+inline auto nowSeconds() -> int64_t {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Parse an IMF-fixdate ("Sun, 06 Nov 1994 08:49:37 GMT") to epoch seconds
+ */
+inline auto parseHttpDate(const std::string& value) -> std::optional<int64_t> {
+    static constexpr const char* kMonths[] = {
+        "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    char month[4] = {};
+    int day = 0, year = 0, hour = 0, minute = 0, second = 0;
+    auto comma = value.find(',');
+    if (comma == std::string::npos
+        || std::sscanf(value.c_str() + comma + 1, " %d %3s %d %d:%d:%d", &day, month, &year, &hour, &minute, &second) != 6) {
+        return std::nullopt;
+    }
+    int monthIndex = -1;
+    for (int i = 0; i < 12; ++i) {
+        if (std::string(month) == kMonths[i]) {
+            monthIndex = i;
+        }
+    }
+    if (monthIndex < 0) {
+        return std::nullopt;
+    }
+    std::tm tm{};
+    tm.tm_year = year - 1900;
+    tm.tm_mon = monthIndex;
+    tm.tm_mday = day;
+    tm.tm_hour = hour;
+    tm.tm_min = minute;
+    tm.tm_sec = second;
+    return static_cast<int64_t>(::timegm(&tm));
+}
+
+/// Headers of a 304 that describe its empty body, not the stored one
+inline auto describesBody(const std::string& name) -> bool {
+    return headerNameEquals(name, "Content-Length") || headerNameEquals(name, "Content-Encoding")
+        || headerNameEquals(name, "Transfer-Encoding");
+}
+
+/**
+ * @brief The Cache-Control directives the cache acts on
+ */
+struct CacheControl {
+    bool noStore = false;
+    bool noCache = false;
+    std::optional<int64_t> maxAge;
+
+    static auto parse(const HttpHeaders& headers) -> CacheControl {
+        CacheControl result;
+        auto value = findHeader(headers, "Cache-Control").value_or("");
+        std::transform(value.begin(), value.end(), value.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        size_t pos = 0;
+        while (pos < value.size()) {
+            auto end = value.find(',', pos);
+            auto directive = value.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+            directive.erase(0, directive.find_first_not_of(" \t"));
+            directive.erase(directive.find_last_not_of(" \t") + 1);
+            if (directive == "no-store") {
+                result.noStore = true;
+            } else if (directive == "no-cache" || directive.rfind("no-cache=", 0) == 0) {
+                result.noCache = true;
+            } else if (directive.rfind("max-age=", 0) == 0) {
+                try {
+                    result.maxAge = std::stoll(directive.substr(8));
+                } catch (...) {
+                    result.noCache = true;  // Unparsable means stale
+                }
+            }
+            if (end == std::string::npos) {
+                break;
+            }
+            pos = end + 1;
+        }
+        if (!result.noCache && findHeader(headers, "Pragma").value_or("") == "no-cache") {
+            result.noCache = true;
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief A stored response
+ */
+struct Entry {
+    std::string url;
+    int32_t statusCode = 200;
+    std::string statusMessage;
+    HttpHeaders headers;
+    /// Request header values named by Vary when the response was stored
+    std::vector<std::pair<std::string, std::string>> vary;
+    int64_t storedAt = 0;    // When the response was received
+    int64_t initialAge = 0;  // Age it already had then
+    int64_t lifetime = 0;    // Seconds it stays fresh after the server sent it
+    std::shared_ptr<const std::vector<uint8_t>> body;
+
+    /** @brief Seconds since the origin server sent it */
+    [[nodiscard]] auto age(int64_t now) const -> int64_t {
+        return initialAge + (now - storedAt);
+    }
+
+    [[nodiscard]] auto fresh(int64_t now) const -> bool {
+        return !CacheControl::parse(headers).noCache && lifetime > age(now);
+    }
+
+    [[nodiscard]] auto matches(const HttpRequestConfig& config) const -> bool {
+        if (url != config.url) {
+            return false;
+        }
+        return std::all_of(vary.begin(), vary.end(), [&](const auto& field) {
+            return findHeader(config.headers, field.first).value_or("") == field.second;
+        });
+    }
+
+    [[nodiscard]] auto toResponse() const -> HttpResponse {
+        HttpResponse response;
+        response.success = true;
+        response.statusCode = statusCode;
+        response.statusMessage = statusMessage;
+        response.headers = headers;
+        response.url = url;
+        response.body = *body;
+        return response;
+    }
+
+    /** @brief Recompute age and lifetime from the headers of a response just received */
+    auto updateFreshness(int64_t now) -> void {
+        auto dateHeader = findHeader(headers, "Date");
+        auto date = (dateHeader ? parseHttpDate(*dateHeader) : std::nullopt).value_or(now);
+        int64_t ageHeader = 0;
+        if (auto age = findHeader(headers, "Age")) {
+            try {
+                ageHeader = std::stoll(*age);
+            } catch (...) {
+            }
+        }
+        storedAt = now;
+        initialAge = std::max(std::max<int64_t>(0, now - date), ageHeader);
+
+        auto control = CacheControl::parse(headers);
+        if (control.maxAge) {
+            lifetime = *control.maxAge;
+        } else if (auto expires = findHeader(headers, "Expires")) {
+            lifetime = parseHttpDate(*expires).value_or(date) - date;
+        } else if (auto modified = findHeader(headers, "Last-Modified"); modified && parseHttpDate(*modified)) {
+            lifetime = std::clamp<int64_t>((date - *parseHttpDate(*modified)) / 10, 0, kMaxHeuristicLifetime);
+        } else {
+            lifetime = 0;
+        }
+    }
+
+    [[nodiscard]] auto hasValidator() const -> bool {
+        return findHeader(headers, "ETag") || findHeader(headers, "Last-Modified");
+    }
+};
+
+inline auto writeEntry(const std::filesystem::path& path, const Entry& entry) -> bool {
+    // Unique per store, so two stores of one key never write the same file
+    static std::atomic<uint64_t> counter{0};
+    auto temp = path;
+    temp += "." + std::to_string(::getpid()) + "-" + std::to_string(counter++) + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out << kEntryMagic << '\n'
+            << "url " << entry.url << '\n'
+            << "status " << entry.statusCode << ' ' << entry.statusMessage << '\n'
+            << "stored " << entry.storedAt << '\n'
+            << "age " << entry.initialAge << '\n'
+            << "lifetime " << entry.lifetime << '\n';
+        for (const auto& [name, value] : entry.vary) {
+            out << "vary " << name << '\t' << value << '\n';
+        }
+        for (const auto& [name, value] : entry.headers) {
+            out << "header " << name << '\t' << value << '\n';
+        }
+        out << "body " << entry.body->size() << '\n';
+        out.write(reinterpret_cast<const char*>(entry.body->data()), static_cast<std::streamsize>(entry.body->size()));
+        if (!out.flush()) {
+            std::error_code ec;
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    return !ec;
+}
+
+inline auto readEntry(const std::filesystem::path& path) -> std::optional<Entry> {
+    std::ifstream in(path, std::ios::binary);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != kEntryMagic) {
+        return std::nullopt;
+    }
+    Entry entry;
+    auto tabbed = [](const std::string& rest) {
+        auto tab = rest.find('\t');
+        return tab == std::string::npos
+            ? std::pair<std::string, std::string>{rest, ""}
+            : std::pair<std::string, std::string>{rest.substr(0, tab), rest.substr(tab + 1)};
+    };
+    try {
+        while (std::getline(in, line)) {
+            auto space = line.find(' ');
+            auto key = line.substr(0, space);
+            auto rest = space == std::string::npos ? std::string() : line.substr(space + 1);
+            if (key == "url") {
+                entry.url = rest;
+            } else if (key == "status") {
+                auto split = rest.find(' ');
+                entry.statusCode = std::stoi(rest.substr(0, split));
+                entry.statusMessage = split == std::string::npos ? "" : rest.substr(split + 1);
+            } else if (key == "stored") {
+                entry.storedAt = std::stoll(rest);
+            } else if (key == "age") {
+                entry.initialAge = std::stoll(rest);
+            } else if (key == "lifetime") {
+                entry.lifetime = std::stoll(rest);
+            } else if (key == "vary") {
+                entry.vary.push_back(tabbed(rest));
+            } else if (key == "header") {
+                entry.headers.insert(tabbed(rest));
+            } else if (key == "body") {
+                auto body = std::make_shared<std::vector<uint8_t>>(std::stoull(rest));
+                if (!in.read(reinterpret_cast<char*>(body->data()), static_cast<std::streamsize>(body->size()))) {
+                    return std::nullopt;  // Truncated
+                }
+                entry.body = std::move(body);
+                return entry;
+            }
+        }
+    } catch (const std::exception&) {
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Keys in least-recently-used order with a size per key
+ */
+template <typename Value>
+class LruIndex {
+private:
+    struct Slot {
+        std::list<std::string>::iterator position;
+        uint64_t size;
+        Value value;
+    };
+    std::list<std::string> order_;  // Most recent first
+    std::unordered_map<std::string, Slot> slots_;
+    uint64_t total_ = 0;
+
+public:
+    [[nodiscard]] auto total() const -> uint64_t { return total_; }
+    [[nodiscard]] auto empty() const -> bool { return slots_.empty(); }
+
+    auto find(const std::string& key) -> Value* {
+        auto it = slots_.find(key);
+        if (it == slots_.end()) {
+            return nullptr;
+        }
+        order_.splice(order_.begin(), order_, it->second.position);
+        return &it->second.value;
+    }
+
+    auto put(const std::string& key, uint64_t size, Value value) -> void {
+        erase(key);
+        order_.push_front(key);
+        slots_.emplace(key, Slot{order_.begin(), size, std::move(value)});
+        total_ += size;
+    }
+
+    auto erase(const std::string& key) -> void {
+        auto it = slots_.find(key);
+        if (it != slots_.end()) {
+            total_ -= it->second.size;
+            order_.erase(it->second.position);
+            slots_.erase(it);
+        }
+    }
+
+    /** @brief Remove and return the least recently used key */
+    auto popOldest() -> std::string {
+        auto key = order_.back();
+        erase(key);
+        return key;
+    }
+
+    auto clear() -> void {
+        order_.clear();
+        slots_.clear();
+        total_ = 0;
+    }
+};
+
+} // namespace http_cache
+
+/**
+ * @brief Process-wide HTTP response cache
+ *
+ * Caches successful (200) GET responses that carry a freshness lifetime
+ * or a validator and are not marked no-store. Requests with no-cache,
+ * max-age=0 (or Pragma: no-cache) always revalidate, and a request max-age
+ * caps the age of a response it accepts; requests with no-store, a Range or
+ * their own conditional headers bypass the cache. A successful unsafe
+ * request (POST, PUT, PATCH, DELETE) drops the stored entry of its URL.
+ */
+class HttpCache {
+private:
+    using Entry = http_cache::Entry;
+
+    std::mutex mutex_;
+    std::filesystem::path directory_;
+    HttpCacheLimits limits_;
+    http_cache::LruIndex<bool> disk_;
+    http_cache::LruIndex<std::shared_ptr<const Entry>> memory_;
+
+    static auto keyFor(const std::string& url) -> std::string {
+        // FNV-1a; a collision only costs a miss, as entries store their URL
+        uint64_t hash = 1469598103934665603ull;
+        for (unsigned char c : url) {
+            hash = (hash ^ c) * 1099511628211ull;
+        }
+        char key[17];
+        std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+        return key;
+    }
+
+    [[nodiscard]] auto pathFor(const std::string& key) const -> std::filesystem::path {
+        return directory_ / (key + http_cache::kEntrySuffix);
+    }
+
+    /** @brief Rebuild the disk index from the directory, oldest access first (locked) */
+    auto scanLocked() -> void {
+        disk_.clear();
+        std::error_code ec;
+        std::filesystem::create_directories(directory_, ec);
+        std::vector<std::tuple<std::filesystem::file_time_type, std::string, uint64_t>> found;
+        for (const auto& item : std::filesystem::directory_iterator(directory_, ec)) {
+            auto name = item.path().filename().string();
+            if (name.size() > 4 && name.ends_with(".tmp")) {
+                std::filesystem::remove(item.path(), ec);  // Interrupted write
+                continue;
+            }
+            if (!name.ends_with(http_cache::kEntrySuffix)) {
+                continue;
+            }
+            auto size = item.file_size(ec);
+            auto time = item.last_write_time(ec);
+            if (!ec) {
+                found.emplace_back(time, name.substr(0, name.size() - std::strlen(http_cache::kEntrySuffix)), size);
+            }
+        }
+        std::sort(found.begin(), found.end());
+        for (auto& [time, key, size] : found) {
+            disk_.put(key, size, true);
+        }
+        evictLocked();
+    }
+
+    auto evictLocked() -> void {
+        while (!disk_.empty() && disk_.total() > limits_.maxDiskBytes) {
+            auto key = disk_.popOldest();
+            memory_.erase(key);
+            std::error_code ec;
+            std::filesystem::remove(pathFor(key), ec);
+        }
+        while (!memory_.empty() && memory_.total() > limits_.maxMemoryBytes) {
+            memory_.popOldest();
+        }
+    }
+
+    auto load(const std::string& key) -> std::shared_ptr<const Entry> {
+        std::filesystem::path path;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (auto* cached = memory_.find(key)) {
+                disk_.find(key);
+                return *cached;
+            }
+            if (!disk_.find(key)) {
+                return nullptr;
+            }
+            path = pathFor(key);
+        }
+        auto entry = http_cache::readEntry(path);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!entry) {
+            disk_.erase(key);
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+            return nullptr;
+        }
+        // Keep the recency across launches
+        std::error_code ec;
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+        auto shared = std::make_shared<const Entry>(std::move(*entry));
+        rememberLocked(key, shared);
+        return shared;
+    }
+
+    auto rememberLocked(const std::string& key, const std::shared_ptr<const Entry>& entry) -> void {
+        auto size = static_cast<uint64_t>(entry->body->size());
+        if (size <= std::min(http_cache::kMaxMemoryEntry, limits_.maxMemoryBytes / 4)) {
+            memory_.put(key, size, entry);
+            evictLocked();
+        }
+    }
+
+    auto store(const std::string& key, Entry&& entry) -> std::shared_ptr<const Entry> {
+        auto shared = std::make_shared<const Entry>(std::move(entry));
+        std::filesystem::path path;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (limits_.maxDiskBytes == 0 || shared->body->size() > limits_.maxDiskBytes / 8) {
+                return shared;  // Too large to be worth evicting everything else for
+            }
+            path = pathFor(key);
+        }
+        if (!http_cache::writeEntry(path, *shared)) {
+            return shared;
+        }
+        std::error_code ec;
+        auto size = std::filesystem::file_size(path, ec);
+        std::lock_guard<std::mutex> lock(mutex_);
+        disk_.put(key, ec ? shared->body->size() : size, true);
+        memory_.erase(key);
+        rememberLocked(key, shared);
+        evictLocked();
+        return shared;
+    }
+
+    auto remove(const std::string& key) -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        disk_.erase(key);
+        memory_.erase(key);
+        std::error_code ec;
+        std::filesystem::remove(pathFor(key), ec);
+    }
+
+    static auto cacheable(const HttpRequestConfig& config, const HttpResponse& response) -> bool {
+        if (!response.success || response.statusCode != 200) {
+            return false;
+        }
+        auto vary = findHeader(response.headers, "Vary");
+        return !http_cache::CacheControl::parse(response.headers).noStore
+            && !http_cache::CacheControl::parse(config.headers).noStore
+            && !(vary && vary->find('*') != std::string::npos);
+    }
+
+    static auto makeEntry(const HttpRequestConfig& config, HttpResponse&& response) -> Entry {
+        Entry entry;
+        entry.url = config.url;
+        entry.statusCode = response.statusCode;
+        entry.statusMessage = response.statusMessage;
+        entry.headers = std::move(response.headers);
+        if (auto vary = findHeader(entry.headers, "Vary")) {
+            size_t pos = 0;
+            while (pos < vary->size()) {
+                auto end = vary->find(',', pos);
+                auto name = vary->substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+                name.erase(0, name.find_first_not_of(" \t"));
+                name.erase(name.find_last_not_of(" \t") + 1);
+                if (!name.empty()) {
+                    entry.vary.emplace_back(name, findHeader(config.headers, name).value_or(""));
+                }
+                if (end == std::string::npos) {
+                    break;
+                }
+                pos = end + 1;
+            }
+        }
+        entry.body = std::make_shared<const std::vector<uint8_t>>(std::move(response.body));
+        entry.updateFreshness(http_cache::nowSeconds());
+        return entry;
+    }
+
+public:
+    HttpCache() = default;
+    HttpCache(const HttpCache&) = delete;
+    HttpCache& operator=(const HttpCache&) = delete;
+
+    /** @brief The process-wide cache (never destroyed, like the request scheduler) */
+    [[nodiscard]] static auto instance() -> HttpCache& {
+        static auto* cache = new HttpCache();
+        return *cache;
+    }
+
+    /**
+     * @brief Enable, resize or (maxDiskBytes = 0) disable the cache
+     *
+     * Disabling removes the stored entries. Shrinking evicts at once.
+     */
+    auto configure(const std::filesystem::path& directory, const HttpCacheLimits& limits) -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bool moved = directory != directory_;
+        directory_ = directory;
+        limits_ = limits;
+        if (limits_.maxDiskBytes == 0) {
+            disk_.clear();
+            memory_.clear();
+            std::error_code ec;
+            std::filesystem::remove_all(directory_, ec);
+            return;
+        }
+        if (moved || disk_.empty()) {
+            memory_.clear();
+            scanLocked();
+        } else {
+            evictLocked();
+        }
+    }
+
+    [[nodiscard]] auto limits() -> HttpCacheLimits {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return limits_;
+    }
+
+    [[nodiscard]] auto enabled() -> bool {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return limits_.maxDiskBytes > 0;
+    }
+
+    /**
+     * @brief Perform a request through the cache
+     *
+     * Same contract as IOHttpClient::request(); a revalidated entry is
+     * returned as the stored 200 response with the updated headers.
+     */
+    auto fetch(IOHttpClient& client, const HttpRequestConfig& config) -> HttpResponse {
+        if (!enabled() || config.onBodyChunk) {
+            return client.request(config);
+        }
+        auto key = keyFor(config.url);
+
+        if (config.method != HttpMethod::GET) {
+            auto response = client.request(config);
+            if (config.method != HttpMethod::HEAD && config.method != HttpMethod::OPTIONS
+                && response.success && response.statusCode < 400) {
+                remove(key);
+            }
+            return response;
+        }
+
+        auto requestControl = http_cache::CacheControl::parse(config.headers);
+        if (requestControl.noStore || findHeader(config.headers, "Range")
+            || findHeader(config.headers, "If-None-Match") || findHeader(config.headers, "If-Modified-Since")) {
+            return client.request(config);
+        }
+
+        auto entry = load(key);
+        if (entry && !entry->matches(config)) {
+            entry = nullptr;  // Other URL with the same hash, or other Vary values
+        }
+        auto now = http_cache::nowSeconds();
+        // A request max-age caps the accepted age; max-age=0 revalidates like no-cache
+        bool acceptable = !requestControl.maxAge
+            || (*requestControl.maxAge > 0 && entry && entry->age(now) <= *requestControl.maxAge);
+        if (entry && !requestControl.noCache && acceptable && entry->fresh(now)) {
+            return entry->toResponse();
+        }
+
+        if (!entry || !entry->hasValidator()) {
+            auto response = client.request(config);
+            if (cacheable(config, response)) {
+                auto stored = makeEntry(config, std::move(response));
+                if (stored.lifetime > 0 || stored.hasValidator()) {
+                    return store(key, std::move(stored))->toResponse();
+                }
+                return stored.toResponse();
+            }
+            return response;
+        }
+
+        auto conditional = config;
+        if (auto etag = findHeader(entry->headers, "ETag")) {
+            conditional.headers["If-None-Match"] = *etag;
+        }
+        if (auto modified = findHeader(entry->headers, "Last-Modified")) {
+            conditional.headers["If-Modified-Since"] = *modified;
+        }
+        auto response = client.request(conditional);
+
+        if (response.success && response.statusCode == 304) {
+            // Headers of the 304 replace the stored ones; the body is unchanged
+            Entry updated = *entry;
+            for (auto& [name, value] : response.headers) {
+                if (http_cache::describesBody(name)) {
+                    continue;
+                }
+                eraseHeader(updated.headers, name);
+                updated.headers[name] = value;
+            }
+            updated.updateFreshness(http_cache::nowSeconds());
+            return store(key, std::move(updated))->toResponse();
+        }
+        if (cacheable(config, response)) {
+            return store(key, makeEntry(config, std::move(response)))->toResponse();
+        }
+        if (response.success) {
+            remove(key);
+        }
+        return response;
+    }
+};
+
+} // namespace rct_io::network
@@ -12,7 +12,11 @@
 
 #include "IOHttpClientAndroid.hpp"
 #include "../src/Logger.h"
+#include <algorithm>
 #include <atomic>
+#include <climits>
+#include <new>
+#include <optional>
 
 namespace {
 constexpr const char* TAG = "IOHttpClient";
@@ -40,19 +44,6 @@ std::string JHttpResult::getStatusMessage() {
     return value ? value->toStdString() : "";
 }
 
-std::vector<uint8_t> JHttpResult::getBody() {
-    static const auto field = javaClassStatic()->getField<jbyteArray>("body");
-    auto arr = getFieldValue(field);
-    if (!arr) return {};
-
-    auto size = arr->size();
-    std::vector<uint8_t> result(size);
-    if (size > 0) {
-        arr->getRegion(0, size, reinterpret_cast<jbyte*>(result.data()));
-    }
-    return result;
-}
-
 HttpHeaders JHttpResult::getHeaders() {
     HttpHeaders headers;
     static const auto keysField = javaClassStatic()->getField<JArrayClass<JString>>("headerKeys");
@@ -164,13 +155,18 @@ namespace {
         return arr;
     }
 
-    // Helper: Convert std::vector<uint8_t> to Java byte[]
-    local_ref<JArrayByte> toJByteArray(const std::vector<uint8_t>& vec) {
-        auto arr = JArrayByte::newArray(vec.size());
-        if (!vec.empty()) {
-            arr->setRegion(0, vec.size(), reinterpret_cast<const jbyte*>(vec.data()));
+    // Helper: Wrap bytes in a direct ByteBuffer without copying (null if empty).
+    // Java only reads it, and the bytes outlive the call.
+    local_ref<JByteBuffer> toJDirectBuffer(std::span<const uint8_t> bytes) {
+        if (bytes.empty()) {
+            return nullptr;
         }
-        return arr;
+        return JByteBuffer::wrapBytes(const_cast<uint8_t*>(bytes.data()), bytes.size());
+    }
+
+    // Helper: Pass a cancel check to Java as an opaque pointer (0 = not cancellable)
+    jlong toJCancelCheck(const TransferCancelCheck* cancelCheck) {
+        return (cancelCheck && *cancelCheck) ? reinterpret_cast<jlong>(cancelCheck) : 0;
     }
 }
 
@@ -179,9 +175,12 @@ local_ref<JHttpResult> JIOHttpClient::request(
         const std::string& method,
         const std::vector<std::string>& headerKeys,
         const std::vector<std::string>& headerValues,
-        const std::vector<uint8_t>& body,
+        std::span<const uint8_t> body,
         long timeoutMs,
-        bool followRedirects) {
+        bool followRedirects,
+        JniBodyBuffer* bodyBuffer,
+        const BodyChunkCallback* bodySink,
+        const TransferCancelCheck* cancelCheck) {
 
     rct_io::Logger::d(TAG, "JIOHttpClient::request() - url=%s, method=%s", url.c_str(), method.c_str());
 
@@ -190,13 +189,13 @@ local_ref<JHttpResult> JIOHttpClient::request(
         ->getStaticMethod<JHttpResult(
             JString, JString,
             JArrayClass<JString>, JArrayClass<JString>,
-            JArrayByte, jint, jboolean)>("request");
+            JByteBuffer, jint, jboolean, jlong, jlong, jlong)>("request");
 
     auto jUrl = make_jstring(url);
     auto jMethod = make_jstring(method);
     auto jHeaderKeys = toJStringArray(headerKeys);
     auto jHeaderValues = toJStringArray(headerValues);
-    auto jBody = toJByteArray(body);
+    auto jBody = toJDirectBuffer(body);
 
     return requestMethod(
         JIOHttpClient::javaClassStatic(),
@@ -204,9 +203,12 @@ local_ref<JHttpResult> JIOHttpClient::request(
         *jMethod,
         *jHeaderKeys,
         *jHeaderValues,
-        *jBody,
+        jBody,
         static_cast<jint>(timeoutMs),
-        static_cast<jboolean>(followRedirects)
+        static_cast<jboolean>(followRedirects),
+        reinterpret_cast<jlong>(bodyBuffer),
+        (bodySink && *bodySink) ? reinterpret_cast<jlong>(bodySink) : 0,
+        toJCancelCheck(cancelCheck)
     );
 }
 
@@ -216,7 +218,9 @@ local_ref<JDownloadResult> JIOHttpClient::download(
         const std::vector<std::string>& headerKeys,
         const std::vector<std::string>& headerValues,
         long timeoutMs,
-        bool resumable) {
+        bool resumable,
+        const DownloadProgressCallback* progress,
+        const TransferCancelCheck* cancelCheck) {
 
     rct_io::Logger::d(TAG, "JIOHttpClient::download() - url=%s", url.c_str());
 
@@ -224,7 +228,7 @@ local_ref<JDownloadResult> JIOHttpClient::download(
         ->getStaticMethod<JDownloadResult(
             JString, JString,
             JArrayClass<JString>, JArrayClass<JString>,
-            jint, jboolean)>("download");
+            jint, jboolean, jlong, jlong)>("download");
 
     auto jUrl = make_jstring(url);
     auto jDestPath = make_jstring(destinationPath);
@@ -238,53 +242,48 @@ local_ref<JDownloadResult> JIOHttpClient::download(
         *jHeaderKeys,
         *jHeaderValues,
         static_cast<jint>(timeoutMs),
-        static_cast<jboolean>(resumable)
+        static_cast<jboolean>(resumable),
+        (progress && *progress) ? reinterpret_cast<jlong>(progress) : 0,
+        toJCancelCheck(cancelCheck)
     );
 }
 
 local_ref<JUploadResult> JIOHttpClient::upload(
         const std::string& url,
-        const std::string& filePath,
-        const std::string& fieldName,
-        const std::string& fileName,
-        const std::string& mimeType,
+        const std::string& contentType,
+        int64_t contentLength,
         const std::vector<std::string>& headerKeys,
         const std::vector<std::string>& headerValues,
-        const std::vector<std::string>& formKeys,
-        const std::vector<std::string>& formValues,
-        long timeoutMs) {
+        long timeoutMs,
+        JniUploadSource* bodySource,
+        const UploadProgressCallback* progress,
+        const TransferCancelCheck* cancelCheck) {
 
-    rct_io::Logger::d(TAG, "JIOHttpClient::upload() - filePath=%s", filePath.c_str());
+    rct_io::Logger::d(TAG, "JIOHttpClient::upload() - url=%s, length=%lld", url.c_str(),
+                      static_cast<long long>(contentLength));
 
     static const auto uploadMethod = JIOHttpClient::javaClassStatic()
         ->getStaticMethod<JUploadResult(
-            JString, JString, JString, JString, JString,
+            JString, JString, jlong,
             JArrayClass<JString>, JArrayClass<JString>,
-            JArrayClass<JString>, JArrayClass<JString>,
-            jint)>("upload");
+            jint, jlong, jlong, jlong)>("upload");
 
     auto jUrl = make_jstring(url);
-    auto jFilePath = make_jstring(filePath);
-    auto jFieldName = make_jstring(fieldName);
-    auto jFileName = make_jstring(fileName);
-    auto jMimeType = make_jstring(mimeType);
+    auto jContentType = make_jstring(contentType);
     auto jHeaderKeys = toJStringArray(headerKeys);
     auto jHeaderValues = toJStringArray(headerValues);
-    auto jFormKeys = toJStringArray(formKeys);
-    auto jFormValues = toJStringArray(formValues);
 
     return uploadMethod(
         JIOHttpClient::javaClassStatic(),
         *jUrl,
-        *jFilePath,
-        *jFieldName,
-        *jFileName,
-        *jMimeType,
+        *jContentType,
+        static_cast<jlong>(contentLength),
         *jHeaderKeys,
         *jHeaderValues,
-        *jFormKeys,
-        *jFormValues,
-        static_cast<jint>(timeoutMs)
+        static_cast<jint>(timeoutMs),
+        reinterpret_cast<jlong>(bodySource),
+        (progress && *progress) ? reinterpret_cast<jlong>(progress) : 0,
+        toJCancelCheck(cancelCheck)
     );
 }
 
@@ -307,14 +306,25 @@ HttpResponse IOHttpClientAndroid::request(const HttpRequestConfig& config) {
             headerValues.push_back(v);
         }
 
+        // Negotiate the encoding here rather than leave it to HttpURLConnection,
+        // which only decodes gzip and does it on the Java heap
+        JniBodyBuffer bodyBuffer;
+        if (!findHeader(config.headers, "Accept-Encoding")) {
+            headerKeys.emplace_back("Accept-Encoding");
+            headerValues.emplace_back(kNativeAcceptEncoding);
+            bodyBuffer.negotiated = true;
+        }
         auto jResult = JIOHttpClient::request(
             config.url,
             httpMethodToString(config.method),
             headerKeys,
             headerValues,
-            config.getBodyBytes(),
+            config.bodyBytes(),
             config.timeoutMs,
-            config.followRedirects
+            config.followRedirects,
+            &bodyBuffer,
+            &config.onBodyChunk,
+            &config.isCancelled
         );
 
         if (jResult) {
@@ -323,9 +333,30 @@ HttpResponse IOHttpClientAndroid::request(const HttpRequestConfig& config) {
             response.statusMessage = jResult->getStatusMessage();
             response.url = jResult->getFinalUrl();
             response.errorMessage = jResult->getErrorMessage();
-            response.body = jResult->getBody();
+            bodyBuffer.data.resize(bodyBuffer.committed);
+            response.body = std::move(bodyBuffer.data);
             response.headers = jResult->getHeaders();
 
+            if (auto& decoder = bodyBuffer.decoder; decoder && bodyBuffer.error.empty()) {
+                try {
+                    if (config.onBodyChunk) {
+                        decoder->finish();
+                    } else if (response.success) {
+                        response.body = decoder->decodeAll(response.body);
+                    }
+                    // The headers now describe the decoded body
+                    eraseHeader(response.headers, "Content-Encoding");
+                    eraseHeader(response.headers, "Content-Length");
+                } catch (const std::exception& e) {
+                    bodyBuffer.error = e.what();
+                }
+            }
+            if (!bodyBuffer.error.empty()) {
+                response.success = false;
+                response.errorMessage = bodyBuffer.error;
+                response.body.clear();
+            }
+
             rct_io::Logger::d(TAG, "Response: success=%d, statusCode=%d, bodySize=%zu",
                  response.success, response.statusCode, response.body.size());
         } else {
@@ -363,7 +394,9 @@ DownloadResult IOHttpClientAndroid::download(const DownloadConfig& config,
             headerKeys,
             headerValues,
             config.timeoutMs,
-            config.resumable
+            config.resumable,
+            &progressCallback,
+            &config.isCancelled
         );
 
         if (jResult) {
@@ -396,7 +429,11 @@ UploadResult IOHttpClientAndroid::upload(const UploadConfig& config,
     UploadResult result;
 
     try {
-        rct_io::Logger::d(TAG, "Starting upload of: %s", config.filePath.c_str());
+        rct_io::Logger::d(TAG, "Starting upload to: %s", config.url.c_str());
+
+        if (config.resumable) {
+            return uploadResumable(*this, config, progressCallback);
+        }
 
         std::vector<std::string> headerKeys, headerValues;
         for (const auto& [k, v] : config.headers) {
@@ -404,25 +441,32 @@ UploadResult IOHttpClientAndroid::upload(const UploadConfig& config,
             headerValues.push_back(v);
         }
 
-        std::vector<std::string> formKeys, formValues;
-        for (const auto& [k, v] : config.formFields) {
-            formKeys.push_back(k);
-            formValues.push_back(v);
+        std::optional<JniUploadSource> built;
+        try {
+            built.emplace(JniUploadSource{MultipartBody(config), {}});
+        } catch (const std::exception& e) {
+            result.errorMessage = e.what();  // e.g. "File not found: <path>"
+            return result;
         }
-
+        auto& source = *built;
+        auto contentType = source.body.contentType();
+        auto contentLength = source.body.contentLength();
         auto jResult = JIOHttpClient::upload(
             config.url,
-            config.filePath,
-            config.fieldName,
-            config.fileName,
-            config.mimeType,
+            contentType,
+            contentLength,
             headerKeys,
             headerValues,
-            formKeys,
-            formValues,
-            config.timeoutMs
+            config.timeoutMs,
+            &source,
+            &progressCallback,
+            &config.isCancelled
         );
 
+        if (!source.error.empty()) {
+            result.errorMessage = source.error;
+            return result;
+        }
         if (jResult) {
             result.success = jResult->isSuccess();
             result.statusCode = jResult->getStatusCode();
@@ -498,6 +542,129 @@ Java_xyz_bczl_io_IOHttpClient_nativeUploadProgress(
     }
 }
 
+JNIEXPORT jobject JNICALL
+Java_xyz_bczl_io_IOHttpClient_nativeBodyWindow(
+        JNIEnv* env,
+        jclass /*clazz*/,
+        jlong buffer,
+        jlong committed,
+        jlong want) {
+
+    auto* target = reinterpret_cast<rct_io::network::JniBodyBuffer*>(buffer);
+    auto& data = target->data;
+    target->committed = std::min(static_cast<size_t>(committed), data.size());
+    if (want <= 0) {
+        return nullptr;
+    }
+    // A ByteBuffer holds at most INT_MAX bytes
+    auto room = std::min<size_t>(static_cast<size_t>(want), INT_MAX);
+    auto needed = target->committed + room;
+    if (data.size() < needed) {
+        try {
+            data.resize(std::max(needed, data.size() * 2));
+        } catch (const std::bad_alloc&) {
+            env->ThrowNew(env->FindClass("java/lang/OutOfMemoryError"), "Response body too large");
+            return nullptr;
+        }
+    }
+    return env->NewDirectByteBuffer(data.data() + target->committed,
+                                    static_cast<jlong>(data.size() - target->committed));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_xyz_bczl_io_IOHttpClient_nativeBodyChunk(
+        JNIEnv* /*env*/,
+        jclass /*clazz*/,
+        jlong sink,
+        jlong buffer,
+        jint length) {
+
+    auto* source = reinterpret_cast<rct_io::network::JniBodyBuffer*>(buffer);
+    if (sink == 0 || length <= 0) {
+        return JNI_TRUE;
+    }
+    auto* onChunk = reinterpret_cast<const rct_io::network::BodyChunkCallback*>(sink);
+    if (source->decoder) {
+        // Decoded blocks go to the sink; the window is reused for the next read
+        try {
+            return source->decoder->decode(source->data.data(), static_cast<size_t>(length),
+                [onChunk](const uint8_t* data, size_t size) {
+                    return (*onChunk)(std::vector<uint8_t>(data, data + size));
+                }) ? JNI_TRUE : JNI_FALSE;
+        } catch (const std::exception& e) {
+            source->error = e.what();
+            return JNI_FALSE;
+        }
+    }
+    // The chunk takes the window's memory; the next window allocates afresh
+    auto chunk = std::move(source->data);
+    source->data.clear();
+    chunk.resize(std::min(chunk.size(), static_cast<size_t>(length)));
+    try {
+        return (*onChunk)(std::move(chunk)) ? JNI_TRUE : JNI_FALSE;
+    } catch (const std::exception&) {
+        return JNI_FALSE;  // Must not unwind into the JVM
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_xyz_bczl_io_IOHttpClient_nativeBodyEncoding(
+        JNIEnv* env,
+        jclass /*clazz*/,
+        jlong buffer,
+        jstring encoding) {
+
+    auto* target = reinterpret_cast<rct_io::network::JniBodyBuffer*>(buffer);
+    if (!target->negotiated || encoding == nullptr) {
+        return;
+    }
+    const char* chars = env->GetStringUTFChars(encoding, nullptr);
+    if (chars == nullptr) {
+        return;
+    }
+    std::string name(chars);
+    env->ReleaseStringUTFChars(encoding, chars);
+    try {
+        target->decoder = rct_io::network::ContentDecoder::create(name);
+    } catch (const std::exception& e) {
+        target->error = e.what();
+    }
+}
+
+JNIEXPORT jint JNICALL
+Java_xyz_bczl_io_IOHttpClient_nativeUploadRead(
+        JNIEnv* env,
+        jclass /*clazz*/,
+        jlong source,
+        jobject window) {
+
+    auto* upload = reinterpret_cast<rct_io::network::JniUploadSource*>(source);
+    auto* data = static_cast<uint8_t*>(env->GetDirectBufferAddress(window));
+    auto capacity = env->GetDirectBufferCapacity(window);
+    if (data == nullptr || capacity <= 0) {
+        return -1;
+    }
+    try {
+        return static_cast<jint>(upload->body.read(data, static_cast<size_t>(capacity)));
+    } catch (const std::exception& e) {
+        upload->error = e.what();
+        return -1;
+    }
+}
+
+JNIEXPORT jboolean JNICALL
+Java_xyz_bczl_io_IOHttpClient_nativeIsCancelled(
+        JNIEnv* /*env*/,
+        jclass /*clazz*/,
+        jlong cancelCheck) {
+
+    if (cancelCheck != 0) {
+        auto* check = reinterpret_cast<const rct_io::network::TransferCancelCheck*>(cancelCheck);
+        return (*check && (*check)()) ? JNI_TRUE : JNI_FALSE;
+    }
+    return JNI_FALSE;
+}
+
 } // extern "C"
 
 // ============================================================================
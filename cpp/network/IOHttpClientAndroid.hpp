@@ -14,15 +14,45 @@
 #ifdef __ANDROID__
 
 #include "IONetwork.hpp"
+#include "IOContentCoding.hpp"
+#include "IOUpload.hpp"
 #include <fbjni/fbjni.h>
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
+#include <span>
 
 namespace rct_io::network {
 
 using namespace facebook::jni;
 
+/**
+ * Native memory a response body is read into from Java.
+ *
+ * Java asks for direct ByteBuffer windows over data (nativeBodyWindow) and
+ * reads the body into them, so the bytes land in the vector that becomes
+ * the JS ArrayBuffer without passing through the Java heap.
+ *
+ * When the client negotiated the encoding itself, a compressed body is
+ * decoded natively: streamed chunks as they arrive, a buffered body once read.
+ */
+struct JniBodyBuffer {
+    std::vector<uint8_t> data;
+    size_t committed = 0;  // Bytes of data Java has filled
+    bool negotiated = false;  // Accept-Encoding was added by the client
+    std::unique_ptr<ContentDecoder> decoder;  // Set by nativeBodyEncoding
+    std::string error;  // Decoding failure, reported instead of Java's
+};
+
+/**
+ * Native producer of an upload body, pulled by Java (nativeUploadRead).
+ */
+struct JniUploadSource {
+    MultipartBody body;
+    std::string error;  // Read failure, reported instead of Java's
+};
+
 // ============================================================================
 // fbjni Wrapper Classes
 // ============================================================================
@@ -41,7 +71,6 @@ public:
     bool isSuccess();
     int getStatusCode();
     std::string getStatusMessage();
-    std::vector<uint8_t> getBody();
     HttpHeaders getHeaders();
     std::string getFinalUrl();
     std::string getErrorMessage();
@@ -96,9 +125,12 @@ public:
         const std::string& method,
         const std::vector<std::string>& headerKeys,
         const std::vector<std::string>& headerValues,
-        const std::vector<uint8_t>& body,
+        std::span<const uint8_t> body,
         long timeoutMs,
-        bool followRedirects
+        bool followRedirects,
+        JniBodyBuffer* bodyBuffer,
+        const BodyChunkCallback* bodySink,
+        const TransferCancelCheck* cancelCheck
     );
 
     static local_ref<JDownloadResult> download(
@@ -107,20 +139,21 @@ public:
         const std::vector<std::string>& headerKeys,
         const std::vector<std::string>& headerValues,
         long timeoutMs,
-        bool resumable
+        bool resumable,
+        const DownloadProgressCallback* progress,
+        const TransferCancelCheck* cancelCheck
     );
 
     static local_ref<JUploadResult> upload(
         const std::string& url,
-        const std::string& filePath,
-        const std::string& fieldName,
-        const std::string& fileName,
-        const std::string& mimeType,
+        const std::string& contentType,
+        int64_t contentLength,
         const std::vector<std::string>& headerKeys,
         const std::vector<std::string>& headerValues,
-        const std::vector<std::string>& formKeys,
-        const std::vector<std::string>& formValues,
-        long timeoutMs
+        long timeoutMs,
+        JniUploadSource* bodySource,
+        const UploadProgressCallback* progress,
+        const TransferCancelCheck* cancelCheck
     );
 };
 
@@ -21,8 +21,8 @@ namespace rct_io::network {
  */
 class IOHttpClientIOS : public IOHttpClient {
 public:
-    IOHttpClientIOS();
-    ~IOHttpClientIOS() override;
+    IOHttpClientIOS() = default;
+    ~IOHttpClientIOS() override = default;
 
     IOHttpClientIOS(const IOHttpClientIOS&) = delete;
     IOHttpClientIOS& operator=(const IOHttpClientIOS&) = delete;
@@ -34,12 +34,13 @@ public:
                         UploadProgressCallback progressCallback = nullptr) override;
 
 private:
-    NSURLSession* session_;
-    NSOperationQueue* delegateQueue_;
+    /// Process-wide session shared by all clients (keeps connections alive)
+    static NSURLSession* sharedSession();
 
     NSMutableURLRequest* createRequest(const HttpRequestConfig& config);
     HttpResponse convertResponse(NSHTTPURLResponse* response, NSData* data, NSError* error);
-    NSData* createMultipartBody(const UploadConfig& config, NSString** boundary);
+    /// Write the multipart body to a temporary file (nil and error set on failure)
+    NSURL* spoolMultipartBody(const UploadConfig& config, std::string& contentType, std::string& error);
 };
 
 } // namespace rct_io::network
@@ -29,7 +29,11 @@
 #include <vector>
 #include <unordered_map>
 #include <functional>
+#include <algorithm>
+#include <cctype>
 #include <cstdint>
+#include <optional>
+#include <span>
 
 namespace rct_io::network {
 
@@ -76,6 +80,71 @@ inline HttpMethod stringToHttpMethod(const std::string& str) {
 
 using HttpHeaders = std::unordered_map<std::string, std::string>;
 
+// ============================================================================
+// URL Helpers
+// ============================================================================
+
+/**
+ * @brief Lowercased "host[:port]" of a URL, without user info
+ *
+ * Returns an empty string if the URL has no "scheme://" prefix.
+ */
+inline std::string urlAuthority(const std::string& url) {
+    auto start = url.find("://");
+    if (start == std::string::npos) {
+        return {};
+    }
+    start += 3;
+    auto end = url.find_first_of("/?#", start);
+    auto authority = url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+    if (auto at = authority.rfind('@'); at != std::string::npos) {
+        authority.erase(0, at + 1);
+    }
+    for (auto& c : authority) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+    return authority;
+}
+
+/** @brief Header names compare case-insensitively */
+inline bool headerNameEquals(const std::string& a, const std::string& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+    });
+}
+
+/**
+ * @brief Case-insensitive header lookup (platforms differ in header case)
+ */
+inline std::optional<std::string> findHeader(const HttpHeaders& headers, const std::string& name) {
+    for (const auto& [key, value] : headers) {
+        if (headerNameEquals(key, name)) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Remove every spelling of a header
+ */
+inline void eraseHeader(HttpHeaders& headers, const std::string& name) {
+    std::erase_if(headers, [&](const auto& header) { return headerNameEquals(header.first, name); });
+}
+
+/// Polled while a transfer is in flight; the transfer is aborted once it returns true
+using TransferCancelCheck = std::function<bool()>;
+
+/**
+ * @brief Receives a response body piece by piece
+ *
+ * Called on the thread that runs the request, in order, as data arrives;
+ * it may block to slow the transfer down. Return false to abort.
+ */
+using BodyChunkCallback = std::function<bool(std::vector<uint8_t>&& chunk)>;
+
 // ============================================================================
 // HTTP Request Config
 // ============================================================================
@@ -86,18 +155,33 @@ struct HttpRequestConfig {
     HttpHeaders headers;
     std::vector<uint8_t> body;
     std::string bodyString;
+    /// Borrowed body (e.g. a pinned JS ArrayBuffer), used when the two above
+    /// are empty; must stay valid until the request returns
+    std::span<const uint8_t> bodyView;
     int32_t timeoutMs = 30000;
     bool followRedirects = true;
+    TransferCancelCheck isCancelled;
+    /// If set, the body goes here instead of into HttpResponse::body
+    BodyChunkCallback onBodyChunk;
 
     [[nodiscard]] std::vector<uint8_t> getBodyBytes() const {
+        auto bytes = bodyBytes();
+        return std::vector<uint8_t>(bytes.begin(), bytes.end());
+    }
+
+    /** @brief The body without copying it, wherever it is stored */
+    [[nodiscard]] std::span<const uint8_t> bodyBytes() const {
         if (!body.empty()) {
             return body;
         }
-        return std::vector<uint8_t>(bodyString.begin(), bodyString.end());
+        if (!bodyString.empty()) {
+            return {reinterpret_cast<const uint8_t*>(bodyString.data()), bodyString.size()};
+        }
+        return bodyView;
     }
 
     [[nodiscard]] bool hasBody() const {
-        return !body.empty() || !bodyString.empty();
+        return !body.empty() || !bodyString.empty() || !bodyView.empty();
     }
 };
 
@@ -152,6 +236,11 @@ struct DownloadConfig {
     HttpHeaders headers;
     int32_t timeoutMs = 60000;
     bool resumable = false;
+    /// Parallel Range connections for downloadSegmented() (1 = single stream)
+    int32_t segments = 1;
+    /// Bytes per range (0 = derived from the size and connection count)
+    int64_t segmentSize = 0;
+    TransferCancelCheck isCancelled;
 };
 
 struct DownloadResult {
@@ -166,15 +255,42 @@ struct DownloadResult {
 // Upload Config & Result
 // ============================================================================
 
+/// One file part of a multipart upload
+struct UploadFile {
+    std::string path;
+    std::string fieldName = "file";
+    std::string fileName;  // Empty = last path component
+    std::string mimeType;  // Empty = application/octet-stream
+};
+
 struct UploadConfig {
     std::string url;
     std::string filePath;
     std::string fieldName = "file";
     std::string fileName;
     std::string mimeType;
+    /// Further file parts, sent after filePath's
+    std::vector<UploadFile> files;
     HttpHeaders headers;
     std::unordered_map<std::string, std::string> formFields;
     int32_t timeoutMs = 60000;
+    /// Send filePath with the tus resumable upload protocol instead of multipart
+    bool resumable = false;
+    /// tus upload URL of an earlier attempt to continue (empty = create one)
+    std::string resumeUrl;
+    /// Bytes per tus PATCH request (0 = kDefaultUploadChunkSize)
+    int64_t chunkSize = 0;
+    TransferCancelCheck isCancelled;
+
+    /** @brief Every file part, filePath's first */
+    [[nodiscard]] std::vector<UploadFile> allFiles() const {
+        std::vector<UploadFile> all;
+        if (!filePath.empty()) {
+            all.push_back({filePath, fieldName, fileName, mimeType});
+        }
+        all.insert(all.end(), files.begin(), files.end());
+        return all;
+    }
 };
 
 struct UploadResult {
@@ -182,6 +298,8 @@ struct UploadResult {
     int32_t statusCode = 0;
     std::vector<uint8_t> responseBody;
     std::string errorMessage;
+    /// tus upload URL, set once the server created it, so a failed upload can be resumed
+    std::string uploadUrl;
 
     [[nodiscard]] std::string responseAsString() const {
         return std::string(responseBody.begin(), responseBody.end());
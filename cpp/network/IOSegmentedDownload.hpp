@@ -0,0 +1,504 @@
+/**
+ * @file IOSegmentedDownload.hpp
+ * @brief Parallel multi-range downloads with per-segment resume
+ *
+ * A single TCP stream rarely fills a high-latency link. A segmented
+ * download splits the file into byte ranges, fetches them over several
+ * connections at once with Range requests, and writes each one in place
+ * into a preallocated file. A sidecar manifest records finished segments,
+ * so an interrupted download resumes with only the missing ones.
+ *
+ * Built on IOHttpClient::request() with a body sink, so it works with any
+ * platform client that streams response bodies.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "IOHttpClient.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rct_io::network {
+
+/**
+ * @brief Runs task on another thread if a connection may be opened now
+ * @return false if no further connection is allowed (task is dropped)
+ */
+using ConnectionLauncher = std::function<bool(std::function<void()>&&)>;
+
+namespace segmented {
+
+/// Smallest range worth its own request
+inline constexpr int64_t kMinSegmentSize = 1024 * 1024;
+
+/// Default range size; several per connection so fast connections take more
+inline constexpr int64_t kDefaultSegmentSize = 8 * 1024 * 1024;
+
+/// Upper bound of parallel connections
+inline constexpr int32_t kMaxConnections = 16;
+
+/// Attempts per segment before the download fails
+inline constexpr int kSegmentAttempts = 3;
+
+inline constexpr const char* kManifestSuffix = ".rnio-segments";
+inline constexpr const char* kManifestMagic = "rnio-segments 1";
+
+/**
+ * @brief Total size from "Content-Range: bytes 0-0/12345" (-1 if unknown)
+ */
+inline auto parseContentRangeTotal(const std::string& value) -> int64_t {
+    auto slash = value.rfind('/');
+    if (slash == std::string::npos || slash + 1 >= value.size() || value[slash + 1] == '*') {
+        return -1;
+    }
+    try {
+        return std::stoll(value.substr(slash + 1));
+    } catch (...) {
+        return -1;
+    }
+}
+
+/**
+ * @brief What a resumed download must still agree on with the server
+ */
+struct Manifest {
+    int64_t size = 0;
+    int64_t segmentSize = 0;
+    std::string validator;  // ETag, else Last-Modified; "" = none
+    std::vector<bool> done;
+
+    [[nodiscard]] auto segmentCount() const -> size_t {
+        return static_cast<size_t>((size + segmentSize - 1) / segmentSize);
+    }
+
+    [[nodiscard]] auto matches(const Manifest& other) const -> bool {
+        return size == other.size && segmentSize == other.segmentSize && validator == other.validator;
+    }
+};
+
+/**
+ * @brief Read a manifest ("done <index>" lines after a fixed header)
+ * @return nullopt if missing or unreadable
+ */
+inline auto readManifest(const std::string& path) -> std::optional<Manifest> {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != kManifestMagic) {
+        return std::nullopt;
+    }
+    Manifest manifest;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+        if (key == "size") {
+            fields >> manifest.size;
+        } else if (key == "segment-size") {
+            fields >> manifest.segmentSize;
+        } else if (key == "validator") {
+            std::getline(fields >> std::ws, manifest.validator);
+        } else if (key == "done" && manifest.size > 0 && manifest.segmentSize > 0) {
+            size_t index = 0;
+            if (fields >> index) {
+                manifest.done.resize(manifest.segmentCount());
+                if (index < manifest.done.size()) {
+                    manifest.done[index] = true;
+                }
+            }
+        }
+    }
+    if (manifest.size <= 0 || manifest.segmentSize <= 0) {
+        return std::nullopt;
+    }
+    manifest.done.resize(manifest.segmentCount());
+    return manifest;
+}
+
+/**
+ * @brief Appends finished segments to the manifest
+ *
+ * Each segment is one appended line, written after its data has been
+ * synced to disk, so a crash loses at most the segments in flight.
+ */
+class ManifestWriter {
+private:
+    std::mutex mutex_;
+    FILE* file_ = nullptr;
+
+public:
+    ManifestWriter(const std::string& path, const Manifest& manifest, bool fresh) {
+        file_ = std::fopen(path.c_str(), fresh ? "w" : "a");
+        if (!file_) {
+            throw std::runtime_error(std::string("Failed to write download manifest: ") + std::strerror(errno));
+        }
+        if (fresh) {
+            std::fprintf(file_, "%s\nsize %lld\nsegment-size %lld\nvalidator %s\n", kManifestMagic,
+                         static_cast<long long>(manifest.size), static_cast<long long>(manifest.segmentSize),
+                         manifest.validator.c_str());
+            std::fflush(file_);
+        }
+    }
+    ~ManifestWriter() {
+        if (file_) {
+            std::fclose(file_);
+        }
+    }
+    ManifestWriter(const ManifestWriter&) = delete;
+    ManifestWriter& operator=(const ManifestWriter&) = delete;
+
+    auto markDone(size_t index) -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::fprintf(file_, "done %zu\n", index);
+        std::fflush(file_);
+    }
+};
+
+/**
+ * @brief Open the destination and reserve its full size
+ *
+ * Preallocation keeps segments from fragmenting the file and fails early
+ * when the disk is too small; filesystems that cannot preallocate just get
+ * a sparse file of the right length.
+ */
+inline auto openPreallocated(const std::string& path, int64_t size, bool truncate) -> int {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("Failed to open download file: ") + std::strerror(errno));
+    }
+#if defined(__APPLE__)
+    fstore_t store{F_ALLOCATEALL, F_PEOFPOSMODE, 0, static_cast<off_t>(size), 0};
+    ::fcntl(fd, F_PREALLOCATE, &store);
+#elif defined(__linux__)
+    int error = ::posix_fallocate(fd, 0, static_cast<off_t>(size));
+    if (error == ENOSPC) {
+        ::close(fd);
+        throw std::runtime_error("Failed to preallocate download file: no space left on device");
+    }
+#endif
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        auto error = errno;
+        ::close(fd);
+        throw std::runtime_error(std::string("Failed to size download file: ") + std::strerror(error));
+    }
+    return fd;
+}
+
+inline auto writeAt(int fd, const uint8_t* data, size_t size, int64_t offset) -> bool {
+    while (size > 0) {
+        auto n = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+        offset += n;
+    }
+    return true;
+}
+
+} // namespace segmented
+
+/**
+ * @brief Download config.url to config.destinationPath over several connections
+ *
+ * The server is probed with a one-byte Range request. Without range
+ * support or a known size this falls back to client.download(). Segments
+ * are requested with If-Range, so a resource that changes mid-download
+ * fails the download rather than mixing two versions.
+ *
+ * With config.resumable, an interrupted download keeps its file and
+ * manifest and the next call fetches only the missing segments (provided
+ * size and ETag/Last-Modified still match). Without it, a failed download
+ * removes both.
+ *
+ * @param progressCallback Optional; called from the segment threads, serialised
+ * @param launchConnection Starts the extra connections; without it the
+ *        segments are fetched one after another on the calling thread
+ */
+inline auto downloadSegmented(
+    IOHttpClient& client,
+    const DownloadConfig& config,
+    DownloadProgressCallback progressCallback = nullptr,
+    const ConnectionLauncher& launchConnection = nullptr
+) -> DownloadResult {
+    using namespace segmented;
+
+    DownloadResult result;
+    auto connections = std::clamp(config.segments, 1, kMaxConnections);
+    if (connections == 1) {
+        return client.download(config, std::move(progressCallback));
+    }
+
+    // Probe range support, size and validator. A server that ignores Range
+    // would send the whole file, so the probe aborts after the first byte.
+    HttpRequestConfig probe;
+    probe.url = config.url;
+    probe.headers = config.headers;
+    probe.headers["Range"] = "bytes=0-0";
+    probe.headers["Accept-Encoding"] = "identity";
+    probe.timeoutMs = config.timeoutMs;
+    probe.isCancelled = config.isCancelled;
+    size_t probeBytes = 0;
+    probe.onBodyChunk = [&probeBytes](std::vector<uint8_t>&& chunk) {
+        probeBytes += chunk.size();
+        return probeBytes <= 1;
+    };
+    auto probed = client.request(probe);
+    auto contentRange = findHeader(probed.headers, "Content-Range");
+    auto total = contentRange ? parseContentRangeTotal(*contentRange) : -1;
+    if (!probed.success || probed.statusCode != 206 || total <= 0) {
+        if (config.isCancelled && config.isCancelled()) {
+            result.errorMessage = "Operation cancelled";
+            return result;
+        }
+        return client.download(config, std::move(progressCallback));
+    }
+
+    Manifest manifest;
+    manifest.size = total;
+    manifest.segmentSize = config.segmentSize > 0
+        ? std::max(config.segmentSize, kMinSegmentSize)
+        : std::clamp(total / connections, kMinSegmentSize, kDefaultSegmentSize);
+    // If-Range needs a strong validator; a weak ETag would never match
+    auto etag = findHeader(probed.headers, "ETag");
+    manifest.validator = etag && etag->rfind("W/", 0) != 0
+        ? *etag
+        : findHeader(probed.headers, "Last-Modified").value_or("");
+
+    auto manifestPath = config.destinationPath + kManifestSuffix;
+    bool resume = false;
+    if (config.resumable) {
+        struct stat st {};
+        auto previous = readManifest(manifestPath);
+        resume = previous && previous->matches(manifest)
+            && ::stat(config.destinationPath.c_str(), &st) == 0 && st.st_size == total;
+        if (resume) {
+            manifest.done = std::move(previous->done);
+        }
+    }
+    manifest.done.resize(manifest.segmentCount());
+
+    int fd = -1;
+    try {
+        fd = openPreallocated(config.destinationPath, total, !resume);
+    } catch (const std::exception& e) {
+        result.errorMessage = e.what();
+        return result;
+    }
+    std::optional<ManifestWriter> writer;
+    try {
+        writer.emplace(manifestPath, manifest, !resume);
+    } catch (const std::exception& e) {
+        ::close(fd);
+        result.errorMessage = e.what();
+        return result;
+    }
+
+    std::vector<size_t> missing;
+    std::atomic<int64_t> received{0};
+    for (size_t i = 0; i < manifest.done.size(); ++i) {
+        if (manifest.done[i]) {
+            received += std::min(manifest.segmentSize, total - static_cast<int64_t>(i) * manifest.segmentSize);
+        } else {
+            missing.push_back(i);
+        }
+    }
+
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::mutex stateMutex;  // Guards firstError and serialises progress
+    std::string firstError;
+    int32_t failedStatus = 0;
+
+    auto fail = [&](std::string message, int32_t status) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (!failed.exchange(true)) {
+            firstError = std::move(message);
+            failedStatus = status;
+        }
+    };
+    auto reportProgress = [&] {
+        if (progressCallback) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            DownloadProgress progress;
+            progress.bytesReceived = received.load();
+            progress.totalBytes = total;
+            progress.progress = static_cast<double>(progress.bytesReceived) / static_cast<double>(total);
+            progressCallback(progress);
+        }
+    };
+
+    auto fetchSegment = [&](size_t index) -> bool {
+        auto begin = static_cast<int64_t>(index) * manifest.segmentSize;
+        auto length = std::min(manifest.segmentSize, total - begin);
+
+        for (int attempt = 0; attempt < kSegmentAttempts; ++attempt) {
+            int64_t written = 0;
+            int writeError = 0;
+
+            HttpRequestConfig range;
+            range.url = config.url;
+            range.headers = config.headers;
+            range.headers["Range"] = "bytes=" + std::to_string(begin) + "-" + std::to_string(begin + length - 1);
+            range.headers["Accept-Encoding"] = "identity";
+            if (!manifest.validator.empty()) {
+                range.headers["If-Range"] = manifest.validator;
+            }
+            range.timeoutMs = config.timeoutMs;
+            range.isCancelled = [&] {
+                return failed.load() || (config.isCancelled && config.isCancelled());
+            };
+            range.onBodyChunk = [&](std::vector<uint8_t>&& chunk) {
+                auto size = std::min<int64_t>(static_cast<int64_t>(chunk.size()), length - written);
+                if (!writeAt(fd, chunk.data(), static_cast<size_t>(size), begin + written)) {
+                    writeError = errno;
+                    return false;
+                }
+                written += size;
+                received += size;
+                reportProgress();
+                return true;
+            };
+
+            auto response = client.request(range);
+            if (writeError != 0) {
+                fail(std::string("Failed to write download file: ") + std::strerror(writeError), 0);
+                return false;
+            }
+            if (response.success && response.statusCode == 206 && written == length) {
+                // Kept even if another segment failed meanwhile, for the resume
+                if (::fsync(fd) != 0) {
+                    fail(std::string("Failed to flush download file: ") + std::strerror(errno), 0);
+                    return false;
+                }
+                writer->markDone(index);
+                return true;
+            }
+            if (range.isCancelled()) {
+                fail("Operation cancelled", 0);
+                return false;
+            }
+            if (response.success && response.statusCode != 206) {
+                // If-Range answered with the whole (changed) resource, or an HTTP error
+                fail(response.statusCode == 200 ? "Resource changed during download"
+                                                : "HTTP error: " + std::to_string(response.statusCode),
+                     response.statusCode);
+                return false;
+            }
+            received -= written;  // The retry writes the range again
+        }
+        fail("Segment " + std::to_string(index) + " failed after " + std::to_string(kSegmentAttempts) + " attempts", 0);
+        return false;
+    };
+
+    auto worker = [&] {
+        while (!failed.load()) {
+            auto slot = next.fetch_add(1);
+            if (slot >= missing.size() || !fetchSegment(missing[slot])) {
+                return;
+            }
+        }
+    };
+
+    // This thread is one of the connections; the others are started through
+    // launchConnection while it grants them. A helper that has not started
+    // by the time every segment is taken is abandoned, not waited for, so a
+    // queued helper can never hold up the download.
+    struct Helper {
+        std::atomic<int> state{0};  // 0 = queued, 1 = running, 2 = abandoned, 3 = finished
+    };
+    std::vector<std::shared_ptr<Helper>> helpers;
+    std::mutex helperMutex;
+    std::condition_variable helperDone;
+    auto extra = std::min<size_t>(static_cast<size_t>(connections), missing.size());
+    for (size_t i = 1; i < extra && launchConnection; ++i) {
+        auto helper = std::make_shared<Helper>();
+        bool started = launchConnection([helper, &worker, &helperMutex, &helperDone] {
+            int queued = 0;
+            if (!helper->state.compare_exchange_strong(queued, 1)) {
+                return;  // Abandoned: the download may already be gone
+            }
+            worker();
+            std::lock_guard<std::mutex> lock(helperMutex);
+            helper->state = 3;
+            helperDone.notify_all();
+        });
+        if (!started) {
+            break;  // Fewer connections, same result
+        }
+        helpers.push_back(std::move(helper));
+    }
+    worker();
+    {
+        std::unique_lock<std::mutex> lock(helperMutex);
+        for (auto& helper : helpers) {
+            int queued = 0;
+            if (!helper->state.compare_exchange_strong(queued, 2)) {
+                helperDone.wait(lock, [&helper] { return helper->state.load() == 3; });
+            }
+        }
+    }
+
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    writer.reset();
+
+    if (failed.load() || !synced) {
+        result.errorMessage = failed.load() ? firstError : "Failed to flush download file";
+        result.statusCode = failedStatus;
+        if (!config.resumable) {
+            ::unlink(config.destinationPath.c_str());
+            ::unlink(manifestPath.c_str());
+        }
+        return result;
+    }
+
+    ::unlink(manifestPath.c_str());
+    result.success = true;
+    result.statusCode = 200;
+    result.filePath = config.destinationPath;
+    result.fileSize = total;
+    return result;
+}
+
+} // namespace rct_io::network
@@ -0,0 +1,442 @@
+/**
+ * @file IOUpload.hpp
+ * @brief Streamed multipart bodies and resumable (tus) uploads
+ *
+ * MultipartBody lays out a multipart/form-data body of form fields and any
+ * number of files and produces it in fixed-size chunks, reading each file
+ * as it goes, so its size is known up front (fixed-length streaming) and no
+ * file is ever held in memory. uploadResumable() sends one file with the
+ * tus 1.0 protocol on top of IOHttpClient::request(): the server keeps what
+ * it received, and a new attempt continues from the offset it reports.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "IOHttpClient.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rct_io::network {
+
+/// Bytes per read of an upload body (and per progress report)
+inline constexpr size_t kUploadBlockSize = 64 * 1024;
+
+/// Default bytes per tus PATCH request
+inline constexpr int64_t kDefaultUploadChunkSize = 4 * 1024 * 1024;
+
+namespace upload_detail {
+
+/** @brief Size of a regular file, or -1 */
+inline auto fileSize(const std::string& path) -> int64_t {
+    struct stat st {};
+    if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        return -1;
+    }
+    return static_cast<int64_t>(st.st_size);
+}
+
+/** @brief Last path component */
+inline auto baseName(const std::string& path) -> std::string {
+    auto slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+/** @brief Quote-safe form of a name in Content-Disposition (as browsers encode it) */
+inline auto dispositionValue(const std::string& value) -> std::string {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '"':  escaped += "%22"; break;
+            case '\r': escaped += "%0D"; break;
+            case '\n': escaped += "%0A"; break;
+            default:   escaped += c;
+        }
+    }
+    return escaped;
+}
+
+inline auto base64(const std::string& input) -> std::string {
+    static constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((input.size() + 2) / 3 * 4);
+    size_t i = 0;
+    for (; i + 2 < input.size(); i += 3) {
+        uint32_t n = (static_cast<uint8_t>(input[i]) << 16) | (static_cast<uint8_t>(input[i + 1]) << 8)
+            | static_cast<uint8_t>(input[i + 2]);
+        out += kAlphabet[(n >> 18) & 63];
+        out += kAlphabet[(n >> 12) & 63];
+        out += kAlphabet[(n >> 6) & 63];
+        out += kAlphabet[n & 63];
+    }
+    if (i < input.size()) {
+        uint32_t n = static_cast<uint8_t>(input[i]) << 16;
+        if (i + 1 < input.size()) {
+            n |= static_cast<uint8_t>(input[i + 1]) << 8;
+        }
+        out += kAlphabet[(n >> 18) & 63];
+        out += kAlphabet[(n >> 12) & 63];
+        out += i + 1 < input.size() ? kAlphabet[(n >> 6) & 63] : '=';
+        out += '=';
+    }
+    return out;
+}
+
+/** @brief Absolute form of a Location header relative to the URL it came from */
+inline auto resolveUrl(const std::string& base, const std::string& location) -> std::string {
+    if (location.find("://") != std::string::npos) {
+        return location;
+    }
+    auto schemeEnd = base.find("://");
+    if (schemeEnd == std::string::npos) {
+        return location;
+    }
+    if (location.rfind("//", 0) == 0) {
+        return base.substr(0, schemeEnd + 1) + location;
+    }
+    auto pathStart = base.find_first_of("/?#", schemeEnd + 3);
+    auto origin = base.substr(0, pathStart);
+    if (!location.empty() && location[0] == '/') {
+        return origin + location;
+    }
+    auto path = pathStart == std::string::npos ? std::string("/") : base.substr(pathStart);
+    path.erase(std::min(path.find_first_of("?#"), path.size()));
+    return origin + path.substr(0, path.rfind('/') + 1) + location;
+}
+
+/** @brief Owned read-only descriptor */
+struct FileReader {
+    int fd = -1;
+
+    FileReader() = default;
+    explicit FileReader(const std::string& path) : fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC)) {
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+        }
+    }
+    ~FileReader() {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+    FileReader(FileReader&& other) noexcept : fd(std::exchange(other.fd, -1)) {}
+    FileReader& operator=(FileReader&& other) noexcept {
+        std::swap(fd, other.fd);
+        return *this;
+    }
+
+    /** @brief Read exactly size bytes at offset; a short file means it changed underneath */
+    auto readAt(uint8_t* dst, size_t size, int64_t offset) const -> void {
+        size_t done = 0;
+        while (done < size) {
+            auto n = ::pread(fd, dst + done, size - done, static_cast<off_t>(offset) + static_cast<off_t>(done));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0) {
+                throw std::runtime_error(std::string("Failed to read upload file: ") + std::strerror(errno));
+            }
+            if (n == 0) {
+                throw std::runtime_error("Upload file was truncated while being sent");
+            }
+            done += static_cast<size_t>(n);
+        }
+    }
+};
+
+} // namespace upload_detail
+
+/**
+ * @brief A multipart/form-data body produced on demand
+ *
+ * Form fields come first, then every file part of the config. Each file
+ * is stat()ed up front for the Content-Length and read when its bytes
+ * are due.
+ */
+class MultipartBody {
+private:
+    struct Segment {
+        std::string text;  // Literal bytes, if path is empty
+        std::string path;
+        int64_t size = 0;
+    };
+
+    std::string boundary_;
+    std::vector<Segment> segments_;
+    int64_t length_ = 0;
+    size_t index_ = 0;      // Segment being read
+    int64_t offset_ = 0;    // Bytes of it already read
+    upload_detail::FileReader file_;
+
+    auto addText(std::string text) -> void {
+        length_ += static_cast<int64_t>(text.size());
+        segments_.push_back({std::move(text), {}, 0});
+    }
+
+public:
+    /**
+     * @throws std::runtime_error if a file is missing or there are none
+     */
+    explicit MultipartBody(const UploadConfig& config) {
+        std::random_device random;
+        static constexpr char kHex[] = "0123456789abcdef";
+        boundary_ = "----IOHttpClientBoundary";
+        for (int i = 0; i < 16; ++i) {
+            boundary_ += kHex[random() & 15];
+        }
+
+        for (const auto& [key, value] : config.formFields) {
+            addText("--" + boundary_ + "\r\nContent-Disposition: form-data; name=\""
+                    + upload_detail::dispositionValue(key) + "\"\r\n\r\n" + value + "\r\n");
+        }
+        auto files = config.allFiles();
+        if (files.empty()) {
+            throw std::runtime_error("Upload has no file");
+        }
+        for (const auto& file : files) {
+            auto size = upload_detail::fileSize(file.path);
+            if (size < 0) {
+                throw std::runtime_error("File not found: " + file.path);
+            }
+            auto name = file.fileName.empty() ? upload_detail::baseName(file.path) : file.fileName;
+            auto type = file.mimeType.empty() ? std::string("application/octet-stream") : file.mimeType;
+            addText("--" + boundary_ + "\r\nContent-Disposition: form-data; name=\""
+                    + upload_detail::dispositionValue(file.fieldName) + "\"; filename=\""
+                    + upload_detail::dispositionValue(name) + "\"\r\nContent-Type: " + type + "\r\n\r\n");
+            segments_.push_back({{}, file.path, size});
+            length_ += size;
+            addText("\r\n");
+        }
+        addText("--" + boundary_ + "--\r\n");
+    }
+
+    [[nodiscard]] auto contentType() const -> std::string {
+        return "multipart/form-data; boundary=" + boundary_;
+    }
+
+    [[nodiscard]] auto contentLength() const -> int64_t { return length_; }
+
+    /**
+     * @brief Copy the next bytes of the body into dst
+     * @return Bytes copied; 0 once the body is complete
+     * @throws std::runtime_error if a file cannot be read or shrank
+     */
+    auto read(uint8_t* dst, size_t capacity) -> size_t {
+        size_t copied = 0;
+        while (copied < capacity && index_ < segments_.size()) {
+            const auto& segment = segments_[index_];
+            auto total = segment.path.empty() ? static_cast<int64_t>(segment.text.size()) : segment.size;
+            auto count = static_cast<size_t>(std::min<int64_t>(total - offset_, static_cast<int64_t>(capacity - copied)));
+            if (segment.path.empty()) {
+                std::memcpy(dst + copied, segment.text.data() + offset_, count);
+            } else {
+                if (offset_ == 0) {
+                    file_ = upload_detail::FileReader(segment.path);
+                }
+                file_.readAt(dst + copied, count, offset_);
+            }
+            copied += count;
+            offset_ += static_cast<int64_t>(count);
+            if (offset_ == total) {
+                if (!segment.path.empty()) {
+                    file_ = upload_detail::FileReader();
+                }
+                ++index_;
+                offset_ = 0;
+            }
+        }
+        return copied;
+    }
+};
+
+/// Attempts per tus chunk before the upload fails
+inline constexpr int kUploadAttempts = 3;
+
+namespace upload_detail {
+
+/** @brief Upload-Offset the server reports for a tus upload (-1 if it does not know it) */
+inline auto queryOffset(IOHttpClient& client, const UploadConfig& config, const std::string& uploadUrl,
+                        const HttpHeaders& headers) -> int64_t {
+    HttpRequestConfig head;
+    head.url = uploadUrl;
+    head.method = HttpMethod::HEAD;
+    head.headers = headers;
+    head.headers["Cache-Control"] = "no-store";
+    head.timeoutMs = config.timeoutMs;
+    head.isCancelled = config.isCancelled;
+    auto response = client.request(head);
+    auto offset = findHeader(response.headers, "Upload-Offset");
+    if (!response.success || response.statusCode < 200 || response.statusCode >= 300 || !offset) {
+        return -1;
+    }
+    try {
+        return std::stoll(*offset);
+    } catch (...) {
+        return -1;
+    }
+}
+
+} // namespace upload_detail
+
+/**
+ * @brief Upload config.filePath with the tus 1.0 protocol
+ *
+ * Creates the upload (POST to config.url) unless config.resumeUrl names
+ * one the server still has, then sends the file in chunkSize PATCH
+ * requests from the offset the server reports. A failed chunk is retried
+ * from the server's offset up to kUploadAttempts times. The result's
+ * uploadUrl can be passed as resumeUrl to continue a failed upload.
+ */
+inline auto uploadResumable(IOHttpClient& client, const UploadConfig& config,
+                            const UploadProgressCallback& progress = nullptr) -> UploadResult {
+    UploadResult result;
+    auto size = upload_detail::fileSize(config.filePath);
+    if (size < 0) {
+        result.errorMessage = "File not found: " + config.filePath;
+        return result;
+    }
+    if (!config.files.empty()) {
+        result.errorMessage = "A resumable upload sends a single file";
+        return result;
+    }
+
+    HttpHeaders headers = config.headers;
+    headers["Tus-Resumable"] = "1.0.0";
+    auto cancelled = [&config] { return config.isCancelled && config.isCancelled(); };
+
+    HttpResponse last;  // Final response of the server
+    int64_t offset = -1;
+    std::string uploadUrl = config.resumeUrl;
+    if (!uploadUrl.empty()) {
+        offset = upload_detail::queryOffset(client, config, uploadUrl, headers);
+    }
+    if (offset < 0) {
+        // Unknown or expired: start a new upload
+        auto name = config.fileName.empty() ? upload_detail::baseName(config.filePath) : config.fileName;
+        HttpRequestConfig create;
+        create.url = config.url;
+        create.method = HttpMethod::POST;
+        create.headers = headers;
+        create.headers["Upload-Length"] = std::to_string(size);
+        create.headers["Upload-Metadata"] = "filename " + upload_detail::base64(name)
+            + (config.mimeType.empty() ? "" : ",filetype " + upload_detail::base64(config.mimeType));
+        create.timeoutMs = config.timeoutMs;
+        create.isCancelled = config.isCancelled;
+        auto created = client.request(create);
+        auto location = findHeader(created.headers, "Location");
+        if (!created.success || created.statusCode != 201 || !location) {
+            result.statusCode = created.statusCode;
+            result.responseBody = std::move(created.body);
+            result.errorMessage = created.success
+                ? "Server did not create the upload (HTTP " + std::to_string(created.statusCode) + ")"
+                : created.errorMessage;
+            return result;
+        }
+        uploadUrl = upload_detail::resolveUrl(config.url, *location);
+        offset = 0;
+        last = std::move(created);
+    }
+    result.uploadUrl = uploadUrl;
+
+    auto chunkSize = config.chunkSize > 0 ? config.chunkSize : kDefaultUploadChunkSize;
+    std::vector<uint8_t> chunk(static_cast<size_t>(std::min(chunkSize, std::max<int64_t>(size - offset, 1))));
+    upload_detail::FileReader file(config.filePath);
+    int failures = 0;
+    while (offset < size) {
+        auto count = static_cast<size_t>(std::min<int64_t>(static_cast<int64_t>(chunk.size()), size - offset));
+        file.readAt(chunk.data(), count, offset);
+
+        HttpRequestConfig patch;
+        patch.url = uploadUrl;
+        patch.method = HttpMethod::PATCH;
+        patch.headers = headers;
+        patch.headers["Upload-Offset"] = std::to_string(offset);
+        patch.headers["Content-Type"] = "application/offset+octet-stream";
+        patch.bodyView = std::span<const uint8_t>(chunk.data(), count);
+        patch.timeoutMs = config.timeoutMs;
+        patch.isCancelled = config.isCancelled;
+        last = client.request(patch);
+
+        auto accepted = findHeader(last.headers, "Upload-Offset");
+        if (last.success && last.statusCode >= 200 && last.statusCode < 300) {
+            auto next = offset + static_cast<int64_t>(count);
+            try {
+                next = accepted ? std::stoll(*accepted) : next;
+            } catch (...) {
+                // Unparsable: assume the whole chunk was taken
+            }
+            // A server that keeps accepting without moving on would loop forever
+            if (next <= offset || next > size) {
+                result.statusCode = last.statusCode;
+                result.responseBody = std::move(last.body);
+                result.errorMessage = "Upload-Offset did not advance past " + std::to_string(offset)
+                    + " (server reported " + std::to_string(next) + ")";
+                return result;
+            }
+            offset = next;
+            failures = 0;
+            if (progress) {
+                progress({offset, size, static_cast<double>(offset) / static_cast<double>(size)});
+            }
+            continue;
+        }
+        if (cancelled()) {
+            result.errorMessage = "Upload cancelled";
+            return result;
+        }
+        // A 4xx other than an offset conflict will not go away on retry
+        bool retryable = !last.success || last.statusCode == 409 || last.statusCode >= 500;
+        if (!retryable || ++failures >= kUploadAttempts) {
+            result.statusCode = last.statusCode;
+            result.responseBody = std::move(last.body);
+            result.errorMessage = last.success
+                ? "Upload chunk rejected (HTTP " + std::to_string(last.statusCode) + ")"
+                : last.errorMessage;
+            return result;
+        }
+        auto resumed = upload_detail::queryOffset(client, config, uploadUrl, headers);
+        if (resumed < 0 || resumed > size) {
+            result.errorMessage = "Upload can no longer be resumed: " + uploadUrl;
+            return result;
+        }
+        offset = resumed;
+    }
+
+    result.success = true;
+    result.statusCode = last.statusCode != 0 ? last.statusCode : 204;  // 0 = nothing was left to send
+    result.responseBody = std::move(last.body);
+    return result;
+}
+
+} // namespace rct_io::network
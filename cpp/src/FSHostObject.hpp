@@ -28,13 +28,23 @@
 #ifndef IO_HOST_OBJECT_HPP
 #define IO_HOST_OBJECT_HPP
 
-#include "BS_thread_pool.hpp"
 #include "JSIHostObjectBase.hpp"
+#include "IOBenchmark.hpp"
+#include "IOExecutor.hpp"
 #include "IOFileSystem.hpp"
 #include "IOFileHandle.hpp"
+#include "IOMappedFile.hpp"
+#include "IODirectoryIterator.hpp"
+#include "IODirectoryWatcher.hpp"
+#include "IOHandleTable.hpp"
+#include "IOPipeline.hpp"
+#include "IORecordPipeline.hpp"
+#include "IOTextCodec.hpp"
+#include "Logger.h"
 #include <ReactCommon/CallInvoker.h>
 #include <mutex>
 #include <atomic>
+#include <cmath>
 
 namespace rct_io {
 
@@ -45,26 +55,6 @@ using namespace jsi_utils;
 using AsyncResultMap = std::unordered_map<std::string, AsyncResult>;
 
 
-// ============================================================================
-// Thread Pool Task Executor
-// ============================================================================
-
-/**
- * @brief TaskExecutor implementation using BS::thread_pool
- */
-class ThreadPoolExecutor : public TaskExecutor {
-private:
-    std::shared_ptr<BS::thread_pool<>> pool_;
-
-public:
-    explicit ThreadPoolExecutor(std::shared_ptr<BS::thread_pool<>> pool)
-        : pool_(std::move(pool)) {}
-
-    void execute(std::function<void()>&& task) override {
-        pool_->detach_task(std::move(task));
-    }
-};
-
 // ============================================================================
 // FSHostObject Implementation
 // ============================================================================
@@ -91,62 +81,278 @@ public:
     }
 };
 
+// ============================================================================
+// Memory-Mapped ArrayBuffer Backing Store
+// ============================================================================
+
+/**
+ * @brief MutableBuffer exposing an IOMappedFile region to JS
+ *
+ * The mapping lives as long as the JS ArrayBuffer (or an explicit unmap()).
+ */
+class MappedFileBuffer : public MutableBuffer {
+private:
+    std::shared_ptr<IOMappedFile> mapping_;
+
+public:
+    explicit MappedFileBuffer(std::shared_ptr<IOMappedFile> mapping)
+        : mapping_(std::move(mapping)) {}
+
+    size_t size() const override { return mapping_->size(); }
+    uint8_t* data() override { return mapping_->data(); }
+};
+
 class FSHostObject : public JSIHostObjectBase<FSHostObject> {
     friend class JSIHostObjectBase<FSHostObject>;
+    static constexpr const char* kStatsScope = "fs";  // Prefix of its methods in getStats()
+    static constexpr double kMaxBufferSize = 2147483647.0;  // Largest ArrayBuffer JS engines accept
+    static constexpr double kMaxSafeInteger = 9007199254740991.0;  // Number.MAX_SAFE_INTEGER
+    static constexpr double kMaxDirectoryBatch = 1000000.0;  // Entries per readDirectoryBatch
+    static constexpr double kMaxLineBatch = 1000000.0;  // Lines per fileReadLines
+    static constexpr double kMaxLineBatchBytes = 256.0 * 1024 * 1024;  // Bytes per fileReadLines
+    static constexpr double kMaxStatCacheEntries = 10000000.0;
+    static constexpr double kMaxStatCacheTtlMs = 86400000.0;  // One day; keeps now + ttl in range
+    static constexpr double kMaxWatchDebounceMs = 3600000.0;  // One hour; keeps debounce * 10 in range
 
 private:
     std::shared_ptr<IOFileSystem> fs_;
     std::shared_ptr<JSCallInvokerWrapper> invoker_;
     std::unique_ptr<TaskExecutor> executor_;
 
-    // File handle management (use shared_ptr to avoid dangling pointers in async ops)
-    std::unordered_map<int, std::shared_ptr<IOFileHandle>> fileHandles_;
-    std::mutex handlesMutex_;
-    std::atomic<int> nextHandleId_{1};
+    // File handles (shared_ptr keeps a handle alive for async ops that outlive close)
+    IOHandleTable<IOFileHandle> fileHandles_;
+
+    // Open directory iterators (same lifetime rules as file handles)
+    IOHandleTable<IODirectoryIterator> dirIterators_;
+
+    // Directory watchers; dropping one stops its thread
+    IOHandleTable<IODirectoryWatcher> watchers_;
+
+    // Live memory mappings, keyed by the data pointer handed to JS
+    std::unordered_map<const uint8_t*, std::weak_ptr<IOMappedFile>> mappings_;
+    std::mutex mappingsMutex_;
 
     /**
-     * @brief Get file handle by ID (thread-safe)
+     * @brief File contents as text in an encoding (default: UTF-8)
+     */
+    static std::string bytesToText(std::string&& bytes, const std::optional<std::string>& encoding) {
+        auto textEncoding = encoding ? parseTextEncoding(*encoding) : TextEncoding::Utf8;
+        std::span<const uint8_t> view(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+        if (textEncoding == TextEncoding::Utf8 && isValidUtf8(view)) {
+            return std::move(bytes);
+        }
+        return decodeText(view, textEncoding);
+    }
+
+    /**
+     * @brief Bytes of text in an encoding (default: UTF-8)
+     */
+    static std::string textToBytes(std::string&& text, const std::optional<std::string>& encoding) {
+        auto textEncoding = encoding ? parseTextEncoding(*encoding) : TextEncoding::Utf8;
+        if (textEncoding == TextEncoding::Utf8) {
+            return std::move(text);
+        }
+        return encodeText(text, textEncoding);
+    }
+
+    static std::optional<std::string> optionalString(Runtime& rt, const Value* args, size_t count, size_t idx) {
+        return count > idx && args[idx].isString() ? std::optional(args[idx].asString(rt).utf8(rt)) : std::nullopt;
+    }
+
+    /**
+     * @brief Get file handle by ID (lock-free)
      * @returns shared_ptr to handle (safe for async operations)
-     * @throws std::runtime_error if handle is invalid
+     * @throws std::runtime_error if handle is invalid, closed or stale
      */
     std::shared_ptr<IOFileHandle> getHandle(int handleId) {
-        std::lock_guard<std::mutex> lock(handlesMutex_);
-        auto it = fileHandles_.find(handleId);
-        if (it == fileHandles_.end()) {
+        auto handle = fileHandles_.get(handleId);
+        if (!handle) {
             throw std::runtime_error("Invalid file handle: " + std::to_string(handleId));
         }
-        return it->second;  // Return shared_ptr, increases ref count
+        return handle;
+    }
+
+    /**
+     * @brief Get directory iterator by ID (lock-free)
+     * @throws std::runtime_error if the iterator is invalid
+     */
+    std::shared_ptr<IODirectoryIterator> getDirIterator(int iteratorId) {
+        auto iterator = dirIterators_.get(iteratorId);
+        if (!iterator) {
+            throw std::runtime_error("Invalid directory iterator: " + std::to_string(iteratorId));
+        }
+        return iterator;
+    }
+
+    /**
+     * @brief Convert a directory entry to a JS object result
+     * @param withSize Include the size property
+     */
+    static AsyncResult toAsyncResult(const DirectoryEntry& entry, bool withSize = true) {
+        AsyncResultMap obj(4);
+        obj.emplace("path", entry.path);
+        obj.emplace("name", entry.name);
+        obj.emplace("type", static_cast<double>(static_cast<int>(entry.type)));
+        if (withSize) {
+            obj.emplace("size", static_cast<double>(entry.size));
+        }
+        return AsyncResult(std::move(obj));
+    }
+
+    /**
+     * @brief Convert columns to an object of ArrayBuffers (no per-entry work)
+     */
+    static AsyncResult toAsyncResult(EntryColumns&& columns) {
+        AsyncResultMap obj(6);
+        obj.emplace("count", static_cast<double>(columns.count));
+        obj.emplace("names", std::move(columns.names));
+        obj.emplace("nameOffsets", std::move(columns.nameOffsets));
+        obj.emplace("types", std::move(columns.types));
+        obj.emplace("sizes", std::move(columns.sizes));
+        obj.emplace("modifiedTimes", std::move(columns.modifiedTimes));
+        return AsyncResult(std::move(obj));
+    }
+
+    /**
+     * @brief Method statistics and executor load as a JS object result
+     *
+     * Latencies are in milliseconds; lanes describe the current shared executor.
+     */
+    static AsyncResult statsResult() {
+        auto latency = [](const LatencyHistogram& histogram) {
+            auto summary = histogram.summary();
+            AsyncResultMap obj(6);
+            obj.emplace("count", static_cast<double>(summary.count));
+            obj.emplace("mean", summary.mean / 1000.0);
+            obj.emplace("p50", static_cast<double>(summary.p50) / 1000.0);
+            obj.emplace("p90", static_cast<double>(summary.p90) / 1000.0);
+            obj.emplace("p99", static_cast<double>(summary.p99) / 1000.0);
+            obj.emplace("max", static_cast<double>(summary.max) / 1000.0);
+            return AsyncResult(std::move(obj));
+        };
+
+        AsyncResultMap methods;
+        MethodStatsRegistry::instance().forEach([&](const std::string& name, const MethodStats& stats) {
+            AsyncResultMap obj(8);
+            obj.emplace("calls", static_cast<double>(stats.calls.load(std::memory_order_relaxed)));
+            obj.emplace("errors", static_cast<double>(stats.errors.load(std::memory_order_relaxed)));
+            obj.emplace("cancelled", static_cast<double>(stats.cancelled.load(std::memory_order_relaxed)));
+            obj.emplace("bytesIn", static_cast<double>(stats.bytesIn.load(std::memory_order_relaxed)));
+            obj.emplace("bytesOut", static_cast<double>(stats.bytesOut.load(std::memory_order_relaxed)));
+            obj.emplace("queue", latency(stats.queue));
+            obj.emplace("execute", latency(stats.execute));
+            obj.emplace("resolve", latency(stats.resolve));
+            methods.emplace(name, std::move(obj));
+        });
+
+        static constexpr const char* kLaneNames[kExecutorLaneCount] = {"interactive", "bulk", "compute", "network"};
+        auto executor = SharedExecutor::instance();
+        AsyncResultMap lanes(kExecutorLaneCount);
+        for (size_t i = 0; i < kExecutorLaneCount; ++i) {
+            auto load = executor->laneStats(static_cast<ExecutorLane>(i));
+            AsyncResultMap obj(4);
+            obj.emplace("threads", static_cast<double>(load.threads));
+            obj.emplace("queued", static_cast<double>(load.queued));
+            obj.emplace("running", static_cast<double>(load.running));
+            obj.emplace("peakQueued", static_cast<double>(load.peakQueued));
+            lanes.emplace(kLaneNames[i], std::move(obj));
+        }
+
+        AsyncResultMap obj(3);
+        obj.emplace("enabled", MethodStatsRegistry::instance().enabled());
+        obj.emplace("methods", std::move(methods));
+        obj.emplace("lanes", std::move(lanes));
+        return AsyncResult(std::move(obj));
+    }
+
+    /**
+     * @brief Map a file range and register it for unmap()/madvise() lookups
+     * @returns Backing store for a JS ArrayBuffer
+     */
+    std::shared_ptr<MutableBuffer> mapFile(
+        const std::string& path, double offset, double length, bool readOnly
+    ) {
+        // Offsets and lengths arrive as JS numbers; keep the int64 casts defined
+        if (!(offset >= 0 && offset <= kMaxSafeInteger)) {
+            throw std::runtime_error("mmapFile: offset must be a non-negative safe integer");
+        }
+        if (std::isnan(length)) {
+            throw std::runtime_error("mmapFile: length must be a number");
+        }
+        auto mapping = std::make_shared<IOMappedFile>(path, static_cast<int64_t>(offset),
+            length < 0 ? -1 : static_cast<int64_t>(std::min(length, kMaxSafeInteger)), readOnly);
+        if (mapping->data()) {
+            std::lock_guard<std::mutex> lock(mappingsMutex_);
+            // Drop entries whose ArrayBuffer has been garbage collected
+            std::erase_if(mappings_, [](const auto& entry) { return entry.second.expired(); });
+            mappings_[mapping->data()] = mapping;
+        }
+        return std::make_shared<MappedFileBuffer>(std::move(mapping));
+    }
+
+    /**
+     * @brief Forward progress to an optional JS callback as (processed, total)
+     */
+    static HashProgressCallback makeProgress(const CallbackArg* callback) {
+        if (!callback) {
+            return {};
+        }
+        return [callback](uint64_t processed, uint64_t total) {
+            callback->post({AsyncResult(processed), AsyncResult(total)});
+        };
+    }
+
+    /**
+     * @brief Cancellation check bound to the call's CancelToken and deadline, if any
+     */
+    static CancelCheck makeCancelCheck(const AsyncContext& context) {
+        if (!context.cancelToken && context.deadline == AsyncContext::kNoDeadline) {
+            return {};
+        }
+        return [&context] { return context.isCancelled(); };
     }
 
     /**
-     * @brief Remove handle from map (does not close file)
-     * @returns shared_ptr to removed handle, or nullptr if not found
+     * @brief Spawner that runs helper tasks on a lane of the shared executor
+     *
+     * Hashing helpers go to the compute lane, read-ahead of byte pipelines
+     * to the bulk lane.
      */
-    std::shared_ptr<IOFileHandle> removeHandle(int handleId) {
-        std::lock_guard<std::mutex> lock(handlesMutex_);
-        auto it = fileHandles_.find(handleId);
-        if (it == fileHandles_.end()) {
+    TaskSpawner makeSpawner(int priority, ExecutorLane lane = ExecutorLane::Compute) {
+        return [this, priority, lane](std::function<void()>&& task) {
+            TaskOptions options;
+            options.lane = static_cast<int>(lane);
+            options.priority = priority;
+            executor_->execute(std::move(task), options);
+        };
+    }
+
+    /**
+     * @brief Find the mapping backing an ArrayBuffer (nullptr if not mapped)
+     */
+    std::shared_ptr<IOMappedFile> findMapping(Runtime& rt, const ArrayBuffer& buffer) {
+        std::lock_guard<std::mutex> lock(mappingsMutex_);
+        auto it = mappings_.find(buffer.data(rt));
+        if (it == mappings_.end()) {
             return nullptr;
         }
-        auto handle = std::move(it->second);
-        fileHandles_.erase(it);
-        return handle;
+        return it->second.lock();
     }
 
 public:
     /**
      * @brief Construct FSHostObject with React Native's CallInvoker
      * @param runtime JSI Runtime reference (must outlive this object)
-     * @param threadPool Thread pool for async operations
+     * @param executor Shared executor for async operations
      * @param callInvoker React Native's CallInvoker for JS thread callbacks
      */
     FSHostObject(
         Runtime& runtime,
-        std::shared_ptr<BS::thread_pool<>> threadPool,
+        std::shared_ptr<SharedExecutor> executor,
         std::shared_ptr<facebook::react::CallInvoker> callInvoker
     ) : fs_(std::make_shared<IOFileSystem>())
       , invoker_(std::make_shared<RNCallInvokerAdapter>(std::move(callInvoker), runtime))
-      , executor_(std::make_unique<ThreadPoolExecutor>(std::move(threadPool)))
+      , executor_(std::make_unique<LaneExecutor>(std::move(executor), ExecutorLane::Interactive))
     {
         callInvoker_ = invoker_;
         init();  // Calls initProperties() then initMethods()
@@ -191,30 +397,31 @@ private:
                 ? static_cast<FileOpenMode>(static_cast<int>(JSI_ARG_NUM(1)))
                 : FileOpenMode::Read;
 
-            auto handle = std::make_shared<IOFileHandle>(path, mode);
-            int handleId = nextHandleId_++;
-
-            {
-                std::lock_guard<std::mutex> lock(handlesMutex_);
-                fileHandles_[handleId] = handle;
-            }
-
-            return JSI_NUM(handleId);
+            return JSI_NUM(fileHandles_.insert(std::make_shared<IOFileHandle>(path, mode)));
         })
 
         // fileClose(handle) -> void
-        // Note: Remove from map first (under lock), then close outside lock
+        // Note: Only removes the handle from the table. Async calls still
+        // running on it hold their own reference, so the FILE* is closed when
+        // the last of them finishes (or right here if none is in flight).
+        // This never blocks the JS thread and never closes the descriptor
+        // under a running pread/pwrite.
         JSI_SYNC_METHOD(fileClose, 1, {
-            int handleId = static_cast<int>(JSI_ARG_NUM(0));
-            // Remove from map (lock-protected)
-            auto handle = removeHandle(handleId);
-            // Close outside lock to avoid deadlock
-            if (handle) {
-                handle->close();
-            }
+            fileHandles_.remove(static_cast<int>(JSI_ARG_NUM(0)));
             return JSI_UNDEFINED;
         })
 
+        // fileGetStats(handle) -> {bytesRead, bytesWritten, readOps, writeOps}
+        JSI_SYNC_METHOD(fileGetStats, 1, {
+            auto stats = getHandle(static_cast<int>(JSI_ARG_NUM(0)))->getStats();
+            Object result(rt);
+            result.setProperty(rt, "bytesRead", static_cast<double>(stats.bytesRead));
+            result.setProperty(rt, "bytesWritten", static_cast<double>(stats.bytesWritten));
+            result.setProperty(rt, "readOps", static_cast<double>(stats.readOps));
+            result.setProperty(rt, "writeOps", static_cast<double>(stats.writeOps));
+            return std::move(result);
+        })
+
         // fileSeek(handle, offset, origin?) -> Promise<position>
         JSI_ASYNC_METHOD(fileSeek, 3, {
             auto handle = getHandle(static_cast<int>(JSI_N_ARG(0)));
@@ -279,25 +486,44 @@ private:
             return JSI_NUM(fs_->getModifiedTime(JSI_ARG_STR(0)));
         })
 
-        // Read operations (1 param: path)
-        JSI_SYNC_METHOD(readStringSync, 1, {
-            return JSI_STRING(fs_->readString(JSI_ARG_STR(0)));
+        // configureStatCache(maxEntries, ttlMs?) -> void; process-wide, 0 entries disables
+        JSI_SYNC_METHOD(configureStatCache, 2, {
+            StatCacheOptions options;
+            double maxEntries = JSI_ARG_NUM(0);
+            double ttlMs = JSI_ARG_NUM_OPT(1, static_cast<double>(options.ttlMs));
+            if (!std::isfinite(maxEntries) || maxEntries < 0) {
+                throw std::runtime_error("configureStatCache: maxEntries must be a non-negative finite number");
+            }
+            if (!std::isfinite(ttlMs) || ttlMs < 0) {
+                throw std::runtime_error("configureStatCache: ttlMs must be a non-negative finite number");
+            }
+            options.maxEntries = static_cast<size_t>(std::min(maxEntries, kMaxStatCacheEntries));
+            options.ttlMs = static_cast<int64_t>(std::min(ttlMs, kMaxStatCacheTtlMs));
+            IOFileSystem::configureStatCache(options);
+            return JSI_UNDEFINED;
+        })
+
+        // invalidateStatCache(path?) -> void; a path drops it and everything below it
+        JSI_SYNC_METHOD(invalidateStatCache, 1, {
+            IOFileSystem::invalidateStatCache(optionalString(rt, args, count, 0).value_or(""));
+            return JSI_UNDEFINED;
+        })
+
+        // Read operations (path, encoding? for strings)
+        JSI_SYNC_METHOD(readStringSync, 2, {
+            return JSI_STRING(bytesToText(fs_->readString(JSI_ARG_STR(0)), optionalString(rt, args, count, 1)));
         })
 
         JSI_SYNC_METHOD(readBytesSync, 1, {
-            auto bytes = fs_->readBytes(JSI_ARG_STR(0));
-            // Create ArrayBuffer via JavaScript constructor
-            auto arrayBufferCtor = rt.global().getPropertyAsFunction(rt, "ArrayBuffer");
-            auto arrayBuffer = arrayBufferCtor.callAsConstructor(rt, static_cast<int>(bytes.size())).asObject(rt).getArrayBuffer(rt);
-            memcpy(arrayBuffer.data(rt), bytes.data(), bytes.size());
-            return std::move(arrayBuffer);
+            // ArrayBuffer takes ownership of the bytes (no copy)
+            return createArrayBuffer(rt, fs_->readBytes(JSI_ARG_STR(0)));
         })
 
-        // Write operations (4 params: path, content, mode?, createParents?)
-        JSI_SYNC_METHOD(writeStringSync, 4, {
+        // Write operations (path, content, mode?, createParents?, encoding? for strings)
+        JSI_SYNC_METHOD(writeStringSync, 5, {
             fs_->writeString(
                 JSI_ARG_STR(0),
-                JSI_ARG_STR(1),
+                textToBytes(JSI_ARG_STR(1), optionalString(rt, args, count, 4)),
                 static_cast<WriteMode>(static_cast<int>(JSI_ARG_NUM_OPT(2, 0))),
                 JSI_ARG_BOOL_OPT(3, false)
             );
@@ -305,11 +531,11 @@ private:
         })
 
         JSI_SYNC_METHOD(writeBytesSync, 4, {
+            // Write straight from the ArrayBuffer's memory (no copy)
             auto ab = JSI_ARG_BUFFER(1);
-            std::vector<uint8_t> bytes(ab.data(rt), ab.data(rt) + ab.size(rt));
             fs_->writeBytes(
                 JSI_ARG_STR(0),
-                bytes,
+                std::span<const uint8_t>(ab.data(rt), ab.size(rt)),
                 static_cast<WriteMode>(static_cast<int>(JSI_ARG_NUM_OPT(2, 0))),
                 JSI_ARG_BOOL_OPT(3, false)
             );
@@ -355,11 +581,167 @@ private:
             return std::move(arr);
         })
 
+        // openDirectoryIterator(path, recursive?) -> iterator id (read with readDirectoryBatch)
+        JSI_SYNC_METHOD(openDirectoryIterator, 2, {
+            auto iterator = std::make_shared<IODirectoryIterator>(JSI_ARG_STR(0), JSI_ARG_BOOL_OPT(1, false));
+            return JSI_NUM(dirIterators_.insert(std::move(iterator)));
+        })
+
+        // closeDirectoryIterator(iterator) -> void
+        JSI_SYNC_METHOD(closeDirectoryIterator, 1, {
+            auto iterator = dirIterators_.remove(static_cast<int>(JSI_ARG_NUM(0)));
+            // Close outside the table lock; waits for a batch that is being read
+            if (iterator) {
+                iterator->close();
+            }
+            return JSI_UNDEFINED;
+        })
+
+        // watch(path, recursive, debounceMs, listener) -> watcher id
+        // listener receives arrays of {type, path}, one call per debounced batch
+        JSI_SYNC_METHOD(watch, 4, {
+            WatchOptions options;
+            options.recursive = JSI_ARG_BOOL_OPT(1, false);
+            double debounceMs = JSI_ARG_NUM_OPT(2, 100);
+            if (!std::isfinite(debounceMs) || debounceMs < 0) {
+                throw std::runtime_error("watch: debounceMs must be a non-negative finite number");
+            }
+            options.debounceMs = static_cast<int64_t>(std::min(debounceMs, kMaxWatchDebounceMs));
+            options.maxLatencyMs = std::max<int64_t>(options.debounceMs * 10, 1000);
+            if (count < 4 || !args[3].isObject() || !args[3].asObject(rt).isFunction(rt)) {
+                throw std::runtime_error("watch: listener must be a function");
+            }
+            auto listener = std::make_shared<CallbackArg>(args[3].asObject(rt), invoker_);
+            auto watcher = IODirectoryWatcher::open(JSI_ARG_STR(0), options,
+                [listener](std::vector<WatchEvent>&& events, std::function<void()> done) {
+                    std::vector<AsyncResult> batch;
+                    batch.reserve(events.size());
+                    for (auto& event : events) {
+                        AsyncResultMap obj(2);
+                        obj.emplace("type", std::string(watchEventName(event.type)));
+                        obj.emplace("path", std::move(event.path));
+                        batch.emplace_back(std::move(obj));
+                    }
+                    // One JS-thread call per batch; the next waits until the listener is done
+                    listener->post({AsyncResult(std::move(batch))}, [done = std::move(done)](bool) { done(); });
+                });
+            return JSI_NUM(watchers_.insert(std::move(watcher)));
+        })
+
+        // unwatch(watcher) -> void
+        JSI_SYNC_METHOD(unwatch, 1, {
+            auto watcher = watchers_.remove(static_cast<int>(JSI_ARG_NUM(0)));
+            if (watcher) {
+                watcher->close();
+            }
+            return JSI_UNDEFINED;
+        })
+
         JSI_SYNC_METHOD(moveDirectorySync, 2, {  // src, dest
             fs_->moveDirectory(JSI_ARG_STR(0), JSI_ARG_STR(1));
             return JSI_UNDEFINED;
         })
 
+        // allocateBuffer(size) -> ArrayBuffer backed by native memory
+        // Zero-filled; useful for large write buffers that should not live on the JS heap
+        JSI_SYNC_METHOD(allocateBuffer, 1, {
+            auto size = JSI_ARG_NUM(0);
+            if (!std::isfinite(size) || size < 0 || size > kMaxBufferSize) {
+                throw std::runtime_error("allocateBuffer: size must be between 0 and "
+                                         + std::to_string(static_cast<int64_t>(kMaxBufferSize)));
+            }
+            std::vector<uint8_t> buffer;
+            try {
+                buffer.resize(static_cast<size_t>(size));
+            } catch (const std::bad_alloc&) {
+                throw std::runtime_error("allocateBuffer: out of memory for "
+                                         + std::to_string(static_cast<int64_t>(size)) + " bytes");
+            }
+            return createArrayBuffer(rt, std::move(buffer));
+        })
+
+        // createCancelToken() -> CancelToken (pass to long-running async methods)
+        JSI_SYNC_METHOD(createCancelToken, 0, {
+            return Object::createFromHostObject(rt, std::make_shared<CancelToken>());
+        })
+
+        // ====================================================================
+        // Instrumentation (process-wide, off by default)
+        // ====================================================================
+
+        // configureStats(enabled, trace?) -> void; trace adds systrace/os_signpost intervals
+        JSI_SYNC_METHOD(configureStats, 2, {
+            TraceHooks hooks;
+            if (JSI_ARG_BOOL_OPT(1, false)) {
+                hooks.enabled = &Logger::tracing;
+                hooks.begin = &Logger::traceBegin;
+                hooks.end = &Logger::traceEnd;
+            }
+            MethodStatsRegistry::instance().configure(JSI_ARG_BOOL(0), hooks);
+            return JSI_UNDEFINED;
+        })
+
+        // getStats() -> {enabled, methods: {"scope.method": {...}}, lanes: {...}}
+        JSI_SYNC_METHOD(getStats, 0, {
+            return statsResult().toJSValue(rt);
+        })
+
+        // resetStats() -> void
+        JSI_SYNC_METHOD(resetStats, 0, {
+            MethodStatsRegistry::instance().reset();
+            SharedExecutor::instance()->resetPeaks();
+            return JSI_UNDEFINED;
+        })
+
+        // pingSync(payload?) -> number (payload length); measures the cost of a sync call
+        JSI_SYNC_METHOD(pingSync, 1, {
+            return JSI_NUM(count > 0 && args[0].isString() ? JSI_ARG_STR(0).size() : 0);
+        })
+
+        // ====================================================================
+        // Memory-Mapped Files
+        // ====================================================================
+
+        // mmapFileSync(path, offset?, length?, readOnly?) -> ArrayBuffer backed by mmap
+        JSI_SYNC_METHOD(mmapFileSync, 4, {
+            return createArrayBuffer(rt, mapFile(JSI_ARG_STR(0), JSI_ARG_NUM_OPT(1, 0), JSI_ARG_NUM_OPT(2, -1),
+                JSI_ARG_BOOL_OPT(3, true)));
+        })
+
+        // unmap(buffer) -> boolean (false if buffer is not a live mapping)
+        JSI_SYNC_METHOD(unmap, 1, {
+            auto mapping = findMapping(rt, JSI_ARG_BUFFER(0));
+            if (!mapping) {
+                return JSI_BOOL(false);
+            }
+            {
+                std::lock_guard<std::mutex> lock(mappingsMutex_);
+                mappings_.erase(mapping->data());
+            }
+            mapping->unmap();
+            return JSI_BOOL(true);
+        })
+
+        // madvise(buffer, advice) -> void
+        JSI_SYNC_METHOD(madvise, 2, {
+            auto mapping = findMapping(rt, JSI_ARG_BUFFER(0));
+            if (!mapping) {
+                throw std::runtime_error("madvise: buffer is not a mapped file");
+            }
+            mapping->advise(static_cast<MapAdvice>(static_cast<int>(JSI_ARG_NUM(1))));
+            return JSI_UNDEFINED;
+        })
+
+        // msync(buffer) -> void (flush a writable mapping to the file)
+        JSI_SYNC_METHOD(msync, 1, {
+            auto mapping = findMapping(rt, JSI_ARG_BUFFER(0));
+            if (!mapping) {
+                throw std::runtime_error("msync: buffer is not a mapped file");
+            }
+            mapping->sync();
+            return JSI_UNDEFINED;
+        })
+
         // Path operations (pure, no I/O)
         JSI_SYNC_METHOD(getParentPath, 1, {
             return JSI_STRING(IOFileSystem::getParentPath(JSI_ARG_STR(0)));
@@ -409,20 +791,20 @@ private:
         // which is converted to JS Value on the JS thread for thread safety.
 
         // Query operations (1 param: path)
-        JSI_ASYNC_METHOD(exists, 1, {
-            return AsyncResult(fs_->exists(JSI_S_ARG(0)));
+        JSI_ASYNC_TYPED(exists, (const std::string& path), {
+            return AsyncResult(fs_->exists(path));
         })
 
-        JSI_ASYNC_METHOD(isFile, 1, {
-            return AsyncResult(fs_->isFile(JSI_S_ARG(0)));
+        JSI_ASYNC_TYPED(isFile, (const std::string& path), {
+            return AsyncResult(fs_->isFile(path));
         })
 
-        JSI_ASYNC_METHOD(isDirectory, 1, {
-            return AsyncResult(fs_->isDirectory(JSI_S_ARG(0)));
+        JSI_ASYNC_TYPED(isDirectory, (const std::string& path), {
+            return AsyncResult(fs_->isDirectory(path));
         })
 
-        JSI_ASYNC_METHOD(getMetadata, 1, {
-            auto meta = fs_->getMetadata(JSI_S_ARG(0));
+        JSI_ASYNC_TYPED(getMetadata, (const std::string& path), {
+            auto meta = fs_->getMetadata(path);
             AsyncResultMap obj(3);
             obj.emplace("size", static_cast<double>(meta.size));
             obj.emplace("modifiedTime", static_cast<double>(meta.modifiedTime));
@@ -430,35 +812,70 @@ private:
             return AsyncResult(std::move(obj));
         })
 
-        JSI_ASYNC_METHOD(getFileSize, 1, {
-            return AsyncResult(static_cast<double>(fs_->getFileSize(JSI_S_ARG(0))));
+        // getMetadataColumnar(paths) -> columns without names
+        JSI_ASYNC_METHOD(getMetadataColumnar, 1, {
+            return toAsyncResult(fs_->getMetadataColumns(jsiStrArgs, makeCancelCheck(jsiCtx)));
+        })
+
+        JSI_ASYNC_TYPED(getFileSize, (const std::string& path), {
+            return AsyncResult(static_cast<double>(fs_->getFileSize(path)));
         })
 
-        JSI_ASYNC_METHOD(getModifiedTime, 1, {
-            return AsyncResult(static_cast<double>(fs_->getModifiedTime(JSI_S_ARG(0))));
+        JSI_ASYNC_TYPED(getModifiedTime, (const std::string& path), {
+            return AsyncResult(static_cast<double>(fs_->getModifiedTime(path)));
         })
 
-        // Read operations (1 param: path)
-        JSI_ASYNC_METHOD(readString, 1, {
-            return AsyncResult(fs_->readString(JSI_S_ARG(0)));
+        // Read operations (path, encoding? for strings); decoding runs on the worker
+        JSI_ASYNC_TYPED(readString, (const std::string& path, std::optional<std::string> encoding), {
+            return AsyncResult(bytesToText(fs_->readString(path), encoding));
         })
 
-        JSI_ASYNC_METHOD(readBytes, 1, {
-            return AsyncResult(fs_->readBytes(JSI_S_ARG(0)));
+        JSI_ASYNC_TYPED(readBytes, (const std::string& path), {
+            return AsyncResult(fs_->readBytes(path));
         })
 
-        // Write operations (4 params: path, content, mode?, createParents?)
-        JSI_ASYNC_METHOD(writeString, 4, {
-            fs_->writeString(JSI_S_ARG(0), JSI_S_ARG(1),
-                static_cast<WriteMode>(static_cast<int>(JSI_N_OPT(0, 0))),
-                JSI_B_OPT(0, false));
+        // Write operations (path, content, mode?, createParents?, encoding? for strings)
+        JSI_ASYNC_TYPED(writeString, (const std::string& path, const std::string& content,
+                                      std::optional<int> mode, std::optional<bool> createParents,
+                                      std::optional<std::string> encoding), {
+            auto textEncoding = encoding ? parseTextEncoding(*encoding) : TextEncoding::Utf8;
+            auto writeMode = static_cast<WriteMode>(mode.value_or(0));
+            if (textEncoding == TextEncoding::Utf8) {
+                fs_->writeString(path, content, writeMode, createParents.value_or(false));
+            } else {
+                fs_->writeString(path, encodeText(content, textEncoding), writeMode, createParents.value_or(false));
+            }
             return AsyncResult();  // void result
         })
 
-        JSI_ASYNC_METHOD(writeBytes, 4, {
-            fs_->writeBytes(JSI_S_ARG(0), JSI_BUF_ARG(0),
-                static_cast<WriteMode>(static_cast<int>(JSI_N_OPT(0, 0))),
-                JSI_B_OPT(0, false));
+        JSI_ASYNC_TYPED(writeBytes, (const std::string& path, const BufferArg& data,
+                                     std::optional<int> mode, std::optional<bool> createParents), {
+            fs_->writeBytes(path, data, static_cast<WriteMode>(mode.value_or(0)),
+                createParents.value_or(false));
+            return AsyncResult();  // void result
+        })
+
+        // writeFilesAtomic(paths[], contents[], createParents?) -> Promise<void>
+        // contents[i] is a UTF-8 string or an ArrayBuffer, read in place
+        JSI_ASYNC_TYPED(writeFilesAtomic, (const std::vector<std::string>& paths,
+                                           const std::vector<std::variant<std::string, BufferArg>>& contents,
+                                           std::optional<bool> createParents), {
+            if (paths.size() != contents.size()) {
+                throw std::runtime_error("writeFilesAtomic: paths and contents differ in length");
+            }
+            std::vector<AtomicWrite> files;
+            files.reserve(paths.size());
+            for (size_t i = 0; i < paths.size(); ++i) {
+                std::span<const uint8_t> data = std::visit([](const auto& content) -> std::span<const uint8_t> {
+                    if constexpr (std::is_same_v<std::decay_t<decltype(content)>, std::string>) {
+                        return {reinterpret_cast<const uint8_t*>(content.data()), content.size()};
+                    } else {
+                        return content.span();
+                    }
+                }, contents[i]);
+                files.push_back({paths[i], data});
+            }
+            fs_->writeFilesAtomic(files, createParents.value_or(false));
             return AsyncResult();  // void result
         })
 
@@ -472,9 +889,12 @@ private:
             return AsyncResult(fs_->deleteFile(JSI_S_ARG(0)));
         })
 
-        JSI_ASYNC_METHOD(copyFile, 3, {  // src, dest, overwrite?
-            fs_->copyFile(JSI_S_ARG(0), JSI_S_ARG(1), JSI_B_OPT(0, true));
-            return AsyncResult();
+        // copyFile(src, dest, overwrite?, onProgress?, cancelToken?) -> bytes copied
+        JSI_ASYNC_METHOD(copyFile, 5, {
+            return AsyncResult(fs_->copyFile(
+                JSI_S_ARG(0), JSI_S_ARG(1), JSI_B_OPT(0, true),
+                makeProgress(JSI_FN_OPT(0)), makeCancelCheck(jsiCtx)
+            ));
         })
 
         JSI_ASYNC_METHOD(moveFile, 2, {  // src, dest
@@ -493,16 +913,37 @@ private:
         })
 
         JSI_ASYNC_METHOD(listDirectory, 2, {  // path, recursive?
-            auto entries = fs_->listDirectory(JSI_S_ARG(0), JSI_B_OPT(0, false));
+            auto entries = fs_->listDirectory(JSI_S_ARG(0), JSI_B_OPT(0, false), makeCancelCheck(jsiCtx));
             std::vector<AsyncResult> arr;
             arr.reserve(entries.size());
             for (const auto& entry : entries) {
-                AsyncResultMap obj(4);
-                obj.emplace("path", entry.path);
-                obj.emplace("name", entry.name);
-                obj.emplace("type", static_cast<double>(static_cast<int>(entry.type)));
-                obj.emplace("size", static_cast<double>(entry.size));
-                arr.emplace_back(std::move(obj));
+                arr.push_back(toAsyncResult(entry));
+            }
+            return AsyncResult(std::move(arr));
+        })
+
+        // listDirectoryColumnar(path, recursive?, withSize?, withTime?) -> columns
+        JSI_ASYNC_METHOD(listDirectoryColumnar, 4, {
+            return toAsyncResult(fs_->listDirectoryColumns(
+                JSI_S_ARG(0), JSI_B_OPT(0, false), JSI_B_OPT(1, true), JSI_B_OPT(2, true),
+                makeCancelCheck(jsiCtx)));
+        })
+
+        // readDirectoryBatch(iterator, count?, withSize?) -> entries (empty when exhausted)
+        JSI_ASYNC_METHOD(readDirectoryBatch, 3, {
+            auto iterator = getDirIterator(static_cast<int>(JSI_N_ARG(0)));
+            auto requested = JSI_N_OPT(1, 1000.0);
+            if (!std::isfinite(requested)) {
+                throw std::runtime_error("readDirectoryBatch: count must be a finite number");
+            }
+            auto maxEntries = static_cast<size_t>(std::clamp(requested, 1.0, kMaxDirectoryBatch));
+            bool withSize = JSI_B_OPT(0, false);
+            auto entries = iterator->readBatch(maxEntries, withSize);
+
+            std::vector<AsyncResult> arr;
+            arr.reserve(entries.size());
+            for (const auto& entry : entries) {
+                arr.push_back(toAsyncResult(entry, withSize));
             }
             return AsyncResult(std::move(arr));
         })
@@ -530,10 +971,214 @@ private:
             return AsyncResult(static_cast<double>(fs_->getTotalSpace(JSI_S_ARG(0))));
         })
 
-        // Hash (2 params: path, algorithm?)
-        JSI_ASYNC_METHOD(calcHash, 2, {
+        // mmapFile(path, offset, length, readOnly) -> Promise<ArrayBuffer> backed by mmap
+        JSI_ASYNC_METHOD(mmapFile, 4, {
+            return AsyncResult(mapFile(JSI_S_ARG(0), JSI_N_OPT(0, 0), JSI_N_OPT(1, -1), JSI_B_OPT(0, true)));
+        })
+
+        // Hash (4 params: path, algorithm?, onProgress?, cancelToken?)
+        JSI_ASYNC_METHOD(calcHash, 4, {
+            auto algorithm = static_cast<HashAlgorithm>(static_cast<int>(JSI_N_OPT(0, 2)));
+            return AsyncResult(fs_->calcHash(
+                JSI_S_ARG(0), algorithm, makeProgress(JSI_FN_OPT(0)), makeCancelCheck(jsiCtx),
+                makeSpawner(jsiCtx.priority)
+            ));
+        })
+
+        // calcHashes(path, algorithms[], onProgress?, cancelToken?) -> { [algorithm]: hash }
+        // All digests come from a single read of the file
+        JSI_ASYNC_METHOD(calcHashes, 4, {
+            std::vector<HashAlgorithm> algorithms;
+            algorithms.reserve(jsiNumArgs.size());
+            for (auto value : jsiNumArgs) {
+                algorithms.push_back(static_cast<HashAlgorithm>(static_cast<int>(value)));
+            }
+            auto digests = fs_->calcHashes(
+                JSI_S_ARG(0), algorithms, makeProgress(JSI_FN_OPT(0)), makeCancelCheck(jsiCtx),
+                makeSpawner(jsiCtx.priority)
+            );
+
+            AsyncResultMap result;
+            for (size_t i = 0; i < algorithms.size(); ++i) {
+                result[std::to_string(static_cast<int>(algorithms[i]))] = AsyncResult(std::move(digests[i]));
+            }
+            return AsyncResult(std::move(result));
+        })
+
+        // calcHashChunked(path, algorithm, chunkSize, onProgress?, cancelToken?)
+        //   -> { root, chunkSize, chunks: string[] }
+        // Ranges are hashed concurrently on the thread pool
+        JSI_ASYNC_METHOD(calcHashChunked, 5, {
             auto algorithm = static_cast<HashAlgorithm>(static_cast<int>(JSI_N_OPT(0, 2)));
-            return AsyncResult(fs_->calcHash(JSI_S_ARG(0), algorithm));
+            auto chunkSize = JSI_N_OPT(1, static_cast<double>(kChunkedHashDefaultSize));
+            // Written to also reject NaN; above 2^53 - 1 it is no exact byte count
+            if (!(chunkSize >= 1 && chunkSize <= kMaxSafeInteger)) {
+                throw std::runtime_error("calcHashChunked: chunkSize must be a positive safe integer");
+            }
+            auto hash = fs_->calcChunkedHash(
+                JSI_S_ARG(0), algorithm, static_cast<uint64_t>(chunkSize),
+                makeSpawner(jsiCtx.priority),
+                executor_->concurrency(static_cast<int>(ExecutorLane::Compute)) - 1,
+                makeProgress(JSI_FN_OPT(0)), makeCancelCheck(jsiCtx)
+            );
+
+            std::vector<AsyncResult> chunks;
+            chunks.reserve(hash.chunks.size());
+            for (auto& chunk : hash.chunks) {
+                chunks.emplace_back(std::move(chunk));
+            }
+            AsyncResultMap result;
+            result["root"] = AsyncResult(std::move(hash.root));
+            result["chunkSize"] = AsyncResult(hash.chunkSize);
+            result["chunks"] = AsyncResult(std::move(chunks));
+            return AsyncResult(std::move(result));
+        })
+
+        // ====================================================================
+        // Pipelines
+        // ====================================================================
+
+        // pipe(source, offset?, length?, stages, sink?, append?, onProgress?, cancelToken?)
+        //   -> {bytesRead, bytesWritten, digests: string[], data?: ArrayBuffer}
+        // source and sink are a path or a handle ID; without a sink the output
+        // is returned as data. stages: [[kind, param?], ...] (PipeStageKind)
+        JSI_ASYNC_TYPED(pipe, (const std::variant<std::string, int>& source,
+                               std::optional<int64_t> offset, std::optional<int64_t> length,
+                               const std::vector<std::vector<int>>& stages,
+                               const std::variant<std::monostate, std::string, int>& sink,
+                               std::optional<bool> append), {
+            IOPipeline pipeline;
+            for (const auto& stage : stages) {
+                if (stage.empty()) {
+                    throw std::runtime_error("pipe: stage without kind");
+                }
+                pipeline.addStage(static_cast<PipeStageKind>(stage[0]), stage.size() > 1 ? stage[1] : -1);
+            }
+
+            PipeSource input;
+            input.offset = offset.value_or(0);
+            input.length = length.value_or(-1);
+            if (auto* path = std::get_if<std::string>(&source)) {
+                input.handle = std::make_shared<IOFileHandle>(*path, FileOpenMode::Read);
+            } else {
+                input.handle = getHandle(std::get<int>(source));
+            }
+
+            std::vector<uint8_t> data;
+            std::unique_ptr<PipeSink> output;
+            if (auto* path = std::get_if<std::string>(&sink)) {
+                // Opening the sink would truncate the source before it is read
+                std::error_code ec;
+                if (std::filesystem::equivalent(input.handle->getPath(), *path, ec)) {
+                    throw std::runtime_error("pipe: source and sink are the same file");
+                }
+                output = std::make_unique<detail::FileSink>(*path, append.value_or(false));
+            } else if (auto* id = std::get_if<int>(&sink)) {
+                output = std::make_unique<detail::HandleSink>(getHandle(*id));
+            } else {
+                output = std::make_unique<detail::MemorySink>(data);
+            }
+
+            auto run = pipeline.run(input, *output, makeProgress(JSI_FN_OPT(0)), makeCancelCheck(jsiCtx),
+                                    makeSpawner(jsiCtx.priority, ExecutorLane::Bulk));
+
+            std::vector<AsyncResult> digests;
+            digests.reserve(run.digests.size());
+            for (auto& digest : run.digests) {
+                digests.emplace_back(std::move(digest));
+            }
+            AsyncResultMap result;
+            result["bytesRead"] = AsyncResult(run.bytesRead);
+            result["bytesWritten"] = AsyncResult(run.bytesWritten);
+            result["digests"] = AsyncResult(std::move(digests));
+            if (std::holds_alternative<std::monostate>(sink)) {
+                result["data"] = AsyncResult(std::move(data));
+            }
+            return AsyncResult(std::move(result));
+        })
+
+        // pipeLines(source, offset?, length?, stages, recordStages, output, onProgress?, cancelToken?)
+        //   -> {bytesRead, linesRead, records, invalid, lines? | columns? | counts? | bytesWritten?}
+        // stages: [[kind, param?], ...] applied to the bytes before they are split into lines;
+        // recordStages and output: string specs, see IORecordPipeline. Numeric columns come
+        // back as Float64 ArrayBuffers, others as string arrays
+        JSI_ASYNC_TYPED(pipeLines, (const std::variant<std::string, int>& source,
+                                    std::optional<int64_t> offset, std::optional<int64_t> length,
+                                    const std::vector<std::vector<int>>& stages,
+                                    const std::vector<std::vector<std::string>>& recordStages,
+                                    const std::vector<std::string>& output), {
+            IORecordPipeline pipeline;
+            for (const auto& stage : stages) {
+                if (stage.empty()) {
+                    throw std::runtime_error("pipeLines: stage without kind");
+                }
+                pipeline.bytes().addStage(static_cast<PipeStageKind>(stage[0]), stage.size() > 1 ? stage[1] : -1);
+            }
+            for (const auto& stage : recordStages) {
+                pipeline.addStage(stage);
+            }
+
+            PipeSource input;
+            input.offset = offset.value_or(0);
+            input.length = length.value_or(-1);
+            if (auto* path = std::get_if<std::string>(&source)) {
+                input.handle = std::make_shared<IOFileHandle>(*path, FileOpenMode::Read);
+            } else {
+                input.handle = getHandle(std::get<int>(source));
+            }
+            if (output.size() > 1 && output[0] == "file") {
+                // Opening the output would truncate the source before it is read
+                std::error_code ec;
+                if (std::filesystem::equivalent(input.handle->getPath(), output[1], ec)) {
+                    throw std::runtime_error("pipeLines: source and output are the same file");
+                }
+            }
+            pipeline.setOutput(output);
+
+            auto run = pipeline.run(input, makeProgress(JSI_FN_OPT(0)), makeCancelCheck(jsiCtx),
+                                    makeSpawner(jsiCtx.priority, ExecutorLane::Bulk));
+
+            AsyncResultMap result;
+            result["bytesRead"] = AsyncResult(run.bytesRead);
+            result["linesRead"] = AsyncResult(run.linesRead);
+            result["records"] = AsyncResult(run.records);
+            result["invalid"] = AsyncResult(run.invalid);
+            auto kind = output.empty() ? std::string("lines") : output[0];
+            if (kind == "lines") {
+                std::vector<AsyncResult> lines;
+                lines.reserve(run.lines.size());
+                for (auto& line : run.lines) {
+                    lines.emplace_back(std::move(line));
+                }
+                result["lines"] = AsyncResult(std::move(lines));
+            } else if (kind == "columns") {
+                std::vector<AsyncResult> columns;
+                columns.reserve(run.columns.size());
+                for (auto& column : run.columns) {
+                    if (column.numeric) {
+                        std::vector<uint8_t> bytes(column.numbers.size() * sizeof(double));
+                        std::memcpy(bytes.data(), column.numbers.data(), bytes.size());
+                        columns.emplace_back(std::move(bytes));
+                        continue;
+                    }
+                    std::vector<AsyncResult> strings;
+                    strings.reserve(column.strings.size());
+                    for (auto& value : column.strings) {
+                        strings.push_back(value ? AsyncResult(std::move(*value)) : AsyncResult());
+                    }
+                    columns.emplace_back(std::move(strings));
+                }
+                result["columns"] = AsyncResult(std::move(columns));
+            } else if (kind == "countBy") {
+                AsyncResultMap counts(run.counts.size());
+                for (auto& [key, count] : run.counts) {
+                    counts.emplace(std::move(key), AsyncResult(count));
+                }
+                result["counts"] = AsyncResult(std::move(counts));
+            } else if (kind == "file") {
+                result["bytesWritten"] = AsyncResult(run.bytesWritten);
+            }
+            return AsyncResult(std::move(result));
         })
 
         // ====================================================================
@@ -555,17 +1200,13 @@ private:
         })
 
         // fileRead(handle, size?) -> ArrayBuffer
-        JSI_ASYNC_METHOD(fileRead, 2, {
-            int handleId = static_cast<int>(JSI_N_ARG(0));
-            int64_t size = jsiNumArgs.size() > 1 ? static_cast<int64_t>(JSI_N_ARG(1)) : -1;
-            return AsyncResult(getHandle(handleId)->read(size));
+        JSI_ASYNC_TYPED(fileRead, (int handleId, std::optional<int64_t> size), {
+            return AsyncResult(getHandle(handleId)->read(size.value_or(-1)));
         })
 
         // fileReadString(handle, size?) -> string
-        JSI_ASYNC_METHOD(fileReadString, 2, {
-            int handleId = static_cast<int>(JSI_N_ARG(0));
-            int64_t size = jsiNumArgs.size() > 1 ? static_cast<int64_t>(JSI_N_ARG(1)) : -1;
-            return AsyncResult(getHandle(handleId)->readString(size));
+        JSI_ASYNC_TYPED(fileReadString, (int handleId, std::optional<int64_t> size), {
+            return AsyncResult(getHandle(handleId)->readString(size.value_or(-1)));
         })
 
         // fileReadLine(handle) -> string
@@ -574,17 +1215,56 @@ private:
             return AsyncResult(getHandle(handleId)->readLine());
         })
 
-        // fileWrite(handle, buffer) -> number (bytes written)
-        JSI_ASYNC_METHOD(fileWrite, 2, {
+        // fileReadLines(handle, maxLines?, maxBytes?) -> string[] (empty at EOF)
+        JSI_ASYNC_METHOD(fileReadLines, 3, {
             int handleId = static_cast<int>(JSI_N_ARG(0));
-            auto& buffer = JSI_BUF_ARG(0);
+            auto requestedLines = JSI_N_OPT(1, 1000.0);
+            auto requestedBytes = JSI_N_OPT(2, 16.0 * 1024 * 1024);
+            if (!std::isfinite(requestedLines) || !std::isfinite(requestedBytes)) {
+                throw std::runtime_error("fileReadLines: maxLines and maxBytes must be finite numbers");
+            }
+            auto maxLines = static_cast<size_t>(std::clamp(requestedLines, 1.0, kMaxLineBatch));
+            auto maxBytes = static_cast<size_t>(std::clamp(requestedBytes, 1.0, kMaxLineBatchBytes));
+            auto lines = getHandle(handleId)->readLines(maxLines, maxBytes);
+
+            std::vector<AsyncResult> result;
+            result.reserve(lines.size());
+            for (auto& line : lines) {
+                result.emplace_back(std::move(line));
+            }
+            return AsyncResult(std::move(result));
+        })
+
+        // fileReadAt(handle, offset, size) -> ArrayBuffer (position-independent)
+        JSI_ASYNC_TYPED(fileReadAt, (int handleId, int64_t offset, std::optional<int64_t> size), {
+            return AsyncResult(getHandle(handleId)->readAt(offset, size.value_or(-1)));
+        })
+
+        // fileHashRange(handle, offset, length, algorithm, onProgress?, cancelToken?) -> string
+        JSI_ASYNC_METHOD(fileHashRange, 6, {
+            int handleId = static_cast<int>(JSI_N_ARG(0));
+            auto offset = static_cast<int64_t>(JSI_N_ARG(1));
+            auto length = static_cast<int64_t>(JSI_N_OPT(2, -1));
+            auto algorithm = static_cast<HashAlgorithm>(static_cast<int>(JSI_N_OPT(3, 2)));
+            return AsyncResult(getHandle(handleId)->hashRange(
+                offset, length, algorithm, makeProgress(JSI_FN_OPT(0)), makeCancelCheck(jsiCtx),
+                makeSpawner(jsiCtx.priority)
+            ));
+        })
+
+        // fileWriteAt(handle, offset, buffer) -> number (bytes written, position-independent)
+        JSI_ASYNC_TYPED(fileWriteAt, (int handleId, int64_t offset, const BufferArg& buffer), {
+            return AsyncResult(static_cast<double>(getHandle(handleId)->writeAt(offset, buffer)));
+        })
+
+        // fileWrite(handle, buffer) -> number (bytes written)
+        JSI_ASYNC_TYPED(fileWrite, (int handleId, const BufferArg& buffer), {
             return AsyncResult(static_cast<double>(getHandle(handleId)->write(buffer)));
         })
 
         // fileWriteString(handle, string) -> number (bytes written)
-        JSI_ASYNC_METHOD(fileWriteString, 2, {
-            int handleId = static_cast<int>(JSI_N_ARG(0));
-            return AsyncResult(static_cast<double>(getHandle(handleId)->writeString(JSI_S_ARG(0))));
+        JSI_ASYNC_TYPED(fileWriteString, (int handleId, const std::string& content), {
+            return AsyncResult(static_cast<double>(getHandle(handleId)->writeString(content)));
         })
 
         // fileWriteLine(handle, string) -> number (bytes written)
@@ -592,6 +1272,48 @@ private:
             int handleId = static_cast<int>(JSI_N_ARG(0));
             return AsyncResult(static_cast<double>(getHandle(handleId)->writeLine(JSI_S_ARG(0))));
         })
+
+        // ====================================================================
+        // Benchmarks (Asynchronous)
+        // ====================================================================
+
+        // ping(payload?) -> number (payload length); measures the round trip of an async call
+        JSI_ASYNC_TYPED(ping, (std::optional<std::string> payload), {
+            return AsyncResult(static_cast<double>(payload ? payload->size() : 0));
+        })
+
+        // runBenchmarks(directory, suites[], quick?, cancelToken?) -> JSON report (see IOBenchmark.hpp)
+        JSI_ASYNC_TYPED(runBenchmarks, (const std::string& directory, const std::vector<std::string>& suites,
+                                        std::optional<bool> quick), {
+            BenchmarkOptions options;
+            options.directory = directory;
+            options.suites = suites;
+            options.quick = quick.value_or(false);
+            BenchmarkRunner runner(std::move(options), makeCancelCheck(jsiCtx));
+            runner.run();
+            return AsyncResult(runner.toJson());
+        })
+
+        // ====================================================================
+        // Batch (Asynchronous)
+        // ====================================================================
+
+        // batch([{op, args?, group?}, ...], ordered?) -> Promise<[{ok, value?, error?}]>
+        // op is the name of any async method above
+        registerBatch("batch");
+
+        // ====================================================================
+        // Executor Lanes (everything else runs on the interactive lane)
+        // ====================================================================
+
+        for (const char* name : {"copyFile", "moveFile", "deleteDirectory", "moveDirectory",
+                                 "listDirectory", "listDirectoryColumnar", "getMetadataColumnar",
+                                 "readDirectoryBatch", "pipe", "pipeLines", "runBenchmarks"}) {
+            setAsyncLane(name, static_cast<int>(ExecutorLane::Bulk));
+        }
+        for (const char* name : {"calcHash", "calcHashes", "calcHashChunked", "fileHashRange"}) {
+            setAsyncLane(name, static_cast<int>(ExecutorLane::Compute));
+        }
     }
 };
 
@@ -0,0 +1,281 @@
+/**
+ * @file IOAtomicWrite.hpp
+ * @brief Crash-safe file replacement
+ *
+ * A file is written to a temporary sibling, flushed to storage and renamed
+ * over the target, and the directory is flushed so the rename survives a
+ * power loss too. Readers see the old or the new contents, never a mix.
+ * Writing many files at once shares the expensive flushes between them.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_ATOMIC_WRITE_HPP
+#define IO_ATOMIC_WRITE_HPP
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "IOFileCopy.hpp"
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// sync_file_range() starts write-back without waiting (bionic: API 26+)
+#if defined(__linux__) && defined(SYNC_FILE_RANGE_WRITE) && (!defined(__ANDROID__) || __ANDROID_API__ >= 26)
+#define IO_ATOMIC_EARLY_WRITEBACK 1
+#else
+#define IO_ATOMIC_EARLY_WRITEBACK 0
+#endif
+
+namespace rct_io {
+
+/**
+ * @brief One file of writeFilesAtomic()
+ */
+struct AtomicWrite {
+    std::string path;
+    std::span<const uint8_t> data;
+};
+
+namespace detail {
+
+[[noreturn]] inline void throwAtomicWriteError(const std::string& path, const std::string& what) {
+    throw std::runtime_error("Failed to write file atomically: " + path + " (" + what + ")");
+}
+
+/** @brief Unused name next to path, so the rename stays on one filesystem */
+inline auto atomicTempPath(const std::string& path) -> std::string {
+    static std::atomic<uint64_t> counter{0};
+    std::filesystem::path target(path);
+    auto name = "." + target.filename().string() + ".rnio-tmp-"
+#ifndef _WIN32
+        + std::to_string(::getpid()) + "-"
+#endif
+        + std::to_string(counter++);
+    return (target.parent_path() / name).string();
+}
+
+#ifndef _WIN32
+
+/**
+ * @brief Flush file data so that later writes cannot reach storage first
+ *
+ * On Apple platforms fsync only reaches the drive cache; a barrier keeps
+ * the order without paying for a cache flush per file.
+ */
+inline auto syncOrdered(int fd) -> int {
+#if defined(__APPLE__)
+#if defined(F_BARRIERFSYNC)
+    if (::fcntl(fd, F_BARRIERFSYNC) == 0) {
+        return 0;
+    }
+#endif
+    return ::fsync(fd);
+#else
+    return ::fdatasync(fd);
+#endif
+}
+
+/** @brief Flush everything written so far all the way to storage */
+inline auto syncFull(int fd) -> int {
+#if defined(__APPLE__)
+    if (::fcntl(fd, F_FULLFSYNC) == 0) {
+        return 0;
+    }
+#endif
+    return ::fsync(fd);
+}
+
+inline auto writeAll(int fd, const uint8_t* data, size_t size) -> bool {
+    size_t total = 0;
+    while (total < size) {
+        auto n = ::write(fd, data + total, size - total);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        total += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Replace files with new contents, each one atomically and durably
+ *
+ * All temporary files are written first; then their data is flushed,
+ * they are renamed over their targets and every distinct directory is
+ * flushed once. On Apple platforms only the last flush empties the drive
+ * cache (F_FULLFSYNC), so a batch costs about as much as a single file.
+ *
+ * Each file is replaced atomically, the batch as a whole is not: a
+ * failure can leave the files before it replaced. Temporary files are
+ * removed on failure. An existing target keeps its permissions.
+ *
+ * @throws std::runtime_error naming the file that failed
+ */
+inline auto writeFilesAtomic(std::span<const AtomicWrite> files) -> void {
+    std::vector<std::string> temps;
+    temps.reserve(files.size());
+    size_t renamed = 0;
+
+#ifdef _WIN32
+    try {
+        for (const auto& file : files) {
+            temps.push_back(detail::atomicTempPath(file.path));
+            std::ofstream out(temps.back(), std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(file.data.data()),
+                      static_cast<std::streamsize>(file.data.size()));
+            out.flush();
+            if (!out) {
+                detail::throwAtomicWriteError(file.path, "write failed");
+            }
+        }
+        for (; renamed < files.size(); ++renamed) {
+            std::error_code ec;
+            std::filesystem::rename(temps[renamed], files[renamed].path, ec);
+            if (ec) {
+                detail::throwAtomicWriteError(files[renamed].path, ec.message());
+            }
+        }
+    } catch (...) {
+        for (size_t i = renamed; i < temps.size(); ++i) {
+            std::error_code ec;
+            std::filesystem::remove(temps[i], ec);
+        }
+        throw;
+    }
+#else
+    std::vector<int> fds;
+    fds.reserve(files.size());
+    auto closeAll = [&fds] {
+        for (auto& fd : fds) {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+    };
+
+    try {
+        // 1. Write every temporary file; on Linux its write-back starts right away
+        for (const auto& file : files) {
+            std::string temp;
+            int fd = -1;
+            for (int attempt = 0; attempt < 8 && fd < 0; ++attempt) {
+                temp = detail::atomicTempPath(file.path);
+                fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+                if (fd < 0 && errno != EEXIST) {
+                    break;
+                }
+            }
+            if (fd < 0) {
+                detail::throwAtomicWriteError(file.path, std::strerror(errno));
+            }
+            temps.push_back(temp);
+            fds.push_back(fd);
+
+            struct stat existing {};
+            if (::stat(file.path.c_str(), &existing) == 0) {
+                ::fchmod(fd, existing.st_mode & 07777);
+            }
+            if (!detail::writeAll(fd, file.data.data(), file.data.size())) {
+                detail::throwAtomicWriteError(file.path, std::strerror(errno));
+            }
+#if IO_ATOMIC_EARLY_WRITEBACK
+            ::sync_file_range(fd, 0, 0, SYNC_FILE_RANGE_WRITE);
+#endif
+        }
+
+        // 2. Wait for the data; the write-back of the files overlaps
+        for (size_t i = 0; i < fds.size(); ++i) {
+            if (detail::syncOrdered(fds[i]) != 0) {
+                detail::throwAtomicWriteError(files[i].path, std::strerror(errno));
+            }
+            int fd = fds[i];
+            fds[i] = -1;
+            if (::close(fd) != 0) {
+                detail::throwAtomicWriteError(files[i].path, std::strerror(errno));
+            }
+        }
+
+        // 3. Swap the files in
+        for (; renamed < files.size(); ++renamed) {
+            if (::rename(temps[renamed].c_str(), files[renamed].path.c_str()) != 0) {
+                detail::throwAtomicWriteError(files[renamed].path, std::strerror(errno));
+            }
+        }
+    } catch (...) {
+        closeAll();
+        for (size_t i = renamed; i < temps.size(); ++i) {
+            ::unlink(temps[i].c_str());
+        }
+        throw;
+    }
+
+    // 4. Make the renames durable: each directory once, the last one all the way
+    std::set<std::string> directories;
+    for (const auto& file : files) {
+        auto parent = std::filesystem::path(file.path).parent_path().string();
+        directories.insert(parent.empty() ? "." : parent);
+    }
+    size_t left = directories.size();
+    for (const auto& directory : directories) {
+        detail::ScopedFd dir(::open(directory.c_str(), O_RDONLY | O_CLOEXEC));
+        --left;
+        if (dir.fd < 0) {
+            continue;  // Some platforms do not open directories; the data is already safe
+        }
+        if ((left == 0 ? detail::syncFull(dir.fd) : detail::syncOrdered(dir.fd)) != 0 && errno != EINVAL) {
+            detail::throwAtomicWriteError(directory, std::strerror(errno));
+        }
+    }
+#endif
+}
+
+/** @brief Replace one file atomically and durably, see writeFilesAtomic() */
+inline auto writeFileAtomic(const std::string& path, std::span<const uint8_t> data) -> void {
+    AtomicWrite file{path, data};
+    writeFilesAtomic(std::span<const AtomicWrite>(&file, 1));
+}
+
+} // namespace rct_io
+
+#endif // IO_ATOMIC_WRITE_HPP
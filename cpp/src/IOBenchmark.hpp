@@ -0,0 +1,429 @@
+/**
+ * @file IOBenchmark.hpp
+ * @brief Throughput benchmarks of the file system, hash and codec paths
+ *
+ * The same runner backs the host executable in cpp/bench and
+ * FS.runBenchmarks() in the app, so numbers from a workstation and from a
+ * device are directly comparable. Results are emitted as JSON so they can
+ * be tracked across releases.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_BENCHMARK_HPP
+#define IO_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "IOFileHandle.hpp"
+#include "IOFileSystem.hpp"
+#include "IOHasher.hpp"
+#include "IOTextCodec.hpp"
+
+#if defined(__APPLE__)
+#include <TargetConditionals.h>
+#endif
+
+namespace rct_io {
+
+struct BenchmarkOptions {
+    std::string directory;            // Scratch directory; created, and removed afterwards
+    std::vector<std::string> suites;  // "fs", "list", "hash", "codec"; empty = all
+    bool quick = false;               // Small sizes only, for smoke tests
+    double minSeconds = 0.25;         // Least time measured per case, over all samples
+};
+
+/**
+ * @brief One measured case; value is the median of the samples
+ */
+struct BenchmarkResult {
+    std::string suite;
+    std::string name;   // e.g. "seqRead/1MB"
+    std::string unit;   // "MB/s" (10^6 bytes), "ops/s" or "entries/s"
+    double value = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    uint64_t iterations = 0;  // Operations run over all samples
+};
+
+namespace bench_detail {
+
+using Clock = std::chrono::steady_clock;
+
+inline constexpr int kSamples = 5;
+
+inline auto sizeLabel(size_t bytes) -> std::string {
+    if (bytes >= 1024 * 1024 && bytes % (1024 * 1024) == 0) {
+        return std::to_string(bytes / (1024 * 1024)) + "MB";
+    }
+    if (bytes >= 1024 && bytes % 1024 == 0) {
+        return std::to_string(bytes / 1024) + "KB";
+    }
+    return std::to_string(bytes) + "B";
+}
+
+/** @brief Incompressible-looking bytes, the same on every run */
+inline auto randomBytes(size_t size) -> std::vector<uint8_t> {
+    std::vector<uint8_t> data(size);
+    std::mt19937_64 rng(42);
+    for (size_t i = 0; i < size; i += 8) {
+        auto word = rng();
+        std::memcpy(data.data() + i, &word, std::min<size_t>(8, size - i));
+    }
+    return data;
+}
+
+/** @brief Text of the given size: ASCII only, or with 2-4 byte UTF-8 sequences mixed in */
+inline auto sampleText(size_t size, bool ascii) -> std::string {
+    static constexpr std::string_view kAscii = "The quick brown fox jumps over the lazy dog 0123456789. ";
+    static constexpr std::string_view kMixed = "Grüße aus Zürich, naïve café — 東京 ✓ 🦊 ";
+    auto piece = ascii ? kAscii : kMixed;
+    std::string text;
+    text.reserve(size + piece.size());
+    while (text.size() < size) {
+        text.append(piece);
+    }
+    // Cut at a character boundary
+    size_t end = size;
+    while (end > 0 && (static_cast<uint8_t>(text[end]) & 0xC0) == 0x80) {
+        --end;
+    }
+    text.resize(end);
+    return text;
+}
+
+} // namespace bench_detail
+
+/**
+ * @brief Runs the benchmark suites in a scratch directory
+ *
+ * Every case is warmed up once, then run for kSamples samples of equal
+ * iteration counts sized so all samples together take about minSeconds.
+ * File reads go through the page cache, as reads of recently written app
+ * data do; they measure the library's overhead, not the flash chip.
+ */
+class BenchmarkRunner {
+private:
+    BenchmarkOptions options_;
+    CancelCheck isCancelled_;
+    IOFileSystem fs_;
+    std::vector<BenchmarkResult> results_;
+
+    [[nodiscard]] auto wants(std::string_view suite) const -> bool {
+        return options_.suites.empty()
+            || std::find(options_.suites.begin(), options_.suites.end(), suite) != options_.suites.end();
+    }
+
+    auto checkCancelled() const -> void {
+        if (isCancelled_ && isCancelled_()) {
+            throw std::runtime_error("Operation cancelled");
+        }
+    }
+
+    [[nodiscard]] auto scratch(const std::string& name) const -> std::string {
+        return options_.directory + "/" + name;
+    }
+
+    /**
+     * @brief Time op and record its rate
+     * @param unitsPerOp What one call of op amounts to in unit (MB, entries, 1 op)
+     */
+    template <typename Op>
+    auto measure(std::string suite, std::string name, std::string unit, double unitsPerOp, Op&& op) -> void {
+        using namespace bench_detail;
+        checkCancelled();
+
+        auto start = Clock::now();
+        op();
+        double once = std::chrono::duration<double>(Clock::now() - start).count();
+        auto perSample = static_cast<uint64_t>(
+            std::clamp(options_.minSeconds / kSamples / std::max(once, 1e-7), 1.0, 1e8));
+
+        std::vector<double> rates;
+        rates.reserve(kSamples);
+        for (int sample = 0; sample < kSamples; ++sample) {
+            checkCancelled();
+            start = Clock::now();
+            for (uint64_t i = 0; i < perSample; ++i) {
+                op();
+            }
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            rates.push_back(unitsPerOp * static_cast<double>(perSample) / std::max(seconds, 1e-9));
+        }
+        std::sort(rates.begin(), rates.end());
+
+        results_.push_back({std::move(suite), std::move(name), std::move(unit),
+                            rates[rates.size() / 2], rates.front(), rates.back(),
+                            perSample * kSamples});
+    }
+
+    auto runFileSuite() -> void {
+        using namespace bench_detail;
+        std::vector<size_t> sizes = options_.quick
+            ? std::vector<size_t>{4 * 1024, 1024 * 1024}
+            : std::vector<size_t>{4 * 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024};
+        auto data = randomBytes(sizes.back());
+        auto path = scratch("sequential.bin");
+
+        for (auto size : sizes) {
+            std::span<const uint8_t> block(data.data(), size);
+            double mb = static_cast<double>(size) / 1e6;
+            measure("fs", "seqWrite/" + sizeLabel(size), "MB/s", mb, [&] {
+                fs_.writeBytes(path, block);
+            });
+            measure("fs", "seqRead/" + sizeLabel(size), "MB/s", mb, [&] {
+                auto bytes = fs_.readBytes(path);
+                if (bytes.size() != size) {
+                    throw std::runtime_error("Benchmark read came back short: " + path);
+                }
+            });
+        }
+
+        // Random block access inside one larger file
+        size_t fileSize = options_.quick ? 8 * 1024 * 1024 : 64 * 1024 * 1024;
+        auto randomPath = scratch("random.bin");
+        {
+            IOFileHandle file(randomPath, FileOpenMode::Write);
+            for (size_t written = 0; written < fileSize; written += data.size()) {
+                file.write({data.data(), std::min(data.size(), fileSize - written)});
+            }
+        }
+        std::vector<uint8_t> buffer(64 * 1024);
+        std::mt19937_64 rng(7);
+        for (size_t block : {size_t{4 * 1024}, size_t{64 * 1024}}) {
+            std::uniform_int_distribution<size_t> slot(0, fileSize / block - 1);
+            IOFileHandle file(randomPath, FileOpenMode::ReadWrite);
+            measure("fs", "randRead/" + sizeLabel(block), "ops/s", 1.0, [&] {
+                auto offset = static_cast<int64_t>(slot(rng) * block);
+                if (file.readAtInto(offset, buffer.data(), block) != block) {
+                    throw std::runtime_error("Benchmark read came back short: " + randomPath);
+                }
+            });
+            measure("fs", "randWrite/" + sizeLabel(block), "ops/s", 1.0, [&] {
+                auto offset = static_cast<int64_t>(slot(rng) * block);
+                file.writeAt(offset, {data.data(), block});
+            });
+        }
+        fs_.deleteFile(path);
+        fs_.deleteFile(randomPath);
+    }
+
+    auto runListSuite() -> void {
+        std::vector<size_t> counts = options_.quick
+            ? std::vector<size_t>{1000}
+            : std::vector<size_t>{10000, 100000};
+        for (auto count : counts) {
+            auto dir = scratch("list-" + std::to_string(count));
+            fs_.createDirectory(dir, true);
+            for (size_t i = 0; i < count; ++i) {
+                if (i % 1000 == 0) {
+                    checkCancelled();
+                }
+                std::FILE* file = std::fopen((dir + "/f" + std::to_string(i)).c_str(), "wb");
+                if (!file) {
+                    throw std::runtime_error("Cannot create benchmark file in: " + dir);
+                }
+                std::fclose(file);
+            }
+
+            auto label = std::to_string(count / 1000) + "k";
+            auto entries = static_cast<double>(count);
+            measure("list", "listDirectory/" + label, "entries/s", entries, [&] {
+                if (fs_.listDirectory(dir).size() != count) {
+                    throw std::runtime_error("Benchmark listing is incomplete: " + dir);
+                }
+            });
+            measure("list", "listDirectoryColumns/" + label, "entries/s", entries, [&] {
+                (void)fs_.listDirectoryColumns(dir, false, false, false);
+            });
+            measure("list", "listDirectoryColumns+stat/" + label, "entries/s", entries, [&] {
+                (void)fs_.listDirectoryColumns(dir, false, true, true);
+            });
+            fs_.deleteDirectory(dir, true);
+        }
+    }
+
+    auto runHashSuite() -> void {
+        static constexpr std::pair<HashAlgorithm, const char*> kAlgorithms[] = {
+            {HashAlgorithm::MD5, "MD5"},             {HashAlgorithm::SHA1, "SHA1"},
+            {HashAlgorithm::SHA256, "SHA256"},       {HashAlgorithm::SHA3_224, "SHA3_224"},
+            {HashAlgorithm::SHA3_256, "SHA3_256"},   {HashAlgorithm::SHA3_384, "SHA3_384"},
+            {HashAlgorithm::SHA3_512, "SHA3_512"},   {HashAlgorithm::Keccak224, "Keccak224"},
+            {HashAlgorithm::Keccak256, "Keccak256"}, {HashAlgorithm::Keccak384, "Keccak384"},
+            {HashAlgorithm::Keccak512, "Keccak512"}, {HashAlgorithm::CRC32, "CRC32"},
+        };
+        size_t size = options_.quick ? 1024 * 1024 : 16 * 1024 * 1024;
+        auto data = bench_detail::randomBytes(size);
+        for (const auto& [algorithm, name] : kAlgorithms) {
+            measure("hash", name, "MB/s", static_cast<double>(size) / 1e6, [&] {
+                IOHasher hasher(algorithm);
+                hasher.add(data.data(), data.size());
+                (void)hasher.getHash();
+            });
+        }
+    }
+
+    auto runCodecSuite() -> void {
+        using namespace bench_detail;
+        static constexpr std::pair<TextEncoding, const char*> kEncodings[] = {
+            {TextEncoding::Utf8, "utf8"},       {TextEncoding::Ascii, "ascii"},
+            {TextEncoding::Latin1, "latin1"},   {TextEncoding::Utf16le, "utf16le"},
+            {TextEncoding::Base64, "base64"},   {TextEncoding::Hex, "hex"},
+        };
+        size_t size = options_.quick ? 256 * 1024 : 4 * 1024 * 1024;
+
+        for (bool ascii : {true, false}) {
+            auto text = sampleText(size, ascii);
+            const char* kind = ascii ? "ascii" : "mixed";
+            double mb = static_cast<double>(text.size()) / 1e6;
+            for (const auto& [encoding, name] : kEncodings) {
+                // Single-byte targets only have an ASCII fast path worth tracking
+                if (!ascii && (encoding == TextEncoding::Ascii || encoding == TextEncoding::Latin1)) {
+                    continue;
+                }
+                // Binary-to-text encodings go the other way: decoding bytes yields base64/hex text
+                bool binary = encoding == TextEncoding::Base64 || encoding == TextEncoding::Hex;
+                std::string input = text;
+                std::string encoded;
+                if (binary) {
+                    input = decodeText({reinterpret_cast<const uint8_t*>(text.data()), text.size()}, encoding);
+                    encoded = text;
+                } else {
+                    encoded = encodeText(text, encoding);
+                }
+                std::span<const uint8_t> bytes(reinterpret_cast<const uint8_t*>(encoded.data()), encoded.size());
+                auto label = std::string(name) + "/" + kind;
+                // Both rates are in MB of the sample text, so encodings compare directly
+                measure("codec", "encode/" + label, "MB/s", mb, [&] {
+                    (void)encodeText(input, encoding);
+                });
+                measure("codec", "decode/" + label, "MB/s", mb, [&] {
+                    (void)decodeText(bytes, encoding);
+                });
+            }
+        }
+    }
+
+public:
+    explicit BenchmarkRunner(BenchmarkOptions options, CancelCheck isCancelled = {})
+        : options_(std::move(options)), isCancelled_(std::move(isCancelled)) {
+        if (options_.directory.empty()) {
+            throw std::runtime_error("Benchmark directory is required");
+        }
+        options_.directory += "/rn-io-bench";
+    }
+
+    /**
+     * @brief Run the selected suites
+     * @throws std::runtime_error("Operation cancelled") when cancelled
+     */
+    auto run() -> const std::vector<BenchmarkResult>& {
+        results_.clear();
+        fs_.createDirectory(options_.directory, true);
+        try {
+            if (wants("fs")) runFileSuite();
+            if (wants("list")) runListSuite();
+            if (wants("hash")) runHashSuite();
+            if (wants("codec")) runCodecSuite();
+        } catch (...) {
+            std::error_code ec;
+            std::filesystem::remove_all(options_.directory, ec);
+            throw;
+        }
+        fs_.deleteDirectory(options_.directory, true);
+        return results_;
+    }
+
+    [[nodiscard]] auto results() const -> const std::vector<BenchmarkResult>& {
+        return results_;
+    }
+
+    /**
+     * @brief Results as JSON: {"schema", "platform", "arch", "quick", "results": [...]}
+     */
+    [[nodiscard]] auto toJson() const -> std::string {
+        auto number = [](double value) {
+            if (!std::isfinite(value)) {
+                return std::string("0");
+            }
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+            return std::string(buffer);
+        };
+
+#if defined(__ANDROID__)
+        const char* platform = "android";
+#elif defined(__APPLE__) && TARGET_OS_IPHONE
+        const char* platform = "ios";
+#elif defined(__APPLE__)
+        const char* platform = "macos";
+#elif defined(__linux__)
+        const char* platform = "linux";
+#else
+        const char* platform = "unknown";
+#endif
+#if defined(__aarch64__)
+        const char* arch = "arm64";
+#elif defined(__x86_64__)
+        const char* arch = "x86_64";
+#elif defined(__arm__)
+        const char* arch = "arm";
+#elif defined(__i386__)
+        const char* arch = "x86";
+#else
+        const char* arch = "unknown";
+#endif
+
+        // Names and units are fixed ASCII identifiers; nothing needs escaping
+        std::string json = "{\"schema\":1,\"platform\":\"";
+        json += platform;
+        json += "\",\"arch\":\"";
+        json += arch;
+        json += "\",\"quick\":";
+        json += options_.quick ? "true" : "false";
+        json += ",\"results\":[";
+        for (size_t i = 0; i < results_.size(); ++i) {
+            const auto& result = results_[i];
+            json += i == 0 ? "\n" : ",\n";
+            json += "{\"suite\":\"" + result.suite + "\",\"name\":\"" + result.name + "\",\"unit\":\""
+                + result.unit + "\",\"value\":" + number(result.value) + ",\"min\":" + number(result.min)
+                + ",\"max\":" + number(result.max) + ",\"iterations\":" + std::to_string(result.iterations) + "}";
+        }
+        json += "\n]}";
+        return json;
+    }
+};
+
+} // namespace rct_io
+
+#endif // IO_BENCHMARK_HPP
@@ -0,0 +1,142 @@
+/**
+ * @file IODirectoryIterator.hpp
+ * @brief Cursor over the entries of a directory
+ *
+ * Reads a directory in batches instead of collecting every entry up front,
+ * so huge directories can be listed with bounded memory and abandoned early.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_DIRECTORY_ITERATOR_HPP
+#define IO_DIRECTORY_ITERATOR_HPP
+
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "IOFileSystem.hpp"
+
+namespace rct_io {
+
+/**
+ * @brief Batched, optionally recursive directory listing
+ *
+ * Entry types come from the type cached by the OS iterator (d_type) where
+ * available; file sizes cost a stat each and are only fetched on request.
+ *
+ * @note readBatch() is thread-safe; concurrent calls are serialized.
+ */
+class IODirectoryIterator {
+private:
+    std::string path_;
+    bool recursive_;
+    fs::directory_iterator flat_;
+    fs::recursive_directory_iterator deep_;
+    bool done_ = false;
+    std::mutex mutex_;
+
+    template <typename Iterator>
+    auto readFrom(Iterator& it, size_t maxEntries, bool withSize, std::vector<DirectoryEntry>& out) -> void {
+        while (out.size() < maxEntries) {
+            if (it == Iterator()) {
+                done_ = true;
+                return;
+            }
+            out.push_back(detail::makeDirectoryEntry(*it, withSize));
+
+            std::error_code ec;
+            it.increment(ec);
+            if (ec) {
+                done_ = true;
+                throw std::runtime_error("Failed to list directory: " + ec.message());
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Open a directory for iteration
+     * @param path Directory path
+     * @param recursive Descend into subdirectories
+     * @throws std::runtime_error if the directory cannot be opened
+     */
+    IODirectoryIterator(const std::string& path, bool recursive)
+        : path_(path), recursive_(recursive)
+    {
+        std::error_code ec;
+        if (recursive) {
+            deep_ = fs::recursive_directory_iterator(path, ec);
+        } else {
+            flat_ = fs::directory_iterator(path, ec);
+        }
+        if (ec) {
+            throw std::runtime_error("Failed to list directory: " + ec.message());
+        }
+    }
+
+    // Non-copyable
+    IODirectoryIterator(const IODirectoryIterator&) = delete;
+    IODirectoryIterator& operator=(const IODirectoryIterator&) = delete;
+
+    [[nodiscard]] auto getPath() const -> const std::string& {
+        return path_;
+    }
+
+    /**
+     * @brief Read the next entries
+     * @param maxEntries Maximum number of entries to return
+     * @param withSize Fetch file sizes (otherwise size is 0)
+     * @return Up to maxEntries entries, empty once the listing is exhausted
+     */
+    [[nodiscard]] auto readBatch(size_t maxEntries, bool withSize = false) -> std::vector<DirectoryEntry> {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<DirectoryEntry> entries;
+        if (done_) {
+            return entries;
+        }
+        entries.reserve(std::min<size_t>(maxEntries, 4096));
+        if (recursive_) {
+            readFrom(deep_, maxEntries, withSize, entries);
+        } else {
+            readFrom(flat_, maxEntries, withSize, entries);
+        }
+        return entries;
+    }
+
+    /**
+     * @brief Release the OS directory stream(s) early
+     */
+    auto close() -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flat_ = fs::directory_iterator();
+        deep_ = fs::recursive_directory_iterator();
+        done_ = true;
+    }
+};
+
+} // namespace rct_io
+
+#endif // IO_DIRECTORY_ITERATOR_HPP
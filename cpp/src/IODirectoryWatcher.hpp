@@ -0,0 +1,854 @@
+/**
+ * @file IODirectoryWatcher.hpp
+ * @brief Change notifications for a directory (inotify / kqueue)
+ *
+ * A watcher owns one thread that blocks on the kernel's notifications:
+ * inotify on Android, kqueue vnode events on iOS (FSEvents is macOS only;
+ * dispatch vnode sources are kqueue underneath). Changes are coalesced per
+ * path and handed over in batches once the directory has been quiet for
+ * the debounce interval, so a file being written shows up as one event.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_DIRECTORY_WATCHER_HPP
+#define IO_DIRECTORY_WATCHER_HPP
+
+#include "IOStatCache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <sys/event.h>
+#define IO_WATCH_KQUEUE 1
+#elif defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#define IO_WATCH_INOTIFY 1
+#endif
+
+namespace rct_io {
+
+struct WatchEvent {
+    enum class Type : uint8_t {
+        Created = 0,
+        Modified = 1,
+        Deleted = 2,
+        Overflow = 3,   // Changes were lost; list the directory again
+    };
+
+    Type type;
+    std::string path;
+};
+
+[[nodiscard]] inline auto watchEventName(WatchEvent::Type type) -> const char* {
+    switch (type) {
+        case WatchEvent::Type::Created: return "created";
+        case WatchEvent::Type::Modified: return "modified";
+        case WatchEvent::Type::Deleted: return "deleted";
+        case WatchEvent::Type::Overflow: return "overflow";
+    }
+    return "overflow";
+}
+
+struct WatchOptions {
+    bool recursive = false;
+    int64_t debounceMs = 100;     // Quiet time before a batch goes out
+    int64_t maxLatencyMs = 1000;  // Longest an event waits while changes keep coming
+};
+
+namespace watch_detail {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Pending events, one per path in order of first change
+ *
+ * A file created and written is Created, created and deleted again is
+ * nothing, deleted and recreated is Modified.
+ */
+class EventBatch {
+public:
+    /// Distinct paths after which a batch collapses into one Overflow event:
+    /// listing the directory again is cheaper than marshalling them all
+    static constexpr size_t kMaxEvents = 4096;
+
+private:
+    struct Slot {
+        WatchEvent event;
+        bool live;
+    };
+
+    std::vector<Slot> slots_;
+    std::unordered_map<std::string, size_t> index_;
+    bool overflow_ = false;
+    std::string root_;
+
+public:
+    explicit EventBatch(std::string root) : root_(std::move(root)) {}
+
+    [[nodiscard]] auto empty() const -> bool { return !overflow_ && index_.empty(); }
+
+    auto add(WatchEvent::Type type, const std::string& path) -> void {
+        using Type = WatchEvent::Type;
+        if (type == Type::Overflow || (index_.size() >= kMaxEvents && index_.count(path) == 0)) {
+            overflow_ = true;
+            slots_.clear();
+            index_.clear();
+            return;
+        }
+        if (overflow_) {
+            return;
+        }
+        auto [it, inserted] = index_.try_emplace(path, slots_.size());
+        if (inserted) {
+            slots_.push_back({{type, path}, true});
+            return;
+        }
+        auto& slot = slots_[it->second];
+        if (!slot.live) {
+            slot.event.type = type;
+            slot.live = true;
+            return;
+        }
+        switch (slot.event.type) {
+            case Type::Created:
+                slot.live = type != Type::Deleted;
+                break;
+            case Type::Modified:
+                slot.event.type = type == Type::Deleted ? Type::Deleted : Type::Modified;
+                break;
+            case Type::Deleted:
+                slot.event.type = type == Type::Deleted ? Type::Deleted : Type::Modified;
+                break;
+            case Type::Overflow:
+                break;
+        }
+    }
+
+    auto take() -> std::vector<WatchEvent> {
+        std::vector<WatchEvent> events;
+        if (overflow_) {
+            events.push_back({WatchEvent::Type::Overflow, root_});
+        } else {
+            events.reserve(slots_.size());
+            for (auto& slot : slots_) {
+                if (slot.live) {
+                    events.push_back(std::move(slot.event));
+                }
+            }
+        }
+        slots_.clear();
+        index_.clear();
+        overflow_ = false;
+        return events;
+    }
+};
+
+/**
+ * @brief What the backends report to: the batch, its timing, and the stat cache
+ */
+class Recorder {
+private:
+    EventBatch batch_;
+    Clock::time_point first_{};
+    Clock::time_point last_{};
+
+public:
+    explicit Recorder(const std::string& root) : batch_(root) {}
+
+    auto record(WatchEvent::Type type, const std::string& path, bool directory = false) -> void {
+        auto now = Clock::now();
+        if (batch_.empty()) {
+            first_ = now;
+        }
+        last_ = now;
+        batch_.add(type, path);
+        // Changes made outside this library must not be answered from the cache
+        if (directory) {
+            StatCache::instance().invalidateTree(path);
+        } else if (type != WatchEvent::Type::Overflow) {
+            StatCache::instance().invalidate(path);
+        } else {
+            StatCache::instance().clear();
+        }
+    }
+
+    [[nodiscard]] auto empty() const -> bool { return batch_.empty(); }
+
+    /** @brief When the batch should go out: after a quiet interval, or at the latest maxLatency after its first event */
+    [[nodiscard]] auto due(const WatchOptions& options) const -> Clock::time_point {
+        return std::min(last_ + std::chrono::milliseconds(options.debounceMs),
+                        first_ + std::chrono::milliseconds(std::max(options.maxLatencyMs, options.debounceMs)));
+    }
+
+    auto take() -> std::vector<WatchEvent> { return batch_.take(); }
+};
+
+inline auto joinPath(const std::string& dir, const char* name) -> std::string {
+    return dir == "/" ? dir + name : dir + "/" + name;
+}
+
+/** @brief Self-pipe that interrupts a backend's wait */
+class WakePipe {
+private:
+    int fds_[2] = {-1, -1};
+
+public:
+    WakePipe() {
+        if (::pipe(fds_) != 0) {
+            throw std::runtime_error(std::string("watch: cannot create pipe (") + std::strerror(errno) + ")");
+        }
+        for (int fd : fds_) {
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        }
+    }
+
+    ~WakePipe() {
+        ::close(fds_[0]);
+        ::close(fds_[1]);
+    }
+
+    WakePipe(const WakePipe&) = delete;
+    WakePipe& operator=(const WakePipe&) = delete;
+
+    [[nodiscard]] auto fd() const -> int { return fds_[0]; }
+
+    auto wake() -> void {
+        char byte = 1;
+        (void)!::write(fds_[1], &byte, 1);  // A full pipe is already awake
+    }
+
+    auto drain() -> void {
+        char buffer[64];
+        while (::read(fds_[0], buffer, sizeof(buffer)) > 0) {
+        }
+    }
+};
+
+/** @brief Names of the subdirectories of a directory, symlinks excluded */
+inline auto subdirectories(const std::string& path) -> std::vector<std::string> {
+    std::vector<std::string> result;
+    DIR* dir = ::opendir(path.c_str());
+    if (!dir) {
+        return result;
+    }
+    while (auto* entry = ::readdir(dir)) {
+        if (std::strcmp(entry->d_name, ".") == 0 || std::strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        bool isDir = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat st {};
+            isDir = ::fstatat(::dirfd(dir), entry->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+        }
+        if (isDir) {
+            result.emplace_back(entry->d_name);
+        }
+    }
+    ::closedir(dir);
+    return result;
+}
+
+#if defined(IO_WATCH_INOTIFY)
+
+/**
+ * @brief inotify: one watch per directory, events name the changed entry
+ */
+class Backend {
+private:
+    static constexpr uint32_t kMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB
+        | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+    std::string root_;
+    bool recursive_;
+    Recorder& recorder_;
+    WakePipe wake_;
+    int fd_ = -1;
+    int rootWatch_ = -1;
+    std::unordered_map<int, std::string> directories_;  // Watch descriptor -> path
+
+    auto addWatch(const std::string& path, uint32_t extra) -> int {
+        int wd = ::inotify_add_watch(fd_, path.c_str(), kMask | extra);
+        if (wd >= 0) {
+            directories_[wd] = path;
+        }
+        return wd;
+    }
+
+    /**
+     * @brief Watch a new subdirectory and below
+     *
+     * Entries created before their directory's watch existed are reported
+     * as Created here; the kernel never will.
+     */
+    auto addTree(const std::string& path, bool report) -> void {
+        if (addWatch(path, IN_DONT_FOLLOW) < 0) {
+            if (errno == ENOSPC) {
+                recorder_.record(WatchEvent::Type::Overflow, root_);  // Out of watches (max_user_watches)
+            }
+            return;
+        }
+        if (report) {
+            DIR* dir = ::opendir(path.c_str());
+            if (dir) {
+                while (auto* entry = ::readdir(dir)) {
+                    if (std::strcmp(entry->d_name, ".") != 0 && std::strcmp(entry->d_name, "..") != 0) {
+                        recorder_.record(WatchEvent::Type::Created, joinPath(path, entry->d_name));
+                    }
+                }
+                ::closedir(dir);
+            }
+        }
+        for (const auto& name : subdirectories(path)) {
+            addTree(joinPath(path, name.c_str()), report);
+        }
+    }
+
+    /** @brief Stop watching a directory that moved away, and everything below it */
+    auto removeTree(const std::string& path) -> void {
+        auto prefix = path + "/";
+        for (auto it = directories_.begin(); it != directories_.end();) {
+            if (it->second == path || it->second.compare(0, prefix.size(), prefix) == 0) {
+                ::inotify_rm_watch(fd_, it->first);
+                it = directories_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    auto handle(const struct inotify_event& event) -> void {
+        if (event.mask & IN_Q_OVERFLOW) {
+            recorder_.record(WatchEvent::Type::Overflow, root_);
+            return;
+        }
+        auto it = directories_.find(event.wd);
+        if (it == directories_.end()) {
+            return;
+        }
+        if (event.mask & IN_IGNORED) {
+            directories_.erase(it);
+            return;
+        }
+        if (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+            // A subdirectory's removal is reported by its parent
+            if (event.wd == rootWatch_) {
+                recorder_.record(WatchEvent::Type::Deleted, root_, true);
+                removeTree(root_);
+            }
+            return;
+        }
+        if (event.len == 0 || event.name[0] == '\0') {
+            return;  // The watched directory's own attributes
+        }
+        auto path = joinPath(it->second, event.name);
+        bool isDir = (event.mask & IN_ISDIR) != 0;
+        if (event.mask & (IN_CREATE | IN_MOVED_TO)) {
+            recorder_.record(WatchEvent::Type::Created, path, isDir);
+            if (isDir && recursive_) {
+                addTree(path, true);
+            }
+        } else if (event.mask & (IN_DELETE | IN_MOVED_FROM)) {
+            recorder_.record(WatchEvent::Type::Deleted, path, isDir);
+            if (isDir && recursive_ && (event.mask & IN_MOVED_FROM)) {
+                removeTree(path);
+            }
+        } else if (!isDir && (event.mask & (IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB))) {
+            recorder_.record(WatchEvent::Type::Modified, path);
+        }
+    }
+
+    auto readEvents() -> void {
+        alignas(struct inotify_event) char buffer[16 * 1024];
+        while (true) {
+            ssize_t n = ::read(fd_, buffer, sizeof(buffer));
+            if (n <= 0) {
+                return;  // EAGAIN: drained
+            }
+            for (char* p = buffer; p < buffer + n;) {
+                const auto* event = reinterpret_cast<const struct inotify_event*>(p);
+                handle(*event);
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+    }
+
+public:
+    Backend(const std::string& root, bool recursive, Recorder& recorder)
+        : root_(root), recursive_(recursive), recorder_(recorder) {
+        fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd_ < 0) {
+            throw std::runtime_error(std::string("watch: inotify unavailable (") + std::strerror(errno) + ")");
+        }
+        rootWatch_ = addWatch(root_, 0);
+        if (rootWatch_ < 0) {
+            auto error = errno;
+            ::close(fd_);
+            throw std::runtime_error("watch: cannot watch " + root_ + " (" + std::strerror(error) + ")");
+        }
+        if (recursive_) {
+            for (const auto& name : subdirectories(root_)) {
+                addTree(joinPath(root_, name.c_str()), false);
+            }
+        }
+    }
+
+    ~Backend() {
+        ::close(fd_);  // Drops every watch
+    }
+
+    Backend(const Backend&) = delete;
+    Backend& operator=(const Backend&) = delete;
+
+    auto wake() -> void { wake_.wake(); }
+
+    /** @brief Block until changes arrive, wake() is called, or the timeout (-1 = none) runs out */
+    auto wait(int timeoutMs) -> void {
+        struct pollfd fds[2] = {{fd_, POLLIN, 0}, {wake_.fd(), POLLIN, 0}};
+        if (::poll(fds, 2, timeoutMs) <= 0) {
+            return;  // Timeout or EINTR
+        }
+        if (fds[1].revents) {
+            wake_.drain();
+        }
+        if (fds[0].revents) {
+            readEvents();
+        }
+    }
+};
+
+#elif defined(IO_WATCH_KQUEUE)
+
+/**
+ * @brief kqueue: vnode events on an fd per directory and file
+ *
+ * A directory event only says that its entries changed, so every watched
+ * directory keeps a snapshot of them to tell what was created, deleted or
+ * replaced. Files get their own fd for content changes, up to
+ * kMaxWatchedFiles; past that, writes to a file are noticed when they
+ * change its directory's snapshot (size or modification time) on the next
+ * directory event.
+ */
+class Backend {
+private:
+    static constexpr size_t kMaxWatchedFiles = 1024;
+    static constexpr uint32_t kDirectoryFlags = NOTE_WRITE | NOTE_DELETE | NOTE_RENAME | NOTE_REVOKE;
+    static constexpr uint32_t kFileFlags = NOTE_WRITE | NOTE_EXTEND | NOTE_ATTRIB | NOTE_DELETE | NOTE_RENAME | NOTE_REVOKE;
+
+    struct EntryStat {
+        bool directory = false;
+        uint64_t inode = 0;
+        int64_t size = 0;
+        int64_t modifiedNs = 0;
+    };
+
+    struct Node {
+        std::string path;
+        bool directory = false;
+        std::unordered_map<std::string, EntryStat> entries;  // Directories only
+    };
+
+    std::string root_;
+    bool recursive_;
+    Recorder& recorder_;
+    WakePipe wake_;
+    int kq_ = -1;
+    size_t watchedFiles_ = 0;
+    std::unordered_map<int, Node> nodes_;         // fd -> node
+    std::unordered_map<std::string, int> byPath_; // path -> fd
+
+    static auto scan(const std::string& path) -> std::unordered_map<std::string, EntryStat> {
+        std::unordered_map<std::string, EntryStat> entries;
+        DIR* dir = ::opendir(path.c_str());
+        if (!dir) {
+            return entries;
+        }
+        while (auto* entry = ::readdir(dir)) {
+            if (std::strcmp(entry->d_name, ".") == 0 || std::strcmp(entry->d_name, "..") == 0) {
+                continue;
+            }
+            struct stat st {};
+            if (::fstatat(::dirfd(dir), entry->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                continue;  // Gone already
+            }
+            entries[entry->d_name] = {
+                S_ISDIR(st.st_mode),
+                static_cast<uint64_t>(st.st_ino),
+                static_cast<int64_t>(st.st_size),
+                static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec
+            };
+        }
+        ::closedir(dir);
+        return entries;
+    }
+
+    auto open(const std::string& path, bool directory) -> int {
+        int fd = ::open(path.c_str(), O_EVTONLY | O_CLOEXEC | (directory ? O_DIRECTORY : 0));
+        if (fd < 0) {
+            return -1;
+        }
+        struct kevent change;
+        EV_SET(&change, fd, EVFILT_VNODE, EV_ADD | EV_CLEAR, directory ? kDirectoryFlags : kFileFlags, 0, nullptr);
+        if (::kevent(kq_, &change, 1, nullptr, 0, nullptr) != 0) {
+            ::close(fd);
+            return -1;
+        }
+        nodes_[fd] = {path, directory, {}};
+        byPath_[path] = fd;
+        return fd;
+    }
+
+    auto unwatch(const std::string& path) -> void {
+        auto it = byPath_.find(path);
+        if (it == byPath_.end()) {
+            return;
+        }
+        auto node = nodes_.find(it->second);
+        if (!node->second.directory) {
+            --watchedFiles_;
+        }
+        ::close(it->second);  // Drops its kevent
+        nodes_.erase(node);
+        byPath_.erase(it);
+    }
+
+    auto unwatchTree(const std::string& path) -> void {
+        auto prefix = path + "/";
+        std::vector<std::string> paths;
+        for (const auto& [watched, fd] : byPath_) {
+            if (watched == path || watched.compare(0, prefix.size(), prefix) == 0) {
+                paths.push_back(watched);
+            }
+        }
+        for (const auto& watched : paths) {
+            unwatch(watched);
+        }
+    }
+
+    auto watchFile(const std::string& path) -> void {
+        if (watchedFiles_ < kMaxWatchedFiles && byPath_.count(path) == 0 && open(path, false) >= 0) {
+            ++watchedFiles_;
+        }
+    }
+
+    /** @brief Watch a directory (and, if recursive, below); report its entries as Created if it is new */
+    auto watchDirectory(const std::string& path, bool report) -> void {
+        int fd = open(path, true);
+        if (fd < 0) {
+            if (errno == EMFILE || errno == ENFILE) {
+                recorder_.record(WatchEvent::Type::Overflow, root_);
+            }
+            return;
+        }
+        // Snapshot after the fd is registered, so no change falls in between
+        auto entries = scan(path);
+        for (const auto& [name, entry] : entries) {
+            auto child = joinPath(path, name.c_str());
+            if (report) {
+                recorder_.record(WatchEvent::Type::Created, child, entry.directory);
+            }
+            if (!entry.directory) {
+                watchFile(child);
+            } else if (recursive_) {
+                watchDirectory(child, report);
+            }
+        }
+        nodes_[fd].entries = std::move(entries);
+    }
+
+    /** @brief Compare a directory with its snapshot */
+    auto rescan(int fd) -> void {
+        auto path = nodes_[fd].path;
+        auto entries = scan(path);
+        auto previous = std::move(nodes_[fd].entries);
+        for (const auto& [name, old] : previous) {
+            if (entries.count(name) == 0) {
+                auto child = joinPath(path, name.c_str());
+                recorder_.record(WatchEvent::Type::Deleted, child, old.directory);
+                unwatchTree(child);
+            }
+        }
+        for (const auto& [name, entry] : entries) {
+            auto child = joinPath(path, name.c_str());
+            auto old = previous.find(name);
+            if (old == previous.end()) {
+                recorder_.record(WatchEvent::Type::Created, child, entry.directory);
+                if (!entry.directory) {
+                    watchFile(child);
+                } else if (recursive_) {
+                    watchDirectory(child, true);
+                }
+                continue;
+            }
+            const auto& before = old->second;
+            if (before.directory != entry.directory || before.inode != entry.inode) {
+                // Replaced, e.g. by an atomic rename: the old fd watches the old inode
+                recorder_.record(WatchEvent::Type::Modified, child, before.directory || entry.directory);
+                unwatchTree(child);
+                if (!entry.directory) {
+                    watchFile(child);
+                } else if (recursive_) {
+                    watchDirectory(child, true);
+                }
+            } else if (!entry.directory && (before.size != entry.size || before.modifiedNs != entry.modifiedNs)) {
+                recorder_.record(WatchEvent::Type::Modified, child);
+                watchFile(child);  // In case its fd was dropped
+            }
+        }
+        // A nested rescan may have replaced the map entry; look it up again
+        if (auto it = nodes_.find(fd); it != nodes_.end()) {
+            it->second.entries = std::move(entries);
+        }
+    }
+
+    auto handle(const struct kevent& event) -> void {
+        int fd = static_cast<int>(event.ident);
+        auto it = nodes_.find(fd);
+        if (it == nodes_.end()) {
+            return;
+        }
+        auto flags = event.fflags;
+        if (it->second.directory) {
+            if (flags & (NOTE_DELETE | NOTE_RENAME | NOTE_REVOKE)) {
+                // A subdirectory's removal shows up in its parent's snapshot
+                if (it->second.path == root_) {
+                    recorder_.record(WatchEvent::Type::Deleted, root_, true);
+                    unwatchTree(root_);
+                }
+                return;
+            }
+            if (flags & NOTE_WRITE) {
+                rescan(fd);
+            }
+            return;
+        }
+        if (flags & (NOTE_WRITE | NOTE_EXTEND | NOTE_ATTRIB)) {
+            recorder_.record(WatchEvent::Type::Modified, it->second.path);
+        }
+        if (flags & (NOTE_DELETE | NOTE_RENAME | NOTE_REVOKE)) {
+            unwatch(it->second.path);  // The directory event reports what happened to the name
+        }
+    }
+
+public:
+    Backend(const std::string& root, bool recursive, Recorder& recorder)
+        : root_(root), recursive_(recursive), recorder_(recorder) {
+        kq_ = ::kqueue();
+        if (kq_ < 0) {
+            throw std::runtime_error(std::string("watch: kqueue unavailable (") + std::strerror(errno) + ")");
+        }
+        struct kevent change;
+        EV_SET(&change, wake_.fd(), EVFILT_READ, EV_ADD, 0, 0, nullptr);
+        ::kevent(kq_, &change, 1, nullptr, 0, nullptr);
+        int fd = open(root_, true);
+        if (fd < 0) {
+            auto error = errno;
+            ::close(kq_);
+            throw std::runtime_error("watch: cannot watch " + root_ + " (" + std::strerror(error) + ")");
+        }
+        auto entries = scan(root_);
+        for (const auto& [name, entry] : entries) {
+            auto child = joinPath(root_, name.c_str());
+            if (!entry.directory) {
+                watchFile(child);
+            } else if (recursive_) {
+                watchDirectory(child, false);
+            }
+        }
+        nodes_[fd].entries = std::move(entries);
+    }
+
+    ~Backend() {
+        for (const auto& [fd, node] : nodes_) {
+            ::close(fd);
+        }
+        ::close(kq_);
+    }
+
+    Backend(const Backend&) = delete;
+    Backend& operator=(const Backend&) = delete;
+
+    auto wake() -> void { wake_.wake(); }
+
+    /** @brief Block until changes arrive, wake() is called, or the timeout (-1 = none) runs out */
+    auto wait(int timeoutMs) -> void {
+        struct kevent events[64];
+        struct timespec timeout {timeoutMs / 1000, (timeoutMs % 1000) * 1000000L};
+        int n = ::kevent(kq_, nullptr, 0, events, 64, timeoutMs < 0 ? nullptr : &timeout);
+        for (int i = 0; i < n; ++i) {
+            if (events[i].filter == EVFILT_READ) {
+                wake_.drain();
+            } else {
+                handle(events[i]);
+            }
+        }
+    }
+};
+
+#endif
+
+} // namespace watch_detail
+
+/**
+ * @brief Watches a directory on a thread of its own
+ *
+ * The sink receives each batch on the watcher thread, together with a done
+ * callback; the next batch is held back (and keeps coalescing) until done
+ * has been called, so a slow consumer gets fewer, larger batches instead
+ * of a queue of them.
+ */
+class IODirectoryWatcher : public std::enable_shared_from_this<IODirectoryWatcher> {
+public:
+    using Sink = std::function<void(std::vector<WatchEvent>&& events, std::function<void()> done)>;
+
+#if defined(IO_WATCH_INOTIFY) || defined(IO_WATCH_KQUEUE)
+private:
+    std::string path_;
+    WatchOptions options_;
+    Sink sink_;
+    watch_detail::Recorder recorder_;
+    watch_detail::Backend backend_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> delivering_{false};
+    std::thread thread_;
+
+    static auto normalize(const std::string& path) -> std::string {
+        auto normal = std::filesystem::path(path).lexically_normal().string();
+        while (normal.size() > 1 && normal.back() == '/') {
+            normal.pop_back();
+        }
+        return normal;
+    }
+
+    IODirectoryWatcher(std::string path, const WatchOptions& options, Sink sink)
+        : path_(std::move(path))
+        , options_(options)
+        , sink_(std::move(sink))
+        , recorder_(path_)
+        , backend_(path_, options.recursive, recorder_) {}
+
+    auto deliver() -> void {
+        auto events = recorder_.take();
+        if (events.empty()) {
+            return;  // Everything cancelled out
+        }
+        delivering_.store(true, std::memory_order_release);
+        sink_(std::move(events), [weak = weak_from_this()] {
+            if (auto self = weak.lock()) {
+                self->delivering_.store(false, std::memory_order_release);
+                self->backend_.wake();
+            }
+        });
+    }
+
+    auto run() -> void {
+        while (!stopping_.load(std::memory_order_acquire)) {
+            int timeoutMs = -1;
+            if (!recorder_.empty() && !delivering_.load(std::memory_order_acquire)) {
+                auto now = watch_detail::Clock::now();
+                auto due = recorder_.due(options_);
+                if (now >= due) {
+                    deliver();
+                    continue;
+                }
+                auto wait = std::chrono::ceil<std::chrono::milliseconds>(due - now).count();
+                timeoutMs = static_cast<int>(std::max<int64_t>(wait, 1));
+            }
+            backend_.wait(timeoutMs);
+        }
+    }
+
+public:
+    /**
+     * @brief Start watching a directory
+     * @throws std::runtime_error if the path is not a directory or cannot be watched
+     */
+    static auto open(const std::string& path, const WatchOptions& options, Sink sink)
+        -> std::shared_ptr<IODirectoryWatcher> {
+        auto root = normalize(path);
+        if (statFile(root).kind != FileStat::Kind::Directory) {
+            throw std::runtime_error("watch: not a directory: " + path);
+        }
+        std::shared_ptr<IODirectoryWatcher> watcher(new IODirectoryWatcher(root, options, std::move(sink)));
+        // Started here, not in the constructor, so done callbacks can find the watcher
+        watcher->thread_ = std::thread([raw = watcher.get()] { raw->run(); });
+        return watcher;
+    }
+
+    ~IODirectoryWatcher() {
+        close();
+    }
+
+    IODirectoryWatcher(const IODirectoryWatcher&) = delete;
+    IODirectoryWatcher& operator=(const IODirectoryWatcher&) = delete;
+
+    [[nodiscard]] auto path() const -> const std::string& { return path_; }
+
+    /** @brief Stop watching; events that have not been delivered are dropped. Idempotent */
+    auto close() -> void {
+        stopping_.store(true, std::memory_order_release);
+        backend_.wake();
+        if (thread_.joinable()) {
+            if (thread_.get_id() == std::this_thread::get_id()) {
+                thread_.detach();  // Released from within the sink
+            } else {
+                thread_.join();
+            }
+        }
+    }
+#else
+public:
+    static auto open(const std::string&, const WatchOptions&, Sink) -> std::shared_ptr<IODirectoryWatcher> {
+        throw std::runtime_error("watch: not supported on this platform");
+    }
+
+    [[nodiscard]] auto path() const -> const std::string& {
+        static const std::string empty;
+        return empty;
+    }
+
+    auto close() -> void {}
+#endif
+};
+
+} // namespace rct_io
+
+#endif // IO_DIRECTORY_WATCHER_HPP
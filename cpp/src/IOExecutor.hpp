@@ -0,0 +1,242 @@
+/**
+ * @file IOExecutor.hpp
+ * @brief Process-wide task executor with separate lanes
+ *
+ * All host objects share one set of thread pools, one per kind of work, so
+ * a long hash does not delay a small read and the process does not create
+ * a new pool per FileSystem or Request instance.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_EXECUTOR_HPP
+#define IO_EXECUTOR_HPP
+
+#include "BS_thread_pool.hpp"
+#include "JSIHostObjectBase.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+namespace rct_io {
+
+/**
+ * @brief Kind of work, each served by its own thread pool
+ */
+enum class ExecutorLane : int {
+    Interactive = 0,  // Small latency-sensitive I/O (stat, small reads/writes)
+    Bulk = 1,         // Large copies, recursive listings and deletes
+    Compute = 2,      // CPU-bound work (hashing)
+    Network = 3,      // Blocking HTTP transfers
+};
+
+inline constexpr size_t kExecutorLaneCount = 4;
+
+/**
+ * @brief Load of one lane, for the instrumentation in getStats()
+ */
+struct LaneStats {
+    size_t threads = 0;
+    size_t queued = 0;      // Waiting for a thread now
+    size_t running = 0;     // Running now
+    size_t peakQueued = 0;  // Most ever waiting, while statistics are enabled
+};
+
+/**
+ * @brief Thread count per lane (0 = keep the current value)
+ */
+struct ExecutorConfig {
+    std::array<size_t, kExecutorLaneCount> threads{};
+
+    /**
+     * @brief Defaults sized for mobile SoCs
+     *
+     * Compute gets half the cores, which roughly matches the number of
+     * performance cores on big.LITTLE designs; the I/O and network lanes
+     * mostly block in the kernel and need few threads.
+     */
+    [[nodiscard]] static auto defaults() -> ExecutorConfig {
+        size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        ExecutorConfig config;
+        config.threads = {2, 2, std::max<size_t>(1, cores / 2), 4};
+        return config;
+    }
+};
+
+/**
+ * @brief Priority thread pools shared by all host objects
+ *
+ * instance() returns the current executor. configure() only affects host
+ * objects created afterwards; existing ones keep their pools until they
+ * are released.
+ */
+class SharedExecutor {
+private:
+    std::array<std::unique_ptr<BS::priority_thread_pool>, kExecutorLaneCount> pools_;
+    std::array<std::atomic<size_t>, kExecutorLaneCount> peakQueued_{};
+
+    static inline std::mutex instanceMutex_;
+    static inline std::shared_ptr<SharedExecutor> instance_;
+    static inline ExecutorConfig config_ = ExecutorConfig::defaults();
+
+    [[nodiscard]] static auto laneIndex(ExecutorLane lane) -> size_t {
+        auto idx = static_cast<size_t>(lane);
+        return idx < kExecutorLaneCount ? idx : 0;
+    }
+
+    [[nodiscard]] auto pool(ExecutorLane lane) const -> BS::priority_thread_pool& {
+        return *pools_[laneIndex(lane)];
+    }
+
+public:
+    explicit SharedExecutor(const ExecutorConfig& config) {
+        for (size_t i = 0; i < kExecutorLaneCount; ++i) {
+            pools_[i] = std::make_unique<BS::priority_thread_pool>(std::max<size_t>(1, config.threads[i]));
+        }
+    }
+
+    SharedExecutor(const SharedExecutor&) = delete;
+    SharedExecutor& operator=(const SharedExecutor&) = delete;
+
+    /**
+     * @brief The process-wide executor (created on first use)
+     */
+    [[nodiscard]] static auto instance() -> std::shared_ptr<SharedExecutor> {
+        std::lock_guard<std::mutex> lock(instanceMutex_);
+        if (!instance_) {
+            instance_ = std::make_shared<SharedExecutor>(config_);
+        }
+        return instance_;
+    }
+
+    /**
+     * @brief Change thread counts for host objects created from now on
+     *
+     * If nothing else holds the previous executor, it is released on a
+     * detached thread: destroying its pools waits for their queued tasks,
+     * which must not happen on the calling (JS) thread.
+     *
+     * @param config Threads per lane; lanes set to 0 keep their current count
+     */
+    static auto configure(const ExecutorConfig& config) -> void {
+        std::shared_ptr<SharedExecutor> previous;
+        {
+            std::lock_guard<std::mutex> lock(instanceMutex_);
+            for (size_t i = 0; i < kExecutorLaneCount; ++i) {
+                if (config.threads[i] > 0) {
+                    config_.threads[i] = config.threads[i];
+                }
+            }
+            previous = std::move(instance_);
+        }
+        if (previous) {
+            try {
+                std::thread([previous = std::move(previous)]() mutable { previous.reset(); }).detach();
+            } catch (const std::system_error&) {
+                // No thread available; previous is released here instead
+            }
+        }
+    }
+
+    /**
+     * @brief Queue a task on a lane
+     * @param priority Higher starts first, clamped to [-128, 127]
+     */
+    auto submit(ExecutorLane lane, std::function<void()>&& task, int priority = 0) -> void {
+        auto pr = static_cast<BS::priority_t>(std::clamp(priority, -128, 127));
+        auto& target = pool(lane);
+        target.detach_task(std::move(task), pr);
+        if (jsi_utils::MethodStatsRegistry::instance().enabled()) {
+            auto& peak = peakQueued_[laneIndex(lane)];
+            auto queued = target.get_tasks_queued();
+            auto seen = peak.load(std::memory_order_relaxed);
+            while (queued > seen && !peak.compare_exchange_weak(seen, queued, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    [[nodiscard]] auto laneStats(ExecutorLane lane) const -> LaneStats {
+        const auto& target = pool(lane);
+        LaneStats stats;
+        stats.threads = target.get_thread_count();
+        stats.queued = target.get_tasks_queued();
+        stats.running = target.get_tasks_running();
+        stats.peakQueued = peakQueued_[laneIndex(lane)].load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    auto resetPeaks() -> void {
+        for (auto& peak : peakQueued_) {
+            peak.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] auto threadCount(ExecutorLane lane) const -> size_t {
+        return pool(lane).get_thread_count();
+    }
+};
+
+/**
+ * @brief TaskExecutor view of the shared executor for one host object
+ *
+ * Tasks without a lane hint go to the host object's default lane.
+ */
+class LaneExecutor : public jsi_utils::TaskExecutor {
+private:
+    std::shared_ptr<SharedExecutor> shared_;
+    ExecutorLane defaultLane_;
+
+    [[nodiscard]] auto toLane(int lane) const -> ExecutorLane {
+        return lane < 0 || lane >= static_cast<int>(kExecutorLaneCount)
+            ? defaultLane_
+            : static_cast<ExecutorLane>(lane);
+    }
+
+public:
+    LaneExecutor(std::shared_ptr<SharedExecutor> shared, ExecutorLane defaultLane)
+        : shared_(std::move(shared)), defaultLane_(defaultLane) {}
+
+    void execute(std::function<void()>&& task) override {
+        shared_->submit(defaultLane_, std::move(task));
+    }
+
+    void execute(std::function<void()>&& task, const jsi_utils::TaskOptions& options) override {
+        shared_->submit(toLane(options.lane), std::move(task), options.priority);
+    }
+
+    size_t concurrency() const override {
+        return shared_->threadCount(defaultLane_);
+    }
+
+    size_t concurrency(int lane) const override {
+        return shared_->threadCount(toLane(lane));
+    }
+};
+
+} // namespace rct_io
+
+#endif // IO_EXECUTOR_HPP
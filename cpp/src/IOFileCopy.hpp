@@ -0,0 +1,374 @@
+/**
+ * @file IOFileCopy.hpp
+ * @brief Fast whole-file copy
+ *
+ * Copies a file with the cheapest mechanism the platform offers:
+ * copy-on-write cloning (clonefile on APFS, FICLONE on Linux), then an
+ * in-kernel copy (copy_file_range, sendfile), then a large-buffer
+ * read/write loop.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_FILE_COPY_HPP
+#define IO_FILE_COPY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "IOHasher.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__APPLE__)
+#include <sys/clonefile.h>
+#elif defined(__linux__)
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#ifndef FICLONE
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+#endif
+
+namespace rct_io {
+
+/**
+ * @brief How copyFileFast() copied the data
+ */
+enum class CopyMethod : int {
+    Clone = 0,      // Copy-on-write clone, no data copied
+    Kernel = 1,     // copy_file_range / sendfile
+    ReadWrite = 2,  // Userspace loop
+};
+
+namespace detail {
+
+/// Bytes per in-kernel copy call; also the progress and cancellation granularity
+inline constexpr size_t kCopyChunkSize = 8 * 1024 * 1024;
+
+/// Buffer size of the userspace fallback
+inline constexpr size_t kCopyBufferSize = 1024 * 1024;
+
+[[noreturn]] inline void throwCopyError(const char* what) {
+    throw std::runtime_error(std::string("Failed to copy file: ") + what);
+}
+
+#ifndef _WIN32
+
+/**
+ * @brief Closes a descriptor when it goes out of scope
+ */
+struct ScopedFd {
+    int fd = -1;
+
+    explicit ScopedFd(int f) : fd(f) {}
+    ~ScopedFd() {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+    ScopedFd(const ScopedFd&) = delete;
+    ScopedFd& operator=(const ScopedFd&) = delete;
+
+    /** @brief Close now and report errors (write-back failures show up here) */
+    auto close() -> int {
+        int result = ::close(fd);
+        fd = -1;
+        return result;
+    }
+};
+
+inline auto writeFully(int fd, const uint8_t* data, size_t size) -> void {
+    size_t total = 0;
+    while (total < size) {
+        auto n = ::write(fd, data + total, size - total);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwCopyError(std::strerror(errno));
+        }
+        total += static_cast<size_t>(n);
+    }
+}
+
+/**
+ * @brief Copy up to size bytes from the current offset of in to out
+ *
+ * Starts with copy_file_range and steps down to sendfile and then to a
+ * read/write loop whenever the kernel or filesystem rejects a method
+ * (old kernel, cross-filesystem copy, seccomp filter). All methods use and
+ * advance the descriptors' file offsets, so switching mid-copy is safe.
+ */
+inline auto copyFileData(
+    int in, int out, uint64_t size, CopyMethod& method,
+    const HashProgressCallback& onProgress, const CancelCheck& isCancelled
+) -> uint64_t {
+#if defined(__linux__)
+    enum class Step { CopyRange, SendFile, ReadWrite };
+#ifdef __NR_copy_file_range
+    auto step = Step::CopyRange;
+#else
+    auto step = Step::SendFile;
+#endif
+#endif
+    std::vector<uint8_t> buffer;
+    uint64_t copied = 0;
+
+    while (copied < size) {
+        if (isCancelled && isCancelled()) {
+            throw std::runtime_error("Operation cancelled");
+        }
+        auto want = static_cast<size_t>(std::min<uint64_t>(kCopyChunkSize, size - copied));
+        ssize_t n = -1;
+
+#if defined(__linux__)
+        if (step == Step::CopyRange) {
+#ifdef __NR_copy_file_range
+            // Called through syscall(): bionic has no wrapper before API 34
+            n = static_cast<ssize_t>(::syscall(__NR_copy_file_range, in, nullptr, out, nullptr, want, 0u));
+#endif
+            if (n < 0 && errno != EINTR) {
+                if (errno == ENOSYS || errno == EXDEV || errno == EINVAL
+                    || errno == EOPNOTSUPP || errno == EPERM) {
+                    step = Step::SendFile;
+                    continue;
+                }
+            }
+            method = CopyMethod::Kernel;
+        } else if (step == Step::SendFile) {
+            n = ::sendfile(out, in, nullptr, want);
+            if (n < 0 && errno != EINTR) {
+                if (errno == ENOSYS || errno == EINVAL || errno == EPERM) {
+                    step = Step::ReadWrite;
+                    continue;
+                }
+            }
+            method = CopyMethod::Kernel;
+        } else
+#endif
+        {
+            if (buffer.empty()) {
+                buffer.resize(kCopyBufferSize);
+            }
+            n = ::read(in, buffer.data(), std::min(want, buffer.size()));
+            if (n > 0) {
+                writeFully(out, buffer.data(), static_cast<size_t>(n));
+            }
+            method = CopyMethod::ReadWrite;
+        }
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwCopyError(std::strerror(errno));
+        }
+        if (n == 0) {
+#if defined(__linux__)
+            // Some filesystems report 0 from in-kernel copies before EOF;
+            // only trust a 0 from read()
+            if (step != Step::ReadWrite) {
+                step = Step::ReadWrite;
+                continue;
+            }
+#endif
+            break;  // Source shrank while copying
+        }
+        copied += static_cast<uint64_t>(n);
+        if (onProgress) {
+            onProgress(copied, size);
+        }
+    }
+    return copied;
+}
+
+#if defined(__APPLE__)
+/**
+ * @brief Clone src to dst on APFS
+ *
+ * clonefile() refuses an existing destination, so a replaced file is cloned
+ * next to it first and renamed over it, which also keeps dst intact if the
+ * clone fails.
+ *
+ * @return false if the filesystem cannot clone (the caller copies instead)
+ */
+inline auto cloneFile(const std::string& src, const std::string& dst, bool replace) -> bool {
+    // Unique per call, so concurrent copies to the same dst do not collide
+    static std::atomic<uint64_t> counter{0};
+    auto target = replace
+        ? dst + ".rnio-clone-" + std::to_string(::getpid()) + "-" + std::to_string(counter++)
+        : dst;
+    if (::clonefile(src.c_str(), target.c_str(), 0) != 0) {
+        if (errno == ENOTSUP || errno == EXDEV || errno == ENOSYS) {
+            return false;
+        }
+        throwCopyError(std::strerror(errno));
+    }
+    if (replace && ::rename(target.c_str(), dst.c_str()) != 0) {
+        auto error = errno;
+        ::unlink(target.c_str());
+        throwCopyError(std::strerror(error));
+    }
+    return true;
+}
+#endif
+
+#endif // !_WIN32
+
+} // namespace detail
+
+/**
+ * @brief Copy a regular file as fast as the platform allows
+ *
+ * The destination gets the source's permission bits. On failure or
+ * cancellation a partially written destination is removed.
+ *
+ * @param overwrite Replace an existing destination
+ * @param onProgress Optional callback, (bytes copied, total); a clone reports once
+ * @param isCancelled Optional cancellation check, polled between chunks
+ * @param usedMethod Optional output: how the data was copied
+ * @return Number of bytes copied
+ * @throws std::runtime_error on failure, "Operation cancelled" when cancelled
+ */
+inline auto copyFileFast(
+    const std::string& src,
+    const std::string& dst,
+    bool overwrite,
+    const HashProgressCallback& onProgress = {},
+    const CancelCheck& isCancelled = {},
+    CopyMethod* usedMethod = nullptr
+) -> uint64_t {
+    if (isCancelled && isCancelled()) {
+        throw std::runtime_error("Operation cancelled");
+    }
+
+#ifdef _WIN32
+    auto options = overwrite
+        ? std::filesystem::copy_options::overwrite_existing
+        : std::filesystem::copy_options::none;
+    std::error_code ec;
+    std::filesystem::copy_file(src, dst, options, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to copy file: " + ec.message());
+    }
+    auto size = static_cast<uint64_t>(std::filesystem::file_size(dst, ec));
+    if (usedMethod) {
+        *usedMethod = CopyMethod::ReadWrite;
+    }
+    if (onProgress) {
+        onProgress(size, size);
+    }
+    return size;
+#else
+    detail::ScopedFd in(::open(src.c_str(), O_RDONLY | O_CLOEXEC));
+    if (in.fd < 0) {
+        detail::throwCopyError(std::strerror(errno));
+    }
+    struct stat srcStat {};
+    if (::fstat(in.fd, &srcStat) != 0) {
+        detail::throwCopyError(std::strerror(errno));
+    }
+    if (!S_ISREG(srcStat.st_mode)) {
+        detail::throwCopyError("source is not a regular file");
+    }
+
+    struct stat dstStat {};
+    bool dstExists = ::stat(dst.c_str(), &dstStat) == 0;
+    if (dstExists) {
+        if (dstStat.st_dev == srcStat.st_dev && dstStat.st_ino == srcStat.st_ino) {
+            detail::throwCopyError("source and destination are the same file");
+        }
+        if (!overwrite) {
+            detail::throwCopyError(std::strerror(EEXIST));
+        }
+    }
+
+    auto size = static_cast<uint64_t>(srcStat.st_size);
+    auto method = CopyMethod::ReadWrite;
+
+#if defined(__APPLE__)
+    if (detail::cloneFile(src, dst, dstExists)) {
+        if (usedMethod) {
+            *usedMethod = CopyMethod::Clone;
+        }
+        if (onProgress) {
+            onProgress(size, size);
+        }
+        return size;
+    }
+#endif
+
+    auto flags = O_WRONLY | O_CREAT | O_CLOEXEC | (overwrite ? O_TRUNC : O_EXCL);
+    detail::ScopedFd out(::open(dst.c_str(), flags, srcStat.st_mode & 0777));
+    if (out.fd < 0) {
+        detail::throwCopyError(std::strerror(errno));
+    }
+
+    uint64_t copied = 0;
+    try {
+#if defined(__linux__)
+        // Reflink on filesystems that share extents (btrfs, XFS)
+        if (::ioctl(out.fd, FICLONE, in.fd) == 0) {
+            method = CopyMethod::Clone;
+            copied = size;
+            if (onProgress) {
+                onProgress(size, size);
+            }
+        } else
+#endif
+        {
+            copied = detail::copyFileData(in.fd, out.fd, size, method, onProgress, isCancelled);
+        }
+        ::fchmod(out.fd, srcStat.st_mode & 07777);
+        if (out.close() != 0) {
+            detail::throwCopyError(std::strerror(errno));
+        }
+    } catch (...) {
+        if (out.fd >= 0) {
+            out.close();
+        }
+        ::unlink(dst.c_str());
+        throw;
+    }
+
+    if (usedMethod) {
+        *usedMethod = method;
+    }
+    return copied;
+#endif
+}
+
+} // namespace rct_io
+
+#endif // IO_FILE_COPY_HPP
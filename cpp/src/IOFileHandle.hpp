@@ -30,16 +30,27 @@
 #define IO_FILE_HANDLE_HPP
 
 #include <fstream>
+#include <span>
 #include <string>
 #include <vector>
 #include <stdexcept>
 #include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#include "IOHasher.hpp"
+#include "IOStatCache.hpp"
 
 #ifdef _WIN32
 #include <io.h>
 #else
 #include <unistd.h>
+#include <sys/stat.h>
 #endif
 
 namespace rct_io {
@@ -65,20 +76,57 @@ enum class SeekOrigin : int {
     End = 2,     // SEEK_END
 };
 
+/**
+ * @brief I/O counters of one file handle
+ */
+struct IOHandleStats {
+    uint64_t bytesRead = 0;     // Bytes read from the file (including line read-ahead)
+    uint64_t bytesWritten = 0;  // Bytes written to the file
+    uint64_t readOps = 0;       // Read calls (read, readLines, readAt, hashRange)
+    uint64_t writeOps = 0;      // Write calls (write, writeAt, writeString)
+};
+
 /**
  * @brief Low-level file handle for streaming operations
  *
  * Uses C FILE* for maximum performance and portability.
  * Supports both text and binary operations.
  *
- * @note This class is NOT thread-safe. Each thread should have its own handle.
+ * @note Cursor-based operations (seek/read/write/...) share one file position
+ *       and are serialized by a per-handle mutex, so parallel calls on one
+ *       handle do not interleave inside the stdio buffer. readAt()/writeAt()
+ *       use pread/pwrite on the underlying descriptor and may run alongside
+ *       them; data still buffered by write() is flushed first.
+ * @note close() must not race with readAt()/writeAt()/hashRange(), which use
+ *       the descriptor without taking the mutex. Shared owners should simply
+ *       drop their reference and let the destructor close the file.
  */
 class IOFileHandle {
 private:
     FILE* file_ = nullptr;
     std::string path_;
     FileOpenMode mode_;
-    int64_t size_ = -1;  // Cached file size, -1 = unknown
+    std::atomic<int64_t> size_{-1};  // Cached file size, -1 = unknown
+
+    // Guards file_, its position and the read-ahead (cursor operations)
+    mutable std::mutex mutex_;
+    // write() data may sit in the stdio buffer, unseen by pread/pwrite
+    std::atomic<bool> dirty_{false};
+
+    // Read-ahead for readLine()/readLines(): bytes already read from file_
+    // but not yet returned. Other cursor operations hand the unconsumed part
+    // back to file_ first (dropReadAhead), so the file position stays exact.
+    std::vector<char> readAhead_;
+    size_t readAheadPos_ = 0;
+
+    // I/O counters (relaxed: readAt()/writeAt() may update them concurrently)
+    std::atomic<uint64_t> bytesRead_{0};
+    std::atomic<uint64_t> bytesWritten_{0};
+    std::atomic<uint64_t> readOps_{0};
+    std::atomic<uint64_t> writeOps_{0};
+
+    /// Read-ahead block size for line reading
+    static constexpr size_t kLineBufferSize = 64 * 1024;
 
     /**
      * @brief Convert FileOpenMode to fopen mode string
@@ -125,6 +173,148 @@ private:
         }
     }
 
+    auto countRead(size_t bytes) -> void {
+        bytesRead_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    auto countWrite(size_t bytes) -> void {
+        bytesWritten_.fetch_add(bytes, std::memory_order_relaxed);
+        writeOps_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Bytes read ahead by the line reader but not consumed yet
+     */
+    [[nodiscard]] auto readAheadSize() const -> size_t {
+        return readAhead_.size() - readAheadPos_;
+    }
+
+    /**
+     * @brief Move the position of file_ back to the first unconsumed byte
+     */
+    auto dropReadAhead() -> void {
+        if (readAhead_.empty()) {
+            return;
+        }
+        // Always seek: it is also required between reading and writing
+        std::fseek(file_, -static_cast<long>(readAheadSize()), SEEK_CUR);
+        readAhead_.clear();
+        readAheadPos_ = 0;
+    }
+
+    /**
+     * @brief Append up to kLineBufferSize bytes from file_ to the read-ahead
+     * @return false at end of file
+     */
+    auto fillReadAhead() -> bool {
+        // Discard consumed bytes before growing the buffer
+        if (readAheadPos_ > 0) {
+            readAhead_.erase(readAhead_.begin(), readAhead_.begin() + static_cast<std::ptrdiff_t>(readAheadPos_));
+            readAheadPos_ = 0;
+        }
+        auto used = readAhead_.size();
+        readAhead_.resize(used + kLineBufferSize);
+        auto bytesRead = std::fread(readAhead_.data() + used, 1, kLineBufferSize, file_);
+        readAhead_.resize(used + bytesRead);
+        countRead(bytesRead);
+        if (bytesRead == 0 && std::ferror(file_)) {
+            throw std::runtime_error("Read error");
+        }
+        return bytesRead > 0;
+    }
+
+    /** @brief Buffered write at the cursor (mutex_ held) */
+    auto writeLocked(const void* data, size_t size) -> size_t {
+        dropReadAhead();
+        auto written = std::fwrite(data, 1, size, file_);
+        if (written < size) {
+            throw std::runtime_error("Write error");
+        }
+        dirty_.store(true, std::memory_order_release);
+        // Invalidate cached size
+        size_ = -1;
+        countWrite(written);
+        return written;
+    }
+
+    /** @brief fflush (mutex_ held) */
+    auto flushLocked() -> void {
+        if (std::fflush(file_) != 0) {
+            throw std::runtime_error("Flush failed");
+        }
+        dirty_.store(false, std::memory_order_release);
+        if (canWrite()) {
+            StatCache::instance().invalidate(path_);
+        }
+    }
+
+    /**
+     * @brief Push data buffered by write() to the descriptor before pread/pwrite
+     */
+    auto flushPendingWrites() -> void {
+        if (!dirty_.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (dirty_.load(std::memory_order_relaxed)) {
+            flushLocked();
+        }
+    }
+
+    [[nodiscard]] auto sizeLocked() -> int64_t {
+        if (size_ < 0) {
+            // Save current position
+            auto currentPos = std::ftell(file_);
+            // Seek to end
+            std::fseek(file_, 0, SEEK_END);
+            size_ = std::ftell(file_);
+            // Restore position
+            std::fseek(file_, currentPos, SEEK_SET);
+        }
+        return size_;
+    }
+
+    [[nodiscard]] auto positionLocked() const -> int64_t {
+        return std::ftell(file_) - static_cast<int64_t>(readAheadSize());
+    }
+
+#ifndef _WIN32
+    /**
+     * @brief pread until size bytes are read or EOF is reached
+     * @return Number of bytes read
+     */
+    auto preadFully(uint8_t* dst, size_t size, int64_t offset) const -> size_t {
+        int fd = fileno(file_);
+        size_t total = 0;
+        while (total < size) {
+            auto n = ::pread(fd, dst + total, size - total,
+                             static_cast<off_t>(offset + static_cast<int64_t>(total)));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("Read error");
+            }
+            if (n == 0) {
+                break;  // EOF
+            }
+            total += static_cast<size_t>(n);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Current file size from the descriptor (does not touch the cursor)
+     */
+    [[nodiscard]] auto statSize() const -> int64_t {
+        struct stat st {};
+        if (::fstat(fileno(file_), &st) != 0) {
+            throw std::runtime_error("Cannot stat file: " + path_);
+        }
+        return static_cast<int64_t>(st.st_size);
+    }
+#endif
+
 public:
     IOFileHandle() = default;
 
@@ -141,6 +331,9 @@ public:
         if (!file_) {
             throw std::runtime_error("Cannot open file: " + path);
         }
+        if (canWrite()) {
+            StatCache::instance().invalidate(path_);  // May have been created or truncated
+        }
     }
 
     ~IOFileHandle() {
@@ -156,9 +349,17 @@ public:
         : file_(other.file_)
         , path_(std::move(other.path_))
         , mode_(other.mode_)
-        , size_(other.size_)
+        , size_(other.size_.load())
+        , dirty_(other.dirty_.load())
+        , readAhead_(std::move(other.readAhead_))
+        , readAheadPos_(other.readAheadPos_)
+        , bytesRead_(other.bytesRead_.load())
+        , bytesWritten_(other.bytesWritten_.load())
+        , readOps_(other.readOps_.load())
+        , writeOps_(other.writeOps_.load())
     {
         other.file_ = nullptr;
+        other.readAheadPos_ = 0;
     }
 
     IOFileHandle& operator=(IOFileHandle&& other) noexcept {
@@ -167,8 +368,16 @@ public:
             file_ = other.file_;
             path_ = std::move(other.path_);
             mode_ = other.mode_;
-            size_ = other.size_;
+            size_ = other.size_.load();
+            dirty_ = other.dirty_.load();
+            readAhead_ = std::move(other.readAhead_);
+            readAheadPos_ = other.readAheadPos_;
+            bytesRead_ = other.bytesRead_.load();
+            bytesWritten_ = other.bytesWritten_.load();
+            readOps_ = other.readOps_.load();
+            writeOps_ = other.writeOps_.load();
             other.file_ = nullptr;
+            other.readAheadPos_ = 0;
         }
         return *this;
     }
@@ -184,6 +393,18 @@ public:
         return path_;
     }
 
+    /**
+     * @brief Snapshot of the I/O counters
+     */
+    [[nodiscard]] auto getStats() const -> IOHandleStats {
+        return {
+            bytesRead_.load(std::memory_order_relaxed),
+            bytesWritten_.load(std::memory_order_relaxed),
+            readOps_.load(std::memory_order_relaxed),
+            writeOps_.load(std::memory_order_relaxed),
+        };
+    }
+
     /**
      * @brief Check if file is open
      */
@@ -196,26 +417,18 @@ public:
      * @note Caches the result after first call
      */
     [[nodiscard]] auto getSize() -> int64_t {
+        std::lock_guard<std::mutex> lock(mutex_);
         ensureOpen();
-
-        if (size_ < 0) {
-            // Save current position
-            auto currentPos = std::ftell(file_);
-            // Seek to end
-            std::fseek(file_, 0, SEEK_END);
-            size_ = std::ftell(file_);
-            // Restore position
-            std::fseek(file_, currentPos, SEEK_SET);
-        }
-        return size_;
+        return sizeLocked();
     }
 
     /**
      * @brief Get current file position
      */
     [[nodiscard]] auto getPosition() const -> int64_t {
+        std::lock_guard<std::mutex> lock(mutex_);
         ensureOpen();
-        return std::ftell(file_);
+        return positionLocked();
     }
 
     /**
@@ -224,12 +437,11 @@ public:
      *       after reading all content (feof only triggers after a failed read)
      */
     [[nodiscard]] auto isEOF() -> bool {
+        std::lock_guard<std::mutex> lock(mutex_);
         ensureOpen();
         // feof() only returns true after attempting to read past EOF
         // So we compare current position with file size for accurate detection
-        auto currentPos = std::ftell(file_);
-        auto fileSize = getSize();
-        return currentPos >= fileSize;
+        return positionLocked() >= sizeLocked();
     }
 
     // ========================================================================
@@ -243,7 +455,9 @@ public:
      * @return New position
      */
     auto seek(int64_t offset, SeekOrigin origin = SeekOrigin::Begin) -> int64_t {
+        std::lock_guard<std::mutex> lock(mutex_);
         ensureOpen();
+        dropReadAhead();
 
         int whence;
         switch (origin) {
@@ -264,7 +478,10 @@ public:
      * @brief Rewind to beginning of file
      */
     auto rewind() -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
         ensureOpen();
+        readAhead_.clear();
+        readAheadPos_ = 0;
         std::rewind(file_);
     }
 
@@ -278,10 +495,12 @@ public:
      * @return Bytes read
      */
     [[nodiscard]] auto read(int64_t size = -1) -> std::vector<uint8_t> {
+        std::lock_guard<std::mutex> lock(mutex_);
         ensureOpen();
         if (!canRead()) {
             throw std::runtime_error("File not opened for reading");
         }
+        dropReadAhead();
 
         if (size < 0) {
             // Read all remaining
@@ -299,6 +518,8 @@ public:
             throw std::runtime_error("Read error");
         }
 
+        countRead(bytesRead);
+        readOps_.fetch_add(1, std::memory_order_relaxed);
         buffer.resize(bytesRead);
         return buffer;
     }
@@ -315,29 +536,200 @@ public:
 
     /**
      * @brief Read a single line (up to newline or EOF)
-     * @param maxLength Maximum line length (default 64KB)
+     * @param maxLength Maximum line length (default 64KB); longer lines are
+     *        returned in pieces of maxLength bytes
      * @return Line content (without newline), empty string at EOF
      */
     [[nodiscard]] auto readLine(size_t maxLength = 65536) -> std::string {
+        auto lines = readLines(1, maxLength);
+        return lines.empty() ? std::string() : std::move(lines.front());
+    }
+
+    /**
+     * @brief Read a batch of lines
+     *
+     * Lines are split with memchr over a large read-ahead buffer instead of
+     * reading byte by byte. "\n" and "\r\n" both end a line; a final line
+     * without newline is returned as well.
+     *
+     * @param maxLines Stop after this many lines
+     * @param maxBytes Stop once the returned lines add up to this many bytes
+     *        (at least one line is returned); also the maximum length of a
+     *        single line, longer lines are returned in pieces
+     * @return Lines without line endings, empty at EOF
+     */
+    [[nodiscard]] auto readLines(size_t maxLines, size_t maxBytes = 16 * 1024 * 1024) -> std::vector<std::string> {
+        std::lock_guard<std::mutex> lock(mutex_);
         ensureOpen();
         if (!canRead()) {
             throw std::runtime_error("File not opened for reading");
         }
-
-        std::string line;
-        line.reserve(256);
-
-        int ch;
-        while ((ch = std::fgetc(file_)) != EOF && line.size() < maxLength) {
-            if (ch == '\n') {
-                break;
+        maxBytes = std::clamp<size_t>(maxBytes, 1, SIZE_MAX / 2);
+        readOps_.fetch_add(1, std::memory_order_relaxed);
+
+        std::vector<std::string> lines;
+        size_t totalBytes = 0;
+        bool eof = false;
+        while (lines.size() < maxLines && totalBytes < maxBytes) {
+            const char* start = readAhead_.data() + readAheadPos_;
+            size_t available = readAheadSize();
+            // Look two bytes further so a CRLF right after maxBytes still
+            // ends a line of maxBytes
+            size_t window = std::min(available, maxBytes + 2);
+            auto newline = window > 0
+                ? static_cast<const char*>(std::memchr(start, '\n', window))
+                : nullptr;
+
+            size_t length = 0;
+            size_t consumed = 0;
+            if (newline) {
+                length = static_cast<size_t>(newline - start);
+                consumed = length + 1;
+                if (length > 0 && start[length - 1] == '\r') {
+                    --length;  // Strip CR in CRLF
+                }
             }
-            if (ch != '\r') {  // Skip CR in CRLF
-                line.push_back(static_cast<char>(ch));
+            if (!newline || length > maxBytes) {
+                if (available > maxBytes + 1 || (eof && available > 0)) {
+                    // Over-long line, or last line without newline
+                    length = std::min(available, maxBytes);
+                    consumed = length;
+                } else if (!eof) {
+                    eof = !fillReadAhead();
+                    continue;
+                } else {
+                    break;
+                }
             }
+
+            lines.emplace_back(start, length);
+            totalBytes += length;
+            readAheadPos_ += consumed;
+        }
+
+        if (readAheadSize() == 0) {
+            readAhead_.clear();
+            readAheadPos_ = 0;
+        }
+        return lines;
+    }
+
+    /**
+     * @brief Read bytes at an absolute offset without moving the file position
+     * @param offset Absolute offset in bytes
+     * @param size Number of bytes to read, -1 for all bytes after offset
+     * @return Bytes read (shorter than size at EOF)
+     */
+    [[nodiscard]] auto readAt(int64_t offset, int64_t size = -1) -> std::vector<uint8_t> {
+        ensureOpen();
+        if (!canRead()) {
+            throw std::runtime_error("File not opened for reading");
+        }
+        if (offset < 0) {
+            throw std::runtime_error("Offset must be non-negative");
+        }
+
+#ifdef _WIN32
+        throw std::runtime_error("Positional read is not supported on this platform");
+#else
+        flushPendingWrites();
+        if (size < 0) {
+            size = std::max<int64_t>(0, statSize() - offset);
+        }
+
+        std::vector<uint8_t> buffer(static_cast<size_t>(size));
+        buffer.resize(preadFully(buffer.data(), buffer.size(), offset));
+        countRead(buffer.size());
+        readOps_.fetch_add(1, std::memory_order_relaxed);
+        return buffer;
+#endif
+    }
+
+    /**
+     * @brief Read bytes at an absolute offset into a caller-owned buffer
+     *
+     * Like readAt(), but fills dst instead of allocating, for callers that
+     * stream a range through a reused buffer.
+     *
+     * @return Number of bytes read (shorter than size at EOF)
+     */
+    auto readAtInto(int64_t offset, uint8_t* dst, size_t size) -> size_t {
+        ensureOpen();
+        if (!canRead()) {
+            throw std::runtime_error("File not opened for reading");
+        }
+        if (offset < 0) {
+            throw std::runtime_error("Offset must be non-negative");
+        }
+
+#ifdef _WIN32
+        throw std::runtime_error("Positional read is not supported on this platform");
+#else
+        flushPendingWrites();
+        auto n = preadFully(dst, size, offset);
+        countRead(n);
+        readOps_.fetch_add(1, std::memory_order_relaxed);
+        return n;
+#endif
+    }
+
+    /**
+     * @brief Hash a byte range without moving the file position
+     *
+     * Streams the range in chunks with pread, so it can run concurrently with
+     * other positional operations on the same handle.
+     *
+     * @param offset Absolute offset in bytes
+     * @param length Number of bytes, -1 for all bytes after offset
+     * @param algorithm Hash algorithm
+     * @param onProgress Optional progress callback
+     * @param isCancelled Optional cancellation check
+     * @param spawn Schedules the read-ahead task (empty: read on this thread)
+     * @return Hex string of the hash (of fewer bytes if the range passes EOF)
+     */
+    [[nodiscard]] auto hashRange(
+        int64_t offset,
+        int64_t length,
+        HashAlgorithm algorithm,
+        const HashProgressCallback& onProgress = {},
+        const CancelCheck& isCancelled = {},
+        const TaskSpawner& spawn = {}
+    ) -> std::string {
+        ensureOpen();
+        if (!canRead()) {
+            throw std::runtime_error("File not opened for reading");
+        }
+        if (offset < 0) {
+            throw std::runtime_error("Offset must be non-negative");
         }
 
-        return line;
+#ifdef _WIN32
+        throw std::runtime_error("Positional read is not supported on this platform");
+#else
+        flushPendingWrites();
+        auto available = std::max<int64_t>(0, statSize() - offset);
+        if (length < 0 || length > available) {
+            length = available;
+        }
+
+        readOps_.fetch_add(1, std::memory_order_relaxed);
+        auto position = offset;
+        auto end = offset + length;
+        return hashStream(
+            [&](uint8_t* dst, size_t max) -> size_t {
+                auto want = static_cast<size_t>(std::min<int64_t>(static_cast<int64_t>(max), end - position));
+                auto n = preadFully(dst, want, position);
+                position += static_cast<int64_t>(n);
+                countRead(n);
+                return n;
+            },
+            static_cast<uint64_t>(length),
+            algorithm,
+            onProgress,
+            isCancelled,
+            spawn
+        );
+#endif
     }
 
     // ========================================================================
@@ -349,21 +741,62 @@ public:
      * @param data Data to write
      * @return Number of bytes written
      */
-    auto write(const std::vector<uint8_t>& data) -> size_t {
+    auto write(std::span<const uint8_t> data) -> size_t {
+        std::lock_guard<std::mutex> lock(mutex_);
         ensureOpen();
         if (!canWrite()) {
             throw std::runtime_error("File not opened for writing");
         }
+        return writeLocked(data.data(), data.size());
+    }
 
-        auto written = std::fwrite(data.data(), 1, data.size(), file_);
-        if (written < data.size()) {
-            throw std::runtime_error("Write error");
+    /**
+     * @brief Write bytes at an absolute offset without moving the file position
+     * @param offset Absolute offset in bytes
+     * @param data Data to write
+     * @return Number of bytes written
+     * @note Not available for append modes, where the OS ignores the offset.
+     *       Data written through write() is flushed first so it is not
+     *       reordered after this call.
+     */
+    auto writeAt(int64_t offset, std::span<const uint8_t> data) -> size_t {
+        ensureOpen();
+        if (!canWrite()) {
+            throw std::runtime_error("File not opened for writing");
+        }
+        if (mode_ == FileOpenMode::Append || mode_ == FileOpenMode::AppendRead) {
+            throw std::runtime_error("Positional write is not supported in append mode");
+        }
+        if (offset < 0) {
+            throw std::runtime_error("Offset must be non-negative");
+        }
+
+#ifdef _WIN32
+        throw std::runtime_error("Positional write is not supported on this platform");
+#else
+        flushPendingWrites();
+
+        int fd = fileno(file_);
+        size_t total = 0;
+        while (total < data.size()) {
+            auto n = ::pwrite(fd, data.data() + total, data.size() - total,
+                              static_cast<off_t>(offset + static_cast<int64_t>(total)));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("Write error");
+            }
+            total += static_cast<size_t>(n);
         }
 
         // Invalidate cached size
         size_ = -1;
+        StatCache::instance().invalidate(path_);
+        countWrite(total);
 
-        return written;
+        return total;
+#endif
     }
 
     /**
@@ -372,20 +805,12 @@ public:
      * @return Number of bytes written
      */
     auto writeString(const std::string& content) -> size_t {
+        std::lock_guard<std::mutex> lock(mutex_);
         ensureOpen();
         if (!canWrite()) {
             throw std::runtime_error("File not opened for writing");
         }
-
-        auto written = std::fwrite(content.data(), 1, content.size(), file_);
-        if (written < content.size()) {
-            throw std::runtime_error("Write error");
-        }
-
-        // Invalidate cached size
-        size_ = -1;
-
-        return written;
+        return writeLocked(content.data(), content.size());
     }
 
     /**
@@ -394,8 +819,13 @@ public:
      * @return Number of bytes written (including newline)
      */
     auto writeLine(const std::string& line) -> size_t {
-        auto written = writeString(line);
-        written += writeString("\n");
+        std::lock_guard<std::mutex> lock(mutex_);
+        ensureOpen();
+        if (!canWrite()) {
+            throw std::runtime_error("File not opened for writing");
+        }
+        auto written = writeLocked(line.data(), line.size());
+        written += writeLocked("\n", 1);
         return written;
     }
 
@@ -407,10 +837,9 @@ public:
      * @brief Flush buffered data to disk
      */
     auto flush() -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
         ensureOpen();
-        if (std::fflush(file_) != 0) {
-            throw std::runtime_error("Flush failed");
-        }
+        flushLocked();
     }
 
     /**
@@ -418,12 +847,14 @@ public:
      * @note Platform-specific, may not work on all systems
      */
     auto truncate() -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
         ensureOpen();
         if (!canWrite()) {
             throw std::runtime_error("File not opened for writing");
         }
 
-        flush();
+        dropReadAhead();
+        flushLocked();
         auto pos = std::ftell(file_);
 
 #ifdef _WIN32
@@ -438,16 +869,25 @@ public:
 
         // Invalidate cached size
         size_ = -1;
+        StatCache::instance().invalidate(path_);
     }
 
     /**
      * @brief Close the file handle
+     * @note Waits for a running cursor operation; see the class note on
+     *       positional operations
      */
     auto close() -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
         if (file_) {
             std::fclose(file_);
             file_ = nullptr;
+            if (canWrite()) {
+                StatCache::instance().invalidate(path_);
+            }
         }
+        readAhead_.clear();
+        readAheadPos_ = 0;
     }
 };
 
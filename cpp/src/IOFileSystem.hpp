@@ -40,15 +40,17 @@
 #include <unordered_map>
 #include <chrono>
 #include <optional>
+#include <span>
 #include <variant>
+#include <algorithm>
+#include <cstring>
+#include <string_view>
 
 // Hash algorithms
-#include "md5.h"
-#include "sha1.h"
-#include "sha256.h"
-#include "sha3.h"
-#include "keccak.h"
-#include "crc32.h"
+#include "IOHasher.hpp"
+#include "IOAtomicWrite.hpp"
+#include "IOFileCopy.hpp"
+#include "IOStatCache.hpp"
 
 namespace rct_io {
 
@@ -74,24 +76,7 @@ enum class EntityType : int {
 enum class WriteMode : int {
     Overwrite = 0,   // Truncate and write
     Append = 1,      // Append to existing
-};
-
-/**
- * @brief Hash algorithm for file integrity check
- */
-enum class HashAlgorithm : int {
-    MD5 = 0,
-    SHA1 = 1,
-    SHA256 = 2,      // Default
-    SHA3_224 = 3,
-    SHA3_256 = 4,
-    SHA3_384 = 5,
-    SHA3_512 = 6,
-    Keccak224 = 7,
-    Keccak256 = 8,
-    Keccak384 = 9,
-    Keccak512 = 10,
-    CRC32 = 11,
+    Atomic = 2,      // Replace via a flushed temp file (see writeFileAtomic)
 };
 
 /**
@@ -111,6 +96,58 @@ struct FileMetadata {
     }
 };
 
+/**
+ * @brief Column-oriented listing of entries
+ *
+ * Every field is one contiguous byte buffer that becomes a single JS
+ * ArrayBuffer, so conversion cost does not grow with the number of entries:
+ * - names: UTF-8 names packed back to back, entry i spans
+ *   [nameOffsets[i], nameOffsets[i + 1])
+ * - nameOffsets: count + 1 uint32 offsets (empty if names were not collected)
+ * - types: one uint8 EntityType per entry
+ * - sizes, modifiedTimes: one float64 per entry (native byte order)
+ */
+struct EntryColumns {
+    std::vector<uint8_t> names;
+    std::vector<uint8_t> nameOffsets;
+    std::vector<uint8_t> types;
+    std::vector<uint8_t> sizes;
+    std::vector<uint8_t> modifiedTimes;
+    size_t count{0};
+
+    auto reserve(size_t entries, bool withNames) -> void {
+        if (withNames) {
+            nameOffsets.reserve((entries + 1) * sizeof(uint32_t));
+        }
+        types.reserve(entries);
+        sizes.reserve(entries * sizeof(double));
+        modifiedTimes.reserve(entries * sizeof(double));
+    }
+
+    auto appendName(std::string_view name) -> void {
+        if (nameOffsets.empty()) {
+            appendRaw(nameOffsets, uint32_t{0});
+        }
+        names.insert(names.end(), name.begin(), name.end());
+        appendRaw(nameOffsets, static_cast<uint32_t>(names.size()));
+    }
+
+    auto append(EntityType type, int64_t size, int64_t modifiedTime) -> void {
+        types.push_back(static_cast<uint8_t>(type));
+        appendRaw(sizes, static_cast<double>(size));
+        appendRaw(modifiedTimes, static_cast<double>(modifiedTime));
+        ++count;
+    }
+
+private:
+    template <typename T>
+    static auto appendRaw(std::vector<uint8_t>& column, T value) -> void {
+        auto offset = column.size();
+        column.resize(offset + sizeof(T));
+        std::memcpy(column.data() + offset, &value, sizeof(T));
+    }
+};
+
 /**
  * @brief Directory entry information
  */
@@ -168,13 +205,61 @@ namespace detail {
     return EntityType::NotFound;
 }
 
+/**
+ * @brief Get entity type of a directory entry
+ * @note Uses the file type cached by the directory iterator (d_type) when
+ *       the platform provides it, so only symlinks and entries of unknown
+ *       type cost an extra stat
+ */
+[[nodiscard]] inline auto getEntityType(const fs::directory_entry& entry) -> EntityType {
+    std::error_code ec;
+    if (entry.is_regular_file(ec)) {
+        return EntityType::File;
+    }
+    if (entry.is_directory(ec)) {
+        return EntityType::Directory;
+    }
+    return EntityType::NotFound;
+}
+
+/**
+ * @brief Build a DirectoryEntry from an iterator entry
+ * @param withSize Also fetch the size of files (one stat per file)
+ */
+[[nodiscard]] inline auto makeDirectoryEntry(const fs::directory_entry& entry, bool withSize) -> DirectoryEntry {
+    DirectoryEntry dirEntry;
+    dirEntry.path = entry.path().string();
+    dirEntry.name = entry.path().filename().string();
+    dirEntry.type = getEntityType(entry);
+
+    if (withSize && dirEntry.type == EntityType::File) {
+        std::error_code sizeEc;
+        dirEntry.size = static_cast<int64_t>(entry.file_size(sizeEc));
+    }
+    return dirEntry;
+}
+
+/**
+ * @brief Drop cached stats of a directory and of the ancestors create_directories() may have made
+ */
+inline auto invalidateCreatedDirectories(const fs::path& path) -> void {
+    for (auto dir = path; ; dir = dir.parent_path()) {
+        StatCache::instance().invalidate(dir.string());
+        if (!dir.has_relative_path() || dir == dir.parent_path()) {
+            break;
+        }
+    }
+}
+
 /**
  * @brief Ensure parent directory exists
  */
 inline auto ensureParentDirectory(const fs::path& path) -> void {
     if (auto parent = path.parent_path(); !parent.empty()) {
         std::error_code ec;
-        fs::create_directories(parent, ec);
+        if (fs::create_directories(parent, ec)) {
+            invalidateCreatedDirectories(parent);
+        }
         // Ignore error - parent might already exist
     }
 }
@@ -206,28 +291,28 @@ public:
     // File Query Operations
     // ========================================================================
 
+    // All queries below are one stat() of the path, answered by the
+    // StatCache instead when it is enabled (see configureStatCache)
+
     /**
      * @brief Check if a path exists
      */
     [[nodiscard]] auto exists(const std::string& path) const -> bool {
-        std::error_code ec;
-        return fs::exists(path, ec);
+        return StatCache::instance().stat(path).exists();
     }
 
     /**
      * @brief Check if path is a file
      */
     [[nodiscard]] auto isFile(const std::string& path) const -> bool {
-        std::error_code ec;
-        return fs::is_regular_file(path, ec);
+        return StatCache::instance().stat(path).kind == FileStat::Kind::File;
     }
 
     /**
      * @brief Check if path is a directory
      */
     [[nodiscard]] auto isDirectory(const std::string& path) const -> bool {
-        std::error_code ec;
-        return fs::is_directory(path, ec);
+        return StatCache::instance().stat(path).kind == FileStat::Kind::Directory;
     }
 
     /**
@@ -235,24 +320,17 @@ public:
      */
     [[nodiscard]] auto getMetadata(const std::string& path) const -> FileMetadata {
         FileMetadata metadata;
-        std::error_code ec;
-
-        auto status = fs::status(path, ec);
-        if (ec || !fs::exists(status)) {
+        auto stat = StatCache::instance().stat(path);
+        if (!stat.exists()) {
             return metadata;
         }
-
-        metadata.type = detail::getEntityType(path);
-
-        if (metadata.type == EntityType::File) {
-            metadata.size = static_cast<int64_t>(fs::file_size(path, ec));
+        if (stat.kind == FileStat::Kind::File) {
+            metadata.type = EntityType::File;
+            metadata.size = stat.size;
+        } else if (stat.kind == FileStat::Kind::Directory) {
+            metadata.type = EntityType::Directory;
         }
-
-        auto lastWrite = fs::last_write_time(path, ec);
-        if (!ec) {
-            metadata.modifiedTime = detail::toMilliseconds(lastWrite);
-        }
-
+        metadata.modifiedTime = stat.modifiedTime;
         return metadata;
     }
 
@@ -260,24 +338,42 @@ public:
      * @brief Get file size in bytes
      */
     [[nodiscard]] auto getFileSize(const std::string& path) const -> int64_t {
-        std::error_code ec;
-        auto size = fs::file_size(path, ec);
-        if (ec) {
+        auto stat = StatCache::instance().stat(path);
+        if (stat.kind != FileStat::Kind::File) {
             throw std::runtime_error("Failed to get file size: " + path);
         }
-        return static_cast<int64_t>(size);
+        return stat.size;
     }
 
     /**
      * @brief Get last modified time (milliseconds since epoch)
      */
     [[nodiscard]] auto getModifiedTime(const std::string& path) const -> int64_t {
-        std::error_code ec;
-        auto time = fs::last_write_time(path, ec);
-        if (ec) {
+        auto stat = StatCache::instance().stat(path);
+        if (!stat.exists()) {
             throw std::runtime_error("Failed to get modified time: " + path);
         }
-        return detail::toMilliseconds(time);
+        return stat.modifiedTime;
+    }
+
+    /**
+     * @brief Cache stat results of the queries above, process-wide
+     * @param options maxEntries 0 disables the cache; either call drops all entries
+     */
+    static auto configureStatCache(const StatCacheOptions& options) -> void {
+        StatCache::instance().configure(options);
+    }
+
+    /**
+     * @brief Forget cached stats of a path and everything below it, or of all
+     *        paths if path is empty (after changes made outside this library)
+     */
+    static auto invalidateStatCache(const std::string& path = {}) -> void {
+        if (path.empty()) {
+            StatCache::instance().clear();
+        } else {
+            StatCache::instance().invalidateTree(path);
+        }
     }
 
     // ========================================================================
@@ -337,7 +433,7 @@ public:
      * @brief Write UTF-8 string to file
      * @param path File path
      * @param content Content to write
-     * @param mode Write mode (Overwrite or Append)
+     * @param mode Write mode (Overwrite, Append or Atomic)
      * @param createParents Create parent directories if needed
      */
     auto writeString(
@@ -349,6 +445,11 @@ public:
         if (createParents) {
             detail::ensureParentDirectory(path);
         }
+        StatCacheInvalidation changed(path);
+        if (mode == WriteMode::Atomic) {
+            writeFileAtomic(path, {reinterpret_cast<const uint8_t*>(content.data()), content.size()});
+            return;
+        }
 
         auto openMode = std::ios::binary | std::ios::out;
         if (mode == WriteMode::Append) {
@@ -371,16 +472,22 @@ public:
 
     /**
      * @brief Write binary data to file
+     * @note Takes a span so pinned JS ArrayBuffers can be written without a copy
      */
     auto writeBytes(
         const std::string& path,
-        const std::vector<uint8_t>& data,
+        std::span<const uint8_t> data,
         WriteMode mode = WriteMode::Overwrite,
         bool createParents = false
     ) -> void {
         if (createParents) {
             detail::ensureParentDirectory(path);
         }
+        StatCacheInvalidation changed(path);
+        if (mode == WriteMode::Atomic) {
+            writeFileAtomic(path, data);
+            return;
+        }
 
         auto openMode = std::ios::binary | std::ios::out;
         if (mode == WriteMode::Append) {
@@ -404,6 +511,27 @@ public:
         }
     }
 
+    /**
+     * @brief Replace many files atomically, sharing the flushes (see writeFilesAtomic)
+     * @param createParents Create parent directories if needed
+     */
+    auto writeFilesAtomic(std::span<const AtomicWrite> files, bool createParents = false) -> void {
+        if (createParents) {
+            for (const auto& file : files) {
+                detail::ensureParentDirectory(file.path);
+            }
+        }
+        struct Invalidation {
+            std::span<const AtomicWrite> files;
+            ~Invalidation() {
+                for (const auto& file : files) {
+                    StatCache::instance().invalidate(file.path);
+                }
+            }
+        } changed{files};
+        rct_io::writeFilesAtomic(files);
+    }
+
     // ========================================================================
     // File Management Operations
     // ========================================================================
@@ -417,6 +545,7 @@ public:
         if (createParents) {
             detail::ensureParentDirectory(path);
         }
+        StatCacheInvalidation changed(path);
 
         std::ofstream file(path);
         if (!file) {
@@ -429,37 +558,41 @@ public:
      * @returns true if file was deleted, false if it didn't exist
      */
     auto deleteFile(const std::string& path) -> bool {
+        StatCacheInvalidation changed(path);
         std::error_code ec;
         return fs::remove(path, ec);
     }
 
     /**
      * @brief Copy a file
+     *
+     * Clones the file where the filesystem supports it (APFS, btrfs/XFS),
+     * otherwise copies in the kernel (copy_file_range/sendfile) or with a
+     * large-buffer loop, see copyFileFast().
+     *
      * @param sourcePath Source file path
      * @param destinationPath Destination path
      * @param overwrite Overwrite if destination exists
+     * @param onProgress Optional progress callback (bytes copied, total)
+     * @param isCancelled Optional cancellation check, polled between chunks
+     * @return Number of bytes copied
      */
     auto copyFile(
         const std::string& sourcePath,
         const std::string& destinationPath,
-        bool overwrite = true
-    ) -> void {
-        auto options = overwrite
-            ? fs::copy_options::overwrite_existing
-            : fs::copy_options::none;
-
-        std::error_code ec;
-        fs::copy_file(sourcePath, destinationPath, options, ec);
-
-        if (ec) {
-            throw std::runtime_error("Failed to copy file: " + ec.message());
-        }
+        bool overwrite = true,
+        const HashProgressCallback& onProgress = {},
+        const CancelCheck& isCancelled = {}
+    ) -> uint64_t {
+        StatCacheInvalidation changed(destinationPath);
+        return copyFileFast(sourcePath, destinationPath, overwrite, onProgress, isCancelled);
     }
 
     /**
      * @brief Move/rename a file
      */
     auto moveFile(const std::string& sourcePath, const std::string& destinationPath) -> void {
+        StatCacheInvalidation from(sourcePath, true), to(destinationPath, true);
         std::error_code ec;
         fs::rename(sourcePath, destinationPath, ec);
 
@@ -484,6 +617,12 @@ public:
             ? fs::create_directories(path, ec)
             : fs::create_directory(path, ec);
 
+        if (recursive) {
+            detail::invalidateCreatedDirectories(path);
+        } else {
+            StatCache::instance().invalidate(path);
+        }
+
         if (ec) {
             throw std::runtime_error("Failed to create directory: " + ec.message());
         }
@@ -499,6 +638,7 @@ public:
      * @returns Number of items deleted
      */
     auto deleteDirectory(const std::string& path, bool recursive = false) -> int64_t {
+        StatCacheInvalidation changed(path, true);
         std::error_code ec;
         int64_t count = 0;
 
@@ -519,27 +659,96 @@ public:
      * @brief List directory contents
      * @param path Directory path
      * @param recursive List recursively
+     * @param isCancelled Polled before each entry; stops the listing when true
      * @returns Vector of directory entries
+     * @throws std::runtime_error("Operation cancelled") when cancelled
      */
     [[nodiscard]] auto listDirectory(
         const std::string& path,
-        bool recursive = false
+        bool recursive = false,
+        const CancelCheck& isCancelled = {}
     ) const -> std::vector<DirectoryEntry> {
         std::vector<DirectoryEntry> entries;
         std::error_code ec;
 
-        auto processEntry = [&entries](const fs::directory_entry& entry) {
-            DirectoryEntry dirEntry;
-            dirEntry.path = entry.path().string();
-            dirEntry.name = entry.path().filename().string();
-            dirEntry.type = detail::getEntityType(entry.path());
+        auto processEntry = [&entries, &isCancelled](const fs::directory_entry& entry) {
+            if (isCancelled && isCancelled()) {
+                throw std::runtime_error("Operation cancelled");
+            }
+            entries.push_back(detail::makeDirectoryEntry(entry, true));
+        };
+
+        if (recursive) {
+            for (const auto& entry : fs::recursive_directory_iterator(path, ec)) {
+                processEntry(entry);
+            }
+        } else {
+            for (const auto& entry : fs::directory_iterator(path, ec)) {
+                processEntry(entry);
+            }
+        }
+
+        if (ec) {
+            throw std::runtime_error("Failed to list directory: " + ec.message());
+        }
+
+        return entries;
+    }
+
+    /**
+     * @brief List directory contents as columns
+     *
+     * Unlike listDirectory() no per-entry objects are built; names go
+     * straight into the packed name column. In recursive mode names are
+     * paths relative to the listed directory.
+     *
+     * @param withSize Fetch file sizes (one stat per file)
+     * @param withTime Fetch modification times (one stat per entry)
+     * @param isCancelled Polled before each entry; stops the listing when true
+     */
+    [[nodiscard]] auto listDirectoryColumns(
+        const std::string& path,
+        bool recursive,
+        bool withSize,
+        bool withTime,
+        const CancelCheck& isCancelled = {}
+    ) const -> EntryColumns {
+        EntryColumns columns;
+        std::error_code ec;
+        auto rootLength = fs::path(path).string().size();
 
-            if (dirEntry.type == EntityType::File) {
-                std::error_code sizeEc;
-                dirEntry.size = static_cast<int64_t>(entry.file_size(sizeEc));
+        auto processEntry = [&](const fs::directory_entry& entry) {
+            if (isCancelled && isCancelled()) {
+                throw std::runtime_error("Operation cancelled");
+            }
+            auto type = detail::getEntityType(entry);
+            if (recursive) {
+                std::string_view relative = entry.path().native();
+                relative.remove_prefix(std::min(rootLength, relative.size()));
+                while (!relative.empty() && relative.front() == fs::path::preferred_separator) {
+                    relative.remove_prefix(1);
+                }
+                columns.appendName(relative);
+            } else {
+                columns.appendName(entry.path().filename().native());
             }
 
-            entries.push_back(std::move(dirEntry));
+            std::error_code entryEc;
+            int64_t size = 0;
+            int64_t modifiedTime = 0;
+            if (withSize && type == EntityType::File) {
+                size = static_cast<int64_t>(entry.file_size(entryEc));
+                if (entryEc) {
+                    size = 0;
+                }
+            }
+            if (withTime) {
+                auto lastWrite = entry.last_write_time(entryEc);
+                if (!entryEc) {
+                    modifiedTime = detail::toMilliseconds(lastWrite);
+                }
+            }
+            columns.append(type, size, modifiedTime);
         };
 
         if (recursive) {
@@ -556,13 +765,35 @@ public:
             throw std::runtime_error("Failed to list directory: " + ec.message());
         }
 
-        return entries;
+        return columns;
+    }
+
+    /**
+     * @brief Get metadata of several paths as columns (names are not collected)
+     *
+     * Missing paths are reported with type NotFound instead of failing.
+     */
+    [[nodiscard]] auto getMetadataColumns(
+        const std::vector<std::string>& paths,
+        const CancelCheck& isCancelled = {}
+    ) const -> EntryColumns {
+        EntryColumns columns;
+        columns.reserve(paths.size(), false);
+        for (const auto& path : paths) {
+            if (isCancelled && isCancelled()) {
+                throw std::runtime_error("Operation cancelled");
+            }
+            auto metadata = getMetadata(path);
+            columns.append(metadata.type, metadata.size, metadata.modifiedTime);
+        }
+        return columns;
     }
 
     /**
      * @brief Move/rename a directory
      */
     auto moveDirectory(const std::string& sourcePath, const std::string& destinationPath) -> void {
+        StatCacheInvalidation from(sourcePath, true), to(destinationPath, true);
         std::error_code ec;
         fs::rename(sourcePath, destinationPath, ec);
 
@@ -699,72 +930,140 @@ public:
 
     /**
      * @brief Calculate hash of file content
+     *
+     * The file is streamed in fixed-size chunks (read-ahead overlaps hashing),
+     * so memory use does not depend on file size.
+     *
      * @param path File path
      * @param algorithm Hash algorithm to use
+     * @param onProgress Optional progress callback (bytes hashed, file size)
+     * @param isCancelled Optional cancellation check, polled between chunks
+     * @param spawn Schedules the read-ahead task (empty: read on this thread)
      * @return Hex string of the hash
      */
     [[nodiscard]] auto calcHash(
         const std::string& path,
-        HashAlgorithm algorithm = HashAlgorithm::SHA256
+        HashAlgorithm algorithm = HashAlgorithm::SHA256,
+        const HashProgressCallback& onProgress = {},
+        const CancelCheck& isCancelled = {},
+        const TaskSpawner& spawn = {}
     ) const -> std::string {
-        auto content = readBytes(path);
-        const void* data = content.data();
-        size_t numBytes = content.size();
-
-        switch (algorithm) {
-            case HashAlgorithm::MD5: {
-                MD5 hasher;
-                return hasher(data, numBytes);
-            }
-            case HashAlgorithm::SHA1: {
-                SHA1 hasher;
-                return hasher(data, numBytes);
-            }
-            case HashAlgorithm::SHA256: {
-                SHA256 hasher;
-                return hasher(data, numBytes);
-            }
-            case HashAlgorithm::SHA3_224: {
-                SHA3 hasher(SHA3::Bits224);
-                return hasher(data, numBytes);
-            }
-            case HashAlgorithm::SHA3_256: {
-                SHA3 hasher(SHA3::Bits256);
-                return hasher(data, numBytes);
-            }
-            case HashAlgorithm::SHA3_384: {
-                SHA3 hasher(SHA3::Bits384);
-                return hasher(data, numBytes);
-            }
-            case HashAlgorithm::SHA3_512: {
-                SHA3 hasher(SHA3::Bits512);
-                return hasher(data, numBytes);
-            }
-            case HashAlgorithm::Keccak224: {
-                Keccak hasher(Keccak::Keccak224);
-                return hasher(data, numBytes);
-            }
-            case HashAlgorithm::Keccak256: {
-                Keccak hasher(Keccak::Keccak256);
-                return hasher(data, numBytes);
-            }
-            case HashAlgorithm::Keccak384: {
-                Keccak hasher(Keccak::Keccak384);
-                return hasher(data, numBytes);
-            }
-            case HashAlgorithm::Keccak512: {
-                Keccak hasher(Keccak::Keccak512);
-                return hasher(data, numBytes);
+        auto stream = openForStreaming(path);
+        auto& file = stream.first;
+        return hashStream(
+            [&](uint8_t* dst, size_t max) { return readChunk(file, path, dst, max); },
+            stream.second,
+            algorithm,
+            onProgress,
+            isCancelled,
+            spawn
+        );
+    }
+
+    /**
+     * @brief Calculate several hashes of a file in one read pass
+     * @param path File path
+     * @param algorithms Algorithms to compute
+     * @param onProgress Optional progress callback (bytes hashed, file size)
+     * @param isCancelled Optional cancellation check, polled between chunks
+     * @param spawn Schedules the read-ahead and hasher helper tasks
+     *        (empty: everything runs on this thread)
+     * @return Hex digests, in the order of algorithms
+     */
+    [[nodiscard]] auto calcHashes(
+        const std::string& path,
+        const std::vector<HashAlgorithm>& algorithms,
+        const HashProgressCallback& onProgress = {},
+        const CancelCheck& isCancelled = {},
+        const TaskSpawner& spawn = {}
+    ) const -> std::vector<std::string> {
+        auto stream = openForStreaming(path);
+        auto& file = stream.first;
+        return hashStreamMulti(
+            [&](uint8_t* dst, size_t max) { return readChunk(file, path, dst, max); },
+            stream.second,
+            algorithms,
+            onProgress,
+            isCancelled,
+            spawn
+        );
+    }
+
+    /**
+     * @brief Hash a file as consecutive ranges in parallel (chunked / tree hash)
+     *
+     * Each range is read through its own stream, so ranges can be hashed on
+     * several threads at once. See ChunkedHash for the digest format.
+     *
+     * @param path File path
+     * @param algorithm Hash algorithm for the chunks and the root
+     * @param chunkSize Range size in bytes
+     * @param spawn Schedules helper tasks on other threads
+     * @param maxHelpers Maximum number of helper tasks
+     * @param onProgress Optional progress callback (bytes hashed, file size)
+     * @param isCancelled Optional cancellation check, polled between reads
+     * @return Per-range digests and root digest
+     */
+    [[nodiscard]] auto calcChunkedHash(
+        const std::string& path,
+        HashAlgorithm algorithm,
+        uint64_t chunkSize,
+        const TaskSpawner& spawn,
+        size_t maxHelpers,
+        const HashProgressCallback& onProgress = {},
+        const CancelCheck& isCancelled = {}
+    ) const -> ChunkedHash {
+        auto total = openForStreaming(path).second;
+        auto readRange = [&path](uint64_t offset, uint64_t length, const auto& consume) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file || !file.seekg(static_cast<std::streamoff>(offset))) {
+                throw std::runtime_error("Cannot open file for reading: " + path);
             }
-            case HashAlgorithm::CRC32: {
-                CRC32 hasher;
-                return hasher(data, numBytes);
+            std::vector<uint8_t> buffer(static_cast<size_t>(std::min<uint64_t>(length, kHashChunkSize)));
+            while (length > 0) {
+                auto max = static_cast<size_t>(std::min<uint64_t>(length, buffer.size()));
+                auto n = readChunk(file, path, buffer.data(), max);
+                if (n == 0) {
+                    throw std::runtime_error("File changed while hashing: " + path);
+                }
+                consume(buffer.data(), n);
+                length -= n;
             }
-            default:
-                // Fallback to SHA256
-                SHA256 hasher;
-                return hasher(data, numBytes);
+        };
+        return hashChunked(readRange, total, algorithm, chunkSize, spawn, maxHelpers, onProgress, isCancelled);
+    }
+
+private:
+    /**
+     * @brief Open a file for chunked reading
+     * @return Stream positioned at the start, and the file size
+     */
+    [[nodiscard]] static auto openForStreaming(const std::string& path)
+        -> std::pair<std::ifstream, uint64_t>
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            throw std::runtime_error("Cannot open file for reading: " + path);
+        }
+
+        auto fileSize = file.tellg();
+        if (fileSize < 0) {
+            throw std::runtime_error("Cannot determine file size: " + path);
+        }
+        file.seekg(0, std::ios::beg);
+
+        return {std::move(file), static_cast<uint64_t>(fileSize)};
+    }
+
+    /**
+     * @brief Read up to max bytes, returning 0 at end of file
+     */
+    static auto readChunk(std::ifstream& file, const std::string& path, uint8_t* dst, size_t max) -> size_t {
+        file.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(max));
+        if (file.bad()) {
+            throw std::runtime_error("Error reading file: " + path);
         }
+        return static_cast<size_t>(file.gcount());
     }
 
 };
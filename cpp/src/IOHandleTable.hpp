@@ -0,0 +1,240 @@
+/**
+ * @file IOHandleTable.hpp
+ * @brief Slot table mapping numeric JS handles to native objects
+ *
+ * Lookups are lock-free; only opening and closing a handle take a mutex.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_HANDLE_TABLE_HPP
+#define IO_HANDLE_TABLE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace rct_io {
+
+/**
+ * @brief Fixed-capacity table of shared objects addressed by generation-checked IDs
+ *
+ * An ID encodes a slot index in its low kIndexBits bits and the slot's
+ * generation above them. Closing a handle bumps the generation, so a stale
+ * ID - including one whose slot has since been reused - no longer matches
+ * and get() returns nullptr instead of someone else's object. IDs are
+ * positive and fit in an int, so they round-trip through JS numbers.
+ *
+ * Each slot has one atomic state word: the generation, a live bit and a
+ * count of readers currently copying the slot's shared_ptr. get() pins the
+ * slot with a CAS, copies the pointer and unpins it; remove() clears the
+ * live bit and waits for the (few nanoseconds long) pins to drain before
+ * releasing the object. Slots are allocated in chunks that are never freed
+ * while the table lives, so a reader never touches released memory.
+ *
+ * @tparam T Type of the stored objects
+ */
+template <typename T>
+class IOHandleTable {
+public:
+    static constexpr uint32_t kIndexBits = 16;
+    static constexpr uint32_t kGenerationBits = 15;
+    static constexpr size_t kCapacity = size_t{1} << kIndexBits;
+
+private:
+    static constexpr size_t kChunkSize = 256;
+    static constexpr size_t kMaxChunks = kCapacity / kChunkSize;
+    static constexpr uint32_t kIndexMask = (uint32_t{1} << kIndexBits) - 1;
+    static constexpr uint32_t kGenerationMask = (uint32_t{1} << kGenerationBits) - 1;
+
+    // State word: [generation << 1 | live] in the high 32 bits, pins in the low 32
+    static constexpr uint64_t kPinMask = 0xFFFFFFFFull;
+    static constexpr uint32_t kLiveBit = 1;
+
+    struct Slot {
+        std::atomic<uint64_t> state{0};
+        std::shared_ptr<T> value;  // Written only while not live and unpinned
+    };
+
+    struct Chunk {
+        std::array<Slot, kChunkSize> slots;
+    };
+
+    std::array<std::atomic<Chunk*>, kMaxChunks> chunks_{};
+    std::vector<uint32_t> freeList_;  // Released slot indices
+    uint32_t nextIndex_ = 0;          // First never-used slot index
+    size_t size_ = 0;
+    std::mutex mutex_;                // Serializes insert() and remove()
+
+    [[nodiscard]] static auto tagOf(uint64_t state) -> uint32_t {
+        return static_cast<uint32_t>(state >> 32);
+    }
+
+    [[nodiscard]] static auto nextGeneration(uint32_t generation) -> uint32_t {
+        generation = (generation + 1) & kGenerationMask;
+        return generation == 0 ? 1 : generation;  // 0 would allow ID 0
+    }
+
+    /**
+     * @brief Find the slot an ID points at, without checking its generation
+     * @returns nullptr if the index was never allocated
+     */
+    [[nodiscard]] auto slotFor(int id) const -> Slot* {
+        if (id <= 0) {
+            return nullptr;
+        }
+        auto index = static_cast<uint32_t>(id) & kIndexMask;
+        auto* chunk = chunks_[index / kChunkSize].load(std::memory_order_acquire);
+        return chunk ? &chunk->slots[index % kChunkSize] : nullptr;
+    }
+
+    [[nodiscard]] static auto liveTagFor(int id) -> uint32_t {
+        auto generation = (static_cast<uint32_t>(id) >> kIndexBits) & kGenerationMask;
+        return (generation << 1) | kLiveBit;
+    }
+
+public:
+    IOHandleTable() = default;
+
+    ~IOHandleTable() {
+        for (auto& chunk : chunks_) {
+            delete chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Non-copyable, non-movable (readers hold pointers into the slots)
+    IOHandleTable(const IOHandleTable&) = delete;
+    IOHandleTable& operator=(const IOHandleTable&) = delete;
+    IOHandleTable(IOHandleTable&&) = delete;
+    IOHandleTable& operator=(IOHandleTable&&) = delete;
+
+    /**
+     * @brief Store an object and return its new ID
+     * @throws std::runtime_error if all kCapacity slots are in use
+     */
+    auto insert(std::shared_ptr<T> value) -> int {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        uint32_t index = 0;
+        if (!freeList_.empty()) {
+            index = freeList_.back();
+            freeList_.pop_back();
+        } else {
+            if (nextIndex_ >= kCapacity) {
+                throw std::runtime_error("Too many open handles");
+            }
+            index = nextIndex_++;
+            auto& chunk = chunks_[index / kChunkSize];
+            if (!chunk.load(std::memory_order_relaxed)) {
+                chunk.store(new Chunk(), std::memory_order_release);
+            }
+        }
+
+        auto& slot = chunks_[index / kChunkSize].load(std::memory_order_relaxed)->slots[index % kChunkSize];
+        auto generation = tagOf(slot.state.load(std::memory_order_relaxed)) >> 1;
+        if (generation == 0) {
+            generation = 1;  // Never used before
+        }
+
+        slot.value = std::move(value);
+        // Publishes value; pins are zero because the slot was not live
+        slot.state.store(static_cast<uint64_t>((generation << 1) | kLiveBit) << 32,
+                         std::memory_order_release);
+        ++size_;
+        return static_cast<int>((generation << kIndexBits) | index);
+    }
+
+    /**
+     * @brief Look up an object (lock-free)
+     * @returns The object, or nullptr if the ID is unknown, closed or stale
+     */
+    [[nodiscard]] auto get(int id) const -> std::shared_ptr<T> {
+        auto* slot = slotFor(id);
+        if (!slot) {
+            return nullptr;
+        }
+
+        auto expected = liveTagFor(id);
+        auto state = slot->state.load(std::memory_order_acquire);
+        do {
+            if (tagOf(state) != expected) {
+                return nullptr;
+            }
+        } while (!slot->state.compare_exchange_weak(
+            state, state + 1, std::memory_order_acquire, std::memory_order_acquire));
+
+        auto value = slot->value;
+        slot->state.fetch_sub(1, std::memory_order_release);
+        return value;
+    }
+
+    /**
+     * @brief Remove an object, invalidating its ID
+     * @returns The removed object, or nullptr if the ID was not live
+     */
+    auto remove(int id) -> std::shared_ptr<T> {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto* slot = slotFor(id);
+        if (!slot) {
+            return nullptr;
+        }
+
+        auto expected = liveTagFor(id);
+        auto retired = nextGeneration(expected >> 1) << 1;
+        auto state = slot->state.load(std::memory_order_relaxed);
+        do {
+            if (tagOf(state) != expected) {
+                return nullptr;
+            }
+        } while (!slot->state.compare_exchange_weak(
+            state, (static_cast<uint64_t>(retired) << 32) | (state & kPinMask),
+            std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        // No new reader can pin the slot now; wait for the current ones
+        while ((slot->state.load(std::memory_order_acquire) & kPinMask) != 0) {
+            std::this_thread::yield();
+        }
+
+        auto value = std::move(slot->value);
+        slot->value.reset();
+        freeList_.push_back(static_cast<uint32_t>(id) & kIndexMask);
+        --size_;
+        return value;
+    }
+
+    /**
+     * @brief Number of live objects
+     */
+    [[nodiscard]] auto size() -> size_t {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_;
+    }
+};
+
+} // namespace rct_io
+
+#endif // IO_HANDLE_TABLE_HPP
@@ -0,0 +1,654 @@
+/**
+ * @file IOHasher.hpp
+ * @brief Streaming hash computation over the cpp/hash algorithms
+ *
+ * Wraps every supported hash behind one incremental interface and feeds it
+ * from fixed-size chunks, so files of any size are hashed in bounded memory.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_HASHER_HPP
+#define IO_HASHER_HPP
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "md5.h"
+#include "sha1.h"
+#include "sha256.h"
+#include "sha3.h"
+#include "keccak.h"
+#include "crc32.h"
+
+namespace rct_io {
+
+/**
+ * @brief Hash algorithm for file integrity check
+ */
+enum class HashAlgorithm : int {
+    MD5 = 0,
+    SHA1 = 1,
+    SHA256 = 2,      // Default
+    SHA3_224 = 3,
+    SHA3_256 = 4,
+    SHA3_384 = 5,
+    SHA3_512 = 6,
+    Keccak224 = 7,
+    Keccak256 = 8,
+    Keccak384 = 9,
+    Keccak512 = 10,
+    CRC32 = 11,
+};
+
+/**
+ * @brief Progress callback: bytes processed so far, total bytes
+ */
+using HashProgressCallback = std::function<void(uint64_t processed, uint64_t total)>;
+
+/**
+ * @brief Cancellation check, polled between chunks
+ */
+using CancelCheck = std::function<bool()>;
+
+/// Chunk size used for streaming hashes
+inline constexpr size_t kHashChunkSize = 1024 * 1024;
+
+/// Default range size for chunked (tree) hashes
+inline constexpr uint64_t kChunkedHashDefaultSize = 4 * 1024 * 1024;
+
+/**
+ * @brief Schedules a task on another thread (e.g. the async thread pool)
+ */
+using TaskSpawner = std::function<void(std::function<void()>&&)>;
+
+/**
+ * @brief Result of hashChunked()
+ *
+ * The input is split into consecutive ranges of chunkSize bytes (the last one
+ * may be shorter) and every range is hashed on its own:
+ *   - CRC32: chunks are the CRC32 of each range, root is the CRC32 of the
+ *     whole input (ranges merged with CRC32::combine)
+ *   - other algorithms: chunks are the digests of each range, root is the
+ *     digest of the concatenated binary chunk digests
+ * An empty input has no chunks.
+ */
+struct ChunkedHash {
+    std::string root;
+    std::vector<std::string> chunks;
+    uint64_t chunkSize = 0;
+};
+
+/**
+ * @brief Incremental hasher for any HashAlgorithm
+ */
+class IOHasher {
+private:
+    using Impl = std::variant<MD5, SHA1, SHA256, SHA3, Keccak, CRC32>;
+    Impl impl_;
+
+    [[nodiscard]] static auto makeImpl(HashAlgorithm algorithm) -> Impl {
+        switch (algorithm) {
+            case HashAlgorithm::MD5:       return MD5();
+            case HashAlgorithm::SHA1:      return SHA1();
+            case HashAlgorithm::SHA256:    return SHA256();
+            case HashAlgorithm::SHA3_224:  return SHA3(SHA3::Bits224);
+            case HashAlgorithm::SHA3_256:  return SHA3(SHA3::Bits256);
+            case HashAlgorithm::SHA3_384:  return SHA3(SHA3::Bits384);
+            case HashAlgorithm::SHA3_512:  return SHA3(SHA3::Bits512);
+            case HashAlgorithm::Keccak224: return Keccak(Keccak::Keccak224);
+            case HashAlgorithm::Keccak256: return Keccak(Keccak::Keccak256);
+            case HashAlgorithm::Keccak384: return Keccak(Keccak::Keccak384);
+            case HashAlgorithm::Keccak512: return Keccak(Keccak::Keccak512);
+            case HashAlgorithm::CRC32:     return CRC32();
+            default:                       return SHA256();  // Fallback to SHA256
+        }
+    }
+
+public:
+    explicit IOHasher(HashAlgorithm algorithm = HashAlgorithm::SHA256)
+        : impl_(makeImpl(algorithm)) {}
+
+    /**
+     * @brief Add bytes to the running hash
+     */
+    auto add(const void* data, size_t numBytes) -> void {
+        std::visit([&](auto& hasher) { hasher.add(data, numBytes); }, impl_);
+    }
+
+    /**
+     * @brief Finish and return the hash as hex string
+     */
+    [[nodiscard]] auto getHash() -> std::string {
+        return std::visit([](auto& hasher) { return hasher.getHash(); }, impl_);
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief State of forEachChunk shared with its read-ahead task
+ *
+ * Reads are claimed under the mutex by whoever gets there first, the caller
+ * or the task, so a task that has not started yet never holds the caller
+ * up: the caller simply reads the chunk itself.
+ */
+struct ReadAhead {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::array<std::vector<uint8_t>, 2> buffers;
+    std::array<size_t, 2> lengths{};
+    std::array<bool, 2> filled{};
+    size_t nextRead = 0;   // Index of the next chunk to read
+    bool reading = false;  // A read is running outside the mutex
+    bool eof = false;
+    bool stop = false;     // Set by the caller; the task must not read any more
+    std::exception_ptr error;
+    std::function<size_t(uint8_t*, size_t)> read;  // Only called while claimed
+
+    /** @brief Claim, run and publish the read of chunk nextRead (lock held) */
+    auto readNext(std::unique_lock<std::mutex>& lock) -> void {
+        auto slot = nextRead & 1;
+        reading = true;
+        lock.unlock();
+        size_t n = 0;
+        std::exception_ptr failure;
+        try {
+            n = read(buffers[slot].data(), buffers[slot].size());
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        lock.lock();
+        reading = false;
+        if (failure) {
+            error = failure;
+        } else {
+            lengths[slot] = n;
+            filled[slot] = true;
+            eof = n == 0;
+            ++nextRead;
+        }
+        cv.notify_all();
+    }
+
+    /** @brief Body of the read-ahead task */
+    auto run() -> void {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            cv.wait(lock, [&] { return stop || eof || error || (!reading && !filled[nextRead & 1]); });
+            if (stop || eof || error) {
+                return;
+            }
+            readNext(lock);
+        }
+    }
+};
+
+/**
+ * @brief Read a source in fixed-size chunks and hand each chunk to a consumer
+ *
+ * With a spawner, a read-ahead task reads the next chunk into the second of
+ * two buffers while the consumer processes the current one, so disk I/O and
+ * hashing run in parallel. Without one, chunks are read on the calling
+ * thread. Exceptions from either side are rethrown.
+ *
+ * @param read     size_t(uint8_t* dst, size_t max): fill dst, return 0 at end
+ * @param consume  void(const uint8_t* data, size_t size)
+ * @param spawn    Schedules the read-ahead task (may be empty)
+ */
+template <typename ReadFn, typename ConsumeFn>
+auto forEachChunk(ReadFn&& read, ConsumeFn&& consume, size_t chunkSize, const TaskSpawner& spawn) -> void {
+    if (!spawn) {
+        std::vector<uint8_t> buffer(chunkSize);
+        while (auto n = read(buffer.data(), chunkSize)) {
+            consume(buffer.data(), n);
+        }
+        return;
+    }
+
+    auto state = std::make_shared<ReadAhead>();
+    state->buffers = {std::vector<uint8_t>(chunkSize), std::vector<uint8_t>(chunkSize)};
+    state->read = [&read](uint8_t* dst, size_t max) -> size_t { return read(dst, max); };
+    try {
+        spawn([state] { state->run(); });
+    } catch (...) {
+        // No read-ahead; the loop below reads every chunk itself
+    }
+
+    // Stop the task and wait for a read it has claimed, since read refers to
+    // this frame
+    auto finish = [&state] {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->stop = true;
+        state->cv.notify_all();
+        state->cv.wait(lock, [&] { return !state->reading; });
+    };
+
+    try {
+        for (size_t chunk = 0;; ++chunk) {
+            auto slot = chunk & 1;
+            {
+                std::unique_lock<std::mutex> lock(state->mutex);
+                while (!state->filled[slot] && !state->error) {
+                    if (state->reading) {
+                        state->cv.wait(lock);
+                    } else {
+                        state->readNext(lock);
+                    }
+                }
+                if (state->error) {
+                    std::rethrow_exception(state->error);
+                }
+                if (state->lengths[slot] == 0) {
+                    break;
+                }
+            }
+            consume(state->buffers[slot].data(), state->lengths[slot]);
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->filled[slot] = false;
+            }
+            state->cv.notify_all();
+        }
+    } catch (...) {
+        finish();
+        throw;
+    }
+    finish();
+}
+
+/**
+ * @brief Feeds each chunk to several hashers at once
+ *
+ * Every add() hands out the hashers one by one to the calling thread and to
+ * helper tasks started with spawn, and returns once all of them consumed the
+ * chunk, so the caller may reuse the buffer afterwards. Helpers that have
+ * not started leave their share to the caller.
+ */
+class ParallelHashers {
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable workCv;
+        std::condition_variable doneCv;
+        std::vector<IOHasher>* hashers = nullptr;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        size_t next = 0;      // Next hasher to hand out for the current chunk
+        size_t inFlight = 0;  // Hashers being fed outside the mutex
+        bool stop = false;
+
+        /** @brief Feed hashers of the current chunk until none is left (lock held) */
+        auto drain(std::unique_lock<std::mutex>& lock) -> void {
+            while (!stop && next < hashers->size()) {
+                auto index = next++;
+                ++inFlight;
+                lock.unlock();
+                (*hashers)[index].add(data, size);
+                lock.lock();
+                if (--inFlight == 0 && next == hashers->size()) {
+                    doneCv.notify_all();
+                }
+            }
+        }
+
+        auto work() -> void {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                workCv.wait(lock, [&] { return stop || next < hashers->size(); });
+                if (stop) {
+                    return;
+                }
+                drain(lock);
+            }
+        }
+    };
+
+    std::shared_ptr<State> state_ = std::make_shared<State>();
+
+public:
+    ParallelHashers(std::vector<IOHasher>& hashers, const TaskSpawner& spawn) {
+        state_->hashers = &hashers;
+        state_->next = hashers.size();  // Nothing to hand out yet
+        try {
+            for (size_t i = 1; i < hashers.size(); ++i) {
+                spawn([state = state_] { state->work(); });
+            }
+        } catch (...) {
+            // Fewer helpers; add() feeds the rest itself
+        }
+    }
+
+    ~ParallelHashers() {
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->stop = true;
+        }
+        state_->workCv.notify_all();
+    }
+
+    ParallelHashers(const ParallelHashers&) = delete;
+    ParallelHashers& operator=(const ParallelHashers&) = delete;
+
+    auto add(const uint8_t* data, size_t size) -> void {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->data = data;
+        state_->size = size;
+        state_->next = 0;
+        state_->workCv.notify_all();
+        state_->drain(lock);
+        state_->doneCv.wait(lock, [&] { return state_->inFlight == 0; });
+    }
+};
+
+/**
+ * @brief Work queue of numbered chunks shared by the caller and helper tasks
+ *
+ * Every participant calls drain(), which claims chunk indices until none are
+ * left or one of them failed. Helpers hold the queue by shared_ptr, so one
+ * that starts late (e.g. was queued behind other pool tasks) finds the queue
+ * closed and returns without touching run. The caller never waits for helpers
+ * that have not started, which keeps this deadlock-free on a busy pool.
+ */
+struct ChunkQueue {
+    std::mutex mutex;
+    std::condition_variable idle;
+    size_t next = 0;
+    size_t count = 0;
+    size_t inFlight = 0;
+    bool closed = false;
+    std::exception_ptr error;
+    std::function<void(size_t)> run;  // Only called before close() returns
+
+    auto drain() -> void {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!closed && !error && next < count) {
+            size_t index = next++;
+            ++inFlight;
+            lock.unlock();
+
+            std::exception_ptr failure;
+            try {
+                run(index);
+            } catch (...) {
+                failure = std::current_exception();
+            }
+
+            lock.lock();
+            if (failure && !error) {
+                error = failure;
+            }
+            if (--inFlight == 0) {
+                idle.notify_all();
+            }
+        }
+    }
+
+    /**
+     * @brief Stop handing out chunks and wait for the claimed ones to finish
+     * @return The first error raised by run, if any
+     */
+    auto close() -> std::exception_ptr {
+        std::unique_lock<std::mutex> lock(mutex);
+        closed = true;
+        idle.wait(lock, [&] { return inFlight == 0; });
+        return std::move(error);
+    }
+};
+
+inline auto hexToBytes(const std::string& hex, std::vector<uint8_t>& out) -> void {
+    auto nibble = [](char c) -> uint8_t {
+        if (c >= '0' && c <= '9') return static_cast<uint8_t>(c - '0');
+        if (c >= 'a' && c <= 'f') return static_cast<uint8_t>(c - 'a' + 10);
+        return static_cast<uint8_t>(c - 'A' + 10);
+    };
+    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+        out.push_back(static_cast<uint8_t>((nibble(hex[i]) << 4) | nibble(hex[i + 1])));
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Hash a byte source chunk by chunk
+ * @param read Chunk reader, see detail::forEachChunk
+ * @param total Expected number of bytes (for progress and read-ahead decisions)
+ * @param algorithm Hash algorithm
+ * @param onProgress Optional progress callback, called after each chunk
+ * @param isCancelled Optional cancellation check, polled before each chunk
+ * @param spawn Schedules the read-ahead task (may be empty: single-threaded)
+ * @return Hex string of the hash
+ * @throws std::runtime_error("Operation cancelled") when cancelled
+ */
+template <typename ReadFn>
+[[nodiscard]] auto hashStream(
+    ReadFn&& read,
+    uint64_t total,
+    HashAlgorithm algorithm,
+    const HashProgressCallback& onProgress = {},
+    const CancelCheck& isCancelled = {},
+    const TaskSpawner& spawn = {}
+) -> std::string {
+    IOHasher hasher(algorithm);
+    uint64_t processed = 0;
+
+    detail::forEachChunk(
+        [&](uint8_t* dst, size_t max) -> size_t {
+            if (isCancelled && isCancelled()) {
+                throw std::runtime_error("Operation cancelled");
+            }
+            return read(dst, max);
+        },
+        [&](const uint8_t* data, size_t size) {
+            hasher.add(data, size);
+            processed += size;
+            if (onProgress) {
+                onProgress(processed, total);
+            }
+        },
+        kHashChunkSize,
+        // Only pay for the read-ahead task when there is more than one chunk
+        total > kHashChunkSize ? spawn : TaskSpawner{}
+    );
+
+    return hasher.getHash();
+}
+
+/**
+ * @brief Hash a byte source with several algorithms in a single read pass
+ * @param read Chunk reader, see detail::forEachChunk
+ * @param total Expected number of bytes
+ * @param algorithms Algorithms to compute
+ * @param onProgress Optional progress callback, called after each chunk
+ * @param isCancelled Optional cancellation check, polled before each chunk
+ * @param spawn Schedules the read-ahead task and the helpers that run the
+ *        hashers of one chunk side by side (may be empty: single-threaded)
+ * @return Hex digests, in the order of algorithms
+ */
+template <typename ReadFn>
+[[nodiscard]] auto hashStreamMulti(
+    ReadFn&& read,
+    uint64_t total,
+    const std::vector<HashAlgorithm>& algorithms,
+    const HashProgressCallback& onProgress = {},
+    const CancelCheck& isCancelled = {},
+    const TaskSpawner& spawn = {}
+) -> std::vector<std::string> {
+    std::vector<IOHasher> hashers;
+    hashers.reserve(algorithms.size());
+    for (auto algorithm : algorithms) {
+        hashers.emplace_back(algorithm);
+    }
+
+    bool multiChunk = total > kHashChunkSize;
+    std::optional<detail::ParallelHashers> gang;
+    if (spawn && multiChunk && hashers.size() > 1) {
+        gang.emplace(hashers, spawn);
+    }
+
+    uint64_t processed = 0;
+    detail::forEachChunk(
+        [&](uint8_t* dst, size_t max) -> size_t {
+            if (isCancelled && isCancelled()) {
+                throw std::runtime_error("Operation cancelled");
+            }
+            return read(dst, max);
+        },
+        [&](const uint8_t* data, size_t size) {
+            if (gang) {
+                gang->add(data, size);
+            } else {
+                for (auto& hasher : hashers) {
+                    hasher.add(data, size);
+                }
+            }
+            processed += size;
+            if (onProgress) {
+                onProgress(processed, total);
+            }
+        },
+        kHashChunkSize,
+        multiChunk ? spawn : TaskSpawner{}
+    );
+    gang.reset();
+
+    std::vector<std::string> digests;
+    digests.reserve(hashers.size());
+    for (auto& hasher : hashers) {
+        digests.push_back(hasher.getHash());
+    }
+    return digests;
+}
+
+/**
+ * @brief Hash consecutive ranges of a byte source concurrently
+ *
+ * Ranges are handed out to the calling thread and to up to maxHelpers tasks
+ * scheduled with spawn; see ChunkedHash for the result format.
+ *
+ * @param readRange void(uint64_t offset, uint64_t length, consume): read
+ *        exactly length bytes at offset, passing them to
+ *        consume(const uint8_t* data, size_t size) piece by piece. Called
+ *        concurrently from several threads.
+ * @param total Number of bytes in the source
+ * @param algorithm Hash algorithm for the chunks and the root
+ * @param chunkSize Range size in bytes (> 0)
+ * @param spawn Schedules helper tasks (may be empty: single-threaded)
+ * @param maxHelpers Maximum number of helper tasks
+ * @param onProgress Optional progress callback (serialized, monotonic)
+ * @param isCancelled Optional cancellation check, polled between pieces
+ * @throws std::runtime_error("Operation cancelled") when cancelled
+ */
+template <typename ReadRangeFn>
+[[nodiscard]] auto hashChunked(
+    ReadRangeFn&& readRange,
+    uint64_t total,
+    HashAlgorithm algorithm,
+    uint64_t chunkSize,
+    const TaskSpawner& spawn,
+    size_t maxHelpers,
+    const HashProgressCallback& onProgress = {},
+    const CancelCheck& isCancelled = {}
+) -> ChunkedHash {
+    if (chunkSize == 0) {
+        throw std::runtime_error("hashChunked: chunk size must be positive");
+    }
+
+    ChunkedHash result;
+    result.chunkSize = chunkSize;
+    auto count = static_cast<size_t>((total + chunkSize - 1) / chunkSize);
+    result.chunks.resize(count);
+
+    std::mutex progressMutex;
+    uint64_t processed = 0;
+
+    auto queue = std::make_shared<detail::ChunkQueue>();
+    queue->count = count;
+    queue->run = [&](size_t index) {
+        uint64_t offset = index * chunkSize;
+        uint64_t length = std::min<uint64_t>(chunkSize, total - offset);
+        IOHasher hasher(algorithm);
+        readRange(offset, length, [&](const uint8_t* data, size_t size) {
+            if (isCancelled && isCancelled()) {
+                throw std::runtime_error("Operation cancelled");
+            }
+            hasher.add(data, size);
+            if (onProgress) {
+                std::lock_guard<std::mutex> lock(progressMutex);
+                processed += size;
+                onProgress(processed, total);
+            }
+        });
+        result.chunks[index] = hasher.getHash();
+    };
+
+    if (spawn) {
+        size_t helpers = std::min(maxHelpers, count > 0 ? count - 1 : 0);
+        try {
+            for (size_t i = 0; i < helpers; ++i) {
+                spawn([queue] { queue->drain(); });
+            }
+        } catch (...) {
+            // Could not schedule more helpers; the caller picks up the rest
+        }
+    }
+    queue->drain();
+    if (auto error = queue->close()) {
+        std::rethrow_exception(error);
+    }
+
+    if (algorithm == HashAlgorithm::CRC32) {
+        uint32_t crc = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t length = std::min<uint64_t>(chunkSize, total - i * chunkSize);
+            auto chunkCrc = static_cast<uint32_t>(std::stoul(result.chunks[i], nullptr, 16));
+            crc = CRC32::combine(crc, chunkCrc, static_cast<size_t>(length));
+        }
+        char hex[9];
+        std::snprintf(hex, sizeof(hex), "%08x", crc);
+        result.root = hex;
+    } else {
+        std::vector<uint8_t> digests;
+        for (const auto& chunk : result.chunks) {
+            detail::hexToBytes(chunk, digests);
+        }
+        IOHasher rootHasher(algorithm);
+        rootHasher.add(digests.data(), digests.size());
+        result.root = rootHasher.getHash();
+    }
+    return result;
+}
+
+} // namespace rct_io
+
+#endif // IO_HASHER_HPP
@@ -0,0 +1,896 @@
+/**
+ * @file IOKeyValueStore.hpp
+ * @brief Append-only key-value store for many small values
+ *
+ * Values live in a directory of segment files that are only ever appended
+ * to; an in-memory hash index maps every key to its latest record. One put
+ * costs one write into an already open file instead of a file of its own,
+ * reads are a hash lookup and a copy out of a memory map. Overwritten and
+ * deleted records are dropped by compacting the sealed segments, in the
+ * background, once they are mostly garbage.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_KEY_VALUE_STORE_HPP
+#define IO_KEY_VALUE_STORE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "IOAtomicWrite.hpp"
+
+namespace rct_io {
+
+struct KVStoreOptions {
+    uint64_t maxSegmentBytes = 8 * 1024 * 1024;  // The active segment is sealed past this size
+    bool durable = false;                        // Flush to storage before a write call returns
+    double compactRatio = 0.5;                   // Garbage share of the sealed segments that...
+    uint64_t compactMinBytes = 1024 * 1024;      // ...triggers a compaction, once this much is garbage
+};
+
+struct KVStoreStats {
+    uint64_t keys = 0;
+    uint64_t liveBytes = 0;       // Records the index points to
+    uint64_t deadBytes = 0;       // Overwritten and deleted records, and tombstones
+    uint64_t segments = 0;
+    uint64_t compactions = 0;
+};
+
+/** @brief One entry of KeyValueStore::write(); no value deletes the key */
+struct KVWrite {
+    std::string_view key;
+    std::optional<std::span<const uint8_t>> value;
+};
+
+namespace kv_detail {
+
+/*
+ * Record layout (little endian):
+ *   u32 crc32 of everything after it
+ *   u32 key size
+ *   u32 value size, kTombstone for a deletion
+ *   u32 reserved (0)
+ *   u64 sequence number
+ *   key bytes, value bytes
+ *
+ * The sequence number orders records across segments, so replay does not
+ * depend on which file a record ended up in after a compaction.
+ */
+inline constexpr size_t kHeaderSize = 24;
+inline constexpr uint32_t kTombstone = 0xFFFFFFFFu;
+inline constexpr uint32_t kMaxKeySize = 64 * 1024;
+inline constexpr uint32_t kMaxValueSize = 0x7FFFFFFFu;
+
+struct RecordHeader {
+    uint32_t crc;
+    uint32_t keySize;
+    uint32_t valueSize;
+    uint32_t reserved;
+    uint64_t seq;
+
+    [[nodiscard]] auto tombstone() const -> bool { return valueSize == kTombstone; }
+    [[nodiscard]] auto recordSize() const -> uint64_t {
+        return kHeaderSize + keySize + (tombstone() ? 0 : valueSize);
+    }
+};
+static_assert(sizeof(RecordHeader) == kHeaderSize);
+
+inline auto appendRecord(std::vector<uint8_t>& out, uint64_t seq, std::string_view key,
+                         const std::optional<std::span<const uint8_t>>& value) -> void {
+    RecordHeader header{0, static_cast<uint32_t>(key.size()),
+                        value ? static_cast<uint32_t>(value->size()) : kTombstone, 0, seq};
+    size_t start = out.size();
+    out.resize(start + header.recordSize());
+    uint8_t* record = out.data() + start;
+    std::memcpy(record, &header, kHeaderSize);
+    std::memcpy(record + kHeaderSize, key.data(), key.size());
+    if (value && !value->empty()) {
+        std::memcpy(record + kHeaderSize + key.size(), value->data(), value->size());
+    }
+    header.crc = static_cast<uint32_t>(::crc32(0L, record + 4, static_cast<uInt>(header.recordSize() - 4)));
+    std::memcpy(record, &header.crc, sizeof(header.crc));
+}
+
+inline auto segmentName(uint32_t id) -> std::string {
+    char name[32];
+    std::snprintf(name, sizeof(name), "seg-%08u.log", id);
+    return name;
+}
+
+inline auto parseSegmentName(const std::string& name) -> std::optional<uint32_t> {
+    unsigned id = 0;
+    char tail = 0;
+    if (name.size() != 16 || std::sscanf(name.c_str(), "seg-%8u.lo%c", &id, &tail) != 2 || tail != 'g') {
+        return std::nullopt;
+    }
+    return static_cast<uint32_t>(id);
+}
+
+inline auto preadAll(int fd, uint8_t* data, size_t size, uint64_t offset) -> bool {
+    size_t total = 0;
+    while (total < size) {
+        auto n = ::pread(fd, data + total, size - total, static_cast<off_t>(offset + total));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        total += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+inline auto pwriteAll(int fd, const uint8_t* data, size_t size, uint64_t offset) -> bool {
+    size_t total = 0;
+    while (total < size) {
+        auto n = ::pwrite(fd, data + total, size - total, static_cast<off_t>(offset + total));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        total += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief One segment file with a read-only map over it
+ *
+ * The map covers the segment's reserved size, past the end of the file,
+ * so it keeps working while the active segment grows; only bytes already
+ * written are ever read through it.
+ */
+class Segment {
+public:
+    const uint32_t id;
+    const std::string path;
+
+    Segment(uint32_t segmentId, std::string filePath, int fd, uint64_t size, uint64_t reserve)
+        : id(segmentId), path(std::move(filePath)), fd_(fd), size_(size) {
+        mapSize_ = static_cast<size_t>(std::max(size, reserve));
+        if (mapSize_ > 0) {
+            void* map = ::mmap(nullptr, mapSize_, PROT_READ, MAP_SHARED, fd_, 0);
+            if (map != MAP_FAILED) {
+                map_ = static_cast<const uint8_t*>(map);
+            }
+        }
+    }
+
+    ~Segment() {
+        if (map_) {
+            ::munmap(const_cast<uint8_t*>(map_), mapSize_);
+        }
+        ::close(fd_);
+    }
+
+    Segment(const Segment&) = delete;
+    Segment& operator=(const Segment&) = delete;
+
+    [[nodiscard]] auto fd() const -> int { return fd_; }
+    [[nodiscard]] auto size() const -> uint64_t { return size_.load(std::memory_order_acquire); }
+    auto setSize(uint64_t size) -> void { size_.store(size, std::memory_order_release); }
+
+    /** @brief Bytes [offset, offset + size) through the map, or nullptr */
+    [[nodiscard]] auto view(uint64_t offset, uint64_t size) const -> const uint8_t* {
+        if (!map_ || offset + size > mapSize_ || offset + size > this->size()) {
+            return nullptr;
+        }
+        return map_ + offset;
+    }
+
+    auto read(uint64_t offset, uint8_t* out, size_t size) const -> bool {
+        if (size == 0) {
+            return true;
+        }
+        if (const uint8_t* bytes = view(offset, size)) {
+            std::memcpy(out, bytes, size);
+            return true;
+        }
+        return preadAll(fd_, out, size, offset);
+    }
+
+private:
+    int fd_;
+    std::atomic<uint64_t> size_;
+    const uint8_t* map_ = nullptr;
+    size_t mapSize_ = 0;
+};
+
+} // namespace kv_detail
+
+/**
+ * @brief Key-value store in a directory of append-only segment files
+ *
+ * All methods are thread-safe. Writes are serialized and each write()
+ * call is appended with a single system call; reads run in parallel with
+ * writes and with compaction. A process opens each directory once (see
+ * open()), so all users of a directory share the same index.
+ *
+ * Without the durable option a write survives the app being killed but
+ * not a power loss until flush(); a record torn by a crash is dropped on
+ * the next open, together with whatever followed it.
+ */
+class KeyValueStore : public std::enable_shared_from_this<KeyValueStore> {
+public:
+    using Scheduler = std::function<void(std::function<void()>&&)>;
+
+    /**
+     * @brief Store of a directory, shared with everyone who opened it before
+     *
+     * The directory is created and read on the first operation, not here.
+     * Options and the scheduler of background work apply when the store is
+     * first opened.
+     */
+    static auto open(const std::string& directory, const KVStoreOptions& options,
+                     Scheduler scheduler) -> std::shared_ptr<KeyValueStore> {
+        static std::mutex mutex;
+        static std::unordered_map<std::string, std::weak_ptr<KeyValueStore>> stores;
+
+        std::error_code ec;
+        auto absolute = std::filesystem::absolute(directory, ec);
+        auto key = (ec ? std::filesystem::path(directory) : absolute).lexically_normal().string();
+        while (key.size() > 1 && key.back() == '/') {
+            key.pop_back();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (auto existing = stores[key].lock()) {
+            return existing;
+        }
+        std::shared_ptr<KeyValueStore> store(new KeyValueStore(key, options, std::move(scheduler)));
+        stores[key] = store;
+        return store;
+    }
+
+    KeyValueStore(const KeyValueStore&) = delete;
+    KeyValueStore& operator=(const KeyValueStore&) = delete;
+
+    [[nodiscard]] auto directory() const -> const std::string& { return directory_; }
+
+    /** @brief Value of a key, or nullopt */
+    auto get(std::string_view key) -> std::optional<std::vector<uint8_t>> {
+        load();
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            return std::nullopt;
+        }
+        const auto& entry = it->second;
+        auto segment = segments_.at(entry.segment);
+        std::vector<uint8_t> value(entry.valueSize);
+        uint64_t offset = entry.offset + kv_detail::kHeaderSize + key.size();
+        // The record cannot move while the lock is held, a compaction swaps it under the lock
+        if (!segment->read(offset, value.data(), value.size())) {
+            throw std::runtime_error("Failed to read key: " + std::string(key) + " (" + std::strerror(errno) + ")");
+        }
+        return value;
+    }
+
+    auto contains(std::string_view key) -> bool {
+        load();
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return index_.find(key) != index_.end();
+    }
+
+    /** @brief Keys starting with prefix, sorted */
+    auto keys(std::string_view prefix = {}) -> std::vector<std::string> {
+        load();
+        std::vector<std::string> result;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            result.reserve(prefix.empty() ? index_.size() : 0);
+            for (const auto& [key, entry] : index_) {
+                if (key.compare(0, prefix.size(), prefix) == 0) {
+                    result.push_back(key);
+                }
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    /**
+     * @brief Apply puts and deletes in order, as one append
+     * @return For each entry, whether the key existed before
+     */
+    auto write(std::span<const KVWrite> writes) -> std::vector<bool> {
+        load();
+        for (const auto& w : writes) {
+            if (w.key.empty() || w.key.size() > kv_detail::kMaxKeySize) {
+                throw std::runtime_error("Invalid key size: " + std::to_string(w.key.size()));
+            }
+            if (w.value && w.value->size() > kv_detail::kMaxValueSize) {
+                throw std::runtime_error("Value too large for key: " + std::string(w.key));
+            }
+        }
+
+        std::vector<bool> existed(writes.size());
+        std::lock_guard<std::mutex> writeLock(writeMutex_);
+
+        std::vector<uint8_t> records;
+        std::vector<uint64_t> offsets;
+        offsets.reserve(writes.size());
+        const uint64_t firstSeq = nextSeq_;
+        for (size_t i = 0; i < writes.size(); ++i) {
+            offsets.push_back(records.size());
+            kv_detail::appendRecord(records, firstSeq + i, writes[i].key, writes[i].value);
+        }
+
+        auto segment = active_;
+        if (segment->size() > 0 && segment->size() + records.size() > options_.maxSegmentBytes) {
+            segment = rollActive();
+        }
+        uint64_t base = segment->size();
+        if (!kv_detail::pwriteAll(segment->fd(), records.data(), records.size(), base)
+            || (options_.durable && detail::syncOrdered(segment->fd()) != 0)) {
+            int error = errno;
+            // Cut off what was written so the next append starts at a record boundary
+            [[maybe_unused]] int rc = ::ftruncate(segment->fd(), static_cast<off_t>(base));
+            throw std::runtime_error("Failed to write to store: " + directory_ + " (" + std::strerror(error) + ")");
+        }
+        nextSeq_ = firstSeq + writes.size();
+
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            segment->setSize(base + records.size());
+            for (size_t i = 0; i < writes.size(); ++i) {
+                const auto& w = writes[i];
+                uint64_t size = kv_detail::kHeaderSize + w.key.size() + (w.value ? w.value->size() : 0);
+                auto it = index_.find(w.key);
+                existed[i] = it != index_.end();
+                if (existed[i]) {
+                    deadBytes_[it->second.segment] += it->second.recordSize();
+                    liveBytes_ -= it->second.recordSize();
+                }
+                if (w.value) {
+                    Entry entry{segment->id, static_cast<uint32_t>(w.key.size()), static_cast<uint32_t>(w.value->size()),
+                                base + offsets[i], firstSeq + i};
+                    if (existed[i]) {
+                        it->second = entry;
+                    } else {
+                        index_.emplace(std::string(w.key), entry);
+                    }
+                    liveBytes_ += size;
+                } else {
+                    if (existed[i]) {
+                        index_.erase(it);
+                    }
+                    deadBytes_[segment->id] += size;  // A tombstone is garbage from the start
+                }
+            }
+        }
+        maybeCompact();
+        return existed;
+    }
+
+    auto put(std::string_view key, std::span<const uint8_t> value) -> void {
+        KVWrite w{key, value};
+        write(std::span<const KVWrite>(&w, 1));
+    }
+
+    /** @return Whether the key existed */
+    auto remove(std::string_view key) -> bool {
+        KVWrite w{key, std::nullopt};
+        return write(std::span<const KVWrite>(&w, 1))[0];
+    }
+
+    /** @brief Flush all writes so far to storage */
+    auto flush() -> void {
+        load();
+        std::lock_guard<std::mutex> writeLock(writeMutex_);
+        if (detail::syncFull(active_->fd()) != 0) {
+            throw std::runtime_error("Failed to flush store: " + directory_ + " (" + std::strerror(errno) + ")");
+        }
+    }
+
+    /**
+     * @brief Rewrite the sealed segments without their garbage
+     *
+     * Runs in the calling thread; returns at once when a compaction is
+     * already running. The active segment is sealed first when it holds
+     * garbage, so everything reclaimable is reclaimed.
+     */
+    auto compact() -> void {
+        load();
+        {
+            std::lock_guard<std::mutex> writeLock(writeMutex_);
+            bool activeDirty = false;
+            {
+                std::shared_lock<std::shared_mutex> lock(mutex_);
+                activeDirty = deadBytes(active_->id) > 0;
+            }
+            if (activeDirty) {
+                rollActive();
+            }
+        }
+        runCompaction();
+    }
+
+    auto stats() -> KVStoreStats {
+        load();
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        KVStoreStats stats;
+        stats.keys = index_.size();
+        stats.liveBytes = liveBytes_;
+        for (const auto& [id, dead] : deadBytes_) {
+            stats.deadBytes += dead;
+        }
+        stats.segments = segments_.size();
+        stats.compactions = compactions_;
+        return stats;
+    }
+
+private:
+    struct Entry {
+        uint32_t segment;
+        uint32_t keySize;
+        uint32_t valueSize;
+        uint64_t offset;  // Of the record
+        uint64_t seq;
+
+        [[nodiscard]] auto recordSize() const -> uint64_t {
+            return kv_detail::kHeaderSize + keySize + valueSize;
+        }
+    };
+
+    struct KeyHash {
+        using is_transparent = void;
+        auto operator()(std::string_view key) const -> size_t { return std::hash<std::string_view>{}(key); }
+    };
+
+    using Index = std::unordered_map<std::string, Entry, KeyHash, std::equal_to<>>;
+
+    const std::string directory_;
+    const KVStoreOptions options_;
+    const Scheduler scheduler_;
+
+    std::mutex loadMutex_;
+    std::atomic<bool> loaded_{false};
+
+    // Appends (and the active segment) are serialized by writeMutex_;
+    // the index and segment table are guarded by mutex_
+    std::mutex writeMutex_;
+    std::shared_mutex mutex_;
+    Index index_;
+    std::map<uint32_t, std::shared_ptr<kv_detail::Segment>> segments_;
+    std::unordered_map<uint32_t, uint64_t> deadBytes_;
+    std::shared_ptr<kv_detail::Segment> active_;
+    uint64_t liveBytes_ = 0;
+    uint64_t compactions_ = 0;
+    uint64_t nextSeq_ = 1;
+    std::atomic<uint32_t> nextSegmentId_{1};
+    std::atomic<bool> compactQueued_{false};
+    std::mutex compactMutex_;
+
+    static constexpr const char* kPendingDeletes = "compact.pending";
+
+    KeyValueStore(std::string directory, const KVStoreOptions& options, Scheduler scheduler)
+        : directory_(std::move(directory)), options_(options), scheduler_(std::move(scheduler)) {}
+
+    [[nodiscard]] auto segmentPath(uint32_t id) const -> std::string {
+        return directory_ + "/" + kv_detail::segmentName(id);
+    }
+
+    /** @param reserve Bytes to map ahead of the file end, for a segment that is appended to */
+    auto openSegment(uint32_t id, bool create, uint64_t reserve) -> std::shared_ptr<kv_detail::Segment> {
+        auto path = segmentPath(id);
+        int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC | (create ? O_CREAT | O_EXCL : 0), 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open store segment: " + path + " (" + std::strerror(errno) + ")");
+        }
+        struct stat st {};
+        ::fstat(fd, &st);
+        return std::make_shared<kv_detail::Segment>(id, path, fd, static_cast<uint64_t>(st.st_size), reserve);
+    }
+
+    auto deadBytes(uint32_t segment) const -> uint64_t {
+        auto it = deadBytes_.find(segment);
+        return it == deadBytes_.end() ? 0 : it->second;
+    }
+
+    /** @brief Seal the active segment and start a new one (writeMutex_ held) */
+    auto rollActive() -> std::shared_ptr<kv_detail::Segment> {
+        if (options_.durable) {
+            detail::syncOrdered(active_->fd());
+        }
+        auto segment = openSegment(nextSegmentId_++, true, options_.maxSegmentBytes);
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        segments_[segment->id] = segment;
+        active_ = segment;
+        return segment;
+    }
+
+    /** @brief Finish the deletions of a compaction that was interrupted */
+    auto deletePending() -> void {
+        auto manifest = directory_ + "/" + kPendingDeletes;
+        std::FILE* file = std::fopen(manifest.c_str(), "r");
+        if (!file) {
+            return;
+        }
+        unsigned id = 0;
+        while (std::fscanf(file, "%u", &id) == 1) {
+            ::unlink(segmentPath(id).c_str());
+        }
+        std::fclose(file);
+        ::unlink(manifest.c_str());
+    }
+
+    /**
+     * @brief Read the directory into the index on first use
+     *
+     * A failed load is retried by the next operation.
+     */
+    auto load() -> void {
+        if (loaded_.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(loadMutex_);
+        if (loaded_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(directory_, ec);
+        if (ec) {
+            throw std::runtime_error("Failed to open store: " + directory_ + " (" + ec.message() + ")");
+        }
+        deletePending();
+
+        std::vector<uint32_t> ids;
+        for (const auto& dirEntry : std::filesystem::directory_iterator(directory_, ec)) {
+            if (auto id = kv_detail::parseSegmentName(dirEntry.path().filename().string())) {
+                ids.push_back(*id);
+            }
+        }
+        if (ec) {
+            throw std::runtime_error("Failed to open store: " + directory_ + " (" + ec.message() + ")");
+        }
+        std::sort(ids.begin(), ids.end());
+
+        Index index;
+        std::unordered_map<std::string, uint64_t> deleted;  // Seq of the latest tombstone per key
+        std::map<uint32_t, std::shared_ptr<kv_detail::Segment>> segments;
+        std::unordered_map<uint32_t, uint64_t> total;
+        uint64_t maxSeq = 0;
+        uint64_t lastMinSeq = 0, othersMaxSeq = 0;
+
+        for (uint32_t id : ids) {
+            bool last = id == ids.back();
+            auto segment = openSegment(id, false, last ? options_.maxSegmentBytes : 0);
+            uint64_t minSeq = 0, segmentMaxSeq = 0;
+            uint64_t end = replay(*segment, index, deleted, minSeq, segmentMaxSeq);
+            if (end < segment->size()) {
+                // Torn or corrupt tail: drop it so appends continue from a record boundary
+                if (::ftruncate(segment->fd(), static_cast<off_t>(end)) == 0) {
+                    segment->setSize(end);
+                }
+            }
+            if (end == 0 && !last) {
+                ::unlink(segment->path.c_str());
+                continue;
+            }
+            maxSeq = std::max(maxSeq, segmentMaxSeq);
+            if (last) {
+                lastMinSeq = minSeq;
+            } else {
+                othersMaxSeq = std::max(othersMaxSeq, segmentMaxSeq);
+            }
+            total[id] = end;
+            segments[id] = std::move(segment);
+        }
+
+        std::unordered_map<uint32_t, uint64_t> live;
+        uint64_t liveBytes = 0;
+        for (const auto& [key, entry] : index) {
+            live[entry.segment] += entry.recordSize();
+            liveBytes += entry.recordSize();
+        }
+        std::unordered_map<uint32_t, uint64_t> dead;
+        for (const auto& [id, size] : total) {
+            if (size > live[id]) {
+                dead[id] = size - live[id];
+            }
+        }
+
+        // Keep appending to the last segment only if everything in it is newer than
+        // the rest; a compaction, which drops tombstones, relies on that order
+        std::shared_ptr<kv_detail::Segment> active;
+        if (!ids.empty() && segments.count(ids.back()) && total[ids.back()] < options_.maxSegmentBytes
+            && (total[ids.back()] == 0 || lastMinSeq > othersMaxSeq)) {
+            active = segments[ids.back()];
+        }
+
+        std::lock_guard<std::mutex> writeLock(writeMutex_);
+        std::unique_lock<std::shared_mutex> indexLock(mutex_);
+        index_ = std::move(index);
+        segments_ = std::move(segments);
+        deadBytes_ = std::move(dead);
+        liveBytes_ = liveBytes;
+        nextSeq_ = maxSeq + 1;
+        nextSegmentId_ = ids.empty() ? 1 : ids.back() + 1;
+        if (!active) {
+            active = openSegment(nextSegmentId_++, true, options_.maxSegmentBytes);
+            segments_[active->id] = active;
+        }
+        active_ = std::move(active);
+        loaded_.store(true, std::memory_order_release);
+    }
+
+    /** @return End of the last valid record */
+    static auto replay(const kv_detail::Segment& segment, Index& index, std::unordered_map<std::string, uint64_t>& deleted,
+                       uint64_t& minSeq, uint64_t& maxSeq) -> uint64_t {
+        uint64_t size = segment.size();
+        uint64_t offset = 0;
+        std::vector<uint8_t> buffer;
+        while (offset + kv_detail::kHeaderSize <= size) {
+            kv_detail::RecordHeader header{};
+            if (!segment.read(offset, reinterpret_cast<uint8_t*>(&header), kv_detail::kHeaderSize)) {
+                break;
+            }
+            if (header.keySize == 0 || header.keySize > kv_detail::kMaxKeySize
+                || (!header.tombstone() && header.valueSize > kv_detail::kMaxValueSize)
+                || offset + header.recordSize() > size) {
+                break;
+            }
+            uint64_t recordSize = header.recordSize();
+            const uint8_t* record = segment.view(offset, recordSize);
+            if (!record) {
+                buffer.resize(recordSize);
+                if (!segment.read(offset, buffer.data(), recordSize)) {
+                    break;
+                }
+                record = buffer.data();
+            }
+            auto crc = static_cast<uint32_t>(::crc32(0L, record + 4, static_cast<uInt>(recordSize - 4)));
+            if (crc != header.crc) {
+                break;
+            }
+
+            minSeq = minSeq == 0 ? header.seq : std::min(minSeq, header.seq);
+            maxSeq = std::max(maxSeq, header.seq);
+            std::string key(reinterpret_cast<const char*>(record + kv_detail::kHeaderSize), header.keySize);
+            auto it = index.find(key);
+            auto tomb = deleted.find(key);
+            uint64_t latest = std::max(it != index.end() ? it->second.seq : 0,
+                                       tomb != deleted.end() ? tomb->second : 0);
+            if (header.seq > latest) {
+                if (header.tombstone()) {
+                    if (it != index.end()) {
+                        index.erase(it);
+                    }
+                    deleted[std::move(key)] = header.seq;
+                } else {
+                    Entry entry{segment.id, header.keySize, header.valueSize, offset, header.seq};
+                    if (tomb != deleted.end()) {
+                        deleted.erase(tomb);
+                    }
+                    if (it != index.end()) {
+                        it->second = entry;
+                    } else {
+                        index.emplace(std::move(key), entry);
+                    }
+                }
+            }
+            offset += recordSize;
+        }
+        return offset;
+    }
+
+    /** @brief Whether the sealed segments hold enough garbage to be worth a compaction */
+    auto compactionDue() -> bool {
+        uint64_t sealed = 0, dead = 0;
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto& [id, segment] : segments_) {
+            if (id != active_->id) {
+                sealed += segment->size();
+                dead += deadBytes(id);
+            }
+        }
+        return dead >= options_.compactMinBytes
+            && static_cast<double>(dead) >= options_.compactRatio * static_cast<double>(sealed);
+    }
+
+    /** @brief Queue a background compaction once the sealed segments are mostly garbage */
+    auto maybeCompact() -> void {
+        if (!scheduler_ || compactQueued_.load(std::memory_order_relaxed) || !compactionDue()) {
+            return;
+        }
+        if (compactQueued_.exchange(true)) {
+            return;
+        }
+        std::weak_ptr<KeyValueStore> weak = weak_from_this();
+        scheduler_([weak] {
+            auto store = weak.lock();
+            if (!store) {
+                return;
+            }
+            try {
+                if (store->compactionDue()) {
+                    store->runCompaction();
+                }
+            } catch (...) {
+                // Nothing is lost: the old segments stay until the next attempt
+            }
+            store->compactQueued_ = false;
+        });
+    }
+
+    auto compactError() const -> std::runtime_error {
+        return std::runtime_error("Failed to compact store: " + directory_ + " (" + std::strerror(errno) + ")");
+    }
+
+    auto runCompaction() -> void {
+        std::lock_guard<std::mutex> running(compactMutex_);
+
+        // 1. Snapshot the live records of every sealed segment
+        std::vector<std::shared_ptr<kv_detail::Segment>> sealed;
+        std::vector<std::pair<std::string, Entry>> live;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            for (const auto& [id, segment] : segments_) {
+                if (id != active_->id) {
+                    sealed.push_back(segment);
+                }
+            }
+            if (sealed.empty()) {
+                return;
+            }
+            uint32_t activeId = active_->id;
+            for (const auto& [key, entry] : index_) {
+                if (entry.segment != activeId) {
+                    live.emplace_back(key, entry);
+                }
+            }
+        }
+        // Copy in file order, so reads out of the old segments stay sequential
+        std::sort(live.begin(), live.end(), [](const auto& a, const auto& b) {
+            return a.second.segment != b.second.segment ? a.second.segment < b.second.segment
+                                                        : a.second.offset < b.second.offset;
+        });
+        std::unordered_map<uint32_t, std::shared_ptr<kv_detail::Segment>> byId;
+        for (const auto& segment : sealed) {
+            byId[segment->id] = segment;
+        }
+
+        // 2. Copy them, verbatim with their sequence numbers, into new segments
+        std::vector<std::shared_ptr<kv_detail::Segment>> outputs;
+        std::vector<Entry> moved(live.size());
+        std::vector<uint8_t> buffer;
+        auto flushBuffer = [&] {
+            auto& out = outputs.back();
+            if (!kv_detail::pwriteAll(out->fd(), buffer.data(), buffer.size(), out->size())) {
+                throw compactError();
+            }
+            out->setSize(out->size() + buffer.size());
+            buffer.clear();
+        };
+        try {
+            for (size_t i = 0; i < live.size(); ++i) {
+                const auto& entry = live[i].second;
+                uint64_t size = entry.recordSize();
+                uint64_t filled = outputs.empty() ? 0 : outputs.back()->size() + buffer.size();
+                if (outputs.empty() || (filled > 0 && filled + size > options_.maxSegmentBytes)) {
+                    if (!outputs.empty()) {
+                        flushBuffer();
+                    }
+                    outputs.push_back(openSegment(nextSegmentId_++, true, 0));
+                }
+                size_t at = buffer.size();
+                buffer.resize(at + size);
+                if (!byId.at(entry.segment)->read(entry.offset, buffer.data() + at, size)) {
+                    throw compactError();
+                }
+                moved[i] = entry;
+                moved[i].segment = outputs.back()->id;
+                moved[i].offset = outputs.back()->size() + at;
+                if (buffer.size() >= 1024 * 1024) {
+                    flushBuffer();
+                }
+            }
+            if (!buffer.empty()) {
+                flushBuffer();
+            }
+            // The copies must be on storage before the originals go
+            for (const auto& out : outputs) {
+                if (detail::syncOrdered(out->fd()) != 0) {
+                    throw compactError();
+                }
+            }
+            // Dropping tombstones is only safe once all originals are gone: list
+            // them first, so a crash halfway through the deletions is finished on open
+            std::string manifest;
+            for (const auto& segment : sealed) {
+                manifest += std::to_string(segment->id) + "\n";
+            }
+            writeFileAtomic(directory_ + "/" + kPendingDeletes,
+                            std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(manifest.data()), manifest.size()));
+        } catch (...) {
+            for (const auto& out : outputs) {
+                ::unlink(out->path.c_str());
+            }
+            throw;
+        }
+
+        // Remap the copies now that their size is final
+        for (auto& out : outputs) {
+            out = openSegment(out->id, false, 0);
+        }
+
+        // 3. Point the index at the copies, unless a key was written meanwhile
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            for (const auto& out : outputs) {
+                segments_[out->id] = out;
+            }
+            for (size_t i = 0; i < live.size(); ++i) {
+                auto it = index_.find(live[i].first);
+                if (it != index_.end() && it->second.segment == live[i].second.segment
+                    && it->second.offset == live[i].second.offset) {
+                    it->second = moved[i];
+                } else {
+                    deadBytes_[moved[i].segment] += moved[i].recordSize();
+                }
+            }
+            for (const auto& segment : sealed) {
+                segments_.erase(segment->id);
+                deadBytes_.erase(segment->id);
+            }
+            ++compactions_;
+        }
+
+        // 4. Drop the old files; a reader still holding one keeps its map until it is done
+        for (const auto& segment : sealed) {
+            ::unlink(segment->path.c_str());
+        }
+        ::unlink((directory_ + "/" + kPendingDeletes).c_str());
+    }
+};
+
+} // namespace rct_io
+
+#endif // IO_KEY_VALUE_STORE_HPP
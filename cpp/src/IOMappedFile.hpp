@@ -0,0 +1,248 @@
+/**
+ * @file IOMappedFile.hpp
+ * @brief Memory-mapped file region
+ *
+ * Maps a byte range of a file into memory with mmap so it can be exposed
+ * to JavaScript as an ArrayBuffer without reading it into the heap.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_MAPPED_FILE_HPP
+#define IO_MAPPED_FILE_HPP
+
+#include <string>
+#include <stdexcept>
+#include <mutex>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rct_io {
+
+/**
+ * @brief Access pattern hint for a mapped region (maps to madvise)
+ */
+enum class MapAdvice : int {
+    Normal = 0,      // MADV_NORMAL
+    Sequential = 1,  // MADV_SEQUENTIAL - aggressive read-ahead
+    Random = 2,      // MADV_RANDOM - no read-ahead
+    WillNeed = 3,    // MADV_WILLNEED - start paging in now
+    DontNeed = 4,    // MADV_DONTNEED - pages may be dropped
+};
+
+/**
+ * @brief A byte range of a file mapped into memory
+ *
+ * The mapping starts at the page-aligned offset below the requested one;
+ * data() points at the requested offset inside it.
+ *
+ * unmap() releases the file pages early but keeps the address range reserved
+ * as anonymous zero pages, so JS code still holding the ArrayBuffer sees
+ * zeros instead of faulting. The address range itself is returned to the
+ * system in the destructor.
+ *
+ * @note advise()/sync()/unmap() are thread-safe with respect to each other.
+ */
+class IOMappedFile {
+private:
+    void* base_ = nullptr;      // Page-aligned start of the mapping
+    size_t mappedLength_ = 0;   // Length of the mapping from base_
+    size_t delta_ = 0;          // Offset of requested start within the mapping
+    size_t length_ = 0;         // Requested length
+    bool writable_ = false;
+    bool mapped_ = false;       // false once unmap() has released the file
+    std::string path_;
+    mutable std::mutex mutex_;
+
+    [[nodiscard]] static auto toNativeAdvice(MapAdvice advice) -> int {
+        switch (advice) {
+            case MapAdvice::Sequential: return MADV_SEQUENTIAL;
+            case MapAdvice::Random:     return MADV_RANDOM;
+            case MapAdvice::WillNeed:   return MADV_WILLNEED;
+            case MapAdvice::DontNeed:   return MADV_DONTNEED;
+            default:                    return MADV_NORMAL;
+        }
+    }
+
+public:
+    /**
+     * @brief Map a range of a file
+     * @param path File path
+     * @param offset Start offset in bytes
+     * @param length Number of bytes to map, -1 for everything after offset
+     * @param readOnly Map private copy-on-write (stores stay in memory and never
+     *   reach the file) or read-write (shared with the file)
+     * @throws std::runtime_error on failure
+     */
+    IOMappedFile(const std::string& path, int64_t offset, int64_t length, bool readOnly)
+        : writable_(!readOnly), path_(path)
+    {
+        if (offset < 0) {
+            throw std::runtime_error("mmapFile: offset must be non-negative");
+        }
+
+        int fd = ::open(path.c_str(), readOnly ? O_RDONLY : O_RDWR);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open file for mapping: " + path);
+        }
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat file for mapping: " + path);
+        }
+
+        auto fileSize = static_cast<int64_t>(st.st_size);
+        if (offset > fileSize) {
+            ::close(fd);
+            throw std::runtime_error("mmapFile: offset beyond end of file: " + path);
+        }
+        if (length < 0 || length > fileSize - offset) {
+            length = fileSize - offset;
+        }
+
+        length_ = static_cast<size_t>(length);
+        if (length_ == 0) {
+            // mmap rejects empty mappings; expose an empty buffer instead
+            ::close(fd);
+            return;
+        }
+
+        auto pageSize = static_cast<int64_t>(::sysconf(_SC_PAGESIZE));
+        auto alignedOffset = offset - (offset % pageSize);
+        delta_ = static_cast<size_t>(offset - alignedOffset);
+        mappedLength_ = length_ + delta_;
+
+        // JS sees the mapping as an ordinary ArrayBuffer and may store into it,
+        // so a read-only mapping is writable but private instead of PROT_READ
+        int flags = readOnly ? MAP_PRIVATE : MAP_SHARED;
+        void* addr = ::mmap(nullptr, mappedLength_, PROT_READ | PROT_WRITE, flags, fd,
+                            static_cast<off_t>(alignedOffset));
+        int mmapErrno = errno;
+
+        // The mapping keeps its own reference to the file
+        ::close(fd);
+
+        if (addr == MAP_FAILED) {
+            throw std::runtime_error("mmap failed for " + path + ": " + std::strerror(mmapErrno));
+        }
+
+        base_ = addr;
+        mapped_ = true;
+    }
+
+    ~IOMappedFile() {
+        if (base_) {
+            if (mapped_ && writable_) {
+                ::msync(base_, mappedLength_, MS_SYNC);
+            }
+            ::munmap(base_, mappedLength_);
+        }
+    }
+
+    // Non-copyable, non-movable (data pointer is handed out to JS)
+    IOMappedFile(const IOMappedFile&) = delete;
+    IOMappedFile& operator=(const IOMappedFile&) = delete;
+    IOMappedFile(IOMappedFile&&) = delete;
+    IOMappedFile& operator=(IOMappedFile&&) = delete;
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    [[nodiscard]] auto data() const -> uint8_t* {
+        return base_ ? static_cast<uint8_t*>(base_) + delta_ : nullptr;
+    }
+
+    [[nodiscard]] auto size() const -> size_t {
+        return length_;
+    }
+
+    [[nodiscard]] auto getPath() const -> const std::string& {
+        return path_;
+    }
+
+    [[nodiscard]] auto isMapped() const -> bool {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return mapped_;
+    }
+
+    // ========================================================================
+    // Operations
+    // ========================================================================
+
+    /**
+     * @brief Give the kernel an access pattern hint for the whole mapping
+     */
+    auto advise(MapAdvice advice) -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!mapped_) {
+            return;
+        }
+        if (::madvise(base_, mappedLength_, toNativeAdvice(advice)) != 0) {
+            throw std::runtime_error(std::string("madvise failed: ") + std::strerror(errno));
+        }
+    }
+
+    /**
+     * @brief Flush modified pages of a writable mapping to the file
+     */
+    auto sync() -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!mapped_ || !writable_) {
+            return;
+        }
+        if (::msync(base_, mappedLength_, MS_SYNC) != 0) {
+            throw std::runtime_error(std::string("msync failed: ") + std::strerror(errno));
+        }
+    }
+
+    /**
+     * @brief Release the file pages now, without waiting for garbage collection
+     *
+     * The address range is replaced in place by anonymous zero pages so that
+     * outstanding ArrayBuffer views stay valid (they see zeros afterwards).
+     */
+    auto unmap() -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!mapped_) {
+            return;
+        }
+        if (writable_) {
+            ::msync(base_, mappedLength_, MS_SYNC);
+        }
+        void* addr = ::mmap(base_, mappedLength_, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+        if (addr == MAP_FAILED) {
+            throw std::runtime_error(std::string("unmap failed: ") + std::strerror(errno));
+        }
+        mapped_ = false;
+    }
+};
+
+} // namespace rct_io
+
+#endif // IO_MAPPED_FILE_HPP
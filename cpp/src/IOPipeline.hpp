@@ -0,0 +1,578 @@
+/**
+ * @file IOPipeline.hpp
+ * @brief Native byte pipelines: source -> stages -> sink
+ *
+ * Streams a file range through optional transform stages (hash, base64,
+ * gzip) into a file, a handle or memory, so bulk data never has to pass
+ * through JavaScript.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_PIPELINE_HPP
+#define IO_PIPELINE_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include "IOFileHandle.hpp"
+#include "IOHasher.hpp"
+#include "IOStatCache.hpp"
+#include "IOTextCodec.hpp"
+
+namespace rct_io {
+
+/**
+ * @brief Transform stage of a pipeline
+ */
+enum class PipeStageKind : int {
+    Hash = 0,          // Pass-through; param = HashAlgorithm, digest in the result
+    Base64Encode = 1,  // param: 0 = standard with padding, 1 = URL-safe without
+    Base64Decode = 2,  // Accepts both alphabets, skips whitespace
+    Gzip = 3,          // param: compression level 0-9, -1 = zlib default
+    Gunzip = 4,        // Decodes gzip or zlib streams (auto-detected)
+};
+
+/**
+ * @brief Receives the output of a stage
+ */
+using PipeOutput = std::function<void(const uint8_t* data, size_t size)>;
+
+/**
+ * @brief One transform step; sees its input in arbitrary chunk sizes
+ */
+class PipeStage {
+public:
+    virtual ~PipeStage() = default;
+
+    /** @brief Transform a chunk, emitting any amount of output */
+    virtual auto process(const uint8_t* data, size_t size, const PipeOutput& out) -> void = 0;
+
+    /** @brief Flush buffered output after the last chunk */
+    virtual auto finish(const PipeOutput& /*out*/) -> void {}
+
+    /** @brief Digest of a hashing stage, nullopt for other stages */
+    [[nodiscard]] virtual auto digest() const -> std::optional<std::string> { return std::nullopt; }
+};
+
+/**
+ * @brief Destination of the last stage's output
+ */
+class PipeSink {
+public:
+    virtual ~PipeSink() = default;
+    virtual auto write(const uint8_t* data, size_t size) -> void = 0;
+    /** @brief Called once after all data was written successfully */
+    virtual auto finish() -> void {}
+    /** @brief True once the sink wants no more data; may be called from the reader thread */
+    [[nodiscard]] virtual auto full() const -> bool { return false; }
+};
+
+/**
+ * @brief Outcome of a pipeline run
+ */
+struct PipelineResult {
+    uint64_t bytesRead = 0;            // Bytes taken from the source
+    uint64_t bytesWritten = 0;         // Bytes handed to the sink
+    std::vector<std::string> digests;  // One per hash stage, in stage order
+};
+
+namespace detail {
+
+/// Output block size of the expanding stages (base64, gzip)
+inline constexpr size_t kPipeOutputBlock = 64 * 1024;
+
+class HashStage final : public PipeStage {
+private:
+    IOHasher hasher_;
+    std::optional<std::string> digest_;
+
+public:
+    explicit HashStage(HashAlgorithm algorithm) : hasher_(algorithm) {}
+
+    auto process(const uint8_t* data, size_t size, const PipeOutput& out) -> void override {
+        hasher_.add(data, size);
+        out(data, size);
+    }
+
+    auto finish(const PipeOutput&) -> void override {
+        digest_ = hasher_.getHash();
+    }
+
+    [[nodiscard]] auto digest() const -> std::optional<std::string> override {
+        return digest_;
+    }
+};
+
+class Base64EncodeStage final : public PipeStage {
+private:
+    const char* alphabet_;
+    bool pad_;
+    std::array<uint8_t, 3> carry_{};
+    size_t carrySize_ = 0;
+    std::vector<uint8_t> block_;
+
+    auto encodeTriple(uint32_t v, uint8_t* dst) const -> void {
+        dst[0] = static_cast<uint8_t>(alphabet_[(v >> 18) & 0x3F]);
+        dst[1] = static_cast<uint8_t>(alphabet_[(v >> 12) & 0x3F]);
+        dst[2] = static_cast<uint8_t>(alphabet_[(v >> 6) & 0x3F]);
+        dst[3] = static_cast<uint8_t>(alphabet_[v & 0x3F]);
+    }
+
+public:
+    explicit Base64EncodeStage(bool urlSafe)
+        : alphabet_(urlSafe ? codec_detail::kBase64Url : codec_detail::kBase64)
+        , pad_(!urlSafe)
+        , block_(kPipeOutputBlock) {}
+
+    auto process(const uint8_t* data, size_t size, const PipeOutput& out) -> void override {
+        // Complete the triple left over from the previous chunk
+        while (carrySize_ > 0 && size > 0) {
+            carry_[carrySize_++] = *data++;
+            --size;
+            if (carrySize_ == 3) {
+                encodeTriple((uint32_t{carry_[0]} << 16) | (uint32_t{carry_[1]} << 8) | carry_[2],
+                             block_.data());
+                out(block_.data(), 4);
+                carrySize_ = 0;
+            }
+        }
+
+        size_t used = 0;
+        while (size >= 3) {
+            size_t triples = std::min(size / 3, block_.size() / 4);
+            for (size_t i = 0; i < triples; ++i, data += 3) {
+                uint32_t v = (uint32_t{data[0]} << 16) | (uint32_t{data[1]} << 8) | data[2];
+                encodeTriple(v, block_.data() + used);
+                used += 4;
+            }
+            size -= triples * 3;
+            out(block_.data(), used);
+            used = 0;
+        }
+
+        for (size_t i = 0; i < size; ++i) {
+            carry_[carrySize_++] = data[i];
+        }
+    }
+
+    auto finish(const PipeOutput& out) -> void override {
+        if (carrySize_ == 0) {
+            return;
+        }
+        uint32_t v = uint32_t{carry_[0]} << 16;
+        if (carrySize_ == 2) {
+            v |= uint32_t{carry_[1]} << 8;
+        }
+        encodeTriple(v, block_.data());
+        size_t length = carrySize_ + 1;
+        if (pad_) {
+            for (size_t i = length; i < 4; ++i) {
+                block_[i] = '=';
+            }
+            length = 4;
+        }
+        out(block_.data(), length);
+        carrySize_ = 0;
+    }
+};
+
+class Base64DecodeStage final : public PipeStage {
+private:
+    uint32_t bits_ = 0;
+    int bitCount_ = 0;
+    bool ended_ = false;  // Padding seen; only whitespace and '=' may follow
+    std::vector<uint8_t> block_;
+
+public:
+    Base64DecodeStage() : block_(kPipeOutputBlock) {}
+
+    auto process(const uint8_t* data, size_t size, const PipeOutput& out) -> void override {
+        size_t used = 0;
+        for (size_t i = 0; i < size; ++i) {
+            auto c = data[i];
+            if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+                continue;
+            }
+            if (c == '=') {
+                ended_ = true;
+                continue;
+            }
+            auto value = codec_detail::kBase64Decode[c];
+            if (value == codec_detail::kInvalid || ended_) {
+                throw std::runtime_error("Invalid base64 input");
+            }
+            bits_ = (bits_ << 6) | static_cast<uint32_t>(value);
+            bitCount_ += 6;
+            if (bitCount_ >= 8) {
+                bitCount_ -= 8;
+                block_[used++] = static_cast<uint8_t>(bits_ >> bitCount_);
+                if (used == block_.size()) {
+                    out(block_.data(), used);
+                    used = 0;
+                }
+            }
+        }
+        if (used > 0) {
+            out(block_.data(), used);
+        }
+    }
+
+    auto finish(const PipeOutput&) -> void override {
+        // 6 leftover bits mean a single trailing character, which encodes nothing
+        if (bitCount_ >= 6) {
+            throw std::runtime_error("Invalid base64 input: truncated");
+        }
+    }
+};
+
+class GzipStage final : public PipeStage {
+private:
+    z_stream stream_{};
+    std::vector<uint8_t> block_;
+
+    auto run(int flush, const PipeOutput& out) -> int {
+        int status = Z_OK;
+        do {
+            stream_.next_out = block_.data();
+            stream_.avail_out = static_cast<uInt>(block_.size());
+            status = deflate(&stream_, flush);
+            if (status == Z_STREAM_ERROR) {
+                throw std::runtime_error("gzip: compression failed");
+            }
+            auto produced = block_.size() - stream_.avail_out;
+            if (produced > 0) {
+                out(block_.data(), produced);
+            }
+        } while (stream_.avail_out == 0);
+        return status;
+    }
+
+public:
+    explicit GzipStage(int level) : block_(kPipeOutputBlock) {
+        if (level < -1 || level > 9) {
+            level = Z_DEFAULT_COMPRESSION;
+        }
+        // 15 + 16: largest window, gzip header and trailer
+        if (deflateInit2(&stream_, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::runtime_error("gzip: cannot initialize compressor");
+        }
+    }
+
+    ~GzipStage() override {
+        deflateEnd(&stream_);
+    }
+
+    GzipStage(const GzipStage&) = delete;
+    GzipStage& operator=(const GzipStage&) = delete;
+
+    auto process(const uint8_t* data, size_t size, const PipeOutput& out) -> void override {
+        stream_.next_in = const_cast<Bytef*>(data);
+        stream_.avail_in = static_cast<uInt>(size);
+        run(Z_NO_FLUSH, out);
+    }
+
+    auto finish(const PipeOutput& out) -> void override {
+        stream_.next_in = nullptr;
+        stream_.avail_in = 0;
+        while (run(Z_FINISH, out) != Z_STREAM_END) {
+        }
+    }
+};
+
+class GunzipStage final : public PipeStage {
+private:
+    z_stream stream_{};
+    std::vector<uint8_t> block_;
+    bool inStream_ = false;  // Inside a member whose end was not seen yet
+
+public:
+    GunzipStage() : block_(kPipeOutputBlock) {
+        // 15 + 32: largest window, detect gzip or zlib header
+        if (inflateInit2(&stream_, 15 + 32) != Z_OK) {
+            throw std::runtime_error("gunzip: cannot initialize decompressor");
+        }
+    }
+
+    ~GunzipStage() override {
+        inflateEnd(&stream_);
+    }
+
+    GunzipStage(const GunzipStage&) = delete;
+    GunzipStage& operator=(const GunzipStage&) = delete;
+
+    auto process(const uint8_t* data, size_t size, const PipeOutput& out) -> void override {
+        stream_.next_in = const_cast<Bytef*>(data);
+        stream_.avail_in = static_cast<uInt>(size);
+        if (size == 0) {
+            return;
+        }
+        inStream_ = true;
+        do {
+            stream_.next_out = block_.data();
+            stream_.avail_out = static_cast<uInt>(block_.size());
+            auto status = inflate(&stream_, Z_NO_FLUSH);
+            if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) {
+                throw std::runtime_error(std::string("gunzip: invalid compressed data")
+                    + (stream_.msg ? std::string(": ") + stream_.msg : std::string()));
+            }
+            auto produced = block_.size() - stream_.avail_out;
+            if (produced > 0) {
+                out(block_.data(), produced);
+            }
+            if (status == Z_STREAM_END) {
+                // Concatenated gzip members decode as one stream
+                inStream_ = stream_.avail_in > 0;
+                inflateReset(&stream_);
+            } else if (status == Z_BUF_ERROR) {
+                break;  // Needs more input
+            }
+            // A full output block may leave more output pending
+        } while (stream_.avail_in > 0 || stream_.avail_out == 0);
+    }
+
+    auto finish(const PipeOutput&) -> void override {
+        if (inStream_) {
+            throw std::runtime_error("gunzip: truncated compressed data");
+        }
+    }
+};
+
+class FileSink final : public PipeSink {
+private:
+    FILE* file_ = nullptr;
+    std::string path_;
+    bool append_;
+
+public:
+    FileSink(const std::string& path, bool append) : path_(path), append_(append) {
+        file_ = std::fopen(path.c_str(), append ? "ab" : "wb");
+        if (!file_) {
+            throw std::runtime_error("Cannot open file for writing: " + path);
+        }
+    }
+
+    ~FileSink() override {
+        if (file_) {
+            // Not finished: the run failed, drop a file this sink created
+            std::fclose(file_);
+            if (!append_) {
+                std::error_code ec;
+                std::filesystem::remove(path_, ec);
+            }
+        }
+        StatCache::instance().invalidate(path_);
+    }
+
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    auto write(const uint8_t* data, size_t size) -> void override {
+        if (std::fwrite(data, 1, size, file_) < size) {
+            throw std::runtime_error("Write error: " + path_);
+        }
+    }
+
+    auto finish() -> void override {
+        auto failed = std::fclose(file_) != 0;
+        file_ = nullptr;
+        if (failed) {
+            throw std::runtime_error("Write error: " + path_);
+        }
+    }
+};
+
+class HandleSink final : public PipeSink {
+private:
+    std::shared_ptr<IOFileHandle> handle_;
+
+public:
+    explicit HandleSink(std::shared_ptr<IOFileHandle> handle) : handle_(std::move(handle)) {}
+
+    auto write(const uint8_t* data, size_t size) -> void override {
+        handle_->write({data, size});
+    }
+};
+
+class MemorySink final : public PipeSink {
+private:
+    std::vector<uint8_t>& buffer_;
+
+public:
+    explicit MemorySink(std::vector<uint8_t>& buffer) : buffer_(buffer) {}
+
+    auto write(const uint8_t* data, size_t size) -> void override {
+        buffer_.insert(buffer_.end(), data, data + size);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A byte range of an open file, read with pread
+ */
+struct PipeSource {
+    std::shared_ptr<IOFileHandle> handle;
+    int64_t offset = 0;
+    int64_t length = -1;  // -1 = to the end of the file
+};
+
+/**
+ * @brief Chain of stages from a source to a sink
+ *
+ * The source is read in kHashChunkSize chunks through the double-buffered
+ * read-ahead of detail::forEachChunk, so the next chunk is read while the
+ * current one runs through the stages. Memory use is bounded by the two
+ * read buffers plus one output block per expanding stage, whatever the
+ * size of the input (except for the memory sink, which holds the output).
+ *
+ * @code
+ *   IOPipeline pipeline;
+ *   pipeline.addStage(PipeStageKind::Hash, static_cast<int>(HashAlgorithm::CRC32));
+ *   pipeline.addStage(PipeStageKind::Gzip, 6);
+ *   detail::FileSink sink("/tmp/out.gz", false);
+ *   auto result = pipeline.run(source, sink);  // result.digests[0] = CRC32 of the input
+ * @endcode
+ */
+class IOPipeline {
+private:
+    std::vector<std::unique_ptr<PipeStage>> stages_;
+
+public:
+    /**
+     * @brief Append a stage
+     * @param param Stage parameter, see PipeStageKind
+     * @throws std::runtime_error for an unknown stage kind
+     */
+    auto addStage(PipeStageKind kind, int param = -1) -> void {
+        switch (kind) {
+            case PipeStageKind::Hash:
+                stages_.push_back(std::make_unique<detail::HashStage>(
+                    param < 0 ? HashAlgorithm::SHA256 : static_cast<HashAlgorithm>(param)));
+                break;
+            case PipeStageKind::Base64Encode:
+                stages_.push_back(std::make_unique<detail::Base64EncodeStage>(param == 1));
+                break;
+            case PipeStageKind::Base64Decode:
+                stages_.push_back(std::make_unique<detail::Base64DecodeStage>());
+                break;
+            case PipeStageKind::Gzip:
+                stages_.push_back(std::make_unique<detail::GzipStage>(param));
+                break;
+            case PipeStageKind::Gunzip:
+                stages_.push_back(std::make_unique<detail::GunzipStage>());
+                break;
+            default:
+                throw std::runtime_error("Unknown pipeline stage: " + std::to_string(static_cast<int>(kind)));
+        }
+    }
+
+    /**
+     * @brief Stream the source through all stages into the sink
+     * @param onProgress Optional callback, (source bytes read, source bytes total)
+     * @param isCancelled Optional cancellation check, polled before each chunk
+     * @param spawn Schedules the read-ahead task (empty: read on this thread)
+     * @throws std::runtime_error("Operation cancelled") when cancelled
+     */
+    auto run(
+        const PipeSource& source,
+        PipeSink& sink,
+        const HashProgressCallback& onProgress = {},
+        const CancelCheck& isCancelled = {},
+        const TaskSpawner& spawn = {}
+    ) -> PipelineResult {
+        if (source.offset < 0) {
+            throw std::runtime_error("Offset must be non-negative");
+        }
+
+        PipelineResult result;
+        auto fileSize = static_cast<int64_t>(std::filesystem::file_size(source.handle->getPath()));
+        auto available = std::max<int64_t>(0, fileSize - source.offset);
+        auto total = static_cast<uint64_t>(
+            source.length < 0 ? available : std::min(source.length, available));
+
+        // outputs[i] feeds stage i; the last one feeds the sink
+        std::vector<PipeOutput> outputs(stages_.size() + 1);
+        outputs.back() = [&](const uint8_t* data, size_t size) {
+            sink.write(data, size);
+            result.bytesWritten += size;
+        };
+        for (size_t i = stages_.size(); i-- > 0;) {
+            outputs[i] = [this, i, &outputs](const uint8_t* data, size_t size) {
+                stages_[i]->process(data, size, outputs[i + 1]);
+            };
+        }
+
+        auto position = source.offset;
+        detail::forEachChunk(
+            [&](uint8_t* dst, size_t max) -> size_t {
+                if (isCancelled && isCancelled()) {
+                    throw std::runtime_error("Operation cancelled");
+                }
+                auto remaining = total - (static_cast<uint64_t>(position - source.offset));
+                auto want = static_cast<size_t>(std::min<uint64_t>(max, remaining));
+                // Stages may need all of their input to finish, so only a bare copy stops early
+                if (want == 0 || (stages_.empty() && sink.full())) {
+                    return 0;
+                }
+                auto n = source.handle->readAtInto(position, dst, want);
+                position += static_cast<int64_t>(n);
+                return n;
+            },
+            [&](const uint8_t* data, size_t size) {
+                outputs.front()(data, size);
+                result.bytesRead += size;
+                if (onProgress) {
+                    onProgress(result.bytesRead, total);
+                }
+            },
+            kHashChunkSize,
+            total > kHashChunkSize ? spawn : TaskSpawner{}
+        );
+
+        // Finishing a stage may still emit into the stages after it
+        for (size_t i = 0; i < stages_.size(); ++i) {
+            stages_[i]->finish(outputs[i + 1]);
+        }
+        sink.finish();
+
+        for (auto& stage : stages_) {
+            if (auto digest = stage->digest()) {
+                result.digests.push_back(std::move(*digest));
+            }
+        }
+        return result;
+    }
+};
+
+} // namespace rct_io
+
+#endif // IO_PIPELINE_HPP
@@ -0,0 +1,258 @@
+/**
+ * @file IOProgress.hpp
+ * @brief Rate-limited, coalesced progress events of HTTP transfers
+ *
+ * Platform clients report progress for every buffer they move, thousands
+ * of times a second on a fast link. Each transfer's ProgressReporter
+ * drops reports that come sooner than the minimum interval or byte delta,
+ * and ProgressHub delivers what is left at most once per frame: the
+ * latest event of every transfer sharing a JS thread goes out in a single
+ * JS-thread call.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_PROGRESS_HPP
+#define IO_PROGRESS_HPP
+
+#include "JSIHostObjectBase.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rct_io {
+
+/**
+ * @brief When a transfer's progress is worth reporting
+ *
+ * A report goes out once both the interval has passed and the byte delta
+ * has been reached; the first and the final one always do.
+ */
+struct ProgressOptions {
+    int64_t minIntervalMs = 100;
+    int64_t minBytes = 0;
+};
+
+class ProgressReporter;
+
+/**
+ * @brief Process-wide delivery of progress events to JS
+ *
+ * Events wait in a batch per JS invoker; a dispatcher thread posts every
+ * batch once per frame. A finished reporter flushes its batch at once, so
+ * a transfer's last event reaches JS before its Promise settles.
+ */
+class ProgressHub {
+public:
+    /// Shortest time between two deliveries to one JS thread
+    static constexpr auto kFrame = std::chrono::milliseconds(16);
+
+    struct Event {
+        jsi_utils::CallbackArg callback;
+        int64_t bytes = 0;
+        int64_t total = -1;
+        double bytesPerSecond = 0.0;
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Batch {
+        std::shared_ptr<jsi_utils::JSCallInvokerWrapper> invoker;
+        std::map<uint64_t, Event> events;  // Latest per reporter, in reporter order
+    };
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::unordered_map<jsi_utils::JSCallInvokerWrapper*, Batch> pending_;
+    ProgressOptions options_;
+    std::atomic<uint64_t> nextId_{1};
+
+    ProgressHub() {
+        std::thread([this] { dispatch(); }).detach();
+    }
+
+    /** @brief Post one batch (mutex held, so a later flush cannot overtake it) */
+    static auto post(Batch&& batch) -> void {
+        batch.invoker->invokeAsync([events = std::move(batch.events)](facebook::jsi::Runtime& rt) mutable {
+            for (auto& [id, event] : events) {
+                std::vector<jsi_utils::AsyncResult> args{
+                    jsi_utils::AsyncResult(event.bytes),
+                    jsi_utils::AsyncResult(event.total),
+                    jsi_utils::AsyncResult(event.bytesPerSecond)
+                };
+                event.callback.call(rt, args);
+            }
+        });
+    }
+
+    [[noreturn]] auto dispatch() -> void {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            wake_.wait(lock, [this] { return !pending_.empty(); });
+            // Let the rest of this frame's reports join the batch
+            auto due = Clock::now() + kFrame;
+            wake_.wait_until(lock, due, [] { return false; });
+            for (auto& [key, batch] : pending_) {
+                post(std::move(batch));
+            }
+            pending_.clear();
+        }
+    }
+
+    friend class ProgressReporter;
+
+    auto enqueue(uint64_t id, Event&& event) -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& batch = pending_[event.callback.invoker().get()];
+        if (!batch.invoker) {
+            batch.invoker = event.callback.invoker();
+        }
+        batch.events.insert_or_assign(id, std::move(event));
+        wake_.notify_one();
+    }
+
+    auto flush(jsi_utils::JSCallInvokerWrapper* invoker) -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pending_.find(invoker);
+        if (it != pending_.end()) {
+            post(std::move(it->second));
+            pending_.erase(it);
+        }
+    }
+
+public:
+    static auto instance() -> ProgressHub& {
+        static auto* hub = new ProgressHub();  // Leaked: the dispatcher never exits
+        return *hub;
+    }
+
+    auto configure(const ProgressOptions& options) -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options_ = options;
+    }
+
+    [[nodiscard]] auto options() const -> ProgressOptions {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return options_;
+    }
+
+    /**
+     * @brief Reporter delivering to an optional JS callback as (bytes, total, bytesPerSecond)
+     * @return nullptr without a callback
+     */
+    auto open(const jsi_utils::CallbackArg* callback) -> std::shared_ptr<ProgressReporter>;
+};
+
+/**
+ * @brief Progress of one transfer; report() may be called from any thread
+ */
+class ProgressReporter {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    ProgressHub& hub_;
+    uint64_t id_;
+    jsi_utils::CallbackArg callback_;
+    ProgressOptions options_;
+
+    std::mutex mutex_;
+    bool reported_ = false;         // Something went out already
+    bool held_ = false;             // The latest report was held back
+    int64_t bytes_ = 0, total_ = -1;
+    int64_t sentBytes_ = 0;         // At the last event
+    Clock::time_point sentAt_{};
+
+    auto emit(Clock::time_point now) -> void {
+        auto seconds = std::chrono::duration<double>(now - sentAt_).count();
+        double rate = reported_ && seconds > 0 ? static_cast<double>(bytes_ - sentBytes_) / seconds : 0.0;
+        reported_ = true;
+        held_ = false;
+        sentBytes_ = bytes_;
+        sentAt_ = now;
+        hub_.enqueue(id_, {callback_, bytes_, total_, rate < 0 ? 0.0 : rate});
+    }
+
+public:
+    ProgressReporter(ProgressHub& hub, uint64_t id, jsi_utils::CallbackArg callback, ProgressOptions options)
+        : hub_(hub), id_(id), callback_(std::move(callback)), options_(options) {}
+
+    ~ProgressReporter() {
+        finish();
+    }
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    /**
+     * @brief Deliver a report that was held back, now rather than next frame
+     *
+     * Call once the transfer is over, before its result is posted; reports
+     * coming later are still delivered, through the next frame.
+     */
+    auto finish() -> void {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (held_) {
+                emit(Clock::now());
+            }
+        }
+        hub_.flush(callback_.invoker().get());
+    }
+
+    auto report(int64_t bytes, int64_t total) -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bytes_ = bytes;
+        total_ = total;
+        auto now = Clock::now();
+        bool final = total >= 0 && bytes >= total;
+        bool due = now - sentAt_ >= std::chrono::milliseconds(options_.minIntervalMs)
+            && bytes - sentBytes_ >= options_.minBytes;
+        if (final && reported_ && bytes == sentBytes_) {
+            return;  // Completion already reported
+        }
+        if (!reported_ || final || due) {
+            emit(now);
+        } else {
+            held_ = true;
+        }
+    }
+};
+
+inline auto ProgressHub::open(const jsi_utils::CallbackArg* callback) -> std::shared_ptr<ProgressReporter> {
+    if (!callback) {
+        return nullptr;
+    }
+    return std::make_shared<ProgressReporter>(*this, nextId_++, *callback, options());
+}
+
+} // namespace rct_io
+
+#endif // IO_PROGRESS_HPP
@@ -0,0 +1,1039 @@
+/**
+ * @file IORecordPipeline.hpp
+ * @brief Native line and record transforms: lines -> stages -> aggregate
+ *
+ * Splits the output of an IOPipeline into lines, runs each through
+ * record stages (filter, split into fields, CSV, JSON lines) and folds
+ * the survivors into one output (lines, columns, counts or a file), so
+ * parsing large text files costs the JS thread a single result.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_RECORD_PIPELINE_HPP
+#define IO_RECORD_PIPELINE_HPP
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "IOPipeline.hpp"
+#include "IOTextCodec.hpp"
+
+namespace rct_io {
+
+/// Longest line a record pipeline accepts
+inline constexpr size_t kMaxRecordLine = 16 * 1024 * 1024;
+
+/**
+ * @brief One field of a record
+ */
+struct RecordField {
+    std::string text;
+    bool quoted = false;   // A JSON string or quoted CSV field; never read as a number
+    bool present = true;   // False for a missing JSON key or null
+};
+
+/**
+ * @brief A line and, once split, its fields
+ *
+ * The fields vector is reused from line to line so its strings keep their
+ * capacity; only fields[0..fieldCount) belong to the current record.
+ */
+struct Record {
+    std::string_view line;  // Without the line break
+    std::vector<RecordField> fields;
+    size_t fieldCount = 0;
+    bool split = false;
+
+    auto setFieldCount(size_t count) -> void {
+        if (fields.size() < count) {
+            fields.resize(count);
+        }
+        fieldCount = count;
+    }
+
+    /** @brief Field text, the whole line before splitting; empty if out of range */
+    [[nodiscard]] auto text(int field) const -> std::string_view {
+        if (field < 0 || !split) {
+            return line;
+        }
+        return static_cast<size_t>(field) < fieldCount ? std::string_view(fields[field].text) : std::string_view();
+    }
+};
+
+/**
+ * @brief One record step
+ */
+class RecordStage {
+public:
+    virtual ~RecordStage() = default;
+
+    /** @brief Transform a record; false drops it */
+    virtual auto process(Record& record) -> bool = 0;
+
+    /** @brief True once no later record can pass (stops reading early) */
+    [[nodiscard]] virtual auto exhausted() const -> bool { return false; }
+
+    /** @brief Lines dropped because they could not be parsed */
+    [[nodiscard]] virtual auto invalid() const -> uint64_t { return 0; }
+};
+
+/**
+ * @brief A column of RecordOutput's columns mode
+ *
+ * Numeric when every present value is an unquoted finite number; missing
+ * values are NaN then. Otherwise strings, nullopt for missing values.
+ */
+struct RecordColumn {
+    bool numeric = false;
+    std::vector<double> numbers;
+    std::vector<std::optional<std::string>> strings;
+};
+
+/**
+ * @brief Outcome of a record pipeline run; which of the outputs is filled depends on the output kind
+ */
+struct RecordPipelineResult {
+    uint64_t bytesRead = 0;     // Bytes taken from the source
+    uint64_t linesRead = 0;     // Lines split from the (decoded) input
+    uint64_t records = 0;       // Records that reached the output
+    uint64_t invalid = 0;       // Lines a stage could not parse
+    uint64_t bytesWritten = 0;  // File output
+    std::vector<std::string> lines;
+    std::vector<RecordColumn> columns;
+    std::vector<std::pair<std::string, uint64_t>> counts;
+};
+
+namespace record_detail {
+
+inline auto parseIndex(const std::vector<std::string>& spec, size_t i, const char* what) -> int64_t {
+    if (i >= spec.size()) {
+        throw std::runtime_error(std::string("Record stage '") + spec[0] + "' needs " + what);
+    }
+    char* end = nullptr;
+    auto value = std::strtoll(spec[i].c_str(), &end, 10);
+    if (spec[i].empty() || *end != '\0') {
+        throw std::runtime_error(std::string("Record stage '") + spec[0] + "': " + what + " is not a number");
+    }
+    return value;
+}
+
+/** @brief Whether text is a plain decimal number (no hex, inf or nan) */
+inline auto parseNumber(const std::string& text, double& value) -> bool {
+    if (text.empty() || text.size() > 64) {
+        return false;
+    }
+    char first = text[0];
+    if (!(first == '-' || first == '+' || first == '.' || (first >= '0' && first <= '9'))) {
+        return false;
+    }
+    for (char c : text) {
+        if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E')) {
+            return false;
+        }
+    }
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return end == text.c_str() + text.size() && std::isfinite(value);
+}
+
+/**
+ * @brief Keep records whose line or field matches a plain pattern
+ *
+ * Matching is substring based on purpose: std::regex recurses per input
+ * character and overflows a worker's stack on lines of a few KB.
+ */
+class FilterStage final : public RecordStage {
+public:
+    enum class Mode { Contains, Prefix, Suffix, Equals };
+
+private:
+    Mode mode_;
+    std::string pattern_;
+    int field_;
+    bool invert_;
+
+public:
+    FilterStage(Mode mode, std::string pattern, int field, bool invert)
+        : mode_(mode), pattern_(std::move(pattern)), field_(field), invert_(invert) {}
+
+    auto process(Record& record) -> bool override {
+        auto text = record.text(field_);
+        bool match = false;
+        switch (mode_) {
+            case Mode::Contains: match = text.find(pattern_) != std::string_view::npos; break;
+            case Mode::Prefix:   match = text.substr(0, pattern_.size()) == pattern_; break;
+            case Mode::Suffix:
+                match = text.size() >= pattern_.size() && text.substr(text.size() - pattern_.size()) == pattern_;
+                break;
+            case Mode::Equals:   match = text == pattern_; break;
+        }
+        return match != invert_;
+    }
+};
+
+/**
+ * @brief Split a line at a delimiter; in CSV mode fields may be quoted
+ *
+ * CSV follows RFC 4180 within a line ("" is an escaped quote); a quoted
+ * field cannot span lines.
+ */
+class SplitStage final : public RecordStage {
+private:
+    char delimiter_;
+    bool csv_;
+
+public:
+    SplitStage(char delimiter, bool csv) : delimiter_(delimiter), csv_(csv) {}
+
+    auto process(Record& record) -> bool override {
+        auto line = record.line;
+        size_t count = 0;
+        size_t i = 0;
+        while (true) {
+            record.setFieldCount(count + 1);
+            auto& field = record.fields[count++];
+            field.present = true;
+            field.quoted = false;
+            field.text.clear();
+
+            if (csv_ && i < line.size() && line[i] == '"') {
+                field.quoted = true;
+                ++i;
+                while (i < line.size()) {
+                    if (line[i] == '"') {
+                        if (i + 1 < line.size() && line[i + 1] == '"') {
+                            field.text.push_back('"');
+                            i += 2;
+                            continue;
+                        }
+                        ++i;
+                        break;
+                    }
+                    field.text.push_back(line[i++]);
+                }
+                // Anything between the closing quote and the delimiter is kept as is
+                auto next = line.find(delimiter_, i);
+                field.text.append(line.substr(i, next == std::string_view::npos ? std::string_view::npos : next - i));
+                if (next == std::string_view::npos) {
+                    break;
+                }
+                i = next + 1;
+                continue;
+            }
+
+            auto next = line.find(delimiter_, i);
+            if (next == std::string_view::npos) {
+                field.text.assign(line.substr(i));
+                break;
+            }
+            field.text.assign(line.substr(i, next - i));
+            i = next + 1;
+        }
+        record.fieldCount = count;
+        record.split = true;
+        return true;
+    }
+};
+
+/**
+ * @brief Pick values out of a JSON object per line
+ *
+ * Paths are keys, with dots descending into nested objects ("user.id").
+ * Strings are unescaped; numbers, true and false keep their text; objects
+ * and arrays are returned as JSON text; null and missing keys are absent.
+ * Lines that are not a JSON object are dropped and counted as invalid;
+ * blank lines are dropped silently.
+ */
+class JsonFieldsStage final : public RecordStage {
+private:
+    static constexpr int kMaxDepth = 64;
+
+    std::vector<std::string> paths_;
+    std::vector<std::string> prefixes_;  // "a." for every path "a.b", to know which objects to enter
+    uint64_t invalid_ = 0;
+
+    // Scanner state of the current line
+    const char* p_ = nullptr;
+    const char* end_ = nullptr;
+    Record* record_ = nullptr;
+    std::string path_;
+
+    auto skipSpace() -> void {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\r' || *p_ == '\n')) {
+            ++p_;
+        }
+    }
+
+    static auto hexValue(char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    auto readHex4(uint32_t& value) -> bool {
+        if (end_ - p_ < 4) {
+            return false;
+        }
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            int digit = hexValue(*p_++);
+            if (digit < 0) {
+                return false;
+            }
+            value = (value << 4) | static_cast<uint32_t>(digit);
+        }
+        return true;
+    }
+
+    /** @brief Parse a string at p_ (at the opening quote); out may be null to skip it */
+    auto parseString(std::string* out) -> bool {
+        ++p_;
+        while (p_ < end_) {
+            char c = *p_;
+            if (c == '"') {
+                ++p_;
+                return true;
+            }
+            if (c != '\\') {
+                // Copy the run up to the next quote or escape at once
+                const char* start = p_;
+                while (p_ < end_ && *p_ != '"' && *p_ != '\\') {
+                    ++p_;
+                }
+                if (out) {
+                    out->append(start, p_);
+                }
+                continue;
+            }
+            if (++p_ >= end_) {
+                return false;
+            }
+            char escape = *p_++;
+            char plain = 0;
+            switch (escape) {
+                case '"':  plain = '"'; break;
+                case '\\': plain = '\\'; break;
+                case '/':  plain = '/'; break;
+                case 'b':  plain = '\b'; break;
+                case 'f':  plain = '\f'; break;
+                case 'n':  plain = '\n'; break;
+                case 'r':  plain = '\r'; break;
+                case 't':  plain = '\t'; break;
+                case 'u': {
+                    uint32_t unit = 0;
+                    if (!readHex4(unit)) {
+                        return false;
+                    }
+                    uint32_t codePoint = unit;
+                    if (unit >= 0xD800 && unit <= 0xDBFF) {
+                        uint32_t low = 0;
+                        const char* save = p_;
+                        if (end_ - p_ >= 6 && p_[0] == '\\' && p_[1] == 'u' && (p_ += 2, readHex4(low))
+                            && low >= 0xDC00 && low <= 0xDFFF) {
+                            codePoint = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+                        } else {
+                            p_ = save;
+                            codePoint = 0xFFFD;
+                        }
+                    } else if (unit >= 0xDC00 && unit <= 0xDFFF) {
+                        codePoint = 0xFFFD;
+                    }
+                    if (out) {
+                        codec_detail::appendUtf8(*out, codePoint);
+                    }
+                    continue;
+                }
+                default:
+                    return false;
+            }
+            if (out) {
+                out->push_back(plain);
+            }
+        }
+        return false;
+    }
+
+    /** @brief Skip any value at p_ */
+    auto skipValue(int depth) -> bool {
+        skipSpace();
+        if (p_ >= end_ || depth > kMaxDepth) {
+            return false;
+        }
+        char c = *p_;
+        if (c == '"') {
+            return parseString(nullptr);
+        }
+        if (c == '{' || c == '[') {
+            char close = c == '{' ? '}' : ']';
+            ++p_;
+            skipSpace();
+            if (p_ < end_ && *p_ == close) {
+                ++p_;
+                return true;
+            }
+            while (true) {
+                if (c == '{') {
+                    skipSpace();
+                    if (p_ >= end_ || *p_ != '"' || !parseString(nullptr)) {
+                        return false;
+                    }
+                    skipSpace();
+                    if (p_ >= end_ || *p_++ != ':') {
+                        return false;
+                    }
+                }
+                if (!skipValue(depth + 1)) {
+                    return false;
+                }
+                skipSpace();
+                if (p_ >= end_) {
+                    return false;
+                }
+                if (*p_ == ',') {
+                    ++p_;
+                    continue;
+                }
+                if (*p_ == close) {
+                    ++p_;
+                    return true;
+                }
+                return false;
+            }
+        }
+        // Number, true, false or null
+        const char* start = p_;
+        while (p_ < end_ && *p_ != ',' && *p_ != '}' && *p_ != ']' && *p_ != ' ' && *p_ != '\t'
+               && *p_ != '\r' && *p_ != '\n') {
+            ++p_;
+        }
+        return p_ > start;
+    }
+
+    /** @brief Store the value at p_ as the field of path index */
+    auto captureValue(size_t index, int depth) -> bool {
+        auto& field = record_->fields[index];
+        field.text.clear();
+        skipSpace();
+        if (p_ >= end_) {
+            return false;
+        }
+        if (*p_ == '"') {
+            field.quoted = true;
+            field.present = true;
+            return parseString(&field.text);
+        }
+        const char* start = p_;
+        if (!skipValue(depth)) {
+            return false;
+        }
+        std::string_view raw(start, static_cast<size_t>(p_ - start));
+        field.quoted = raw[0] == '{' || raw[0] == '[';
+        field.present = raw != "null";
+        if (field.present) {
+            field.text.assign(raw);
+        }
+        return true;
+    }
+
+    [[nodiscard]] auto wantsObject(std::string_view path) const -> bool {
+        for (const auto& prefix : prefixes_) {
+            if (prefix.size() == path.size() + 1 && std::string_view(prefix).substr(0, path.size()) == path) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** @brief Parse the object at p_, capturing values of paths below path_ */
+    auto parseObject(int depth) -> bool {
+        ++p_;  // '{'
+        skipSpace();
+        if (p_ < end_ && *p_ == '}') {
+            ++p_;
+            return true;
+        }
+        auto base = path_.size();
+        while (true) {
+            skipSpace();
+            if (p_ >= end_ || *p_ != '"') {
+                return false;
+            }
+            path_.resize(base);
+            if (!parseString(&path_)) {
+                return false;
+            }
+            skipSpace();
+            if (p_ >= end_ || *p_++ != ':') {
+                return false;
+            }
+            skipSpace();
+
+            bool handled = false;
+            for (size_t i = 0; i < paths_.size(); ++i) {
+                if (paths_[i] == path_) {
+                    if (!captureValue(i, depth + 1)) {
+                        return false;
+                    }
+                    handled = true;
+                    break;
+                }
+            }
+            if (!handled && p_ < end_ && *p_ == '{' && depth < kMaxDepth && wantsObject(path_)) {
+                path_.push_back('.');
+                if (!parseObject(depth + 1)) {
+                    return false;
+                }
+                handled = true;
+            }
+            if (!handled && !skipValue(depth + 1)) {
+                return false;
+            }
+
+            skipSpace();
+            if (p_ >= end_) {
+                return false;
+            }
+            if (*p_ == ',') {
+                ++p_;
+                continue;
+            }
+            if (*p_ == '}') {
+                ++p_;
+                path_.resize(base);
+                return true;
+            }
+            return false;
+        }
+    }
+
+public:
+    explicit JsonFieldsStage(std::vector<std::string> paths) : paths_(std::move(paths)) {
+        if (paths_.empty()) {
+            throw std::runtime_error("Record stage 'json' needs at least one field");
+        }
+        for (const auto& path : paths_) {
+            for (auto dot = path.find('.'); dot != std::string::npos; dot = path.find('.', dot + 1)) {
+                prefixes_.push_back(path.substr(0, dot + 1));
+            }
+        }
+    }
+
+    auto process(Record& record) -> bool override {
+        p_ = record.line.data();
+        end_ = p_ + record.line.size();
+        skipSpace();
+        if (p_ >= end_) {
+            return false;
+        }
+
+        record.setFieldCount(paths_.size());
+        for (size_t i = 0; i < paths_.size(); ++i) {
+            record.fields[i].present = false;
+            record.fields[i].quoted = false;
+            record.fields[i].text.clear();
+        }
+        record_ = &record;
+        path_.clear();
+
+        bool ok = *p_ == '{' && parseObject(0);
+        if (ok) {
+            skipSpace();
+            ok = p_ == end_;
+        }
+        if (!ok) {
+            ++invalid_;
+            return false;
+        }
+        record.split = true;
+        return true;
+    }
+
+    [[nodiscard]] auto invalid() const -> uint64_t override {
+        return invalid_;
+    }
+};
+
+/** @brief Keep and reorder fields by index; out-of-range indices give absent fields */
+class SelectStage final : public RecordStage {
+private:
+    std::vector<int64_t> indices_;
+    std::vector<RecordField> scratch_;
+
+public:
+    explicit SelectStage(std::vector<int64_t> indices) : indices_(std::move(indices)) {
+        scratch_.resize(indices_.size());
+    }
+
+    auto process(Record& record) -> bool override {
+        if (!record.split) {
+            // A whole line is a record of one field
+            record.setFieldCount(1);
+            record.fields[0] = {std::string(record.line), false, true};
+            record.split = true;
+        }
+        for (size_t i = 0; i < indices_.size(); ++i) {
+            auto index = indices_[i];
+            if (index >= 0 && static_cast<size_t>(index) < record.fieldCount) {
+                scratch_[i].text.assign(record.fields[index].text);
+                scratch_[i].quoted = record.fields[index].quoted;
+                scratch_[i].present = record.fields[index].present;
+            } else {
+                scratch_[i].text.clear();
+                scratch_[i].quoted = false;
+                scratch_[i].present = false;
+            }
+        }
+        record.setFieldCount(indices_.size());
+        for (size_t i = 0; i < indices_.size(); ++i) {
+            std::swap(record.fields[i], scratch_[i]);
+        }
+        return true;
+    }
+};
+
+/** @brief Drop the first count records that reach it (e.g. a CSV header) */
+class SkipStage final : public RecordStage {
+private:
+    uint64_t remaining_;
+
+public:
+    explicit SkipStage(uint64_t count) : remaining_(count) {}
+
+    auto process(Record&) -> bool override {
+        if (remaining_ > 0) {
+            --remaining_;
+            return false;
+        }
+        return true;
+    }
+};
+
+/** @brief Pass the first count records that reach it */
+class LimitStage final : public RecordStage {
+private:
+    uint64_t remaining_;
+
+public:
+    explicit LimitStage(uint64_t count) : remaining_(count) {}
+
+    auto process(Record&) -> bool override {
+        if (remaining_ == 0) {
+            return false;
+        }
+        --remaining_;
+        return true;
+    }
+
+    [[nodiscard]] auto exhausted() const -> bool override {
+        return remaining_ == 0;
+    }
+};
+
+/**
+ * @brief Where records end up
+ */
+class RecordOutput {
+public:
+    enum class Kind { Lines, Columns, Count, CountBy, File };
+
+private:
+    Kind kind_;
+    std::string separator_;
+    int field_ = -1;
+    std::unique_ptr<detail::FileSink> file_;
+    std::string text_;  // Joined record of the Lines and File kinds
+
+    // Columns: values and flags (bit 0 present, bit 1 quoted) of each column
+    std::vector<std::vector<std::string>> values_;
+    std::vector<std::vector<uint8_t>> flags_;
+    uint64_t rows_ = 0;
+
+    std::unordered_map<std::string, uint64_t> counts_;
+
+    auto joined(const Record& record) -> std::string& {
+        text_.clear();
+        if (!record.split) {
+            text_.assign(record.line);
+            return text_;
+        }
+        for (size_t i = 0; i < record.fieldCount; ++i) {
+            if (i > 0) {
+                text_.append(separator_);
+            }
+            text_.append(record.fields[i].text);
+        }
+        return text_;
+    }
+
+    auto addColumn() -> void {
+        values_.emplace_back(rows_);
+        flags_.emplace_back(rows_, uint8_t{0});
+    }
+
+public:
+    /**
+     * @param separator Joins the fields of a split record (Lines, File)
+     * @param field Field counted by CountBy, -1 = whole line
+     * @param path Destination of the File kind
+     */
+    RecordOutput(Kind kind, std::string separator, int field, const std::string& path, bool append)
+        : kind_(kind), separator_(std::move(separator)), field_(field) {
+        if (kind_ == Kind::File) {
+            file_ = std::make_unique<detail::FileSink>(path, append);
+        }
+    }
+
+    auto add(const Record& record, RecordPipelineResult& result) -> void {
+        switch (kind_) {
+            case Kind::Lines:
+                result.lines.push_back(joined(record));
+                break;
+            case Kind::Columns: {
+                size_t width = record.split ? record.fieldCount : 1;
+                while (values_.size() < width) {
+                    addColumn();
+                }
+                for (size_t i = 0; i < values_.size(); ++i) {
+                    if (i >= width) {
+                        values_[i].emplace_back();
+                        flags_[i].push_back(0);
+                    } else if (!record.split) {
+                        values_[i].emplace_back(record.line);
+                        flags_[i].push_back(1);
+                    } else {
+                        const auto& field = record.fields[i];
+                        values_[i].push_back(field.text);
+                        flags_[i].push_back(static_cast<uint8_t>((field.present ? 1 : 0) | (field.quoted ? 2 : 0)));
+                    }
+                }
+                ++rows_;
+                break;
+            }
+            case Kind::Count:
+                break;
+            case Kind::CountBy: {
+                auto key = record.text(field_);
+                auto it = counts_.find(std::string(key));
+                if (it == counts_.end()) {
+                    counts_.emplace(std::string(key), 1);
+                } else {
+                    ++it->second;
+                }
+                break;
+            }
+            case Kind::File: {
+                auto& text = joined(record);
+                text.push_back('\n');
+                file_->write(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+                result.bytesWritten += text.size();
+                break;
+            }
+        }
+        ++result.records;
+    }
+
+    auto finish(RecordPipelineResult& result) -> void {
+        if (kind_ == Kind::File) {
+            file_->finish();
+        } else if (kind_ == Kind::CountBy) {
+            result.counts.assign(std::make_move_iterator(counts_.begin()), std::make_move_iterator(counts_.end()));
+            counts_.clear();
+        } else if (kind_ == Kind::Columns) {
+            result.columns.resize(values_.size());
+            for (size_t c = 0; c < values_.size(); ++c) {
+                auto& column = result.columns[c];
+                auto& values = values_[c];
+                auto& flags = flags_[c];
+
+                column.numeric = true;
+                column.numbers.reserve(values.size());
+                double number = 0;
+                for (size_t r = 0; r < values.size() && column.numeric; ++r) {
+                    if ((flags[r] & 1) == 0) {
+                        column.numbers.push_back(std::nan(""));
+                    } else if ((flags[r] & 2) == 0 && parseNumber(values[r], number)) {
+                        column.numbers.push_back(number);
+                    } else {
+                        column.numeric = false;
+                    }
+                }
+                if (!column.numeric) {
+                    std::vector<double>().swap(column.numbers);
+                    column.strings.reserve(values.size());
+                    for (size_t r = 0; r < values.size(); ++r) {
+                        if (flags[r] & 1) {
+                            column.strings.emplace_back(std::move(values[r]));
+                        } else {
+                            column.strings.emplace_back(std::nullopt);
+                        }
+                    }
+                }
+                std::vector<std::string>().swap(values);
+            }
+        }
+    }
+};
+
+/**
+ * @brief PipeSink that cuts its input into lines and runs them through the record stages
+ *
+ * Lines end at "\n"; a preceding "\r" and a UTF-8 byte order mark at the
+ * start are removed. The last line needs no line break.
+ */
+class LineSink final : public PipeSink {
+private:
+    std::vector<std::unique_ptr<RecordStage>>& stages_;
+    RecordOutput& output_;
+    RecordPipelineResult& result_;
+    std::string carry_;  // Incomplete line from the previous chunk
+    Record record_;
+    bool first_ = true;
+    std::atomic<bool> done_{false};
+
+    auto line(std::string_view text) -> void {
+        if (first_) {
+            first_ = false;
+            if (text.substr(0, 3) == "\xEF\xBB\xBF") {
+                text.remove_prefix(3);
+            }
+        }
+        if (!text.empty() && text.back() == '\r') {
+            text.remove_suffix(1);
+        }
+        ++result_.linesRead;
+
+        record_.line = text;
+        record_.fieldCount = 0;
+        record_.split = false;
+        for (auto& stage : stages_) {
+            if (!stage->process(record_)) {
+                if (stage->exhausted()) {
+                    done_.store(true, std::memory_order_relaxed);
+                }
+                return;
+            }
+        }
+        output_.add(record_, result_);
+        for (auto& stage : stages_) {
+            if (stage->exhausted()) {
+                done_.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    LineSink(std::vector<std::unique_ptr<RecordStage>>& stages, RecordOutput& output, RecordPipelineResult& result)
+        : stages_(stages), output_(output), result_(result) {}
+
+    auto write(const uint8_t* data, size_t size) -> void override {
+        const char* p = reinterpret_cast<const char*>(data);
+        const char* end = p + size;
+        while (p < end && !done_.load(std::memory_order_relaxed)) {
+            const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!newline) {
+                if (carry_.size() + static_cast<size_t>(end - p) > kMaxRecordLine) {
+                    throw std::runtime_error("Line longer than " + std::to_string(kMaxRecordLine) + " bytes");
+                }
+                carry_.append(p, end);
+                return;
+            }
+            if (carry_.empty()) {
+                line({p, static_cast<size_t>(newline - p)});
+            } else {
+                carry_.append(p, newline);
+                line(carry_);
+                carry_.clear();
+            }
+            p = newline + 1;
+        }
+    }
+
+    auto finish() -> void override {
+        if (!carry_.empty() && !done_.load(std::memory_order_relaxed)) {
+            line(carry_);
+        }
+        carry_.clear();
+    }
+
+    [[nodiscard]] auto full() const -> bool override {
+        return done_.load(std::memory_order_relaxed);
+    }
+};
+
+} // namespace record_detail
+
+/**
+ * @brief Byte stages, then record stages, into one output
+ *
+ * Stage and output specs are lists of strings, as passed from JS:
+ *   ["filter", "contains"|"prefix"|"suffix"|"equals", pattern, field?, invert?]
+ *   ["split", delimiter, csv?]        csv is "1" for RFC 4180 quoting
+ *   ["json", path, ...]               fields of a JSON object per line
+ *   ["select", index, ...]
+ *   ["skip", count], ["limit", count]
+ * and for the output
+ *   ["lines", separator?], ["columns"], ["count"], ["countBy", field?],
+ *   ["file", path, append?, separator?]
+ * field indices count from 0; -1 means the whole line.
+ *
+ * @code
+ *   IORecordPipeline records;
+ *   records.bytes().addStage(PipeStageKind::Gunzip);
+ *   records.addStage({"json", "level", "ms"});
+ *   records.addStage({"filter", "equals", "error", "0"});
+ *   records.setOutput({"columns"});
+ *   auto result = records.run(source);  // result.columns[1] = ms of every error
+ * @endcode
+ */
+class IORecordPipeline {
+private:
+    IOPipeline bytes_;
+    std::vector<std::unique_ptr<RecordStage>> stages_;
+    std::unique_ptr<record_detail::RecordOutput> output_;
+
+public:
+    /** @brief Byte stages the source passes through before it is split into lines */
+    auto bytes() -> IOPipeline& {
+        return bytes_;
+    }
+
+    /**
+     * @brief Append a record stage
+     * @throws std::runtime_error for an unknown or malformed spec
+     */
+    auto addStage(const std::vector<std::string>& spec) -> void {
+        using namespace record_detail;
+        if (spec.empty()) {
+            throw std::runtime_error("Record stage without kind");
+        }
+        const auto& kind = spec[0];
+        if (kind == "filter") {
+            if (spec.size() < 3) {
+                throw std::runtime_error("Record stage 'filter' needs a mode and a pattern");
+            }
+            FilterStage::Mode mode;
+            if (spec[1] == "contains") mode = FilterStage::Mode::Contains;
+            else if (spec[1] == "prefix") mode = FilterStage::Mode::Prefix;
+            else if (spec[1] == "suffix") mode = FilterStage::Mode::Suffix;
+            else if (spec[1] == "equals") mode = FilterStage::Mode::Equals;
+            else throw std::runtime_error("Unknown filter mode: " + spec[1]);
+            auto field = spec.size() > 3 ? static_cast<int>(parseIndex(spec, 3, "a field index")) : -1;
+            bool invert = spec.size() > 4 && spec[4] == "1";
+            stages_.push_back(std::make_unique<FilterStage>(mode, spec[2], field, invert));
+        } else if (kind == "split") {
+            if (spec.size() < 2 || spec[1].size() != 1) {
+                throw std::runtime_error("Record stage 'split' needs a one-character delimiter");
+            }
+            stages_.push_back(std::make_unique<SplitStage>(spec[1][0], spec.size() > 2 && spec[2] == "1"));
+        } else if (kind == "json") {
+            stages_.push_back(std::make_unique<JsonFieldsStage>(std::vector<std::string>(spec.begin() + 1, spec.end())));
+        } else if (kind == "select") {
+            std::vector<int64_t> indices;
+            for (size_t i = 1; i < spec.size(); ++i) {
+                indices.push_back(parseIndex(spec, i, "field indices"));
+            }
+            stages_.push_back(std::make_unique<SelectStage>(std::move(indices)));
+        } else if (kind == "skip" || kind == "limit") {
+            auto count = parseIndex(spec, 1, "a count");
+            if (count < 0) {
+                throw std::runtime_error("Record stage '" + kind + "': count must be non-negative");
+            }
+            if (kind == "skip") {
+                stages_.push_back(std::make_unique<SkipStage>(static_cast<uint64_t>(count)));
+            } else {
+                stages_.push_back(std::make_unique<LimitStage>(static_cast<uint64_t>(count)));
+            }
+        } else {
+            throw std::runtime_error("Unknown record stage: " + kind);
+        }
+    }
+
+    /**
+     * @brief Choose the output (default: lines joined with ",")
+     * @throws std::runtime_error for an unknown spec, or a file that cannot be opened
+     */
+    auto setOutput(const std::vector<std::string>& spec) -> void {
+        using record_detail::RecordOutput;
+        auto kind = spec.empty() ? std::string("lines") : spec[0];
+        auto at = [&](size_t i, const char* fallback) { return spec.size() > i ? spec[i] : std::string(fallback); };
+        if (kind == "lines") {
+            output_ = std::make_unique<RecordOutput>(RecordOutput::Kind::Lines, at(1, ","), -1, "", false);
+        } else if (kind == "columns") {
+            output_ = std::make_unique<RecordOutput>(RecordOutput::Kind::Columns, "", -1, "", false);
+        } else if (kind == "count") {
+            output_ = std::make_unique<RecordOutput>(RecordOutput::Kind::Count, "", -1, "", false);
+        } else if (kind == "countBy") {
+            auto field = spec.size() > 1 ? static_cast<int>(record_detail::parseIndex(spec, 1, "a field index")) : -1;
+            output_ = std::make_unique<RecordOutput>(RecordOutput::Kind::CountBy, "", field, "", false);
+        } else if (kind == "file") {
+            if (spec.size() < 2 || spec[1].empty()) {
+                throw std::runtime_error("Record output 'file' needs a path");
+            }
+            output_ = std::make_unique<RecordOutput>(RecordOutput::Kind::File, at(3, ","), -1, spec[1], at(2, "0") == "1");
+        } else {
+            throw std::runtime_error("Unknown record output: " + kind);
+        }
+    }
+
+    /**
+     * @brief Read the source, split it into lines and run them through all stages
+     * @param onProgress Optional callback, (source bytes read, source bytes total)
+     * @param isCancelled Optional cancellation check, polled before each chunk
+     * @param spawn Schedules the read-ahead task (empty: read on this thread)
+     * @throws std::runtime_error("Operation cancelled") when cancelled
+     */
+    auto run(
+        const PipeSource& source,
+        const HashProgressCallback& onProgress = {},
+        const CancelCheck& isCancelled = {},
+        const TaskSpawner& spawn = {}
+    ) -> RecordPipelineResult {
+        if (!output_) {
+            setOutput({});
+        }
+        RecordPipelineResult result;
+        record_detail::LineSink lines(stages_, *output_, result);
+        auto run = bytes_.run(source, lines, onProgress, isCancelled, spawn);
+        output_->finish(result);
+        result.bytesRead = run.bytesRead;
+        for (const auto& stage : stages_) {
+            result.invalid += stage->invalid();
+        }
+        return result;
+    }
+};
+
+} // namespace rct_io
+
+#endif // IO_RECORD_PIPELINE_HPP
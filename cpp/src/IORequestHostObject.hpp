@@ -10,11 +10,22 @@
 #ifndef IO_REQUEST_HOST_OBJECT_HPP
 #define IO_REQUEST_HOST_OBJECT_HPP
 
-#include "BS_thread_pool.hpp"
 #include "JSIHostObjectBase.hpp"
+#include "IOExecutor.hpp"
+#include "IOProgress.hpp"
+#include "IOStatCache.hpp"
+#include "IORequestScheduler.hpp"
+#include "../network/IOContentCoding.hpp"
+#include "../network/IOHttpCache.hpp"
 #include "../network/IOHttpClient.hpp"
+#include "../network/IOSegmentedDownload.hpp"
+#include "../network/IOUpload.hpp"
 #include <ReactCommon/CallInvoker.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
 #ifdef __ANDROID__
 #include "../network/IOHttpClientAndroid.hpp"
 #endif
@@ -28,23 +39,6 @@ using namespace rct_io::network;
 // Type aliases for async result maps
 using AsyncResultMap = std::unordered_map<std::string, AsyncResult>;
 
-// ============================================================================
-// Thread Pool Task Executor (reuse from FSHostObject pattern)
-// ============================================================================
-
-class RequestThreadPoolExecutor : public TaskExecutor {
-private:
-    std::shared_ptr<BS::thread_pool<>> pool_;
-
-public:
-    explicit RequestThreadPoolExecutor(std::shared_ptr<BS::thread_pool<>> pool)
-        : pool_(std::move(pool)) {}
-
-    void execute(std::function<void()>&& task) override {
-        pool_->detach_task(std::move(task));
-    }
-};
-
 // ============================================================================
 // CallInvoker Adapter
 // ============================================================================
@@ -68,32 +62,102 @@ public:
     }
 };
 
+// ============================================================================
+// Stream Window
+// ============================================================================
+
+/**
+ * @brief Bytes of a streamed body handed to JS but not yet handled
+ *
+ * The request thread acquires room before posting a chunk and blocks while
+ * the window is full; the chunk's completion releases it on the JS thread.
+ * Shared with those completions, which may run after the request returned.
+ */
+class StreamWindow {
+private:
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    size_t inFlight_ = 0;
+    bool failed_ = false;
+    const size_t capacity_;
+
+    static constexpr auto kCancelPollInterval = std::chrono::milliseconds(100);
+
+public:
+    explicit StreamWindow(size_t capacity) : capacity_(std::max<size_t>(1, capacity)) {}
+
+    /**
+     * @brief Wait until size more bytes fit (an empty window takes any chunk)
+     * @return false if the call was cancelled or a chunk failed while waiting
+     */
+    auto acquire(size_t size, const AsyncContext& context) -> bool {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!failed_ && inFlight_ > 0 && inFlight_ + size > capacity_) {
+            if (context.isCancelled()) {
+                return false;
+            }
+            changed_.wait_for(lock, kCancelPollInterval);
+        }
+        inFlight_ += size;
+        return !failed_;
+    }
+
+    /** @brief A chunk was handled; ok = false if its callback threw or rejected */
+    auto release(size_t size, bool ok) -> void {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            inFlight_ -= size;
+            failed_ = failed_ || !ok;
+        }
+        changed_.notify_all();
+    }
+
+    /**
+     * @brief Wait until JS has handled every chunk
+     * @return false if the call was cancelled first or a chunk failed
+     */
+    auto drain(const AsyncContext& context) -> bool {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!failed_ && inFlight_ > 0) {
+            if (context.isCancelled()) {
+                return false;
+            }
+            changed_.wait_for(lock, kCancelPollInterval);
+        }
+        return !failed_;
+    }
+};
+
 // ============================================================================
 // IORequestHostObject Implementation
 // ============================================================================
 
 class IORequestHostObject : public JSIHostObjectBase<IORequestHostObject> {
     friend class JSIHostObjectBase<IORequestHostObject>;
+    static constexpr const char* kStatsScope = "request";  // Prefix of its methods in getStats()
 
 private:
     std::shared_ptr<IOHttpClient> client_;
     std::shared_ptr<JSCallInvokerWrapper> invoker_;
+    std::shared_ptr<SharedExecutor> sharedExecutor_;
     std::unique_ptr<TaskExecutor> executor_;
 
 public:
     /**
      * @brief Construct IORequestHostObject
      * @param runtime JSI Runtime reference
-     * @param threadPool Thread pool for async operations
+     * @param executor Shared executor (requests run on its network lane,
+     *   admitted by the process-wide RequestScheduler)
      * @param callInvoker React Native's CallInvoker for JS thread callbacks
      */
     IORequestHostObject(
         Runtime& runtime,
-        std::shared_ptr<BS::thread_pool<>> threadPool,
+        std::shared_ptr<SharedExecutor> executor,
         std::shared_ptr<facebook::react::CallInvoker> callInvoker
     ) : client_(IOHttpClient::create())
       , invoker_(std::make_shared<RequestCallInvokerAdapter>(std::move(callInvoker), runtime))
-      , executor_(std::make_unique<RequestThreadPoolExecutor>(std::move(threadPool)))
+      , sharedExecutor_(executor)
+      , executor_(std::make_unique<RequestExecutor>(std::move(executor)))
     {
         callInvoker_ = invoker_;
         init();
@@ -102,18 +166,30 @@ public:
     // Required for async methods
     TaskExecutor* getTaskExecutor() { return executor_.get(); }
 
+    /**
+     * @brief Host of an async call, for the scheduler's per-host limit
+     *
+     * request, download and upload all take the URL first.
+     */
+    std::string taskKey(Runtime& rt, const std::string& /*method*/, const Value* args, size_t count) {
+        if (count == 0 || !args[0].isString()) {
+            return {};
+        }
+        return urlAuthority(args[0].asString(rt).utf8(rt));
+    }
+
 private:
     // ========================================================================
     // Helper: Convert HttpResponse to AsyncResult
     // ========================================================================
-    static AsyncResult responseToAsyncResult(const HttpResponse& response) {
+    static AsyncResult responseToAsyncResult(HttpResponse&& response) {
         AsyncResultMap obj;
         obj.emplace("success", response.success);
         obj.emplace("statusCode", static_cast<double>(response.statusCode));
         obj.emplace("statusMessage", response.statusMessage);
         obj.emplace("url", response.url);
         obj.emplace("errorMessage", response.errorMessage);
-        obj.emplace("body", response.body);  // vector<uint8_t> -> ArrayBuffer
+        obj.emplace("body", std::move(response.body));  // vector<uint8_t> -> ArrayBuffer (moved, no copy)
 
         // Headers as parallel arrays
         std::vector<AsyncResult> headerKeys;
@@ -146,15 +222,109 @@ private:
     // ========================================================================
     // Helper: Convert UploadResult to AsyncResult
     // ========================================================================
-    static AsyncResult uploadResultToAsyncResult(const UploadResult& result) {
+    static AsyncResult uploadResultToAsyncResult(UploadResult&& result) {
         AsyncResultMap obj;
         obj.emplace("success", result.success);
         obj.emplace("statusCode", static_cast<double>(result.statusCode));
-        obj.emplace("responseBody", result.responseBody);  // vector<uint8_t> -> ArrayBuffer
+        obj.emplace("responseBody", std::move(result.responseBody));  // vector<uint8_t> -> ArrayBuffer (moved, no copy)
         obj.emplace("errorMessage", result.errorMessage);
+        obj.emplace("uploadUrl", result.uploadUrl);
         return AsyncResult(std::move(obj));
     }
 
+    /**
+     * @brief Upload progress forwarded to an optional JS callback (see ProgressHub)
+     */
+    static UploadProgressCallback makeUploadProgress(const std::shared_ptr<ProgressReporter>& reporter) {
+        if (!reporter) {
+            return {};
+        }
+        return [reporter](const UploadProgress& progress) {
+            reporter->report(progress.bytesSent, progress.totalBytes);
+        };
+    }
+
+    /**
+     * @brief Download progress forwarded to an optional JS callback (see ProgressHub)
+     */
+    static DownloadProgressCallback makeDownloadProgress(const std::shared_ptr<ProgressReporter>& reporter) {
+        if (!reporter) {
+            return {};
+        }
+        return [reporter](const DownloadProgress& progress) {
+            reporter->report(progress.bytesReceived, progress.totalBytes);
+        };
+    }
+
+    /** @brief Request body argument: string, ArrayBuffer or null */
+    using RequestBody = std::variant<std::monostate, std::string, BufferArg>;
+
+    /// Bytes a streamed body may run ahead of its onChunk callback by default
+    static constexpr size_t kDefaultStreamWindow = 1024 * 1024;
+
+    /** @brief Headers from a flat [key1, value1, key2, value2, ...] array */
+    static HttpHeaders toHeaders(const std::vector<std::string>& flat) {
+        HttpHeaders headers;
+        for (size_t i = 0; i + 1 < flat.size(); i += 2) {
+            headers[flat[i]] = flat[i + 1];
+        }
+        return headers;
+    }
+
+    /**
+     * @brief Request config shared by request() and requestStream()
+     */
+    static HttpRequestConfig makeRequestConfig(
+        const std::string& url, const std::string& method, const std::vector<std::string>& headers,
+        const RequestBody& body, int32_t timeoutMs, std::optional<bool> followRedirects,
+        const std::optional<std::string>& bodyEncoding
+    ) {
+        HttpRequestConfig config;
+        config.url = url;
+        config.method = stringToHttpMethod(method);
+        config.headers = toHeaders(headers);
+        config.timeoutMs = timeoutMs;
+        config.followRedirects = followRedirects.value_or(true);
+
+        if (const auto* text = std::get_if<std::string>(&body)) {
+            config.bodyString = *text;
+        } else if (const auto* buffer = std::get_if<BufferArg>(&body)) {
+            config.bodyView = buffer->span();  // The pinned ArrayBuffer outlives the call
+        }
+
+        if (bodyEncoding && !bodyEncoding->empty() && *bodyEncoding != "identity") {
+            if (*bodyEncoding != "gzip") {
+                throw std::runtime_error("Unsupported body encoding: " + *bodyEncoding);
+            }
+            if (config.hasBody()) {
+                config.body = gzipEncode(config.bodyBytes());
+                config.bodyString.clear();
+                config.bodyView = {};
+                config.headers["Content-Encoding"] = "gzip";
+            }
+        }
+        return config;
+    }
+
+    /**
+     * @brief Transfer cancel check bound to the call's CancelToken and deadline, if any
+     */
+    static TransferCancelCheck makeCancelCheck(const AsyncContext& context) {
+        if (!context.cancelToken && context.deadline == AsyncContext::kNoDeadline) {
+            return {};
+        }
+        return [&context] { return context.isCancelled(); };
+    }
+
+    /**
+     * @brief Turn a transfer that ended because of cancellation into a cancel error
+     */
+    static void throwIfCancelled(const AsyncContext& context) {
+        if (context.isCancelled()) {
+            throw std::runtime_error(kCancelledMessage);
+        }
+    }
+
     // ========================================================================
     // Property Registration
     // ========================================================================
@@ -172,64 +342,96 @@ private:
         // Async HTTP Request
         // ====================================================================
 
-        // request(url, method, headers[], body, timeout, followRedirects) -> Promise
-        // JSI_ASYNC_METHOD uses jsiStrArgs, jsiNumArgs, jsiBoolArgs, jsiBufArgs
-        // Args order by type extraction:
-        //   jsiStrArgs: [url, method, headerKey1, headerVal1, ..., bodyStr?]
-        //   jsiNumArgs: [timeout]
-        //   jsiBoolArgs: [followRedirects]
-        //   jsiBufArgs: [body?] if ArrayBuffer
-        JSI_ASYNC_METHOD(request, 6, {
-            HttpRequestConfig config;
-
-            // url and method are first two string args
-            config.url = JSI_S_ARG(0);
-            config.method = stringToHttpMethod(JSI_S_ARG(1));
-            config.timeoutMs = static_cast<int32_t>(JSI_N_ARG(0));
-            config.followRedirects = JSI_B_ARG(0);
-
-            // Body from buffer args if present
-            if (!jsiBufArgs.empty()) {
-                config.body = jsiBufArgs[0];
-            }
-
-            // Parse headers: all strings from index 2 are header key-value pairs
-            // If body was string (not buffer), it would be at end - but we use buffer
-            size_t numHeaderStrings = jsiStrArgs.size() - 2;
+        // request(url, method, headers[], body, timeout, followRedirects, bodyEncoding?) -> Promise
+        // headers is a flat [key1, value1, key2, value2, ...] array. Passes
+        // through the HTTP cache once it is enabled (see HttpCache). With
+        // bodyEncoding "gzip" the body is compressed here before it is sent.
+        JSI_ASYNC_TYPED(request, (const std::string& url, const std::string& method,
+                                  const std::vector<std::string>& headers, const RequestBody& body,
+                                  int32_t timeoutMs, std::optional<bool> followRedirects,
+                                  std::optional<std::string> bodyEncoding), {
+            auto config = makeRequestConfig(url, method, headers, body, timeoutMs, followRedirects, bodyEncoding);
+            config.isCancelled = makeCancelCheck(jsiCtx);
+
+            auto response = HttpCache::instance().fetch(*client_, config);
+            throwIfCancelled(jsiCtx);
+            return responseToAsyncResult(std::move(response));
+        })
 
-            // If odd count and no buffer, last string is body
-            if (numHeaderStrings % 2 == 1 && jsiBufArgs.empty()) {
-                auto bodyStr = jsiStrArgs.back();
-                config.body = std::vector<uint8_t>(bodyStr.begin(), bodyStr.end());
-                numHeaderStrings--;
+        // requestStream(url, method, headers[], body, timeout, followRedirects, bodyEncoding?, highWaterMark?, onChunk) -> Promise
+        // Like request(), but the body is passed to onChunk(ArrayBuffer) as it
+        // arrives and the result's body is empty. At most highWaterMark bytes
+        // run ahead of onChunk; an async onChunk holds the transfer back until
+        // its Promise settles. Resolves after every chunk has been handled and
+        // rejects if onChunk throws or rejects (the transfer is aborted).
+        JSI_ASYNC_TYPED(requestStream, (const std::string& url, const std::string& method,
+                                        const std::vector<std::string>& headers, const RequestBody& body,
+                                        int32_t timeoutMs, std::optional<bool> followRedirects,
+                                        std::optional<std::string> bodyEncoding,
+                                        std::optional<int64_t> highWaterMark), {
+            const auto* onChunk = JSI_FN_OPT(0);
+            if (!onChunk) {
+                throw std::runtime_error("requestStream: onChunk callback is required");
             }
 
-            for (size_t i = 0; i < numHeaderStrings; i += 2) {
-                config.headers[jsiStrArgs[2 + i]] = jsiStrArgs[2 + i + 1];
-            }
+            auto config = makeRequestConfig(url, method, headers, body, timeoutMs, followRedirects, bodyEncoding);
+            config.isCancelled = makeCancelCheck(jsiCtx);
+
+            auto window = std::make_shared<StreamWindow>(
+                highWaterMark && *highWaterMark > 0 ? static_cast<size_t>(*highWaterMark) : kDefaultStreamWindow);
+            config.onBodyChunk = [&jsiCtx, onChunk, window](std::vector<uint8_t>&& chunk) {
+                auto size = chunk.size();
+                if (!window->acquire(size, jsiCtx)) {
+                    return false;
+                }
+                // The vector becomes the ArrayBuffer's backing store (no copy)
+                onChunk->post({AsyncResult(std::move(chunk))},
+                              [window, size](bool ok) { window->release(size, ok); });
+                return !jsiCtx.isCancelled();
+            };
 
             auto response = client_->request(config);
-            return responseToAsyncResult(response);
+            bool handled = window->drain(jsiCtx);
+            throwIfCancelled(jsiCtx);
+            if (!handled) {
+                throw std::runtime_error("requestStream: onChunk failed");
+            }
+            return responseToAsyncResult(std::move(response));
         })
 
         // ====================================================================
         // Async Download
         // ====================================================================
 
-        // download(url, destinationPath, headers[], timeout, resumable) -> Promise
-        JSI_ASYNC_METHOD(download, 5, {
+        // download(url, destinationPath, headers[], timeout, resumable, segments?, onProgress?) -> Promise
+        // segments > 1 fetches that many byte ranges in parallel (see downloadSegmented),
+        // each extra connection admitted by the scheduler's global and per-host limits.
+        // onProgress(received, total, bytesPerSecond) goes through ProgressHub.
+        JSI_ASYNC_TYPED(download, (const std::string& url, const std::string& destinationPath,
+                                   const std::vector<std::string>& headers, int32_t timeoutMs,
+                                   std::optional<bool> resumable, std::optional<int32_t> segments), {
             DownloadConfig config;
-            config.url = JSI_S_ARG(0);
-            config.destinationPath = JSI_S_ARG(1);
-            config.timeoutMs = static_cast<int32_t>(JSI_N_ARG(0));
-            config.resumable = JSI_B_ARG(0);
-
-            // Headers are from index 2 onward in string args
-            for (size_t i = 2; i + 1 < jsiStrArgs.size(); i += 2) {
-                config.headers[jsiStrArgs[i]] = jsiStrArgs[i + 1];
+            config.url = url;
+            config.destinationPath = destinationPath;
+            config.headers = toHeaders(headers);
+            config.timeoutMs = timeoutMs;
+            config.resumable = resumable.value_or(false);
+            config.segments = segments.value_or(1);
+            config.isCancelled = makeCancelCheck(jsiCtx);
+
+            auto reporter = ProgressHub::instance().open(JSI_FN_OPT(0));
+            StatCacheInvalidation changed(destinationPath);
+            // Extra connections go through the scheduler like the download itself
+            auto launchConnection = [this, key = urlAuthority(url)](std::function<void()>&& task) {
+                return RequestScheduler::instance().tryStart(sharedExecutor_, key, 0, std::move(task));
+            };
+            auto result = config.segments > 1
+                ? downloadSegmented(*client_, config, makeDownloadProgress(reporter), launchConnection)
+                : client_->download(config, makeDownloadProgress(reporter));
+            if (reporter) {
+                reporter->finish();  // Last event ahead of the result
             }
-
-            auto result = client_->download(config);
+            throwIfCancelled(jsiCtx);
             return downloadResultToAsyncResult(result);
         })
 
@@ -237,42 +439,57 @@ private:
         // Async Upload
         // ====================================================================
 
-        // upload(url, filePath, fieldName, fileName, mimeType, headers[], formKeys[], formValues[], timeout) -> Promise
-        // jsiStrArgs: [url, filePath, fieldName, fileName, mimeType, headers..., formKeys..., formValues...]
-        // jsiNumArgs: [timeout, headerCount, formFieldCount]
-        JSI_ASYNC_METHOD(upload, 9, {
+        // upload(url, filePath, fieldName, fileName, mimeType, headers[], formKeys[], formValues[], timeout,
+        //        files[]?, resumable?, resumeUrl?, chunkSize?, onProgress?) -> Promise
+        // files is a flat [path, fieldName, fileName, mimeType, ...] array of further
+        // parts. The body is streamed from the files; onProgress(sent, total,
+        // bytesPerSecond) is rate-limited and batched by ProgressHub. resumable
+        // sends filePath with tus instead (see uploadResumable).
+        JSI_ASYNC_TYPED(upload, (const std::string& url, const std::string& filePath,
+                                 const std::string& fieldName, const std::string& fileName,
+                                 const std::string& mimeType, const std::vector<std::string>& headers,
+                                 const std::vector<std::string>& formKeys,
+                                 const std::vector<std::string>& formValues, int32_t timeoutMs,
+                                 std::optional<std::vector<std::string>> files, std::optional<bool> resumable,
+                                 std::optional<std::string> resumeUrl, std::optional<int64_t> chunkSize), {
             UploadConfig config;
-            config.url = JSI_S_ARG(0);
-            config.filePath = JSI_S_ARG(1);
-            config.fieldName = JSI_S_ARG(2);
-            config.fileName = JSI_S_ARG(3);
-            config.mimeType = JSI_S_ARG(4);
-            config.timeoutMs = static_cast<int32_t>(JSI_N_ARG(0));
-
-            // Parse headerCount and formFieldCount from numbers if available
-            size_t headerCount = jsiNumArgs.size() > 1 ? static_cast<size_t>(jsiNumArgs[1]) : 0;
-            size_t formFieldCount = jsiNumArgs.size() > 2 ? static_cast<size_t>(jsiNumArgs[2]) : 0;
-
-            // Headers start at index 5
-            size_t headerStartIdx = 5;
-            for (size_t i = 0; i < headerCount * 2 && (headerStartIdx + i + 1) < jsiStrArgs.size(); i += 2) {
-                config.headers[jsiStrArgs[headerStartIdx + i]] = jsiStrArgs[headerStartIdx + i + 1];
+            config.url = url;
+            config.filePath = filePath;
+            config.fieldName = fieldName;
+            config.fileName = fileName;
+            config.mimeType = mimeType;
+            config.headers = toHeaders(headers);
+            config.timeoutMs = timeoutMs;
+            config.resumable = resumable.value_or(false);
+            config.resumeUrl = resumeUrl.value_or("");
+            config.chunkSize = chunkSize.value_or(0);
+            config.isCancelled = makeCancelCheck(jsiCtx);
+
+            for (size_t i = 0; i < formKeys.size() && i < formValues.size(); ++i) {
+                config.formFields[formKeys[i]] = formValues[i];
             }
-
-            // Form fields start after headers
-            size_t formStartIdx = headerStartIdx + headerCount * 2;
-            for (size_t i = 0; i < formFieldCount && (formStartIdx + i) < jsiStrArgs.size(); ++i) {
-                // formKeys and formValues are separate arrays, so we need different handling
-                // Let's assume formKeys come first, then formValues
-                size_t formKeyIdx = formStartIdx + i;
-                size_t formValIdx = formStartIdx + formFieldCount + i;
-                if (formValIdx < jsiStrArgs.size()) {
-                    config.formFields[jsiStrArgs[formKeyIdx]] = jsiStrArgs[formValIdx];
+            if (files) {
+                for (size_t i = 0; i + 3 < files->size(); i += 4) {
+                    config.files.push_back({(*files)[i], (*files)[i + 1], (*files)[i + 2], (*files)[i + 3]});
                 }
             }
 
-            auto result = client_->upload(config);
-            return uploadResultToAsyncResult(result);
+            auto reporter = ProgressHub::instance().open(JSI_FN_OPT(0));
+            auto result = client_->upload(config, makeUploadProgress(reporter));
+            if (reporter) {
+                reporter->finish();  // Last event ahead of the result
+            }
+            throwIfCancelled(jsiCtx);
+            return uploadResultToAsyncResult(std::move(result));
+        })
+
+        // ====================================================================
+        // Cancellation
+        // ====================================================================
+
+        // createCancelToken() -> CancelToken (pass to request/download/upload)
+        JSI_SYNC_METHOD(createCancelToken, 0, {
+            return Object::createFromHostObject(rt, std::make_shared<CancelToken>());
         })
     }
 };
@@ -0,0 +1,288 @@
+/**
+ * @file IORequestScheduler.hpp
+ * @brief Priority scheduling of HTTP transfers with global and per-host limits
+ *
+ * Transfers wait here, not on a network thread, until both limits allow
+ * them to start, so a burst of requests to one host never occupies the
+ * threads that requests to other hosts need.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_REQUEST_SCHEDULER_HPP
+#define IO_REQUEST_SCHEDULER_HPP
+
+#include "IOExecutor.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace rct_io {
+
+/**
+ * @brief Concurrency limits of HTTP transfers (0 = no limit)
+ *
+ * Without a global limit the network lane's thread count is the limit.
+ */
+struct RequestLimits {
+    size_t maxConcurrent = 0;
+    size_t maxPerHost = 0;
+};
+
+/**
+ * @brief Process-wide queue of HTTP transfers
+ *
+ * Queued transfers start in priority order (FIFO within a priority) as
+ * soon as fewer than the global limit are running and their host is below
+ * the per-host limit; a transfer whose host is saturated is skipped, not
+ * waited for. Started transfers run on the network lane of the executor
+ * they were scheduled with.
+ */
+class RequestScheduler {
+private:
+    struct Pending {
+        std::string key;
+        int priority = 0;
+        std::function<void()> task;
+        std::shared_ptr<SharedExecutor> executor;
+    };
+
+    /// Orders by priority (highest first), then by arrival
+    using QueueKey = std::pair<int, uint64_t>;
+
+    std::mutex mutex_;
+    RequestLimits limits_;
+    std::map<QueueKey, Pending> pending_;
+    std::unordered_map<std::string, size_t> runningPerHost_;
+    size_t running_ = 0;
+    uint64_t nextSeq_ = 0;
+
+    [[nodiscard]] auto globalLimit(const SharedExecutor& executor) const -> size_t {
+        return limits_.maxConcurrent > 0
+            ? limits_.maxConcurrent
+            : executor.threadCount(ExecutorLane::Network);
+    }
+
+    [[nodiscard]] auto hostFull(const std::string& key) const -> bool {
+        if (key.empty() || limits_.maxPerHost == 0) {
+            return false;
+        }
+        auto it = runningPerHost_.find(key);
+        return it != runningPerHost_.end() && it->second >= limits_.maxPerHost;
+    }
+
+    /**
+     * @brief Take every transfer that may start now off the queue (locked)
+     */
+    auto takeRunnableLocked() -> std::vector<Pending> {
+        std::vector<Pending> runnable;
+        std::unordered_set<std::string> fullHosts;
+        for (auto it = pending_.begin(); it != pending_.end();) {
+            auto& entry = it->second;
+            if (running_ >= globalLimit(*entry.executor)) {
+                break;
+            }
+            if (fullHosts.contains(entry.key) || hostFull(entry.key)) {
+                fullHosts.insert(entry.key);
+                ++it;
+                continue;
+            }
+            ++running_;
+            if (!entry.key.empty()) {
+                ++runningPerHost_[entry.key];
+            }
+            runnable.push_back(std::move(entry));
+            it = pending_.erase(it);
+        }
+        return runnable;
+    }
+
+    auto start(std::vector<Pending>&& runnable) -> void {
+        for (auto& entry : runnable) {
+            auto executor = std::move(entry.executor);
+            executor->submit(ExecutorLane::Network,
+                [this, key = std::move(entry.key), task = std::move(entry.task)]() mutable {
+                    struct Finish {
+                        RequestScheduler* scheduler;
+                        const std::string& key;
+                        ~Finish() { scheduler->finished(key); }
+                    } finish{this, key};
+                    task();
+                }, entry.priority);
+        }
+    }
+
+    auto finished(const std::string& key) -> void {
+        std::vector<Pending> runnable;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --running_;
+            if (!key.empty()) {
+                if (auto it = runningPerHost_.find(key); it != runningPerHost_.end() && --it->second == 0) {
+                    runningPerHost_.erase(it);
+                }
+            }
+            runnable = takeRunnableLocked();
+        }
+        start(std::move(runnable));
+    }
+
+public:
+    RequestScheduler() = default;
+    RequestScheduler(const RequestScheduler&) = delete;
+    RequestScheduler& operator=(const RequestScheduler&) = delete;
+
+    /**
+     * @brief The process-wide scheduler
+     *
+     * Never destroyed, so network threads finishing during exit can still
+     * report back.
+     */
+    [[nodiscard]] static auto instance() -> RequestScheduler& {
+        static auto* scheduler = new RequestScheduler();
+        return *scheduler;
+    }
+
+    /**
+     * @brief Change the limits; queued transfers are re-evaluated at once
+     *
+     * Lowering a limit does not interrupt running transfers.
+     */
+    auto configure(const RequestLimits& limits) -> void {
+        std::vector<Pending> runnable;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            limits_ = limits;
+            runnable = takeRunnableLocked();
+        }
+        start(std::move(runnable));
+    }
+
+    [[nodiscard]] auto limits() -> RequestLimits {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return limits_;
+    }
+
+    /**
+     * @brief Queue a transfer
+     * @param key Host of the transfer ("" = not limited per host)
+     * @param priority Higher starts first
+     */
+    auto schedule(
+        std::shared_ptr<SharedExecutor> executor,
+        std::string key,
+        int priority,
+        std::function<void()>&& task
+    ) -> void {
+        priority = std::clamp(priority, -128, 127);
+        std::vector<Pending> runnable;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.emplace(QueueKey{-priority, nextSeq_++},
+                             Pending{std::move(key), priority, std::move(task), std::move(executor)});
+            runnable = takeRunnableLocked();
+        }
+        start(std::move(runnable));
+    }
+
+    /**
+     * @brief Start a task now if the limits allow it, without queueing it
+     *
+     * For extra connections of a running transfer (segmented downloads):
+     * they count against the same global and per-host limits, but are only
+     * granted while no transfer is waiting, so they never delay one.
+     *
+     * @return false if the task was not started
+     */
+    auto tryStart(
+        std::shared_ptr<SharedExecutor> executor,
+        std::string key,
+        int priority,
+        std::function<void()>&& task
+    ) -> bool {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!pending_.empty() || running_ >= globalLimit(*executor) || hostFull(key)) {
+                return false;
+            }
+            ++running_;
+            if (!key.empty()) {
+                ++runningPerHost_[key];
+            }
+        }
+        std::vector<Pending> runnable;
+        runnable.push_back(Pending{std::move(key), std::clamp(priority, -128, 127), std::move(task), std::move(executor)});
+        start(std::move(runnable));
+        return true;
+    }
+
+    /** @brief Number of transfers waiting to start */
+    [[nodiscard]] auto pendingCount() -> size_t {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_.size();
+    }
+
+    /** @brief Number of transfers started and not yet finished */
+    [[nodiscard]] auto runningCount() -> size_t {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return running_;
+    }
+};
+
+/**
+ * @brief TaskExecutor of a request host object
+ *
+ * Sends every task through the process-wide RequestScheduler, with
+ * TaskOptions::key as the host.
+ */
+class RequestExecutor : public jsi_utils::TaskExecutor {
+private:
+    std::shared_ptr<SharedExecutor> shared_;
+
+public:
+    explicit RequestExecutor(std::shared_ptr<SharedExecutor> shared)
+        : shared_(std::move(shared)) {}
+
+    void execute(std::function<void()>&& task) override {
+        RequestScheduler::instance().schedule(shared_, {}, 0, std::move(task));
+    }
+
+    void execute(std::function<void()>&& task, const jsi_utils::TaskOptions& options) override {
+        RequestScheduler::instance().schedule(shared_, options.key, options.priority, std::move(task));
+    }
+
+    size_t concurrency() const override {
+        return shared_->threadCount(ExecutorLane::Network);
+    }
+};
+
+} // namespace rct_io
+
+#endif // IO_REQUEST_SCHEDULER_HPP
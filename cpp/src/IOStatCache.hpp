@@ -0,0 +1,286 @@
+/**
+ * @file IOStatCache.hpp
+ * @brief File metadata in one stat call, and a bounded cache of it
+ *
+ * statFile() gathers type, size and modification time with a single
+ * stat(). StatCache keeps recent results so repeated exists/isFile/
+ * getMetadata queries on hot paths do not reach the kernel. Writes,
+ * deletes and moves made through this library invalidate the paths they
+ * touch; changes made by anyone else are picked up once an entry's TTL
+ * runs out. The cache is process-wide and disabled until configured.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_STAT_CACHE_HPP
+#define IO_STAT_CACHE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <sys/stat.h>
+
+namespace rct_io {
+
+/**
+ * @brief Result of one stat() of a path (symlinks followed)
+ */
+struct FileStat {
+    enum class Kind : uint8_t {
+        Missing = 0,
+        File = 1,
+        Directory = 2,
+        Other = 3,   // Exists, but is neither (socket, device, ...)
+    };
+
+    Kind kind = Kind::Missing;
+    int64_t size = 0;           // Of regular files
+    int64_t modifiedTime = 0;   // Milliseconds since the Unix epoch
+
+    [[nodiscard]] auto exists() const -> bool { return kind != Kind::Missing; }
+};
+
+/** @brief Stat a path once; errors (no such file, no permission) read as missing */
+[[nodiscard]] inline auto statFile(const std::string& path) -> FileStat {
+    FileStat result;
+    struct stat st {};
+    if (::stat(path.c_str(), &st) != 0) {
+        return result;
+    }
+    if (S_ISREG(st.st_mode)) {
+        result.kind = FileStat::Kind::File;
+        result.size = static_cast<int64_t>(st.st_size);
+    } else if (S_ISDIR(st.st_mode)) {
+        result.kind = FileStat::Kind::Directory;
+    } else {
+        result.kind = FileStat::Kind::Other;
+    }
+#if defined(__APPLE__)
+    const auto& mtime = st.st_mtimespec;
+#else
+    const auto& mtime = st.st_mtim;
+#endif
+    result.modifiedTime = static_cast<int64_t>(mtime.tv_sec) * 1000 + static_cast<int64_t>(mtime.tv_nsec) / 1000000;
+    return result;
+}
+
+struct StatCacheOptions {
+    size_t maxEntries = 0;   // 0 = disabled
+    int64_t ttlMs = 1000;    // Age after which an entry is stat'ed again; 0 = until invalidated
+};
+
+/**
+ * @brief Process-wide LRU cache of statFile() results, missing paths included
+ *
+ * A lookup that misses takes a generation token before it stats; the
+ * result is only stored if nothing was invalidated in between, so a stat
+ * racing with a write cannot put a stale entry back.
+ */
+class StatCache {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Node {
+        std::string key;
+        FileStat stat;
+        Clock::time_point expires;
+    };
+
+    mutable std::mutex mutex_;
+    std::list<Node> lru_;  // Most recently used first
+    std::unordered_map<std::string_view, std::list<Node>::iterator> index_;
+    StatCacheOptions options_;
+    std::atomic<bool> enabled_{false};
+    std::atomic<uint64_t> generation_{0};
+
+    StatCache() = default;
+
+    /** @brief Cache key of a path: "a//b/./c/" and "a/b/c" are the same entry */
+    static auto keyOf(const std::string& path) -> std::string {
+        bool plain = path.find("//") == std::string::npos && path.find("/.") == std::string::npos
+            && (path.size() < 2 || path.back() != '/');
+        std::string key = plain ? path : std::filesystem::path(path).lexically_normal().string();
+        while (key.size() > 1 && key.back() == '/') {
+            key.pop_back();
+        }
+        return key;
+    }
+
+    static auto parentOf(const std::string& key) -> std::string {
+        auto slash = key.find_last_of('/');
+        if (slash == std::string::npos) {
+            return {};
+        }
+        return slash == 0 ? "/" : key.substr(0, slash);
+    }
+
+    auto eraseLocked(const std::string& key) -> void {
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            auto node = it->second;
+            index_.erase(it);
+            lru_.erase(node);
+        }
+    }
+
+    auto invalidateLocked(const std::string& key, bool tree) -> void {
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+        eraseLocked(key);
+        // The parent's modification time changes with its entries
+        if (auto parent = parentOf(key); !parent.empty()) {
+            eraseLocked(parent);
+        }
+        if (tree) {
+            std::string prefix = key == "/" ? key : key + "/";
+            for (auto it = lru_.begin(); it != lru_.end();) {
+                if (it->key.compare(0, prefix.size(), prefix) == 0) {
+                    index_.erase(it->key);
+                    it = lru_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+
+public:
+    static auto instance() -> StatCache& {
+        static auto* cache = new StatCache();  // Leaked: used from worker threads up to exit
+        return *cache;
+    }
+
+    /** @brief Set the size limit and TTL; drops all entries */
+    auto configure(const StatCacheOptions& options) -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options_ = options;
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+        index_.clear();
+        lru_.clear();
+        enabled_.store(options.maxEntries > 0, std::memory_order_release);
+    }
+
+    [[nodiscard]] auto options() const -> StatCacheOptions {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return options_;
+    }
+
+    /** @brief statFile() through the cache */
+    auto stat(const std::string& path) -> FileStat {
+        if (!enabled_.load(std::memory_order_acquire)) {
+            return statFile(path);
+        }
+        auto key = keyOf(path);
+        uint64_t token = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = index_.find(key);
+            auto now = Clock::now();
+            if (it != index_.end()) {
+                if (options_.ttlMs <= 0 || it->second->expires > now) {
+                    lru_.splice(lru_.begin(), lru_, it->second);
+                    return it->second->stat;
+                }
+                auto node = it->second;
+                index_.erase(it);
+                lru_.erase(node);
+            }
+            token = generation_.load(std::memory_order_acquire);
+        }
+
+        auto result = statFile(path);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (generation_.load(std::memory_order_acquire) != token || options_.maxEntries == 0
+            || index_.count(key) > 0) {
+            return result;
+        }
+        lru_.push_front({std::move(key), result, Clock::now() + std::chrono::milliseconds(options_.ttlMs)});
+        index_.emplace(lru_.front().key, lru_.begin());
+        while (lru_.size() > options_.maxEntries) {
+            index_.erase(lru_.back().key);
+            lru_.pop_back();
+        }
+        return result;
+    }
+
+    /** @brief Forget a path (and its parent directory) after it was changed */
+    auto invalidate(const std::string& path) -> void {
+        if (!enabled_.load(std::memory_order_acquire)) {
+            return;
+        }
+        auto key = keyOf(path);
+        std::lock_guard<std::mutex> lock(mutex_);
+        invalidateLocked(key, false);
+    }
+
+    /** @brief Forget a path, its parent and everything below it (directory deletes and moves) */
+    auto invalidateTree(const std::string& path) -> void {
+        if (!enabled_.load(std::memory_order_acquire)) {
+            return;
+        }
+        auto key = keyOf(path);
+        std::lock_guard<std::mutex> lock(mutex_);
+        invalidateLocked(key, true);
+    }
+
+    /** @brief Forget everything, e.g. after files were changed outside this library */
+    auto clear() -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+        index_.clear();
+        lru_.clear();
+    }
+};
+
+/**
+ * @brief Invalidate a path when the operation changing it is over, whether it succeeded or not
+ */
+class StatCacheInvalidation {
+private:
+    const std::string& path_;
+    bool tree_;
+
+public:
+    explicit StatCacheInvalidation(const std::string& path, bool tree = false) : path_(path), tree_(tree) {}
+
+    ~StatCacheInvalidation() {
+        if (tree_) {
+            StatCache::instance().invalidateTree(path_);
+        } else {
+            StatCache::instance().invalidate(path_);
+        }
+    }
+
+    StatCacheInvalidation(const StatCacheInvalidation&) = delete;
+    StatCacheInvalidation& operator=(const StatCacheInvalidation&) = delete;
+};
+
+} // namespace rct_io
+
+#endif // IO_STAT_CACHE_HPP
@@ -0,0 +1,616 @@
+/**
+ * @file IOTextCodec.hpp
+ * @brief Text and binary-to-text codecs (UTF-8, UTF-16LE, Latin-1, ASCII, base64, hex)
+ *
+ * JS strings reach native code as UTF-8, so every codec converts between
+ * UTF-8 and the bytes of one encoding. Text is mostly ASCII; the kernels
+ * find and copy ASCII runs 16 bytes at a time with SSE2 or NEON and only
+ * fall back to per-code-point work for the rest.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef IO_TEXT_CODEC_HPP
+#define IO_TEXT_CODEC_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__)
+#define IO_TEXT_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define IO_TEXT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace rct_io {
+
+/**
+ * @brief Byte encoding of a string
+ */
+enum class TextEncoding : int {
+    Utf8 = 0,
+    Ascii = 1,      // 7-bit; other code points encode as '?'
+    Latin1 = 2,     // One byte per code point up to U+00FF; others encode as '?'
+    Utf16le = 3,
+    Base64 = 4,     // Decoding also accepts the URL-safe alphabet and whitespace
+    Base64Url = 5,  // URL-safe alphabet, no padding
+    Hex = 6,
+};
+
+namespace codec_detail {
+
+/** @brief Length of the ASCII run at the start of data */
+inline auto asciiPrefix(const uint8_t* data, size_t size) -> size_t {
+    size_t i = 0;
+#if defined(IO_TEXT_SSE2)
+    for (; i + 16 <= size; i += 16) {
+        auto mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+#elif defined(IO_TEXT_NEON)
+    for (; i + 16 <= size; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(data + i)) >= 0x80) {
+            break;
+        }
+    }
+#endif
+    while (i < size && data[i] < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+/** @brief Number of leading UTF-16 code units below 0x80 */
+inline auto asciiPrefix16(const uint8_t* data, size_t units) -> size_t {
+    size_t i = 0;
+#if defined(IO_TEXT_SSE2)
+    const auto high = _mm_set1_epi16(static_cast<short>(0xFF80));
+    for (; i + 8 <= units; i += 8) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 2 * i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, high), _mm_setzero_si128())) != 0xFFFF) {
+            break;
+        }
+    }
+#elif defined(IO_TEXT_NEON)
+    for (; i + 8 <= units; i += 8) {
+        if (vmaxvq_u16(vreinterpretq_u16_u8(vld1q_u8(data + 2 * i))) >= 0x80) {
+            break;
+        }
+    }
+#endif
+    while (i < units && data[2 * i] < 0x80 && data[2 * i + 1] == 0) {
+        ++i;
+    }
+    return i;
+}
+
+/** @brief Narrow units ASCII UTF-16LE code units to bytes */
+inline auto narrowAscii(const uint8_t* src, size_t units, char* dst) -> void {
+    size_t i = 0;
+#if defined(IO_TEXT_SSE2)
+    for (; i + 8 <= units; i += 8) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(v, v));
+    }
+#elif defined(IO_TEXT_NEON)
+    for (; i + 8 <= units; i += 8) {
+        vst1_u8(reinterpret_cast<uint8_t*>(dst + i), vmovn_u16(vreinterpretq_u16_u8(vld1q_u8(src + 2 * i))));
+    }
+#endif
+    for (; i < units; ++i) {
+        dst[i] = static_cast<char>(src[2 * i]);
+    }
+}
+
+/** @brief Widen size ASCII bytes to UTF-16LE code units */
+inline auto widenAscii(const uint8_t* src, size_t size, char* dst) -> void {
+    size_t i = 0;
+#if defined(IO_TEXT_SSE2)
+    const auto zero = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i + 16), _mm_unpackhi_epi8(v, zero));
+    }
+#elif defined(IO_TEXT_NEON)
+    for (; i + 16 <= size; i += 16) {
+        uint8x16x2_t pair = {{vld1q_u8(src + i), vdupq_n_u8(0)}};
+        vst2q_u8(reinterpret_cast<uint8_t*>(dst + 2 * i), pair);
+    }
+#endif
+    for (; i < size; ++i) {
+        dst[2 * i] = static_cast<char>(src[i]);
+        dst[2 * i + 1] = 0;
+    }
+}
+
+/**
+ * @brief Decode the UTF-8 sequence at p (p[0] >= 0x80)
+ * @return Its length if valid, else minus the length of the invalid
+ *         prefix to replace with one U+FFFD (the WHATWG "maximal subpart")
+ */
+inline auto utf8Sequence(const uint8_t* p, size_t avail, uint32_t& codePoint) -> int {
+    uint8_t lead = p[0];
+    int length;
+    uint8_t low = 0x80, high = 0xBF;  // Range of the second byte
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+        codePoint = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        codePoint = lead & 0x0F;
+        if (lead == 0xE0) low = 0xA0;        // Overlong
+        if (lead == 0xED) high = 0x9F;       // Surrogates
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        codePoint = lead & 0x07;
+        if (lead == 0xF0) low = 0x90;        // Overlong
+        if (lead == 0xF4) high = 0x8F;       // Above U+10FFFF
+    } else {
+        return -1;
+    }
+    for (int i = 1; i < length; ++i) {
+        if (static_cast<size_t>(i) >= avail) {
+            return -i;
+        }
+        uint8_t byte = p[i];
+        if (byte < (i == 1 ? low : 0x80) || byte > (i == 1 ? high : 0xBF)) {
+            return -i;
+        }
+        codePoint = (codePoint << 6) | (byte & 0x3F);
+    }
+    return length;
+}
+
+inline auto appendUtf8(std::string& out, uint32_t codePoint) -> void {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+inline constexpr uint32_t kReplacement = 0xFFFD;
+
+/**
+ * @brief Visit the code points of UTF-8 text
+ *
+ * ascii(data, size) receives whole ASCII runs, other(codePoint) the rest;
+ * invalid sequences arrive as U+FFFD.
+ */
+template <typename Ascii, typename Other>
+inline auto forEachCodePoint(const uint8_t* data, size_t size, Ascii&& ascii, Other&& other) -> void {
+    size_t i = 0;
+    while (i < size) {
+        auto run = asciiPrefix(data + i, size - i);
+        if (run > 0) {
+            ascii(reinterpret_cast<const char*>(data + i), run);
+            i += run;
+            if (i == size) {
+                break;
+            }
+        }
+        uint32_t codePoint = 0;
+        auto length = utf8Sequence(data + i, size - i, codePoint);
+        if (length > 0) {
+            other(codePoint);
+            i += static_cast<size_t>(length);
+        } else {
+            other(kReplacement);
+            i += static_cast<size_t>(-length);
+        }
+    }
+}
+
+inline constexpr char kBase64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+inline constexpr char kBase64Url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+inline constexpr uint8_t kInvalid = 0xFF;
+inline constexpr uint8_t kSkip = 0xFE;  // Whitespace
+
+/// Both alphabets decode; '=' is handled by the caller
+inline constexpr auto kBase64Decode = [] {
+    std::array<uint8_t, 256> table{};
+    table.fill(kInvalid);
+    for (uint8_t i = 0; i < 64; ++i) {
+        table[static_cast<uint8_t>(kBase64[i])] = i;
+        table[static_cast<uint8_t>(kBase64Url[i])] = i;
+    }
+    for (char c : {' ', '\t', '\r', '\n'}) {
+        table[static_cast<uint8_t>(c)] = kSkip;
+    }
+    return table;
+}();
+
+inline constexpr auto kHexDecode = [] {
+    std::array<uint8_t, 256> table{};
+    table.fill(kInvalid);
+    for (uint8_t i = 0; i < 10; ++i) {
+        table['0' + i] = i;
+    }
+    for (uint8_t i = 0; i < 6; ++i) {
+        table['a' + i] = static_cast<uint8_t>(10 + i);
+        table['A' + i] = static_cast<uint8_t>(10 + i);
+    }
+    return table;
+}();
+
+} // namespace codec_detail
+
+/**
+ * @brief Encoding named from JS
+ * @throws std::runtime_error for an unknown name
+ */
+inline auto parseTextEncoding(std::string_view name) -> TextEncoding {
+    if (name == "utf8") return TextEncoding::Utf8;
+    if (name == "ascii") return TextEncoding::Ascii;
+    if (name == "latin1") return TextEncoding::Latin1;
+    if (name == "utf16le") return TextEncoding::Utf16le;
+    if (name == "base64") return TextEncoding::Base64;
+    if (name == "base64url") return TextEncoding::Base64Url;
+    if (name == "hex") return TextEncoding::Hex;
+    throw std::runtime_error("Unsupported encoding: " + std::string(name));
+}
+
+/** @brief Whether data is well-formed UTF-8 */
+inline auto isValidUtf8(std::span<const uint8_t> data) -> bool {
+    size_t i = 0;
+    while (i < data.size()) {
+        i += codec_detail::asciiPrefix(data.data() + i, data.size() - i);
+        if (i == data.size()) {
+            break;
+        }
+        uint32_t codePoint = 0;
+        auto length = codec_detail::utf8Sequence(data.data() + i, data.size() - i, codePoint);
+        if (length < 0) {
+            return false;
+        }
+        i += static_cast<size_t>(length);
+    }
+    return true;
+}
+
+/** @brief UTF-8 with invalid sequences replaced by U+FFFD */
+inline auto sanitizeUtf8(std::span<const uint8_t> data) -> std::string {
+    std::string out;
+    out.reserve(data.size() + data.size() / 8);
+    codec_detail::forEachCodePoint(data.data(), data.size(),
+        [&out](const char* run, size_t size) { out.append(run, size); },
+        [&out](uint32_t codePoint) { codec_detail::appendUtf8(out, codePoint); });
+    return out;
+}
+
+inline auto latin1ToUtf8(std::span<const uint8_t> data) -> std::string {
+    std::string out;
+    out.reserve(data.size() + data.size() / 4);
+    size_t i = 0;
+    while (i < data.size()) {
+        auto run = codec_detail::asciiPrefix(data.data() + i, data.size() - i);
+        out.append(reinterpret_cast<const char*>(data.data() + i), run);
+        i += run;
+        for (; i < data.size() && data[i] >= 0x80; ++i) {
+            out.push_back(static_cast<char>(0xC0 | (data[i] >> 6)));
+            out.push_back(static_cast<char>(0x80 | (data[i] & 0x3F)));
+        }
+    }
+    return out;
+}
+
+/** @brief ASCII text; the high bit of each byte is dropped */
+inline auto asciiToUtf8(std::span<const uint8_t> data) -> std::string {
+    std::string out(reinterpret_cast<const char*>(data.data()), data.size());
+    auto start = codec_detail::asciiPrefix(data.data(), data.size());
+    for (size_t i = start; i < out.size(); ++i) {
+        out[i] = static_cast<char>(out[i] & 0x7F);
+    }
+    return out;
+}
+
+/**
+ * @brief Bytes of each code point up to limit (0x7F or 0xFF); others become '?'
+ */
+inline auto utf8ToSingleByte(std::string_view text, uint32_t limit) -> std::string {
+    std::string out;
+    out.reserve(text.size());
+    codec_detail::forEachCodePoint(reinterpret_cast<const uint8_t*>(text.data()), text.size(),
+        [&out](const char* run, size_t size) { out.append(run, size); },
+        [&out, limit](uint32_t codePoint) {
+            out.push_back(codePoint <= limit ? static_cast<char>(codePoint) : '?');
+        });
+    return out;
+}
+
+/**
+ * @brief UTF-16LE text to UTF-8
+ *
+ * Unpaired surrogates become U+FFFD and a trailing odd byte is ignored.
+ */
+inline auto utf16leToUtf8(std::span<const uint8_t> data) -> std::string {
+    const uint8_t* p = data.data();
+    size_t units = data.size() / 2;
+    std::string out;
+    out.reserve(units + units / 4);
+    size_t i = 0;
+    while (i < units) {
+        auto run = codec_detail::asciiPrefix16(p + 2 * i, units - i);
+        if (run > 0) {
+            auto offset = out.size();
+            out.resize(offset + run);
+            codec_detail::narrowAscii(p + 2 * i, run, out.data() + offset);
+            i += run;
+            if (i == units) {
+                break;
+            }
+        }
+        uint32_t unit = p[2 * i] | (static_cast<uint32_t>(p[2 * i + 1]) << 8);
+        ++i;
+        if (unit >= 0xD800 && unit <= 0xDBFF && i < units) {
+            uint32_t next = p[2 * i] | (static_cast<uint32_t>(p[2 * i + 1]) << 8);
+            if (next >= 0xDC00 && next <= 0xDFFF) {
+                ++i;
+                codec_detail::appendUtf8(out, 0x10000 + ((unit - 0xD800) << 10) + (next - 0xDC00));
+                continue;
+            }
+        }
+        codec_detail::appendUtf8(out, unit >= 0xD800 && unit <= 0xDFFF ? codec_detail::kReplacement : unit);
+    }
+    return out;
+}
+
+inline auto utf8ToUtf16le(std::string_view text) -> std::string {
+    std::string out;
+    out.reserve(text.size() * 2);
+    codec_detail::forEachCodePoint(reinterpret_cast<const uint8_t*>(text.data()), text.size(),
+        [&out](const char* run, size_t size) {
+            auto offset = out.size();
+            out.resize(offset + 2 * size);
+            codec_detail::widenAscii(reinterpret_cast<const uint8_t*>(run), size, out.data() + offset);
+        },
+        [&out](uint32_t codePoint) {
+            auto put = [&out](uint32_t unit) {
+                out.push_back(static_cast<char>(unit & 0xFF));
+                out.push_back(static_cast<char>(unit >> 8));
+            };
+            if (codePoint >= 0x10000) {
+                codePoint -= 0x10000;
+                put(0xD800 + (codePoint >> 10));
+                put(0xDC00 + (codePoint & 0x3FF));
+            } else {
+                put(codePoint);
+            }
+        });
+    return out;
+}
+
+/**
+ * @brief base64 of data
+ * @param url URL-safe alphabet without padding
+ */
+inline auto base64Encode(std::span<const uint8_t> data, bool url = false) -> std::string {
+    const char* alphabet = url ? codec_detail::kBase64Url : codec_detail::kBase64;
+    std::string out((data.size() + 2) / 3 * 4, '=');
+    const uint8_t* p = data.data();
+    char* o = out.data();
+    size_t i = 0;
+    for (; i + 3 <= data.size(); i += 3, o += 4) {
+        uint32_t v = (static_cast<uint32_t>(p[i]) << 16) | (static_cast<uint32_t>(p[i + 1]) << 8) | p[i + 2];
+        o[0] = alphabet[v >> 18];
+        o[1] = alphabet[(v >> 12) & 0x3F];
+        o[2] = alphabet[(v >> 6) & 0x3F];
+        o[3] = alphabet[v & 0x3F];
+    }
+    auto rest = data.size() - i;
+    if (rest > 0) {
+        uint32_t v = static_cast<uint32_t>(p[i]) << 16;
+        if (rest == 2) {
+            v |= static_cast<uint32_t>(p[i + 1]) << 8;
+        }
+        o[0] = alphabet[v >> 18];
+        o[1] = alphabet[(v >> 12) & 0x3F];
+        if (rest == 2) {
+            o[2] = alphabet[(v >> 6) & 0x3F];
+        }
+    }
+    if (url) {
+        out.erase(out.find_last_not_of('=') + 1);
+    }
+    return out;
+}
+
+/**
+ * @brief Bytes of base64 text in either alphabet, padded or not
+ * @throws std::runtime_error on characters outside the alphabet or a
+ *         single trailing character
+ */
+inline auto base64Decode(std::string_view text) -> std::string {
+    using codec_detail::kBase64Decode;
+    using codec_detail::kInvalid;
+    using codec_detail::kSkip;
+    std::string out;
+    out.resize(text.size() / 4 * 3 + 3);
+    auto* in = reinterpret_cast<const uint8_t*>(text.data());
+    auto* o = reinterpret_cast<uint8_t*>(out.data());
+    size_t i = 0, n = text.size();
+    // Whole quads without whitespace or padding
+    for (; i + 4 <= n; i += 4) {
+        uint8_t a = kBase64Decode[in[i]], b = kBase64Decode[in[i + 1]];
+        uint8_t c = kBase64Decode[in[i + 2]], d = kBase64Decode[in[i + 3]];
+        if ((a | b | c | d) & 0xC0) {
+            break;
+        }
+        uint32_t v = (static_cast<uint32_t>(a) << 18) | (b << 12) | (c << 6) | d;
+        o[0] = static_cast<uint8_t>(v >> 16);
+        o[1] = static_cast<uint8_t>(v >> 8);
+        o[2] = static_cast<uint8_t>(v);
+        o += 3;
+    }
+    // The rest one character at a time
+    uint32_t v = 0;
+    int bits = 0;
+    for (; i < n; ++i) {
+        uint8_t value = kBase64Decode[in[i]];
+        if (value == kSkip) {
+            continue;
+        }
+        if (in[i] == '=') {
+            break;
+        }
+        if (value == kInvalid) {
+            throw std::runtime_error("Invalid base64 input");
+        }
+        v = (v << 6) | value;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            *o++ = static_cast<uint8_t>(v >> bits);
+        }
+    }
+    for (; i < n; ++i) {
+        if (in[i] != '=' && kBase64Decode[in[i]] != kSkip) {
+            throw std::runtime_error("Invalid base64 input");
+        }
+    }
+    // 6 leftover bits mean a single trailing character, which encodes nothing
+    if (bits >= 6) {
+        throw std::runtime_error("Invalid base64 input: truncated");
+    }
+    out.resize(static_cast<size_t>(o - reinterpret_cast<uint8_t*>(out.data())));
+    return out;
+}
+
+/** @brief Lowercase hex of data */
+inline auto hexEncode(std::span<const uint8_t> data) -> std::string {
+    std::string out(data.size() * 2, '\0');
+    const uint8_t* p = data.data();
+    char* o = out.data();
+    size_t i = 0;
+#if defined(IO_TEXT_SSE2)
+    const auto nibble = _mm_set1_epi8(0x0F);
+    const auto nine = _mm_set1_epi8(9);
+    const auto zero = _mm_set1_epi8('0');
+    const auto letters = _mm_set1_epi8('a' - '0' - 10);
+    auto digits = [&](__m128i n) {
+        return _mm_add_epi8(_mm_add_epi8(n, zero), _mm_and_si128(_mm_cmpgt_epi8(n, nine), letters));
+    };
+    for (; i + 16 <= data.size(); i += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        auto hi = digits(_mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        auto lo = digits(_mm_and_si128(v, nibble));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(o + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(o + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#elif defined(IO_TEXT_NEON)
+    const auto table = vld1q_u8(reinterpret_cast<const uint8_t*>("0123456789abcdef"));
+    for (; i + 16 <= data.size(); i += 16) {
+        auto v = vld1q_u8(p + i);
+        uint8x16x2_t pair = {{vqtbl1q_u8(table, vshrq_n_u8(v, 4)), vqtbl1q_u8(table, vandq_u8(v, vdupq_n_u8(0x0F)))}};
+        vst2q_u8(reinterpret_cast<uint8_t*>(o + 2 * i), pair);
+    }
+#endif
+    static constexpr char kDigits[] = "0123456789abcdef";
+    for (; i < data.size(); ++i) {
+        o[2 * i] = kDigits[p[i] >> 4];
+        o[2 * i + 1] = kDigits[p[i] & 0x0F];
+    }
+    return out;
+}
+
+/**
+ * @brief Bytes of hex text (either case)
+ * @throws std::runtime_error on an odd length or a non-hex character
+ */
+inline auto hexDecode(std::string_view text) -> std::string {
+    if (text.size() % 2 != 0) {
+        throw std::runtime_error("Invalid hex input: odd length");
+    }
+    std::string out(text.size() / 2, '\0');
+    auto* in = reinterpret_cast<const uint8_t*>(text.data());
+    for (size_t i = 0; i < out.size(); ++i) {
+        uint8_t hi = codec_detail::kHexDecode[in[2 * i]], lo = codec_detail::kHexDecode[in[2 * i + 1]];
+        if (hi == codec_detail::kInvalid || lo == codec_detail::kInvalid) {
+            throw std::runtime_error("Invalid hex input");
+        }
+        out[i] = static_cast<char>((hi << 4) | lo);
+    }
+    return out;
+}
+
+/**
+ * @brief Text of bytes in an encoding, as UTF-8
+ *
+ * Invalid UTF-8 and UTF-16 sequences decode as U+FFFD; base64 and hex
+ * produce their text form of the bytes.
+ */
+inline auto decodeText(std::span<const uint8_t> bytes, TextEncoding encoding) -> std::string {
+    switch (encoding) {
+        case TextEncoding::Utf8:
+            return isValidUtf8(bytes)
+                ? std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size())
+                : sanitizeUtf8(bytes);
+        case TextEncoding::Ascii: return asciiToUtf8(bytes);
+        case TextEncoding::Latin1: return latin1ToUtf8(bytes);
+        case TextEncoding::Utf16le: return utf16leToUtf8(bytes);
+        case TextEncoding::Base64: return base64Encode(bytes);
+        case TextEncoding::Base64Url: return base64Encode(bytes, true);
+        case TextEncoding::Hex: return hexEncode(bytes);
+    }
+    throw std::runtime_error("Unsupported encoding");
+}
+
+/**
+ * @brief Bytes of UTF-8 text in an encoding
+ * @throws std::runtime_error on malformed base64 or hex
+ */
+inline auto encodeText(std::string_view text, TextEncoding encoding) -> std::string {
+    switch (encoding) {
+        case TextEncoding::Utf8: return std::string(text);
+        case TextEncoding::Ascii: return utf8ToSingleByte(text, 0x7F);
+        case TextEncoding::Latin1: return utf8ToSingleByte(text, 0xFF);
+        case TextEncoding::Utf16le: return utf8ToUtf16le(text);
+        case TextEncoding::Base64:
+        case TextEncoding::Base64Url: return base64Decode(text);
+        case TextEncoding::Hex: return hexDecode(text);
+    }
+    throw std::runtime_error("Unsupported encoding");
+}
+
+} // namespace rct_io
+
+#endif // IO_TEXT_CODEC_HPP
@@ -32,13 +32,25 @@
 #define JSI_HOST_OBJECT_BASE_HPP
 
 #include <jsi/jsi.h>
+#include "JSIMethodStats.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <concepts>
+#include <deque>
 #include <memory>
+#include <optional>
+#include <mutex>
+#include <span>
 #include <string>
 #include <functional>
+#include <limits>
 #include <unordered_map>
 #include <vector>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <variant>
 #include <stdexcept>
 
@@ -46,6 +58,115 @@ namespace jsi_utils {
 
 using namespace facebook::jsi;
 
+// ============================================================================
+// Native Buffers (Zero-Copy ArrayBuffer Backing Stores)
+// ============================================================================
+
+/**
+ * @brief MutableBuffer that owns a byte vector
+ *
+ * Lets a worker-produced std::vector<uint8_t> become the backing store of a
+ * JS ArrayBuffer without copying. The vector is released when the JS
+ * ArrayBuffer is garbage collected.
+ */
+class VectorBuffer : public MutableBuffer {
+private:
+    std::vector<uint8_t> data_;
+
+public:
+    explicit VectorBuffer(std::vector<uint8_t> data) : data_(std::move(data)) {}
+
+    size_t size() const override { return data_.size(); }
+    uint8_t* data() override { return data_.data(); }
+};
+
+/**
+ * @brief MutableBuffer that owns a std::string
+ *
+ * Used where the native side naturally produces a std::string (e.g. the UTF-8
+ * bytes of a JS string) and the result must be exposed as an ArrayBuffer.
+ */
+class StringBuffer : public MutableBuffer {
+private:
+    std::string data_;
+
+public:
+    explicit StringBuffer(std::string data) : data_(std::move(data)) {}
+
+    size_t size() const override { return data_.size(); }
+    uint8_t* data() override { return reinterpret_cast<uint8_t*>(data_.data()); }
+};
+
+/**
+ * @brief Create an ArrayBuffer backed by a native buffer (no copy)
+ */
+inline ArrayBuffer createArrayBuffer(Runtime& rt, std::shared_ptr<MutableBuffer> buffer) {
+    return ArrayBuffer(rt, std::move(buffer));
+}
+
+/**
+ * @brief Create an ArrayBuffer that takes ownership of a byte vector (no copy)
+ */
+inline ArrayBuffer createArrayBuffer(Runtime& rt, std::vector<uint8_t>&& bytes) {
+    return ArrayBuffer(rt, std::make_shared<VectorBuffer>(std::move(bytes)));
+}
+
+/**
+ * @brief Create an ArrayBuffer that takes ownership of a string's bytes (no copy)
+ */
+inline ArrayBuffer createArrayBuffer(Runtime& rt, std::string&& bytes) {
+    return ArrayBuffer(rt, std::make_shared<StringBuffer>(std::move(bytes)));
+}
+
+// ============================================================================
+// Buffer Argument (Zero-Copy ArrayBuffer View)
+// ============================================================================
+
+/**
+ * @brief Read-only view of an ArrayBuffer argument passed to an async method
+ *
+ * The view pins the JS ArrayBuffer for the whole async operation instead of
+ * copying its contents on the JS thread. The pin is released on the JS thread
+ * once the Promise settles.
+ *
+ * @note Like Node's fs.write, the caller must not modify or detach the
+ *       ArrayBuffer until the returned Promise settles.
+ */
+class BufferArg {
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::shared_ptr<Object> pin_;  // Keeps the JS ArrayBuffer alive (JS thread only)
+
+public:
+    BufferArg() = default;
+
+    /**
+     * @brief Pin an ArrayBuffer object (must be called on JS thread)
+     */
+    BufferArg(Runtime& rt, Object&& arrayBufferObj)
+        : pin_(std::make_shared<Object>(std::move(arrayBufferObj)))
+    {
+        auto ab = pin_->getArrayBuffer(rt);
+        data_ = ab.data(rt);
+        size_ = ab.size(rt);
+    }
+
+    [[nodiscard]] auto data() const -> const uint8_t* { return data_; }
+    [[nodiscard]] auto size() const -> size_t { return size_; }
+    [[nodiscard]] auto empty() const -> bool { return size_ == 0; }
+    [[nodiscard]] auto begin() const -> const uint8_t* { return data_; }
+    [[nodiscard]] auto end() const -> const uint8_t* { return data_ + size_; }
+
+    [[nodiscard]] auto span() const -> std::span<const uint8_t> { return {data_, size_}; }
+    operator std::span<const uint8_t>() const { return span(); }
+
+    /** @brief Copy the bytes (only where the callee needs to own them) */
+    [[nodiscard]] auto toVector() const -> std::vector<uint8_t> {
+        return std::vector<uint8_t>(data_, data_ + size_);
+    }
+};
+
 // ============================================================================
 // Async Result Type (Thread-Safe)
 // ============================================================================
@@ -55,6 +176,9 @@ using namespace facebook::jsi;
  *
  * Async handlers return pure C++ data types, which are converted to JS values
  * on the JS thread. This ensures thread safety since Runtime is not thread-safe.
+ *
+ * Byte results are never copied: a std::vector<uint8_t> is moved into a
+ * VectorBuffer, and a shared MutableBuffer is attached to the ArrayBuffer as is.
  */
 struct AsyncResult {
     using DataType = std::variant<
@@ -62,7 +186,8 @@ struct AsyncResult {
         bool,                                        // boolean
         double,                                      // number
         std::string,                                 // string
-        std::vector<uint8_t>,                        // ArrayBuffer
+        std::vector<uint8_t>,                        // ArrayBuffer (owned bytes)
+        std::shared_ptr<MutableBuffer>,              // ArrayBuffer (native buffer)
         std::vector<AsyncResult>,                    // Array
         std::unordered_map<std::string, AsyncResult> // Object
     >;
@@ -79,13 +204,16 @@ struct AsyncResult {
     AsyncResult(const char* v) : data(std::string(v)) {}
     AsyncResult(std::string v) : data(std::move(v)) {}
     AsyncResult(std::vector<uint8_t> v) : data(std::move(v)) {}
+    AsyncResult(std::shared_ptr<MutableBuffer> v) : data(std::move(v)) {}
     AsyncResult(std::vector<AsyncResult> v) : data(std::move(v)) {}
     AsyncResult(std::unordered_map<std::string, AsyncResult> v) : data(std::move(v)) {}
 
     /**
      * @brief Convert AsyncResult to JS Value (must be called on JS thread)
+     * @note Byte buffers are moved into the resulting ArrayBuffers, so the
+     *       result must not be converted twice.
      */
-    Value toJSValue(Runtime& rt) const {
+    Value toJSValue(Runtime& rt) {
         return std::visit([&rt](auto&& arg) -> Value {
             using T = std::decay_t<decltype(arg)>;
             if constexpr (std::is_same_v<T, std::monostate>) {
@@ -97,12 +225,10 @@ struct AsyncResult {
             } else if constexpr (std::is_same_v<T, std::string>) {
                 return String::createFromUtf8(rt, arg);
             } else if constexpr (std::is_same_v<T, std::vector<uint8_t>>) {
-                // Create ArrayBuffer and copy data
-                auto arrayBufferCtor = rt.global().getPropertyAsFunction(rt, "ArrayBuffer");
-                auto arrayBufferObj = arrayBufferCtor.callAsConstructor(rt, static_cast<int>(arg.size())).asObject(rt);
-                auto arrayBuffer = arrayBufferObj.getArrayBuffer(rt);
-                memcpy(arrayBuffer.data(rt), arg.data(), arg.size());
-                return std::move(arrayBufferObj);
+                // Hand the worker's bytes to the ArrayBuffer (no copy)
+                return createArrayBuffer(rt, std::move(arg));
+            } else if constexpr (std::is_same_v<T, std::shared_ptr<MutableBuffer>>) {
+                return createArrayBuffer(rt, std::move(arg));
             } else if constexpr (std::is_same_v<T, std::vector<AsyncResult>>) {
                 Array arr(rt, arg.size());
                 for (size_t i = 0; i < arg.size(); ++i) {
@@ -111,7 +237,7 @@ struct AsyncResult {
                 return std::move(arr);
             } else if constexpr (std::is_same_v<T, std::unordered_map<std::string, AsyncResult>>) {
                 Object obj(rt);
-                for (const auto& [key, value] : arg) {
+                for (auto& [key, value] : arg) {
                     obj.setProperty(rt, key.c_str(), value.toJSValue(rt));
                 }
                 return std::move(obj);
@@ -143,6 +269,113 @@ public:
     virtual void invokeAsync(std::function<void(Runtime&)>&& func) = 0;
 };
 
+/**
+ * @brief Invoker that runs queued callbacks in as few JS-thread turns as possible
+ *
+ * Workers finishing at about the same time would otherwise each schedule
+ * their own JS-thread callback. Here callbacks are queued and a single
+ * scheduled turn drains everything pending, in FIFO order. A turn stops
+ * once the time budget is used up and leaves the rest to a new turn, so a
+ * burst of completions does not hold the JS thread for a whole frame.
+ *
+ * Host objects wrap their invoker in one of these in init(), which gives
+ * each host object its own completion queue. Queued callbacks keep the
+ * queue alive, so they still run if the host object goes away.
+ */
+class CoalescingInvoker : public JSCallInvokerWrapper,
+                          public std::enable_shared_from_this<CoalescingInvoker> {
+public:
+    explicit CoalescingInvoker(std::shared_ptr<JSCallInvokerWrapper> inner)
+        : inner_(std::move(inner)) {}
+
+    void invokeAsync(std::function<void(Runtime&)>&& func) override {
+        bool schedule = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.push_back(std::move(func));
+            schedule = !scheduled_;
+            scheduled_ = true;
+        }
+        if (schedule) {
+            scheduleDrain();
+        }
+    }
+
+    /**
+     * @brief Set the time one drain turn may take (0 = drain everything)
+     *
+     * Applies to all queues. At least one callback runs per turn.
+     */
+    static void setTurnBudget(std::chrono::microseconds budget) {
+        turnBudgetUs_.store(std::max<int64_t>(budget.count(), 0), std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static auto turnBudget() -> std::chrono::microseconds {
+        return std::chrono::microseconds(turnBudgetUs_.load(std::memory_order_relaxed));
+    }
+
+private:
+    using Callback = std::function<void(Runtime&)>;
+
+    std::shared_ptr<JSCallInvokerWrapper> inner_;
+    std::mutex mutex_;
+    std::deque<Callback> pending_;
+    bool scheduled_ = false;  // A drain turn is queued on the inner invoker
+
+    static inline std::atomic<int64_t> turnBudgetUs_{4000};
+
+    void scheduleDrain() {
+        inner_->invokeAsync([self = shared_from_this()](Runtime& rt) {
+            self->drain(rt);
+        });
+    }
+
+    void drain(Runtime& rt) {
+        std::deque<Callback> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            batch.swap(pending_);
+        }
+
+        auto budget = turnBudget();
+        auto start = std::chrono::steady_clock::now();
+        std::exception_ptr error;
+        while (!batch.empty()) {
+            auto callback = std::move(batch.front());
+            batch.pop_front();
+            // One failing callback must not strand the others
+            try {
+                callback(rt);
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+            if (budget.count() > 0 && std::chrono::steady_clock::now() - start >= budget) {
+                break;
+            }
+        }
+
+        bool reschedule = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Leftovers go before callbacks queued during this turn
+            while (!batch.empty()) {
+                pending_.push_front(std::move(batch.back()));
+                batch.pop_back();
+            }
+            reschedule = !pending_.empty();
+            scheduled_ = reschedule;
+        }
+        if (reschedule) {
+            scheduleDrain();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
 // ============================================================================
 // Task Executor Interface
 // ============================================================================
@@ -164,10 +397,37 @@ public:
  * };
  * ```
  */
+/**
+ * @brief Scheduling hints for one task
+ *
+ * What a lane is depends on the executor (-1 = its default lane). Within a
+ * lane, tasks with higher priority start first.
+ */
+struct TaskOptions {
+    int lane = -1;
+    int priority = 0;
+    std::string key;  // Concurrency group, e.g. a request's host ("" = none)
+};
+
 class TaskExecutor {
 public:
     virtual ~TaskExecutor() = default;
     virtual void execute(std::function<void()>&& task) = 0;
+
+    /// Execute with scheduling hints (executors without lanes ignore them)
+    virtual void execute(std::function<void()>&& task, const TaskOptions& options) {
+        (void)options;
+        execute(std::move(task));
+    }
+
+    /// Number of tasks that can run at the same time
+    virtual size_t concurrency() const { return 1; }
+
+    /// Number of tasks that can run at the same time on a lane
+    virtual size_t concurrency(int lane) const {
+        (void)lane;
+        return concurrency();
+    }
 };
 
 // ============================================================================
@@ -187,6 +447,434 @@ struct PromiseCallbacks {
         : resolve(rt, res), reject(rt, rej) {}
 };
 
+// ============================================================================
+// Cancellation Errors
+// ============================================================================
+
+inline constexpr const char* kCancelledMessage = "Operation cancelled";
+inline constexpr const char* kTimedOutMessage = "Operation timed out";
+
+/**
+ * @brief Create the Error a cancelled async call rejects with (JS thread only)
+ *
+ * name is "CancelledError" and code is "ECANCELED", or "ETIMEDOUT" when the
+ * call's deadline passed, so callers can tell cancellation from failures.
+ */
+inline auto makeCancelledError(Runtime& rt, bool timedOut) -> Value {
+    auto error = rt.global().getPropertyAsFunction(rt, "Error").callAsConstructor(
+        rt, String::createFromUtf8(rt, timedOut ? kTimedOutMessage : kCancelledMessage)
+    ).asObject(rt);
+    error.setProperty(rt, "name", String::createFromUtf8(rt, "CancelledError"));
+    error.setProperty(rt, "code", String::createFromUtf8(rt, timedOut ? "ETIMEDOUT" : "ECANCELED"));
+    return Value(std::move(error));
+}
+
+// ============================================================================
+// Callback Argument (JS Function Called From Workers)
+// ============================================================================
+
+/**
+ * @brief JS function argument of an async method, callable from worker threads
+ *
+ * post() converts its arguments on the JS thread and calls the function there,
+ * so workers can report progress without touching the Runtime. The function
+ * is pinned until the Promise settles. Errors thrown by the callback are
+ * ignored.
+ */
+class CallbackArg {
+private:
+    std::shared_ptr<Object> fn_;  // JS thread only
+    std::shared_ptr<JSCallInvokerWrapper> invoker_;
+
+public:
+    /**
+     * @brief Pin a function object (must be called on JS thread)
+     */
+    CallbackArg(Object&& fn, std::shared_ptr<JSCallInvokerWrapper> invoker)
+        : fn_(std::make_shared<Object>(std::move(fn)))
+        , invoker_(std::move(invoker)) {}
+
+    /** @brief Invoker that reaches the function's JS thread */
+    [[nodiscard]] auto invoker() const -> const std::shared_ptr<JSCallInvokerWrapper>& {
+        return invoker_;
+    }
+
+    /**
+     * @brief Call the function right away (JS thread only)
+     */
+    void call(Runtime& rt, std::vector<AsyncResult>& args) const {
+        std::vector<Value> values;
+        values.reserve(args.size());
+        for (auto& arg : args) {
+            values.push_back(arg.toJSValue(rt));
+        }
+        try {
+            fn_->asFunction(rt).call(rt, values.data(), values.size());
+        } catch (const std::exception&) {
+            // A failing callback must not take down the operation
+        }
+    }
+
+    /**
+     * @brief Schedule a call of the function on the JS thread
+     */
+    void post(std::vector<AsyncResult> args) const {
+        invoker_->invokeAsync([self = *this, args = std::move(args)](Runtime& rt) mutable {
+            self.call(rt, args);
+        });
+    }
+
+    /**
+     * @brief Schedule a call and run done on the JS thread once it has been handled
+     *
+     * If the function returns a thenable (e.g. it is async), done runs when
+     * that settles, so the caller can hold back further calls until JS has
+     * caught up. done(false) reports a throw or a rejection.
+     */
+    void post(std::vector<AsyncResult> args, std::function<void(bool ok)> done) const {
+        auto once = std::make_shared<std::function<void(bool)>>(std::move(done));
+        invoker_->invokeAsync([fn = fn_, args = std::move(args), once](Runtime& rt) mutable {
+            auto settle = [once](bool ok) {
+                if (auto callback = std::exchange(*once, nullptr)) {
+                    callback(ok);
+                }
+            };
+            auto settled = [settle](bool ok) {
+                return [settle, ok](Runtime&, const Value&, const Value*, size_t) -> Value {
+                    settle(ok);
+                    return Value::undefined();
+                };
+            };
+
+            std::vector<Value> values;
+            values.reserve(args.size());
+            for (auto& arg : args) {
+                values.push_back(arg.toJSValue(rt));
+            }
+            try {
+                auto returned = fn->asFunction(rt).call(rt, values.data(), values.size());
+                if (returned.isObject()) {
+                    auto thenable = returned.asObject(rt);
+                    auto then = thenable.getProperty(rt, "then");
+                    if (then.isObject() && then.asObject(rt).isFunction(rt)) {
+                        auto name = PropNameID::forAscii(rt, "onSettled");
+                        then.asObject(rt).asFunction(rt).callWithThis(
+                            rt, thenable,
+                            Function::createFromHostFunction(rt, name, 1, settled(true)),
+                            Function::createFromHostFunction(rt, name, 1, settled(false)));
+                        return;
+                    }
+                }
+            } catch (const std::exception&) {
+                // A failing callback must not take down the JS thread
+                settle(false);
+                return;
+            }
+            settle(true);
+        });
+    }
+};
+
+// ============================================================================
+// Cancellation Token
+// ============================================================================
+
+/**
+ * @brief Cancellation flag shared between JS and async workers
+ *
+ * Exposed to JS as a host object with cancel() and a `cancelled` property.
+ * Passing it to an async method makes the handler's cancellation checks
+ * observe it.
+ */
+class CancelToken : public HostObject, public std::enable_shared_from_this<CancelToken> {
+private:
+    std::atomic<bool> cancelled_{false};
+
+public:
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+    [[nodiscard]] auto isCancelled() const -> bool { return cancelled_.load(std::memory_order_relaxed); }
+
+    Value get(Runtime& rt, const PropNameID& name) override {
+        auto propName = name.utf8(rt);
+        if (propName == "cancel") {
+            return Function::createFromHostFunction(
+                rt, name, 0,
+                [self = shared_from_this()](Runtime&, const Value&, const Value*, size_t) -> Value {
+                    self->cancel();
+                    return Value::undefined();
+                }
+            );
+        }
+        if (propName == "cancelled") {
+            return Value(isCancelled());
+        }
+        return Value::undefined();
+    }
+
+    std::vector<PropNameID> getPropertyNames(Runtime& rt) override {
+        std::vector<PropNameID> names;
+        names.push_back(PropNameID::forUtf8(rt, "cancel"));
+        names.push_back(PropNameID::forUtf8(rt, "cancelled"));
+        return names;
+    }
+};
+
+// ============================================================================
+// Async Context
+// ============================================================================
+
+/**
+ * @brief Non-data arguments of an async call: callbacks, cancel token and
+ *        call options
+ *
+ * Long-running handlers poll isCancelled() between steps; the base class
+ * also checks it before a queued handler starts and when one fails.
+ */
+struct AsyncContext {
+    using Clock = std::chrono::steady_clock;
+    static constexpr Clock::time_point kNoDeadline = Clock::time_point::max();
+
+    std::vector<CallbackArg> callbacks;     // Function arguments (in order)
+    std::shared_ptr<CancelToken> cancelToken;
+    int priority = 0;                       // From a {priority} options object
+    Clock::time_point deadline = kNoDeadline;  // From a {timeout} options object
+
+    /** @brief true once the token was cancelled or the deadline has passed */
+    [[nodiscard]] auto isCancelled() const -> bool {
+        return (cancelToken && cancelToken->isCancelled()) || isExpired();
+    }
+
+    [[nodiscard]] auto isExpired() const -> bool {
+        return deadline != kNoDeadline && Clock::now() >= deadline;
+    }
+
+    /** @brief true if cancellation is due to the deadline rather than the token */
+    [[nodiscard]] auto isTimedOut() const -> bool {
+        return isExpired() && !(cancelToken && cancelToken->isCancelled());
+    }
+
+    /** @brief Callback at idx, or nullptr if not passed */
+    [[nodiscard]] auto callback(size_t idx) const -> const CallbackArg* {
+        return idx < callbacks.size() ? &callbacks[idx] : nullptr;
+    }
+};
+
+// ============================================================================
+// Typed Async Arguments
+// ============================================================================
+
+/**
+ * @brief Decoder of one positional argument of a typed async method (JS thread)
+ *
+ * Each specialization provides:
+ *   - matches(rt, value): whether the value has this type (used by variants)
+ *   - decode(rt, value, index): the C++ value; throws std::runtime_error
+ *     naming the argument when the JS value has another type
+ *
+ * Supported: std::string, bool, arithmetic types, BufferArg,
+ * std::vector<T>, std::optional<T> and std::variant<T...> (std::monostate
+ * matches undefined/null).
+ */
+template <typename T>
+struct ArgDecoder;
+
+[[noreturn]] inline void throwArgTypeError(size_t index, const char* expected) {
+    throw std::runtime_error("Argument " + std::to_string(index) + ": expected " + expected);
+}
+
+template <>
+struct ArgDecoder<std::string> {
+    static auto matches(Runtime&, const Value& value) -> bool { return value.isString(); }
+    static auto decode(Runtime& rt, const Value& value, size_t index) -> std::string {
+        if (!value.isString()) {
+            throwArgTypeError(index, "string");
+        }
+        return value.asString(rt).utf8(rt);
+    }
+};
+
+template <>
+struct ArgDecoder<bool> {
+    static auto matches(Runtime&, const Value& value) -> bool { return value.isBool(); }
+    static auto decode(Runtime&, const Value& value, size_t index) -> bool {
+        if (!value.isBool()) {
+            throwArgTypeError(index, "boolean");
+        }
+        return value.getBool();
+    }
+};
+
+template <typename T>
+    requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+struct ArgDecoder<T> {
+    static auto matches(Runtime&, const Value& value) -> bool { return value.isNumber(); }
+    static auto decode(Runtime&, const Value& value, size_t index) -> T {
+        if (!value.isNumber()) {
+            throwArgTypeError(index, "number");
+        }
+        auto number = value.getNumber();
+        if constexpr (std::is_integral_v<T>) {
+            // Casting NaN, Infinity or a value outside T is undefined behavior
+            constexpr auto lower = static_cast<double>(std::numeric_limits<T>::min());
+            const auto upper = std::ldexp(1.0, std::numeric_limits<T>::digits);  // max + 1, exact
+            if (!std::isfinite(number) || number < lower || number >= upper) {
+                throw std::runtime_error("Argument " + std::to_string(index) + ": number out of range");
+            }
+        }
+        return static_cast<T>(number);
+    }
+};
+
+template <>
+struct ArgDecoder<BufferArg> {
+    static auto matches(Runtime& rt, const Value& value) -> bool {
+        return value.isObject() && value.getObject(rt).isArrayBuffer(rt);
+    }
+    static auto decode(Runtime& rt, const Value& value, size_t index) -> BufferArg {
+        if (!matches(rt, value)) {
+            throwArgTypeError(index, "ArrayBuffer");
+        }
+        return BufferArg(rt, value.getObject(rt));
+    }
+};
+
+template <typename T>
+struct ArgDecoder<std::vector<T>> {
+    static auto matches(Runtime& rt, const Value& value) -> bool {
+        return value.isObject() && value.getObject(rt).isArray(rt);
+    }
+    static auto decode(Runtime& rt, const Value& value, size_t index) -> std::vector<T> {
+        if (!matches(rt, value)) {
+            throwArgTypeError(index, "array");
+        }
+        auto arr = value.getObject(rt).getArray(rt);
+        auto len = arr.size(rt);
+        std::vector<T> result;
+        result.reserve(len);
+        for (size_t i = 0; i < len; ++i) {
+            result.push_back(ArgDecoder<T>::decode(rt, arr.getValueAtIndex(rt, i), index));
+        }
+        return result;
+    }
+};
+
+template <>
+struct ArgDecoder<std::monostate> {
+    static auto matches(Runtime&, const Value& value) -> bool {
+        return value.isUndefined() || value.isNull();
+    }
+    static auto decode(Runtime& rt, const Value& value, size_t index) -> std::monostate {
+        if (!matches(rt, value)) {
+            throwArgTypeError(index, "undefined");
+        }
+        return {};
+    }
+};
+
+template <typename T>
+struct ArgDecoder<std::optional<T>> {
+    static auto matches(Runtime& rt, const Value& value) -> bool {
+        return value.isUndefined() || value.isNull() || ArgDecoder<T>::matches(rt, value);
+    }
+    static auto decode(Runtime& rt, const Value& value, size_t index) -> std::optional<T> {
+        if (value.isUndefined() || value.isNull()) {
+            return std::nullopt;
+        }
+        return ArgDecoder<T>::decode(rt, value, index);
+    }
+};
+
+template <typename... Ts>
+struct ArgDecoder<std::variant<Ts...>> {
+    static auto matches(Runtime& rt, const Value& value) -> bool {
+        return (ArgDecoder<Ts>::matches(rt, value) || ...);
+    }
+    static auto decode(Runtime& rt, const Value& value, size_t index) -> std::variant<Ts...> {
+        std::optional<std::variant<Ts...>> result;
+        // First alternative whose type matches wins
+        ((!result && ArgDecoder<Ts>::matches(rt, value)
+            ? (result.emplace(ArgDecoder<Ts>::decode(rt, value, index)), true)
+            : false) || ...);
+        if (!result) {
+            throwArgTypeError(index, "a value of another type");
+        }
+        return std::move(*result);
+    }
+};
+
+/**
+ * @brief Arguments of one async call bound to its handler
+ *
+ * Prepared on the JS thread, run once on a worker and released on the JS
+ * thread again (it can hold pinned buffers and callbacks).
+ */
+struct PreparedCall {
+    AsyncContext context;
+    // The host object whose handler runs: handlers use its members from the
+    // worker, so it is kept alive until the call settles on the JS thread
+    std::shared_ptr<const void> owner;
+
+    virtual ~PreparedCall() = default;
+
+    /** @brief Run the handler (worker thread) */
+    virtual auto run() -> AsyncResult = 0;
+
+    /** @brief Bytes of string and buffer arguments (for MethodStats) */
+    [[nodiscard]] virtual auto inputBytes() const -> uint64_t { return 0; }
+};
+
+template <typename T>
+inline constexpr bool kIsVariant = false;
+
+template <typename... Ts>
+inline constexpr bool kIsVariant<std::variant<Ts...>> = true;
+
+/** @brief Bytes of string and buffer data in an argument (for MethodStats) */
+template <typename T>
+auto argBytes(const T& value) -> uint64_t {
+    if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, BufferArg>) {
+        return value.size();
+    } else if constexpr (requires { value.has_value(); *value; }) {
+        return value ? argBytes(*value) : 0;
+    } else if constexpr (kIsVariant<T>) {
+        return std::visit([](const auto& v) { return argBytes(v); }, value);
+    } else if constexpr (requires { value.begin(); value.end(); }) {
+        uint64_t bytes = 0;
+        for (const auto& element : value) {
+            bytes += argBytes(element);
+        }
+        return bytes;
+    } else {
+        return 0;
+    }
+}
+
+/** @brief Bytes of string and buffer data in a result (for MethodStats) */
+inline auto resultBytes(const AsyncResult& result) -> uint64_t {
+    return std::visit([](const auto& v) -> uint64_t {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<uint8_t>>) {
+            return v.size();
+        } else if constexpr (std::is_same_v<T, std::shared_ptr<MutableBuffer>>) {
+            return v ? v->size() : 0;
+        } else if constexpr (std::is_same_v<T, std::vector<AsyncResult>>) {
+            uint64_t bytes = 0;
+            for (const auto& element : v) {
+                bytes += resultBytes(element);
+            }
+            return bytes;
+        } else if constexpr (std::is_same_v<T, std::unordered_map<std::string, AsyncResult>>) {
+            uint64_t bytes = 0;
+            for (const auto& [key, element] : v) {
+                bytes += resultBytes(element);
+            }
+            return bytes;
+        } else {
+            return 0;
+        }
+    }, result.data);
+}
+
 // ============================================================================
 // Concept: JSIHostObjectDerived
 // ============================================================================
@@ -200,6 +888,9 @@ struct PromiseCallbacks {
  * Derived classes MAY implement:
  *   - initProperties(): Register properties
  *   - getTaskExecutor(): Return executor for async methods (required if using async)
+ *   - taskKey(rt, method, args, count): Concurrency key of an async call,
+ *     passed to the executor in TaskOptions::key
+ *   - kStatsScope: static string prefixed to method names in MethodStats
  */
 template <typename T>
 concept JSIHostObjectDerived = requires(T t) {
@@ -219,10 +910,15 @@ concept JSIHostObjectDerived = requires(T t) {
  * Derived class MAY implement:
  *   - initProperties() -> register properties
  *   - getTaskExecutor() -> return TaskExecutor* for async methods
+ *   - taskKey(rt, method, args, count) -> std::string concurrency key of an async call
+ *   - static constexpr const char* kStatsScope -> prefix of method names in MethodStats
  *
  * @tparam Derived The derived class type
  *
  * @note The concept check is deferred to init() call time to work with CRTP
+ * @note Create instances with std::make_shared: each async call then holds
+ *       a reference to the object until its Promise settles, so members
+ *       used by handlers outlive a host object that JS has already released
  *
  * @example
  * ```cpp
@@ -243,7 +939,7 @@ concept JSIHostObjectDerived = requires(T t) {
  * ```
  */
 template <typename Derived>
-class JSIHostObjectBase : public HostObject {
+class JSIHostObjectBase : public HostObject, public std::enable_shared_from_this<JSIHostObjectBase<Derived>> {
 public:
     // ========================================================================
     // Handler Types
@@ -259,7 +955,8 @@ public:
      *   - strings: All string arguments (in order)
      *   - numbers: All number arguments (in order)
      *   - bools: All boolean arguments (in order)
-     *   - buffers: All ArrayBuffer arguments (as byte vectors)
+     *   - buffers: All ArrayBuffer arguments (as pinned zero-copy views)
+     *   - context: Function arguments and the cancellation token, if any
      *
      * Returns: AsyncResult containing pure C++ data (converted to JS on JS thread)
      * Throws: std::exception on error (will be converted to Promise rejection)
@@ -268,7 +965,8 @@ public:
         const std::vector<std::string>& strings,
         const std::vector<double>& numbers,
         const std::vector<bool>& bools,
-        const std::vector<std::vector<uint8_t>>& buffers
+        const std::vector<BufferArg>& buffers,
+        const AsyncContext& context
     )>;
 
     using PropertyGetter = std::function<Value(Runtime&)>;
@@ -283,9 +981,15 @@ public:
         SyncHandler handler;
     };
 
+    /** @brief Decodes JS arguments into a call ready to run (JS thread) */
+    using PrepareFn = std::function<std::shared_ptr<PreparedCall>(
+        Runtime&, const Value*, size_t, const std::shared_ptr<JSCallInvokerWrapper>&
+    )>;
+
     struct AsyncMethod {
         size_t paramCount;
-        AsyncHandler handler;
+        PrepareFn prepare;
+        int lane = -1;  // Executor lane (-1 = default)
     };
 
     struct Property {
@@ -299,6 +1003,7 @@ protected:
     std::unordered_map<std::string, Property> properties_;
     std::shared_ptr<JSCallInvokerWrapper> callInvoker_;
     bool hasAsyncMethods_ = false;
+    std::string batchMethodName_;  // Empty = no batch method
 
     // Cached JS objects (created lazily, invalidated on runtime change)
     mutable std::unordered_map<std::string, std::shared_ptr<Object>> cachedFunctions_;
@@ -337,6 +1042,10 @@ protected:
                 );
             }
 
+            // Completions of this object's async calls share one queue and are
+            // delivered to JS in batched turns
+            callInvoker_ = std::make_shared<CoalescingInvoker>(std::move(callInvoker_));
+
             // Check getTaskExecutor exists and returns non-null
             if constexpr (requires { derived->getTaskExecutor(); }) {
                 if (!derived->getTaskExecutor()) {
@@ -362,7 +1071,58 @@ protected:
 
     void registerAsync(const std::string& name, size_t paramCount, AsyncHandler handler) {
         hasAsyncMethods_ = true;
-        asyncMethods_[name] = {paramCount, std::move(handler)};
+        auto shared = std::make_shared<const AsyncHandler>(std::move(handler));
+        asyncMethods_[name] = {paramCount, [shared = std::move(shared)](
+            Runtime& rt, const Value* args, size_t count,
+            const std::shared_ptr<JSCallInvokerWrapper>& invoker
+        ) -> std::shared_ptr<PreparedCall> {
+            auto call = std::make_shared<UntypedCall>(shared);
+            std::tie(call->strings, call->numbers, call->bools, call->buffers, call->context) =
+                extractArgs(rt, args, count, invoker);
+            return call;
+        }};
+    }
+
+    /**
+     * @brief Register an async method with a typed signature
+     *
+     * fn is called as fn(context, args...) on a worker. Its parameters after
+     * the AsyncContext give the JS signature: argument i is decoded straight
+     * into parameter i (see ArgDecoder), and arguments after those are read
+     * as callbacks, CancelToken or options like in untyped methods. A wrong
+     * argument type throws on the JS thread instead of queueing the call.
+     */
+    template <typename Fn>
+    void registerAsyncTyped(const std::string& name, Fn&& fn) {
+        registerAsyncTypedImpl(name, std::forward<Fn>(fn), &std::decay_t<Fn>::operator());
+    }
+
+    /**
+     * @brief Run a registered async method on a specific executor lane
+     * @throws std::runtime_error if no async method has this name
+     */
+    void setAsyncLane(const std::string& name, int lane) {
+        auto it = asyncMethods_.find(name);
+        if (it == asyncMethods_.end()) {
+            throw std::runtime_error("JSIHostObjectBase: unknown async method " + name);
+        }
+        it->second.lane = lane;
+    }
+
+    /**
+     * @brief Register a method that runs several async methods in one call
+     *
+     * JS: name([{op, args?, group?}, ...], ordered?) -> Promise<results>
+     *
+     * Each op names a registered async method and args are its arguments.
+     * Ops with the same group run one after another in array order; other
+     * ops run in parallel on the executor. ordered=true runs all ops in
+     * order. The Promise resolves once, with {ok: true, value} or
+     * {ok: false, error} per op, in the order of the ops.
+     */
+    void registerBatch(const std::string& name) {
+        hasAsyncMethods_ = true;
+        batchMethodName_ = name;
     }
 
     /** @brief Register a read-only property */
@@ -379,24 +1139,143 @@ protected:
     // Helper: Extract Arguments by Type
     // ========================================================================
 
+    /** @brief Call of an untyped method: arguments sorted by type */
+    struct UntypedCall final : PreparedCall {
+        std::shared_ptr<const AsyncHandler> handler;
+        std::vector<std::string> strings;
+        std::vector<double> numbers;
+        std::vector<bool> bools;
+        std::vector<BufferArg> buffers;
+
+        explicit UntypedCall(std::shared_ptr<const AsyncHandler> h) : handler(std::move(h)) {}
+
+        auto run() -> AsyncResult override {
+            return (*handler)(strings, numbers, bools, buffers, context);
+        }
+
+        [[nodiscard]] auto inputBytes() const -> uint64_t override {
+            return argBytes(strings) + argBytes(buffers);
+        }
+    };
+
+    /** @brief Call of a typed method: arguments decoded into a fixed tuple */
+    template <typename Fn, typename... Args>
+    struct TypedCall final : PreparedCall {
+        std::shared_ptr<const Fn> fn;
+        std::tuple<Args...> args;
+
+        TypedCall(std::shared_ptr<const Fn> f, std::tuple<Args...>&& a)
+            : fn(std::move(f)), args(std::move(a)) {}
+
+        auto run() -> AsyncResult override {
+            return std::apply([this](const Args&... a) { return (*fn)(context, a...); }, args);
+        }
+
+        [[nodiscard]] auto inputBytes() const -> uint64_t override {
+            return std::apply([](const Args&... a) { return (uint64_t{0} + ... + argBytes(a)); }, args);
+        }
+    };
+
+    template <typename Fn, typename C, typename... A>
+    void registerAsyncTypedImpl(
+        const std::string& name, Fn&& fn,
+        AsyncResult (C::*)(const AsyncContext&, A...) const
+    ) {
+        using Call = TypedCall<std::decay_t<Fn>, std::decay_t<A>...>;
+        hasAsyncMethods_ = true;
+        auto shared = std::make_shared<const std::decay_t<Fn>>(std::forward<Fn>(fn));
+        asyncMethods_[name] = {sizeof...(A), [shared = std::move(shared)](
+            Runtime& rt, const Value* args, size_t count,
+            const std::shared_ptr<JSCallInvokerWrapper>& invoker
+        ) -> std::shared_ptr<PreparedCall> {
+            auto call = std::make_shared<Call>(shared,
+                decodeTypedArgs<std::decay_t<A>...>(rt, args, count, std::index_sequence_for<A...>{}));
+            for (size_t i = sizeof...(A); i < count; ++i) {
+                if (args[i].isObject()) {
+                    extractContextArg(rt, args[i].getObject(rt), call->context, invoker);
+                }
+            }
+            return call;
+        }};
+    }
+
+    template <typename... Args, size_t... I>
+    static auto decodeTypedArgs(Runtime& rt, const Value* args, size_t count, std::index_sequence<I...>)
+        -> std::tuple<Args...>
+    {
+        static const Value undefined = Value::undefined();
+        // Braced init decodes left to right
+        return std::tuple<Args...>{ArgDecoder<Args>::decode(rt, I < count ? args[I] : undefined, I)...};
+    }
+
+    /**
+     * @brief Read a non-data object argument into the context (JS thread)
+     *
+     * Functions become callbacks, a CancelToken becomes the call's token and
+     * a plain object is read as {priority, timeout} options.
+     * @return false if the object is none of these
+     */
+    static auto extractContextArg(
+        Runtime& rt, Object&& obj, AsyncContext& context,
+        const std::shared_ptr<JSCallInvokerWrapper>& invoker
+    ) -> bool {
+        if (obj.isFunction(rt)) {
+            context.callbacks.emplace_back(std::move(obj), invoker);
+        } else if (obj.isHostObject<CancelToken>(rt)) {
+            context.cancelToken = obj.getHostObject<CancelToken>(rt);
+        } else if (!obj.isArrayBuffer(rt) && !obj.isArray(rt) && !obj.isHostObject(rt)) {
+            auto priority = obj.getProperty(rt, "priority");
+            if (priority.isNumber()) {
+                auto value = priority.asNumber();
+                if (!std::isfinite(value)) {
+                    throw std::runtime_error("Option 'priority' must be a finite number");
+                }
+                context.priority = static_cast<int>(std::clamp(value, -128.0, 127.0));
+            }
+            auto timeout = obj.getProperty(rt, "timeout");
+            if (timeout.isNumber() && timeout.asNumber() >= 0) {
+                auto ms = timeout.asNumber();  // NaN fails the check above
+                auto now = AsyncContext::Clock::now();
+                // Saturate: a timeout past the clock's range (or Infinity) means none
+                auto headroom = std::chrono::duration_cast<std::chrono::milliseconds>(AsyncContext::kNoDeadline - now);
+                if (ms < static_cast<double>(headroom.count())) {
+                    context.deadline = now + std::chrono::milliseconds(static_cast<int64_t>(ms));
+                }
+            } else if (timeout.isNumber()) {
+                throw std::runtime_error("Option 'timeout' must be a non-negative number");
+            }
+        } else {
+            return false;
+        }
+        return true;
+    }
+
     /**
      * @brief Extract arguments from JS values into typed vectors
      *
      * Groups arguments by type for easy access in async handlers.
-     * Arrays of strings are flattened into the strings vector.
+     * Arrays of strings/numbers are flattened into the strings/numbers vectors.
+     * ArrayBuffers are pinned rather than copied (see BufferArg).
+     * Functions, a CancelToken and a plain options object
+     * ({priority, timeout}) go into the AsyncContext.
      */
-    static auto extractArgs(Runtime& rt, const Value* args, size_t count)
+    static auto extractArgs(
+        Runtime& rt, const Value* args, size_t count,
+        const std::shared_ptr<JSCallInvokerWrapper>& invoker
+    )
         -> std::tuple<
             std::vector<std::string>,
             std::vector<double>,
             std::vector<bool>,
-            std::vector<std::vector<uint8_t>>
+            std::vector<BufferArg>,
+            AsyncContext
         >
     {
         std::vector<std::string> strings;
         std::vector<double> numbers;
         std::vector<bool> bools;
-        std::vector<std::vector<uint8_t>> buffers;
+        std::vector<BufferArg> buffers;
+        AsyncContext context;
 
         for (size_t i = 0; i < count; ++i) {
             if (args[i].isString()) {
@@ -408,25 +1287,321 @@ protected:
             } else if (args[i].isObject()) {
                 auto obj = args[i].asObject(rt);
                 if (obj.isArrayBuffer(rt)) {
-                    auto ab = obj.getArrayBuffer(rt);
-                    auto* data = ab.data(rt);
-                    auto size = ab.size(rt);
-                    buffers.emplace_back(data, data + size);
+                    buffers.emplace_back(rt, std::move(obj));
                 } else if (obj.isArray(rt)) {
-                    // Flatten string arrays into strings vector
+                    // Flatten string/number arrays into strings/numbers vectors
                     auto arr = obj.asArray(rt);
                     auto len = arr.size(rt);
                     for (size_t j = 0; j < len; ++j) {
                         auto elem = arr.getValueAtIndex(rt, j);
                         if (elem.isString()) {
                             strings.push_back(elem.asString(rt).utf8(rt));
+                        } else if (elem.isNumber()) {
+                            numbers.push_back(elem.asNumber());
                         }
                     }
+                } else {
+                    // Functions, CancelToken and per-call options
+                    extractContextArg(rt, std::move(obj), context, invoker);
                 }
             }
         }
 
-        return {std::move(strings), std::move(numbers), std::move(bools), std::move(buffers)};
+        return {std::move(strings), std::move(numbers), std::move(bools), std::move(buffers), std::move(context)};
+    }
+
+    /**
+     * @brief Run a prepared call and settle its Promise (worker thread)
+     *
+     * The call, with its pinned buffers and callbacks, is moved to the JS
+     * thread and released there.
+     */
+    static void runPreparedCall(
+        std::shared_ptr<PreparedCall> call,
+        const std::shared_ptr<JSCallInvokerWrapper>& invoker,
+        std::shared_ptr<PromiseCallbacks> callbacks,
+        CallTiming timing
+    ) {
+        timing.start();
+        // Drop work that was cancelled or timed out while queued
+        bool cancelled = call->context.isCancelled();
+        bool failed = false;
+        AsyncResult result;
+        std::string errorMsg;
+        if (!cancelled) {
+            try {
+                // Pure C++ computation, no Runtime
+                result = call->run();
+            } catch (const std::exception& e) {
+                // Errors caused by cancellation reject with the cancellation error
+                cancelled = call->context.isCancelled();
+                failed = true;
+                errorMsg = e.what();
+            }
+        }
+        timing.finish(failed, cancelled, timing.stats && !failed && !cancelled ? resultBytes(result) : 0);
+
+        if (cancelled) {
+            bool timedOut = call->context.isTimedOut();
+            invoker->invokeAsync([callbacks = std::move(callbacks), timedOut,
+                                  call = std::move(call), timing = std::move(timing)](Runtime& rt) mutable {
+                callbacks->reject.asObject(rt).asFunction(rt).call(rt, makeCancelledError(rt, timedOut));
+                timing.settle();
+            });
+        } else if (failed) {
+            invoker->invokeAsync([callbacks = std::move(callbacks), errorMsg = std::move(errorMsg),
+                                  call = std::move(call), timing = std::move(timing)](Runtime& rt) mutable {
+                callbacks->reject.asObject(rt).asFunction(rt).call(
+                    rt, String::createFromUtf8(rt, errorMsg)
+                );
+                timing.settle();
+            });
+        } else {
+            // Create JS values and resolve on the JS thread
+            invoker->invokeAsync([callbacks = std::move(callbacks), result = std::move(result),
+                                  call = std::move(call), timing = std::move(timing)](Runtime& rt) mutable {
+                Value jsValue = result.toJSValue(rt);
+                callbacks->resolve.asObject(rt).asFunction(rt).call(rt, std::move(jsValue));
+                timing.settle();
+            });
+        }
+    }
+
+    /** @brief Name of a method in MethodStats: "<kStatsScope>.<method>" */
+    static auto statsName(const std::string& method) -> std::shared_ptr<const std::string> {
+        if constexpr (requires { Derived::kStatsScope; }) {
+            return std::make_shared<const std::string>(std::string(Derived::kStatsScope) + "." + method);
+        } else {
+            return std::make_shared<const std::string>(method);
+        }
+    }
+
+    // ========================================================================
+    // Helper: Batch Execution
+    // ========================================================================
+
+    /** @brief One parsed op of a batch call */
+    struct BatchOp {
+        std::shared_ptr<PreparedCall> call;  // nullptr = invalid op, see error
+        int lane = -1;
+        std::string error;
+        CallTiming timing;
+
+        [[nodiscard]] auto priority() const -> int { return call ? call->context.priority : 0; }
+    };
+
+    /** @brief State shared by the worker tasks of one batch call */
+    struct BatchState {
+        std::vector<BatchOp> ops;
+        std::vector<AsyncResult> results;
+        std::atomic<size_t> pendingGroups{0};
+        std::shared_ptr<PromiseCallbacks> callbacks;
+    };
+
+    /**
+     * @brief Parse batch ops on the JS thread
+     * @return Ops and the groups of op indices that must run in order
+     */
+    auto parseBatch(Runtime& rt, const Value* args, size_t count)
+        -> std::pair<std::vector<BatchOp>, std::vector<std::vector<size_t>>>
+    {
+        if (count < 1 || !args[0].isObject() || !args[0].asObject(rt).isArray(rt)) {
+            throw std::runtime_error(batchMethodName_ + ": expected an array of operations");
+        }
+        bool ordered = count > 1 && args[1].isBool() && args[1].asBool();
+
+        auto list = args[0].asObject(rt).asArray(rt);
+        auto len = list.size(rt);
+
+        std::vector<BatchOp> ops(len);
+        std::vector<std::vector<size_t>> groups;
+        std::unordered_map<std::string, size_t> groupIndex;
+
+        for (size_t i = 0; i < len; ++i) {
+            auto& op = ops[i];
+            auto item = list.getValueAtIndex(rt, i);
+            std::string group;
+
+            if (!item.isObject()) {
+                op.error = "Invalid batch operation at index " + std::to_string(i);
+            } else {
+                auto obj = item.asObject(rt);
+                auto name = obj.getProperty(rt, "op");
+                auto it = name.isString()
+                    ? asyncMethods_.find(name.asString(rt).utf8(rt))
+                    : asyncMethods_.end();
+                if (it == asyncMethods_.end()) {
+                    op.error = "Unknown batch operation: "
+                        + (name.isString() ? name.asString(rt).utf8(rt) : std::string("(none)"));
+                } else {
+                    std::vector<Value> values;
+                    auto opArgs = obj.getProperty(rt, "args");
+                    if (opArgs.isObject() && opArgs.asObject(rt).isArray(rt)) {
+                        auto arr = opArgs.asObject(rt).asArray(rt);
+                        auto argCount = arr.size(rt);
+                        values.reserve(argCount);
+                        for (size_t j = 0; j < argCount; ++j) {
+                            values.push_back(arr.getValueAtIndex(rt, j));
+                        }
+                    }
+                    try {
+                        op.call = it->second.prepare(rt, values.data(), values.size(), callInvoker_);
+                        op.call->owner = this->weak_from_this().lock();
+                        op.lane = it->second.lane;
+                        if (MethodStatsRegistry::instance().enabled()) {
+                            op.timing = CallTiming::begin(statsName(it->first), op.call->inputBytes());
+                        }
+                    } catch (const std::exception& e) {
+                        op.error = e.what();
+                    }
+                }
+
+                auto groupValue = obj.getProperty(rt, "group");
+                if (groupValue.isString()) {
+                    group = groupValue.asString(rt).utf8(rt);
+                }
+            }
+
+            if (ordered) {
+                group.clear();
+                if (groups.empty()) {
+                    groups.emplace_back();
+                }
+                groups.front().push_back(i);
+            } else if (group.empty()) {
+                groups.push_back({i});
+            } else {
+                auto [it, inserted] = groupIndex.try_emplace(group, groups.size());
+                if (inserted) {
+                    groups.emplace_back();
+                }
+                groups[it->second].push_back(i);
+            }
+        }
+
+        return {std::move(ops), std::move(groups)};
+    }
+
+    /**
+     * @brief Run one group of batch ops in order (worker thread)
+     *
+     * The last group to finish resolves the Promise. Pinned buffers,
+     * callbacks and the Promise functions are moved to the JS thread and
+     * released there.
+     */
+    static void runBatchGroup(
+        const std::shared_ptr<BatchState>& state,
+        const std::vector<size_t>& group,
+        const std::shared_ptr<JSCallInvokerWrapper>& invoker
+    ) {
+        for (size_t idx : group) {
+            auto& op = state->ops[idx];
+            std::unordered_map<std::string, AsyncResult> entry;
+            op.timing.start();
+            try {
+                if (!op.call) {
+                    throw std::runtime_error(op.error);
+                }
+                if (!op.call->context.isCancelled()) {
+                    entry["value"] = op.call->run();
+                    entry["ok"] = true;
+                }
+            } catch (const std::exception& e) {
+                entry["ok"] = false;
+                entry["error"] = std::string(e.what());
+            }
+            bool cancelled = false;
+            if (op.call && op.call->context.isCancelled() && !entry.contains("value")) {
+                bool timedOut = op.call->context.isTimedOut();
+                cancelled = true;
+                entry["ok"] = false;
+                entry["error"] = std::string(timedOut ? kTimedOutMessage : kCancelledMessage);
+                entry["code"] = std::string(timedOut ? "ETIMEDOUT" : "ECANCELED");
+            }
+            bool succeeded = entry.contains("value");
+            op.timing.finish(!succeeded, cancelled,
+                             op.timing.stats && succeeded ? resultBytes(entry["value"]) : 0);
+            state->results[idx] = std::move(entry);
+        }
+
+        if (state->pendingGroups.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            invoker->invokeAsync([state](Runtime& rt) {
+                auto ops = std::move(state->ops);
+                auto callbacks = std::move(state->callbacks);
+                Value jsValue = AsyncResult(std::move(state->results)).toJSValue(rt);
+                callbacks->resolve.asObject(rt).asFunction(rt).call(rt, std::move(jsValue));
+                for (auto& op : ops) {
+                    op.timing.settle();
+                }
+            });
+        }
+    }
+
+    /** @brief Create the JS function of the batch method */
+    auto createBatchFunction(Runtime& rt, const std::string& propName) -> Function {
+        TaskExecutor* executor = nullptr;
+        if constexpr (requires(Derived& d) { d.getTaskExecutor(); }) {
+            executor = static_cast<Derived*>(this)->getTaskExecutor();
+        }
+
+        return Function::createFromHostFunction(
+            rt,
+            PropNameID::forUtf8(rt, propName),
+            2,
+            [invoker = callInvoker_, executor, this](
+                Runtime& runtime, const Value&, const Value* args, size_t count
+            ) -> Value {
+                std::vector<BatchOp> ops;
+                std::vector<std::vector<size_t>> groups;
+                try {
+                    std::tie(ops, groups) = parseBatch(runtime, args, count);
+                } catch (const std::exception& e) {
+                    throw JSError(runtime, e.what());
+                }
+
+                if (!cachedPromiseCtor_) {
+                    cachedPromiseCtor_ = std::make_shared<Object>(
+                        runtime.global().getPropertyAsFunction(runtime, "Promise")
+                    );
+                }
+
+                auto state = std::make_shared<BatchState>();
+                state->results.resize(ops.size());
+                state->ops = std::move(ops);
+                state->pendingGroups.store(groups.size(), std::memory_order_relaxed);
+
+                auto promiseExecutor = Function::createFromHostFunction(
+                    runtime,
+                    PropNameID::forUtf8(runtime, "executor"),
+                    2,
+                    [invoker, executor, state, groups = std::move(groups)](
+                        Runtime& rt, const Value&, const Value* promiseArgs, size_t
+                    ) mutable -> Value {
+                        if (groups.empty()) {
+                            promiseArgs[0].asObject(rt).asFunction(rt).call(rt, Value(Array(rt, 0)));
+                            return Value::undefined();
+                        }
+
+                        state->callbacks = std::make_shared<PromiseCallbacks>(rt, promiseArgs[0], promiseArgs[1]);
+                        for (auto& group : groups) {
+                            // A group runs on the lane of its first op, at its highest priority
+                            TaskOptions options;
+                            options.lane = state->ops[group.front()].lane;
+                            options.priority = state->ops[group.front()].priority();
+                            for (size_t idx : group) {
+                                options.priority = std::max(options.priority, state->ops[idx].priority());
+                            }
+                            executor->execute([state, invoker, group = std::move(group)]() {
+                                runBatchGroup(state, group, invoker);
+                            }, options);
+                        }
+                        return Value::undefined();
+                    }
+                );
+
+                return cachedPromiseCtor_->asFunction(runtime).callAsConstructor(runtime, promiseExecutor);
+            }
+        );
     }
 
 public:
@@ -459,10 +1634,19 @@ public:
                 rt,
                 PropNameID::forUtf8(rt, propName),
                 method.paramCount,
-                [handler = method.handler](Runtime& runtime, const Value&, const Value* args, size_t count) -> Value {
+                [handler = method.handler, name = statsName(propName)](
+                    Runtime& runtime, const Value&, const Value* args, size_t count
+                ) -> Value {
+                    auto timing = CallTiming::begin(name, 0);
+                    timing.start();
                     try {
-                        return handler(runtime, args, count);
+                        auto result = handler(runtime, args, count);
+                        timing.finish(false, false, 0);
+                        timing.settle();
+                        return result;
                     } catch (const std::exception& e) {
+                        timing.finish(true, false, 0);
+                        timing.settle();
                         throw JSError(runtime, e.what());
                     }
                 }
@@ -488,11 +1672,25 @@ public:
                 rt,
                 PropNameID::forUtf8(rt, propName),
                 method.paramCount,
-                [handler = method.handler, invoker, executor, this](
+                [prepare = method.prepare, lane = method.lane, invoker, executor, this, propName,
+                 name = statsName(propName)](
                     Runtime& runtime, const Value&, const Value* args, size_t count
                 ) -> Value {
-                    // Extract args on JS thread (safe)
-                    auto [strings, numbers, bools, buffers] = extractArgs(runtime, args, count);
+                    // Decode args on JS thread (safe)
+                    std::shared_ptr<PreparedCall> call;
+                    std::string key;
+                    try {
+                        call = prepare(runtime, args, count, invoker);
+                        call->owner = this->weak_from_this().lock();
+                        if constexpr (requires(Derived& d) { d.taskKey(runtime, propName, args, count); }) {
+                            key = static_cast<Derived*>(this)->taskKey(runtime, propName, args, count);
+                        }
+                    } catch (const std::exception& e) {
+                        throw JSError(runtime, e.what());
+                    }
+                    auto timing = MethodStatsRegistry::instance().enabled()
+                        ? CallTiming::begin(name, call->inputBytes())
+                        : CallTiming{};
 
                     // Get cached Promise constructor
                     if (!cachedPromiseCtor_) {
@@ -505,41 +1703,22 @@ public:
                         runtime,
                         PropNameID::forUtf8(runtime, "executor"),
                         2,
-                        [handler, invoker, executor,
-                         strings = std::move(strings),
-                         numbers = std::move(numbers),
-                         bools = std::move(bools),
-                         buffers = std::move(buffers)](
+                        [lane, invoker, executor, call = std::move(call), key = std::move(key),
+                         timing = std::move(timing)](
                             Runtime& rt, const Value&, const Value* promiseArgs, size_t
                         ) mutable -> Value {
                             // Use single allocation for both callbacks
                             auto callbacks = std::make_shared<PromiseCallbacks>(rt, promiseArgs[0], promiseArgs[1]);
+                            TaskOptions options;
+                            options.lane = lane;
+                            options.priority = call->context.priority;
+                            options.key = std::move(key);
 
                             // Execute handler on worker thread
-                            executor->execute([handler, invoker, callbacks,
-                                               strings = std::move(strings),
-                                               numbers = std::move(numbers),
-                                               bools = std::move(bools),
-                                               buffers = std::move(buffers)]() mutable {
-                                try {
-                                    // Run handler on worker thread (pure C++ computation, no Runtime)
-                                    AsyncResult result = handler(strings, numbers, bools, buffers);
-
-                                    // Return to JS thread to create JS values and resolve
-                                    invoker->invokeAsync([callbacks, result = std::move(result)](Runtime& rt) mutable {
-                                        Value jsValue = result.toJSValue(rt);
-                                        callbacks->resolve.asObject(rt).asFunction(rt).call(rt, std::move(jsValue));
-                                    });
-                                } catch (const std::exception& e) {
-                                    std::string errorMsg = e.what();
-                                    // Return to JS thread to reject
-                                    invoker->invokeAsync([callbacks, errorMsg = std::move(errorMsg)](Runtime& rt) {
-                                        callbacks->reject.asObject(rt).asFunction(rt).call(
-                                            rt, String::createFromUtf8(rt, errorMsg)
-                                        );
-                                    });
-                                }
-                            });
+                            executor->execute([invoker, callbacks = std::move(callbacks),
+                                               call = std::move(call), timing = std::move(timing)]() mutable {
+                                runPreparedCall(std::move(call), invoker, std::move(callbacks), std::move(timing));
+                            }, options);
 
                             return Value::undefined();
                         }
@@ -554,6 +1733,13 @@ public:
             return Value(rt, *cached);
         }
 
+        // Batch method lookup
+        if (!batchMethodName_.empty() && propName == batchMethodName_) {
+            auto cached = std::make_shared<Object>(createBatchFunction(rt, propName));
+            cachedFunctions_[propName] = cached;
+            return Value(rt, *cached);
+        }
+
         // Property lookup
         if (auto it = properties_.find(propName); it != properties_.end()) {
             try {
@@ -583,7 +1769,7 @@ public:
 
     std::vector<PropNameID> getPropertyNames(Runtime& rt) override {
         std::vector<PropNameID> names;
-        names.reserve(syncMethods_.size() + asyncMethods_.size() + properties_.size());
+        names.reserve(syncMethods_.size() + asyncMethods_.size() + properties_.size() + 1);
 
         for (const auto& [name, _] : syncMethods_) {
             names.push_back(PropNameID::forUtf8(rt, name));
@@ -594,6 +1780,9 @@ public:
         for (const auto& [name, _] : properties_) {
             names.push_back(PropNameID::forUtf8(rt, name));
         }
+        if (!batchMethodName_.empty()) {
+            names.push_back(PropNameID::forUtf8(rt, batchMethodName_));
+        }
 
         return names;
     }
@@ -640,7 +1829,7 @@ public:
 #endif
 
 // ----------------------------------------------------------------------------
-// Async Argument Macros (for async methods)
+// Async Argument Macros (for JSI_ASYNC_METHOD; JSI_ASYNC_TYPED uses named params)
 // Required args:
 //   - JSI_S_ARG(idx)   : required string arg
 //   - JSI_N_ARG(idx)   : required number arg
@@ -650,6 +1839,10 @@ public:
 //   - JSI_S_OPT(idx, def) : optional string arg
 //   - JSI_N_OPT(idx, def) : optional number arg
 //   - JSI_B_OPT(idx, def) : optional bool arg
+// Context:
+//   - JSI_FN_OPT(idx)     : optional function arg (const CallbackArg*, may be null)
+//   - JSI_CANCELLED()     : true once the passed CancelToken was cancelled or the
+//                           timeout expired (also in JSI_ASYNC_TYPED)
 // ----------------------------------------------------------------------------
 
 // Required argument macros
@@ -682,6 +1875,15 @@ public:
 #define JSI_B_OPT(idx, def) (jsiBoolArgs.size() > (idx) ? jsiBoolArgs[idx] : (def))
 #endif
 
+// Context macros
+#ifndef JSI_FN_OPT
+#define JSI_FN_OPT(idx) jsiCtx.callback(idx)
+#endif
+
+#ifndef JSI_CANCELLED
+#define JSI_CANCELLED() jsiCtx.isCancelled()
+#endif
+
 // ----------------------------------------------------------------------------
 // JS Value Creation Macros (for sync methods ONLY - NOT thread safe)
 // ----------------------------------------------------------------------------
@@ -732,7 +1934,7 @@ public:
  *   - jsiStrArgs (vector of string args)
  *   - jsiNumArgs (vector of number args)
  *   - jsiBoolArgs (vector of bool args)
- *   - jsiBufArgs (vector of ArrayBuffer args as byte vectors)
+ *   - jsiBufArgs (vector of ArrayBuffer args as pinned BufferArg views)
  *
  * @example
  * JSI_ASYNC_METHOD(readFile, 1, {
@@ -746,13 +1948,39 @@ public:
         const std::vector<std::string>& jsiStrArgs, \
         const std::vector<double>& jsiNumArgs, \
         const std::vector<bool>& jsiBoolArgs, \
-        const std::vector<std::vector<uint8_t>>& jsiBufArgs \
+        const std::vector<jsi_utils::BufferArg>& jsiBufArgs, \
+        const jsi_utils::AsyncContext& jsiCtx \
     ) -> jsi_utils::AsyncResult { \
-        (void)jsiStrArgs; (void)jsiNumArgs; (void)jsiBoolArgs; (void)jsiBufArgs; \
+        (void)jsiStrArgs; (void)jsiNumArgs; (void)jsiBoolArgs; (void)jsiBufArgs; (void)jsiCtx; \
         BODY \
     });
 #endif
 
+/**
+ * @brief Register an async method with a typed signature (returns Promise)
+ * @param NAME Method name
+ * @param PARAMS Parenthesized parameter list, e.g. (const std::string& path, int64_t offset)
+ * @param ... Lambda body returning AsyncResult (pure C++ data)
+ *
+ * Arguments are decoded positionally into PARAMS on the JS thread (see
+ * ArgDecoder); use std::optional<T> for optional ones. Trailing callbacks,
+ * CancelToken and options go into jsiCtx, so JSI_FN_OPT and JSI_CANCELLED
+ * work as in JSI_ASYNC_METHOD.
+ *
+ * @example
+ * JSI_ASYNC_TYPED(readRange, (const std::string& path, int64_t offset, std::optional<int64_t> size), {
+ *     return jsi_utils::AsyncResult(readRange(path, offset, size.value_or(-1)));
+ * })
+ */
+#ifndef JSI_ASYNC_TYPED
+#define JSI_TYPED_PARAMS(...) (const jsi_utils::AsyncContext& jsiCtx __VA_OPT__(,) __VA_ARGS__)
+#define JSI_ASYNC_TYPED(NAME, PARAMS, ...) \
+    registerAsyncTyped(#NAME, [this] JSI_TYPED_PARAMS PARAMS -> jsi_utils::AsyncResult { \
+        (void)this; (void)jsiCtx; \
+        __VA_ARGS__ \
+    });
+#endif
+
 // ----------------------------------------------------------------------------
 // Property Registration Macros
 // ----------------------------------------------------------------------------
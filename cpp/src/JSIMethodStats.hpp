@@ -0,0 +1,342 @@
+/**
+ * @file JSIMethodStats.hpp
+ * @brief Opt-in latency and throughput statistics of host object methods
+ *
+ * When enabled, every async call is timed in three phases: waiting in the
+ * executor queue, running on a worker, and waiting for the JS thread to
+ * settle its Promise. Each phase goes into a lock-free histogram per
+ * method, so a slow call can be told apart as disk, pool saturation or a
+ * busy JS thread. Disabled, the cost is one relaxed atomic load per call.
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef JSI_METHOD_STATS_HPP
+#define JSI_METHOD_STATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace jsi_utils {
+
+/**
+ * @brief Lock-free log-linear histogram of durations in microseconds
+ *
+ * HDR-style buckets: exact below 32 µs, then 16 buckets per power of two,
+ * so a reported percentile is at most 1/16 above the true value. Values
+ * past about 71 minutes land in the last bucket.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kSubBits = 4;
+    static constexpr uint64_t kSubCount = uint64_t{1} << kSubBits;
+    static constexpr int kMaxBits = 32;
+    static constexpr size_t kBuckets = (kMaxBits - kSubBits + 1) * kSubCount;
+
+    struct Summary {
+        uint64_t count = 0;
+        double mean = 0.0;
+        uint64_t p50 = 0;
+        uint64_t p90 = 0;
+        uint64_t p99 = 0;
+        uint64_t max = 0;
+    };
+
+private:
+    std::array<std::atomic<uint64_t>, kBuckets> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+
+    static auto indexOf(uint64_t us) -> size_t {
+        us = std::min(us, (uint64_t{1} << kMaxBits) - 1);
+        if (us < kSubCount) {
+            return static_cast<size_t>(us);
+        }
+        int shift = static_cast<int>(std::bit_width(us)) - 1 - kSubBits;
+        return static_cast<size_t>(shift) * kSubCount + static_cast<size_t>(us >> shift);
+    }
+
+    /** @brief Largest value that falls into a bucket */
+    static auto upperBound(size_t index) -> uint64_t {
+        if (index < 2 * kSubCount) {
+            return index;
+        }
+        auto shift = index / kSubCount - 1;
+        auto lower = (index % kSubCount + kSubCount) << shift;
+        return lower + (uint64_t{1} << shift) - 1;
+    }
+
+public:
+    auto record(uint64_t us) -> void {
+        buckets_[indexOf(us)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(us, std::memory_order_relaxed);
+        auto max = max_.load(std::memory_order_relaxed);
+        while (us > max && !max_.compare_exchange_weak(max, us, std::memory_order_relaxed)) {
+        }
+    }
+
+    /** @brief Count, mean and percentiles; concurrent records may be half included */
+    [[nodiscard]] auto summary() const -> Summary {
+        Summary result;
+        result.count = count_.load(std::memory_order_relaxed);
+        if (result.count == 0) {
+            return result;
+        }
+        result.max = max_.load(std::memory_order_relaxed);
+        result.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(result.count);
+
+        const double quantiles[] = {0.5, 0.9, 0.99};
+        uint64_t* outputs[] = {&result.p50, &result.p90, &result.p99};
+        uint64_t seen = 0;
+        size_t next = 0;
+        for (size_t i = 0; i < kBuckets && next < 3; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            while (next < 3 && static_cast<double>(seen) >= quantiles[next] * static_cast<double>(result.count)) {
+                *outputs[next++] = std::min(upperBound(i), result.max);
+            }
+        }
+        for (; next < 3; ++next) {
+            *outputs[next] = result.max;
+        }
+        return result;
+    }
+
+    auto reset() -> void {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Statistics of one method
+ *
+ * Sync methods only fill execute (they run on the JS thread).
+ */
+struct MethodStats {
+    LatencyHistogram queue;    // Submitted until a worker starts it
+    LatencyHistogram execute;  // Running the handler
+    LatencyHistogram resolve;  // Handler done until the Promise is settled on the JS thread
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> cancelled{0};
+    std::atomic<uint64_t> bytesIn{0};   // Strings and buffers passed in
+    std::atomic<uint64_t> bytesOut{0};  // Strings and buffers returned
+
+    auto reset() -> void {
+        queue.reset();
+        execute.reset();
+        resolve.reset();
+        for (auto* counter : {&calls, &errors, &cancelled, &bytesIn, &bytesOut}) {
+            counter->store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * @brief Platform tracer (systrace, os_signpost) for intervals of calls
+ */
+struct TraceHooks {
+    bool (*enabled)() = nullptr;  // Is a trace being recorded
+    void (*begin)(const char* name, int32_t cookie) = nullptr;
+    void (*end)(const char* name, int32_t cookie) = nullptr;
+};
+
+/**
+ * @brief Process-wide statistics of all host objects, keyed by "scope.method"
+ *
+ * Trace markers go through hooks so the platform's tracer can be plugged
+ * in without this header depending on it.
+ */
+class MethodStatsRegistry {
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<MethodStats>, std::less<>> methods_;
+    std::atomic<bool> enabled_{false};
+    std::atomic<bool (*)()> traceEnabled_{nullptr};
+    std::atomic<void (*)(const char*, int32_t)> traceBegin_{nullptr};
+    std::atomic<void (*)(const char*, int32_t)> traceEnd_{nullptr};
+    std::atomic<int32_t> nextCookie_{1};
+
+    MethodStatsRegistry() = default;
+
+public:
+    static auto instance() -> MethodStatsRegistry& {
+        static auto* registry = new MethodStatsRegistry();  // Leaked: workers record up to exit
+        return *registry;
+    }
+
+    [[nodiscard]] auto enabled() const -> bool {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Turn recording on or off; hooks without functions disable tracing
+     *
+     * Statistics gathered so far are kept (see reset()).
+     */
+    auto configure(bool enabled, const TraceHooks& hooks = {}) -> void {
+        bool trace = enabled && hooks.enabled && hooks.begin && hooks.end;
+        traceEnabled_.store(trace ? hooks.enabled : nullptr, std::memory_order_relaxed);
+        traceBegin_.store(trace ? hooks.begin : nullptr, std::memory_order_relaxed);
+        traceEnd_.store(trace ? hooks.end : nullptr, std::memory_order_relaxed);
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    /** @brief Statistics of a method, created on first use; valid for the life of the process */
+    auto method(const std::string& name) -> MethodStats* {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& stats = methods_[name];
+        if (!stats) {
+            stats = std::make_unique<MethodStats>();
+        }
+        return stats.get();
+    }
+
+    /** @brief Zero all statistics */
+    auto reset() -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [name, stats] : methods_) {
+            stats->reset();
+        }
+    }
+
+    /** @brief Visit methods that were called, in name order */
+    template <typename Fn>
+    auto forEach(Fn&& fn) const -> void {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [name, stats] : methods_) {
+            if (stats->calls.load(std::memory_order_relaxed) > 0) {
+                fn(name, *stats);
+            }
+        }
+    }
+
+    /** @brief Start a trace interval; 0 if no trace is being recorded */
+    auto traceBegin(const std::string& name) -> int32_t {
+        auto enabled = traceEnabled_.load(std::memory_order_relaxed);
+        auto begin = traceBegin_.load(std::memory_order_relaxed);
+        if (!enabled || !begin || !enabled()) {
+            return 0;
+        }
+        int32_t cookie = nextCookie_.fetch_add(1, std::memory_order_relaxed);
+        if (cookie <= 0) {
+            nextCookie_.store(2, std::memory_order_relaxed);  // Wrapped; 0 means "none"
+            cookie = 1;
+        }
+        begin(name.c_str(), cookie);
+        return cookie;
+    }
+
+    auto traceEnd(const std::string& name, int32_t cookie) -> void {
+        auto end = traceEnd_.load(std::memory_order_relaxed);
+        if (cookie != 0 && end) {
+            end(name.c_str(), cookie);
+        }
+    }
+};
+
+/**
+ * @brief Timestamps of one call on its way through the executor
+ *
+ * Default-constructed (stats == nullptr) when recording is off; every
+ * member function is then a no-op.
+ */
+struct CallTiming {
+    using Clock = std::chrono::steady_clock;
+
+    MethodStats* stats = nullptr;
+    std::shared_ptr<const std::string> name;  // For the trace marker
+    int32_t cookie = 0;
+    Clock::time_point submitted{};
+    Clock::time_point started{};
+    Clock::time_point finished{};
+
+    static auto micros(Clock::time_point from, Clock::time_point to) -> uint64_t {
+        return to > from ? static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(to - from).count()) : 0;
+    }
+
+    /** @brief Timing of a new call of a method, if recording is on */
+    static auto begin(const std::shared_ptr<const std::string>& name, uint64_t bytesIn) -> CallTiming {
+        auto& registry = MethodStatsRegistry::instance();
+        CallTiming timing;
+        if (!registry.enabled()) {
+            return timing;
+        }
+        timing.stats = registry.method(*name);
+        timing.stats->calls.fetch_add(1, std::memory_order_relaxed);
+        timing.stats->bytesIn.fetch_add(bytesIn, std::memory_order_relaxed);
+        timing.name = name;
+        timing.cookie = registry.traceBegin(*name);
+        timing.submitted = Clock::now();
+        return timing;
+    }
+
+    /** @brief A worker picked the call up */
+    auto start() -> void {
+        if (stats) {
+            started = Clock::now();
+            stats->queue.record(micros(submitted, started));
+        }
+    }
+
+    /** @brief The handler returned or threw */
+    auto finish(bool failed, bool cancelled, uint64_t bytesOut) -> void {
+        if (stats) {
+            finished = Clock::now();
+            if (started == Clock::time_point{}) {
+                started = finished;  // Dropped before it ran
+            }
+            stats->execute.record(micros(started, finished));
+            stats->bytesOut.fetch_add(bytesOut, std::memory_order_relaxed);
+            if (cancelled) {
+                stats->cancelled.fetch_add(1, std::memory_order_relaxed);
+            } else if (failed) {
+                stats->errors.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** @brief The Promise was settled (JS thread) */
+    auto settle() -> void {
+        if (stats) {
+            stats->resolve.record(micros(finished, Clock::now()));
+            MethodStatsRegistry::instance().traceEnd(*name, cookie);
+        }
+    }
+};
+
+} // namespace jsi_utils
+
+#endif // JSI_METHOD_STATS_HPP
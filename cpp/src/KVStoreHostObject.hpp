@@ -0,0 +1,209 @@
+/**
+ * @file KVStoreHostObject.hpp
+ * @brief JSI host object of a KeyValueStore
+ *
+ * Copyright (c) 2025 arcticfox
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef KV_STORE_HOST_OBJECT_HPP
+#define KV_STORE_HOST_OBJECT_HPP
+
+#include "FSHostObject.hpp"
+#include "IOKeyValueStore.hpp"
+
+namespace rct_io {
+
+using namespace facebook::jsi;
+using namespace jsi_utils;
+
+/**
+ * @brief Host object exposing a KeyValueStore to JS
+ *
+ * Every instance for the same directory shares one store. Values are bytes;
+ * get() and multiGet() read them as UTF-8 text, getBytes() as an ArrayBuffer.
+ */
+class KVStoreHostObject : public JSIHostObjectBase<KVStoreHostObject> {
+    friend class JSIHostObjectBase<KVStoreHostObject>;
+    static constexpr const char* kStatsScope = "kv";  // Prefix of its methods in getStats()
+
+private:
+    std::shared_ptr<KeyValueStore> store_;
+    std::shared_ptr<JSCallInvokerWrapper> invoker_;
+    std::unique_ptr<TaskExecutor> executor_;
+
+    using StoreValue = std::variant<std::string, BufferArg>;
+
+    static auto bytesOf(const StoreValue& value) -> std::span<const uint8_t> {
+        return std::visit([](const auto& v) -> std::span<const uint8_t> {
+            if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::string>) {
+                return {reinterpret_cast<const uint8_t*>(v.data()), v.size()};
+            } else {
+                return v.span();
+            }
+        }, value);
+    }
+
+    static auto textOf(const std::optional<std::vector<uint8_t>>& value) -> AsyncResult {
+        if (!value) {
+            return AsyncResult();  // undefined
+        }
+        std::span<const uint8_t> bytes(*value);
+        if (isValidUtf8(bytes)) {
+            return AsyncResult(std::string(value->begin(), value->end()));
+        }
+        return AsyncResult(sanitizeUtf8(bytes));
+    }
+
+public:
+    /**
+     * @brief Construct a host object for the store in a directory
+     * @param runtime JSI Runtime reference (must outlive this object)
+     * @param executor Shared executor for async operations and compaction
+     * @param callInvoker React Native's CallInvoker for JS thread callbacks
+     * @param directory Directory of the store, created on first use
+     * @param options Store options, used when the directory is first opened
+     */
+    KVStoreHostObject(
+        Runtime& runtime,
+        std::shared_ptr<SharedExecutor> executor,
+        std::shared_ptr<facebook::react::CallInvoker> callInvoker,
+        const std::string& directory,
+        const KVStoreOptions& options
+    ) : store_(KeyValueStore::open(directory, options, [executor](std::function<void()>&& task) {
+            executor->submit(ExecutorLane::Bulk, std::move(task), -1);
+        }))
+      , invoker_(std::make_shared<RNCallInvokerAdapter>(std::move(callInvoker), runtime))
+      , executor_(std::make_unique<LaneExecutor>(std::move(executor), ExecutorLane::Interactive))
+    {
+        callInvoker_ = invoker_;
+        init();  // Calls initProperties() then initMethods()
+    }
+
+    // Required for async methods
+    TaskExecutor* getTaskExecutor() { return executor_.get(); }
+
+private:
+    void initProperties() {
+        JSI_PROPERTY(directory, {
+            return JSI_STRING(store_->directory());
+        })
+    }
+
+    void initMethods() {
+        // get(key) -> string | undefined
+        JSI_ASYNC_TYPED(get, (const std::string& key), {
+            return textOf(store_->get(key));
+        })
+
+        // getBytes(key) -> ArrayBuffer | undefined
+        JSI_ASYNC_TYPED(getBytes, (const std::string& key), {
+            auto value = store_->get(key);
+            return value ? AsyncResult(std::move(*value)) : AsyncResult();
+        })
+
+        // multiGet(keys) -> (string | undefined)[]
+        JSI_ASYNC_TYPED(multiGet, (const std::vector<std::string>& keys), {
+            std::vector<AsyncResult> values;
+            values.reserve(keys.size());
+            for (const auto& key : keys) {
+                values.push_back(textOf(store_->get(key)));
+            }
+            return AsyncResult(std::move(values));
+        })
+
+        JSI_ASYNC_TYPED(has, (const std::string& key), {
+            return AsyncResult(store_->contains(key));
+        })
+
+        // keys(prefix?) -> string[], sorted
+        JSI_ASYNC_TYPED(keys, (std::optional<std::string> prefix), {
+            std::vector<AsyncResult> keys;
+            for (auto& key : store_->keys(prefix.value_or(""))) {
+                keys.emplace_back(std::move(key));
+            }
+            return AsyncResult(std::move(keys));
+        })
+
+        // put(key, value: string | ArrayBuffer)
+        JSI_ASYNC_TYPED(put, (const std::string& key, const StoreValue& value), {
+            store_->put(key, bytesOf(value));
+            return AsyncResult();  // void result
+        })
+
+        // multiPut(keys, values) -> one append for all of them
+        JSI_ASYNC_TYPED(multiPut, (const std::vector<std::string>& keys, const std::vector<StoreValue>& values), {
+            if (keys.size() != values.size()) {
+                throw std::runtime_error("multiPut: keys and values differ in length");
+            }
+            std::vector<KVWrite> writes;
+            writes.reserve(keys.size());
+            for (size_t i = 0; i < keys.size(); ++i) {
+                writes.push_back({keys[i], bytesOf(values[i])});
+            }
+            store_->write(writes);
+            return AsyncResult();
+        })
+
+        // delete(key) -> whether the key existed
+        JSI_ASYNC_TYPED(delete, (const std::string& key), {
+            return AsyncResult(store_->remove(key));
+        })
+
+        // multiDelete(keys) -> number of keys that existed
+        JSI_ASYNC_TYPED(multiDelete, (const std::vector<std::string>& keys), {
+            std::vector<KVWrite> writes;
+            writes.reserve(keys.size());
+            for (const auto& key : keys) {
+                writes.push_back({key, std::nullopt});
+            }
+            auto existed = store_->write(writes);
+            return AsyncResult(static_cast<double>(std::count(existed.begin(), existed.end(), true)));
+        })
+
+        JSI_ASYNC_TYPED(flush, (), {
+            store_->flush();
+            return AsyncResult();
+        })
+
+        JSI_ASYNC_TYPED(compact, (), {
+            store_->compact();
+            return AsyncResult();
+        })
+
+        // getStats() -> {keys, liveBytes, deadBytes, segments, compactions}
+        JSI_ASYNC_TYPED(getStats, (), {
+            auto stats = store_->stats();
+            AsyncResultMap obj(5);
+            obj["keys"] = AsyncResult(static_cast<double>(stats.keys));
+            obj["liveBytes"] = AsyncResult(static_cast<double>(stats.liveBytes));
+            obj["deadBytes"] = AsyncResult(static_cast<double>(stats.deadBytes));
+            obj["segments"] = AsyncResult(static_cast<double>(stats.segments));
+            obj["compactions"] = AsyncResult(static_cast<double>(stats.compactions));
+            return AsyncResult(std::move(obj));
+        })
+
+        setAsyncLane("compact", static_cast<int>(ExecutorLane::Bulk));
+    }
+};
+
+} // namespace rct_io
+
+#endif // KV_STORE_HOST_OBJECT_HPP
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <cstdio>
 #include <memory>
 #include <string>
@@ -123,6 +124,21 @@ public:
     static void e(const std::string& tag, const std::string& format, Args&&... args) {
         log(LogLevel::Error, tag, format, std::forward<Args>(args)...);
     }
+
+    // ========================================================================
+    // Trace Markers (systrace/Perfetto on Android, os_signpost on iOS)
+    // ========================================================================
+
+    /** Whether a trace is being recorded; markers are dropped otherwise */
+    static bool tracing();
+
+    /**
+     * Start an interval that may end on another thread
+     * @param cookie Pairs the begin with its end; unique among open intervals
+     */
+    static void traceBegin(const char* name, int32_t cookie);
+
+    static void traceEnd(const char* name, int32_t cookie);
 };
 
 } // namespace rct_io
@@ -2,7 +2,8 @@
  * @file LoggerAndroid.cpp
  * @brief Android NDK logging implementation
  *
- * Uses __android_log_print to output logs to logcat.
+ * Uses __android_log_print to output logs to logcat, and ATrace for trace
+ * markers (systrace / Perfetto).
  *
  * Copyright (c) 2025 arcticfox
  */
@@ -11,6 +12,7 @@
 
 #include "Logger.h"
 #include <android/log.h>
+#include <dlfcn.h>
 
 namespace rct_io {
 
@@ -44,6 +46,52 @@ void Logger::platformLog(LogLevel level, const std::string& tag, const std::stri
 #pragma clang diagnostic pop
 }
 
+namespace {
+
+/**
+ * ATrace functions, looked up at runtime: the async ones need API 29 and
+ * the library supports older devices. Missing functions disable tracing.
+ */
+struct ATraceApi {
+    bool (*isEnabled)() = nullptr;
+    void (*beginAsyncSection)(const char*, int32_t) = nullptr;
+    void (*endAsyncSection)(const char*, int32_t) = nullptr;
+
+    ATraceApi() {
+        void* lib = dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+        if (!lib) {
+            return;
+        }
+        isEnabled = reinterpret_cast<bool (*)()>(dlsym(lib, "ATrace_isEnabled"));
+        beginAsyncSection = reinterpret_cast<void (*)(const char*, int32_t)>(dlsym(lib, "ATrace_beginAsyncSection"));
+        endAsyncSection = reinterpret_cast<void (*)(const char*, int32_t)>(dlsym(lib, "ATrace_endAsyncSection"));
+    }
+
+    static const ATraceApi& get() {
+        static const ATraceApi api;
+        return api;
+    }
+};
+
+} // namespace
+
+bool Logger::tracing() {
+    const auto& api = ATraceApi::get();
+    return api.isEnabled && api.beginAsyncSection && api.endAsyncSection && api.isEnabled();
+}
+
+void Logger::traceBegin(const char* name, int32_t cookie) {
+    if (auto begin = ATraceApi::get().beginAsyncSection) {
+        begin(name, cookie);
+    }
+}
+
+void Logger::traceEnd(const char* name, int32_t cookie) {
+    if (auto end = ATraceApi::get().endAsyncSection) {
+        end(name, cookie);
+    }
+}
+
 } // namespace rct_io
 
 #endif // __ANDROID__
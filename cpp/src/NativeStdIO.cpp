@@ -1,8 +1,15 @@
 #include "NativeStdIO.h"
 #include "FSHostObject.hpp"
 #include "IORequestHostObject.hpp"
+#include "IOTextCodec.hpp"
+#include "KVStoreHostObject.hpp"
 #include "PlatformHostObject.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
 #include <string>
 
 #ifdef __ANDROID__
@@ -11,38 +18,143 @@
 
 namespace facebook::react {
 
+using jsi_utils::createArrayBuffer;
+
 namespace {
-  // Helper to create ArrayBuffer via JavaScript constructor (for cross-platform compatibility)
-  jsi::ArrayBuffer createArrayBuffer(jsi::Runtime &rt, size_t size) {
-    auto arrayBufferCtor = rt.global().getPropertyAsFunction(rt, "ArrayBuffer");
-    return arrayBufferCtor.callAsConstructor(rt, static_cast<int>(size))
-        .asObject(rt)
-        .getArrayBuffer(rt);
+
+/// Most threads configureExecutor gives one lane
+constexpr double kMaxLaneThreads = 64;
+
+/// Longest JS-thread turn configureExecutor accepts for completions
+constexpr double kMaxCompletionBudgetMs = 1000;
+
+/// configureNetwork transfer limits above this mean no limit
+constexpr double kMaxTransferLimit = 1000000;
+
+/// Largest progress interval; fits steady_clock nanoseconds with room to spare
+constexpr double kMaxProgressIntervalMs = 1e9;
+
+/// Largest progress byte step; far beyond any transfer
+constexpr double kMaxProgressBytes = 1e15;
+
+/**
+ * @brief Reject NaN and Infinity, which have no integer value
+ */
+auto requireFinite(double value, const char* name) -> double {
+  if (!std::isfinite(value)) {
+    throw std::runtime_error(std::string(name) + " must be a finite number");
   }
-} // anonymous namespace
+  return value;
+}
+
+} // namespace
 
 NativeStdIO::NativeStdIO(std::shared_ptr<CallInvoker> jsInvoker)
   : NativeStdIOCxxSpec(std::move(jsInvoker)) {}
 
-jsi::Object NativeStdIO::createFileSystem(jsi::Runtime &rt, double numThreads) {
-  auto threads = static_cast<unsigned int>(numThreads > 0 ? numThreads : 3);
-  auto threadPool = std::make_shared<BS::thread_pool<>>(threads);
-  auto hostObject = std::make_shared<rct_io::FSHostObject>(rt, std::move(threadPool), jsInvoker_);
+jsi::Object NativeStdIO::createFileSystem(jsi::Runtime &rt, double /*numThreads*/) {
+  // All file systems share the process-wide executor (see configureExecutor)
+  auto hostObject = std::make_shared<rct_io::FSHostObject>(rt, rct_io::SharedExecutor::instance(), jsInvoker_);
 
   return jsi::Object::createFromHostObject(rt, hostObject);
 }
 
 jsi::Object NativeStdIO::createIORequest(jsi::Runtime &rt){
-  auto threadPool = std::make_shared<BS::thread_pool<>>(1);
-  auto hostObject = std::make_shared<rct_io::IORequestHostObject>(rt, std::move(threadPool), jsInvoker_);
+  auto hostObject = std::make_shared<rct_io::IORequestHostObject>(rt, rct_io::SharedExecutor::instance(), jsInvoker_);
   return jsi::Object::createFromHostObject(rt, hostObject);
 }
 
+void NativeStdIO::configureExecutor(
+    jsi::Runtime &/*rt*/, double interactive, double bulk, double compute, double network,
+    double completionBudgetMs) {
+  // 0 or negative keeps the lane's current count
+  auto toCount = [](double n, const char* name) {
+    return static_cast<size_t>(std::clamp(requireFinite(n, name), 0.0, kMaxLaneThreads));
+  };
+  rct_io::ExecutorConfig config;
+  config.threads = {toCount(interactive, "interactive"), toCount(bulk, "bulk"),
+                    toCount(compute, "compute"), toCount(network, "network")};
+  requireFinite(completionBudgetMs, "completionBudgetMs");
+  rct_io::SharedExecutor::configure(config);
+
+  // Negative keeps the current budget, 0 lets one turn drain all completions
+  if (completionBudgetMs >= 0) {
+    jsi_utils::CoalescingInvoker::setTurnBudget(std::chrono::microseconds(
+        static_cast<int64_t>(std::min(completionBudgetMs, kMaxCompletionBudgetMs) * 1000)));
+  }
+}
+
+void NativeStdIO::configureNetwork(
+    jsi::Runtime &/*rt*/, double maxConcurrent, double maxPerHost, double cacheSize, double memoryCacheSize,
+    double progressInterval, double progressMinBytes) {
+  if (std::isnan(maxConcurrent) || std::isnan(maxPerHost)) {
+    throw std::runtime_error("maxConcurrent and maxPerHost must be numbers");
+  }
+  // Infinity (or anything no device could run) means no limit, like 0
+  auto toLimit = [](double n) {
+    return n > kMaxTransferLimit ? size_t{0} : static_cast<size_t>(n);
+  };
+  auto& scheduler = rct_io::RequestScheduler::instance();
+  auto limits = scheduler.limits();
+  if (maxConcurrent >= 0) {
+    limits.maxConcurrent = toLimit(maxConcurrent);
+  }
+  if (maxPerHost >= 0) {
+    limits.maxPerHost = toLimit(maxPerHost);
+  }
+  scheduler.configure(limits);
+
+  requireFinite(progressInterval, "progressInterval");
+  requireFinite(progressMinBytes, "progressMinBytes");
+  if (progressInterval >= 0 || progressMinBytes >= 0) {
+    auto& hub = rct_io::ProgressHub::instance();
+    auto options = hub.options();
+    if (progressInterval >= 0) {
+      options.minIntervalMs = static_cast<int64_t>(std::min(progressInterval, kMaxProgressIntervalMs));
+    }
+    if (progressMinBytes >= 0) {
+      options.minBytes = static_cast<int64_t>(std::min(progressMinBytes, kMaxProgressBytes));
+    }
+    hub.configure(options);
+  }
+
+  // The HTTP cache lives in the platform cache directory (see PlatformHostObject)
+  if (cacheSize >= 0 || memoryCacheSize >= 0) {
+    auto& cache = rct_io::network::HttpCache::instance();
+    auto cacheLimits = cache.limits();
+    if (cacheSize >= 0) {
+      cacheLimits.maxDiskBytes = static_cast<uint64_t>(cacheSize);
+    }
+    if (memoryCacheSize >= 0) {
+      cacheLimits.maxMemoryBytes = static_cast<uint64_t>(memoryCacheSize);
+    }
+#if defined(__ANDROID__)
+    auto cacheDir = rct_io::getCacheDir();
+#elif defined(__APPLE__)
+    auto cacheDir = rct_io::getCachesDirectory();
+#else
+    std::string cacheDir = ".";
+#endif
+    cache.configure(std::filesystem::path(cacheDir) / "rnio-http-cache", cacheLimits);
+  }
+}
+
 jsi::Object NativeStdIO::createPlatform(jsi::Runtime &rt){
   auto hostObject = std::make_shared<rct_io::PlatformHostObject>(rt);
   return jsi::Object::createFromHostObject(rt, hostObject);
 }
 
+jsi::Object NativeStdIO::createKVStore(jsi::Runtime &rt, jsi::String directory, double maxSegmentBytes, bool durable) {
+  rct_io::KVStoreOptions options;
+  if (maxSegmentBytes > 0) {
+    options.maxSegmentBytes = static_cast<uint64_t>(maxSegmentBytes);
+  }
+  options.durable = durable;
+  auto hostObject = std::make_shared<rct_io::KVStoreHostObject>(
+      rt, rct_io::SharedExecutor::instance(), jsInvoker_, directory.utf8(rt), options);
+  return jsi::Object::createFromHostObject(rt, hostObject);
+}
+
 void NativeStdIO::installHttpClient(jsi::Runtime &/*rt*/) {
 #ifdef __ANDROID__
   // Pre-warm fbjni class caches on Android
@@ -58,76 +170,32 @@ jsi::String NativeStdIO::decodeString(jsi::Runtime &rt, jsi::Object buffer, jsi:
   }
 
   auto arrayBuffer = buffer.getArrayBuffer(rt);
-  auto data = reinterpret_cast<const char*>(arrayBuffer.data(rt));
-  auto size = arrayBuffer.size(rt);
-
-  std::string encodingStr = encoding.utf8(rt);
-
-  if (encodingStr == "utf8") {
-    return jsi::String::createFromUtf8(rt, std::string(data, size));
-  } else if (encodingStr == "ascii") {
-    return jsi::String::createFromAscii(rt, data, size);
-  } else if (encodingStr == "latin1") {
-    // Latin1: each byte (0x00-0xFF) maps to Unicode code point, encode as UTF-8
-    std::string result;
-    result.reserve(size * 2);
-    for (size_t i = 0; i < size; ++i) {
-      unsigned char c = static_cast<unsigned char>(data[i]);
-      if (c < 0x80) {
-        result.push_back(static_cast<char>(c));
-      } else {
-        result.push_back(static_cast<char>(0xC0 | (c >> 6)));
-        result.push_back(static_cast<char>(0x80 | (c & 0x3F)));
-      }
+  std::span<const uint8_t> bytes(arrayBuffer.data(rt), arrayBuffer.size(rt));
+
+  try {
+    auto textEncoding = rct_io::parseTextEncoding(encoding.utf8(rt));
+    // Valid UTF-8 goes to the runtime straight from the buffer
+    if (textEncoding == rct_io::TextEncoding::Utf8 && rct_io::isValidUtf8(bytes)) {
+      return jsi::String::createFromUtf8(rt, bytes.data(), bytes.size());
     }
-    return jsi::String::createFromUtf8(rt, result);
+    return jsi::String::createFromUtf8(rt, rct_io::decodeText(bytes, textEncoding));
+  } catch (const std::runtime_error& e) {
+    throw jsi::JSError(rt, e.what());
   }
-
-  throw jsi::JSError(rt, "Unsupported encoding: " + encodingStr);
 }
 
 jsi::Object NativeStdIO::encodeString(jsi::Runtime &rt, jsi::String str, jsi::String encoding) {
-  std::string encodingStr = encoding.utf8(rt);
-
-  if (encodingStr == "utf8" || encodingStr == "ascii") {
-    // UTF-8 and ASCII share the same byte representation for 0x00-0x7F
-    std::string input = str.utf8(rt);
-    auto buffer = createArrayBuffer(rt, input.size());
-    memcpy(buffer.data(rt), input.data(), input.size());
-    return std::move(buffer);
-  } else if (encodingStr == "latin1") {
-    // Latin1: decode UTF-8 to code points, keep 0x00-0xFF
-    std::string input = str.utf8(rt);
-    std::string result;
-    result.reserve(input.size());
-    for (size_t i = 0; i < input.size(); ) {
-      unsigned char c = static_cast<unsigned char>(input[i]);
-      uint32_t codePoint;
-      if (c < 0x80) {
-        codePoint = c;
-        ++i;
-      } else if ((c & 0xE0) == 0xC0 && i + 1 < input.size()) {
-        codePoint = ((c & 0x1F) << 6) | (input[i + 1] & 0x3F);
-        i += 2;
-      } else if ((c & 0xF0) == 0xE0 && i + 2 < input.size()) {
-        codePoint = ((c & 0x0F) << 12) | ((input[i + 1] & 0x3F) << 6) | (input[i + 2] & 0x3F);
-        i += 3;
-      } else if ((c & 0xF8) == 0xF0 && i + 3 < input.size()) {
-        codePoint = ((c & 0x07) << 18) | ((input[i + 1] & 0x3F) << 12) |
-                    ((input[i + 2] & 0x3F) << 6) | (input[i + 3] & 0x3F);
-        i += 4;
-      } else {
-        ++i;
-        continue;
-      }
-      result.push_back(codePoint <= 0xFF ? static_cast<char>(codePoint) : '?');
+  try {
+    auto textEncoding = rct_io::parseTextEncoding(encoding.utf8(rt));
+    auto text = str.utf8(rt);
+    // The ArrayBuffer adopts the bytes (no copy); UTF-8 is the string's own
+    if (textEncoding == rct_io::TextEncoding::Utf8) {
+      return createArrayBuffer(rt, std::move(text));
     }
-    auto buffer = createArrayBuffer(rt, result.size());
-    memcpy(buffer.data(rt), result.data(), result.size());
-    return std::move(buffer);
+    return createArrayBuffer(rt, rct_io::encodeText(text, textEncoding));
+  } catch (const std::runtime_error& e) {
+    throw jsi::JSError(rt, e.what());
   }
-
-  throw jsi::JSError(rt, "Unsupported encoding: " + encodingStr);
 }
 
 } // namespace facebook::react
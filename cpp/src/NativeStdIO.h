@@ -12,8 +12,21 @@ public:
 
   jsi::Object createIORequest(jsi::Runtime &rt);
 
+  // Thread counts of the shared executor lanes (0 = keep current) and the
+  // per-turn time budget for delivering completions (ms, negative = keep current)
+  void configureExecutor(jsi::Runtime &rt, double interactive, double bulk, double compute, double network,
+                         double completionBudgetMs);
+
+  // Limits of concurrent HTTP transfers, globally and per host, the HTTP cache
+  // and progress events (0 = no limit, negative = keep current)
+  void configureNetwork(jsi::Runtime &rt, double maxConcurrent, double maxPerHost, double cacheSize, double memoryCacheSize,
+                        double progressInterval, double progressMinBytes);
+
   jsi::Object createPlatform(jsi::Runtime &rt);
 
+  // Key-value store in a directory (segment size in bytes, 0 = default)
+  jsi::Object createKVStore(jsi::Runtime &rt, jsi::String directory, double maxSegmentBytes, bool durable);
+
   void installHttpClient(jsi::Runtime &rt);
 
   // String encoding/decoding
@@ -54,6 +54,7 @@ using namespace jsi_utils;
  */
 class PlatformHostObject : public JSIHostObjectBase<PlatformHostObject> {
     friend class JSIHostObjectBase<PlatformHostObject>;
+    static constexpr const char* kStatsScope = "platform";  // Prefix of its methods in getStats()
 
 public:
     /**
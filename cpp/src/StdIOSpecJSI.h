@@ -24,7 +24,10 @@ protected:
   NativeStdIOCxxSpec(std::shared_ptr<CallInvoker> jsInvoker) : TurboModule(std::string{NativeStdIOCxxSpec::kModuleName}, jsInvoker) {
     methodMap_["createFileSystem"] = MethodMetadata {.argCount = 1, .invoker = __createFileSystem};
     methodMap_["createIORequest"] = MethodMetadata {.argCount = 0, .invoker = __createIORequest};
+    methodMap_["configureExecutor"] = MethodMetadata {.argCount = 5, .invoker = __configureExecutor};
+    methodMap_["configureNetwork"] = MethodMetadata {.argCount = 6, .invoker = __configureNetwork};
     methodMap_["createPlatform"] = MethodMetadata {.argCount = 0, .invoker = __createPlatform};
+    methodMap_["createKVStore"] = MethodMetadata {.argCount = 3, .invoker = __createKVStore};
     methodMap_["installHttpClient"] = MethodMetadata {.argCount = 0, .invoker = __installHttpClient};
     methodMap_["decodeString"] = MethodMetadata {.argCount = 2, .invoker = __decodeString};
     methodMap_["encodeString"] = MethodMetadata {.argCount = 2, .invoker = __encodeString};
@@ -46,6 +49,31 @@ private:
     return bridging::callFromJs<jsi::Object>(rt, &T::createIORequest,  static_cast<NativeStdIOCxxSpec*>(&turboModule)->jsInvoker_, static_cast<T*>(&turboModule));
   }
 
+  static jsi::Value __configureExecutor(jsi::Runtime &rt, TurboModule &turboModule, const jsi::Value* args, size_t count) {
+    static_assert(
+      bridging::getParameterCount(&T::configureExecutor) == 6,
+      "Expected configureExecutor(...) to have 6 parameters");
+    bridging::callFromJs<void>(rt, &T::configureExecutor,  static_cast<NativeStdIOCxxSpec*>(&turboModule)->jsInvoker_, static_cast<T*>(&turboModule),
+      count <= 0 ? throw jsi::JSError(rt, "Expected argument in position 0 to be passed") : args[0].asNumber(),
+      count <= 1 ? throw jsi::JSError(rt, "Expected argument in position 1 to be passed") : args[1].asNumber(),
+      count <= 2 ? throw jsi::JSError(rt, "Expected argument in position 2 to be passed") : args[2].asNumber(),
+      count <= 3 ? throw jsi::JSError(rt, "Expected argument in position 3 to be passed") : args[3].asNumber(),
+      count <= 4 ? throw jsi::JSError(rt, "Expected argument in position 4 to be passed") : args[4].asNumber());return jsi::Value::undefined();
+  }
+
+  static jsi::Value __configureNetwork(jsi::Runtime &rt, TurboModule &turboModule, const jsi::Value* args, size_t count) {
+    static_assert(
+      bridging::getParameterCount(&T::configureNetwork) == 7,
+      "Expected configureNetwork(...) to have 7 parameters");
+    bridging::callFromJs<void>(rt, &T::configureNetwork,  static_cast<NativeStdIOCxxSpec*>(&turboModule)->jsInvoker_, static_cast<T*>(&turboModule),
+      count <= 0 ? throw jsi::JSError(rt, "Expected argument in position 0 to be passed") : args[0].asNumber(),
+      count <= 1 ? throw jsi::JSError(rt, "Expected argument in position 1 to be passed") : args[1].asNumber(),
+      count <= 2 ? throw jsi::JSError(rt, "Expected argument in position 2 to be passed") : args[2].asNumber(),
+      count <= 3 ? throw jsi::JSError(rt, "Expected argument in position 3 to be passed") : args[3].asNumber(),
+      count <= 4 ? throw jsi::JSError(rt, "Expected argument in position 4 to be passed") : args[4].asNumber(),
+      count <= 5 ? throw jsi::JSError(rt, "Expected argument in position 5 to be passed") : args[5].asNumber());return jsi::Value::undefined();
+  }
+
   static jsi::Value __createPlatform(jsi::Runtime &rt, TurboModule &turboModule, const jsi::Value* /*args*/, size_t /*count*/) {
     static_assert(
       bridging::getParameterCount(&T::createPlatform) == 1,
@@ -53,6 +81,16 @@ private:
     return bridging::callFromJs<jsi::Object>(rt, &T::createPlatform,  static_cast<NativeStdIOCxxSpec*>(&turboModule)->jsInvoker_, static_cast<T*>(&turboModule));
   }
 
+  static jsi::Value __createKVStore(jsi::Runtime &rt, TurboModule &turboModule, const jsi::Value* args, size_t count) {
+    static_assert(
+      bridging::getParameterCount(&T::createKVStore) == 4,
+      "Expected createKVStore(...) to have 4 parameters");
+    return bridging::callFromJs<jsi::Object>(rt, &T::createKVStore,  static_cast<NativeStdIOCxxSpec*>(&turboModule)->jsInvoker_, static_cast<T*>(&turboModule),
+      count <= 0 ? throw jsi::JSError(rt, "Expected argument in position 0 to be passed") : args[0].asString(rt),
+      count <= 1 ? throw jsi::JSError(rt, "Expected argument in position 1 to be passed") : args[1].asNumber(),
+      count <= 2 ? throw jsi::JSError(rt, "Expected argument in position 2 to be passed") : args[2].asBool());
+  }
+
   static jsi::Value __installHttpClient(jsi::Runtime &rt, TurboModule &turboModule, const jsi::Value* /*args*/, size_t /*count*/) {
     static_assert(
       bridging::getParameterCount(&T::installHttpClient) == 1,
@@ -13,6 +13,7 @@ import {
   openFS,
   FileOpenMode,
   SeekOrigin,
+  type BenchmarkResult,
 } from 'react-native-io';
 
 type TestResult = {
@@ -32,6 +33,7 @@ type TestDef = {
 export default function App() {
   const [results, setResults] = useState<TestResult[]>([]);
   const [running, setRunning] = useState(false);
+  const [benchmarks, setBenchmarks] = useState<BenchmarkResult[]>([]);
 
   const updateResult = (
     name: string,
@@ -741,6 +743,20 @@ export default function App() {
     runTests();
   }, [runTests]);
 
+  const runBenchmarks = useCallback(async () => {
+    setRunning(true);
+    setBenchmarks([]);
+    try {
+      const report = await FS.runBenchmarks();
+      // Machine-readable copy for tracking results across releases
+      console.log(`[Benchmarks] ${JSON.stringify(report)}`);
+      setBenchmarks(report.results);
+    } catch (e: any) {
+      console.error(`[Benchmarks] ${e.message || String(e)}`);
+    }
+    setRunning(false);
+  }, []);
+
   const passCount = results.filter((r) => r.status === 'pass').length;
   const failCount = results.filter((r) => r.status === 'fail').length;
 
@@ -760,9 +776,32 @@ export default function App() {
             {running ? 'Running...' : 'Run Tests'}
           </Text>
         </TouchableOpacity>
+        <TouchableOpacity
+          style={[
+            styles.button,
+            styles.secondButton,
+            running && styles.buttonDisabled,
+          ]}
+          onPress={runBenchmarks}
+          disabled={running}
+        >
+          <Text style={styles.buttonText}>Run Benchmarks</Text>
+        </TouchableOpacity>
       </View>
 
       <ScrollView style={styles.list}>
+        {benchmarks.map((b, i) => (
+          <View key={`bench-${i}`} style={styles.item}>
+            <View style={styles.itemHeader}>
+              <Text style={styles.itemName}>
+                {b.suite} {b.name}
+              </Text>
+              <Text style={styles.duration}>
+                {b.value.toPrecision(4)} {b.unit}
+              </Text>
+            </View>
+          </View>
+        ))}
         {results.map((r, i) => (
           <View key={i} style={styles.item}>
             <Text style={styles.icon}>
@@ -807,6 +846,7 @@ const styles = StyleSheet.create({
     paddingVertical: 12,
     borderRadius: 8,
   },
+  secondButton: { marginTop: 10 },
   buttonDisabled: { opacity: 0.5 },
   buttonText: { color: '#fff', fontSize: 16, fontWeight: '600' },
   list: { flex: 1, padding: 10 },
@@ -10,7 +10,15 @@ import {
   beforeAll,
   afterAll,
 } from 'react-native-harness';
-import { EntityType, FS, openFS, type FSContext } from 'react-native-io';
+import {
+  EntityType,
+  FS,
+  isCancelledError,
+  openFS,
+  WriteMode,
+  type FSContext,
+  type WatchEvent,
+} from 'react-native-io';
 
 describe('Directory', () => {
   let tempDir: string;
@@ -194,6 +202,163 @@ describe('Directory', () => {
       expect(dirs[0]!.name).toBe('subdir');
       expect(dirs[0]!.type).toBe(EntityType.Directory);
     });
+
+    it('should iterate directory contents in batches', async () => {
+      const testDir = getTestDir();
+      const dir = fs.directory(testDir);
+      await dir.create();
+
+      await fs.file(`${testDir}/file1.txt`).writeString('File 1');
+      await fs.file(`${testDir}/file2.txt`).writeString('File 2');
+      await fs.directory(`${testDir}/subdir`).create();
+
+      const iterator = dir.iterate({ batchSize: 2, withSize: true });
+      const batches = [];
+      for await (const batch of iterator) {
+        batches.push(batch);
+      }
+      expect(iterator.isClosed).toBe(true);
+      expect(batches.map((b) => b.length)).toEqual([2, 1]);
+
+      const entries = batches.flat();
+      const file1 = entries.find((e) => e.name === 'file1.txt');
+      expect(file1?.type).toBe(EntityType.File);
+      expect(file1?.size).toBe(6);
+      expect(entries.find((e) => e.name === 'subdir')?.type).toBe(
+        EntityType.Directory
+      );
+      expect(await dir.isEmpty()).toBe(false);
+    });
+
+    it('should list directory contents as columns', async () => {
+      const testDir = getTestDir();
+      const dir = fs.directory(testDir);
+      await dir.create();
+
+      await fs.file(`${testDir}/file1.txt`).writeString('File 1');
+      await fs.directory(`${testDir}/subdir`).create();
+      await fs.file(`${testDir}/subdir/nested.txt`).writeString('Nested');
+
+      const columns = await dir.listColumnar({ recursive: true });
+      expect(columns.count).toBe(3);
+      const names = Array.from({ length: columns.count }, (_, i) =>
+        columns.name(i)
+      );
+      expect([...names].sort()).toEqual([
+        'file1.txt',
+        'subdir',
+        'subdir/nested.txt',
+      ]);
+
+      const file1 = names.indexOf('file1.txt');
+      expect(columns.type(file1)).toBe(EntityType.File);
+      expect(columns.sizes[file1]).toBe(6);
+      expect(columns.modifiedTimes[file1]).toBeGreaterThan(0);
+
+      const meta = await fs.getMetadataColumnar([
+        `${testDir}/file1.txt`,
+        `${testDir}/missing`,
+      ]);
+      expect(Array.from(meta.types)).toEqual([
+        EntityType.File,
+        EntityType.NotFound,
+      ]);
+      expect(meta.sizes[0]).toBe(6);
+      expect(meta.name(0)).toBe('');
+    });
+
+    it('should reject cancelled and timed out listings', async () => {
+      const testDir = getTestDir();
+      const dir = fs.directory(testDir);
+      await dir.create();
+      await fs.file(`${testDir}/file1.txt`).writeString('File 1');
+
+      const cancelToken = fs.createCancelToken();
+      cancelToken.cancel();
+      let cancelled: unknown;
+      try {
+        await dir.list(false, { cancelToken });
+      } catch (e) {
+        cancelled = e;
+      }
+      expect(isCancelledError(cancelled)).toBe(true);
+      expect((cancelled as { code?: string }).code).toBe('ECANCELED');
+
+      let timedOut: unknown;
+      try {
+        await dir.listColumnar({ timeout: 0 });
+      } catch (e) {
+        timedOut = e;
+      }
+      expect(isCancelledError(timedOut)).toBe(true);
+      expect((timedOut as { code?: string }).code).toBe('ETIMEDOUT');
+
+      // An unused token and a generous timeout do not get in the way
+      const entries = await dir.list(false, {
+        cancelToken: fs.createCancelToken(),
+        timeout: 60000,
+      });
+      expect(entries.length).toBe(1);
+    });
+  });
+
+  describe('Watching', () => {
+    it('should report debounced, merged changes', async () => {
+      const testDir = getTestDir();
+      const dir = fs.directory(testDir);
+      await dir.create();
+      await fs.file(`${testDir}/old.txt`).writeString('old');
+
+      const seen: WatchEvent[] = [];
+      let batches = 0;
+      const watcher = dir.watch(
+        (events) => {
+          batches++;
+          seen.push(...events);
+        },
+        { recursive: true, debounceMs: 50 }
+      );
+      const settle = () => new Promise((resolve) => setTimeout(resolve, 500));
+
+      try {
+        // Written many times, one event
+        const file = fs.file(`${testDir}/new.txt`);
+        await file.writeString('a');
+        for (let i = 0; i < 10; i++) {
+          await file.writeString(`${i}`, WriteMode.Append);
+        }
+        await fs.file(`${testDir}/old.txt`).delete();
+        await fs.directory(`${testDir}/sub`).create();
+        await fs.file(`${testDir}/sub/nested.txt`).writeString('n');
+        await settle();
+
+        // First change per path (a later batch may add a 'modified')
+        const byPath = new Map<string, string>();
+        for (const e of seen) {
+          if (!byPath.has(e.path)) {
+            byPath.set(e.path, e.type);
+          }
+        }
+        expect(byPath.get(`${testDir}/new.txt`)).toBe('created');
+        expect(byPath.get(`${testDir}/old.txt`)).toBe('deleted');
+        expect(byPath.get(`${testDir}/sub/nested.txt`)).toBe('created');
+        expect(
+          seen.filter((e) => e.path === `${testDir}/new.txt`).length
+        ).toBeLessThanOrEqual(2);
+        expect(batches).toBeLessThanOrEqual(seen.length);
+      } finally {
+        watcher.close();
+      }
+
+      // Nothing arrives after close()
+      const count = seen.length;
+      await fs.file(`${testDir}/after.txt`).writeString('x');
+      await settle();
+      expect(seen.length).toBe(count);
+      expect(watcher.isClosed).toBe(true);
+
+      expect(() => fs.directory(`${testDir}/missing`).watch(() => {})).toThrow();
+    });
   });
 
   describe('Sync operations', () => {
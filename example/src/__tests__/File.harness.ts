@@ -12,9 +12,13 @@ import {
 } from 'react-native-harness';
 import {
   EntityType,
+  FileOpenMode,
   HashAlgorithm,
+  PipeStageKind,
+  TaskPriority,
   FS,
   openFS,
+  WriteMode,
   type FSContext,
 } from 'react-native-io';
 
@@ -195,6 +199,41 @@ describe('File', () => {
       }
     });
 
+    it('should copy a large file with progress and refuse to overwrite', async () => {
+      console.log('[File.harness] Test: copy progress');
+      const source = fs.file(testBinaryPath);
+      const destPath = `${tempDir}/rn-io-test-copy.bin`;
+      const size = 20 * 1024 * 1024 + 3;
+
+      try {
+        await source.writeBytes(new Uint8Array(size).fill(7).buffer);
+        let last = 0;
+        const dest = await source.copy(destPath, true, {
+          onProgress: (copied, total) => {
+            expect(total).toBe(size);
+            last = copied;
+          },
+        });
+        expect(last).toBe(size);
+        expect(await dest.calcHash(HashAlgorithm.CRC32)).toBe(
+          await source.calcHash(HashAlgorithm.CRC32)
+        );
+
+        let error: unknown;
+        try {
+          await source.copy(destPath, false);
+        } catch (e) {
+          error = e;
+        }
+        expect(String(error)).toContain('File exists');
+        console.log('[File.harness] Test: copy progress - DONE');
+      } finally {
+        try {
+          await fs.file(destPath).delete();
+        } catch {}
+      }
+    });
+
     it('should rename/move file', async () => {
       console.log('[File.harness] Test: rename/move file');
       const sourcePath = `${tempDir}/rn-io-test-move-src.txt`;
@@ -227,6 +266,101 @@ describe('File', () => {
       expect(content).toBe('Hello World');
       console.log('[File.harness] Test: append content - DONE');
     });
+
+    it('should read lines in batches from a handle', async () => {
+      console.log('[File.harness] Test: handle readLines');
+      const file = fs.file(testFilePath);
+      await file.writeString('one\r\ntwo\n\nthree\nfour');
+
+      const handle = fs.open(testFilePath);
+      try {
+        expect(await handle.readLines(3)).toEqual(['one', 'two', '']);
+        expect(await handle.getPosition()).toBe(10);
+        expect(await handle.readLines()).toEqual(['three', 'four']);
+        expect(await handle.readLines()).toEqual([]);
+      } finally {
+        handle.close();
+      }
+      console.log('[File.harness] Test: handle readLines - DONE');
+    });
+
+    it('should count handle I/O and reject closed handles', async () => {
+      console.log('[File.harness] Test: handle stats');
+      const file = fs.file(testFilePath);
+      await file.writeString('Hello World');
+
+      const first = fs.open(testFilePath);
+      first.close();
+      // The reopened handle may reuse the closed handle's native slot
+      const handle = fs.open(testFilePath);
+      try {
+        expect(await handle.readString(5)).toBe('Hello');
+        await handle.readAt(6, 5);
+        const stats = handle.getStats();
+        expect(stats.bytesRead).toBe(10);
+        expect(stats.readOps).toBe(2);
+        expect(stats.bytesWritten).toBe(0);
+        expect(stats.writeOps).toBe(0);
+      } finally {
+        handle.close();
+      }
+      expect(() => first.getStats()).toThrow();
+      expect(() => handle.read()).toThrow();
+      console.log('[File.harness] Test: handle stats - DONE');
+    });
+
+    it('should read at an offset without moving the position', async () => {
+      console.log('[File.harness] Test: handle readAt');
+      const file = fs.file(testFilePath);
+      await file.writeString('Hello World');
+
+      const handle = fs.open(testFilePath);
+      try {
+        expect(FS.decodeString(await handle.readAt(6, 5))).toBe('World');
+        // Reads past the end come back short
+        expect(FS.decodeString(await handle.readAt(6))).toBe('World');
+        const [a, b, c] = await Promise.all([
+          handle.readAt(0, 5),
+          handle.readAt(6, 5),
+          handle.readAt(4, 3),
+        ]);
+        expect(FS.decodeString(a)).toBe('Hello');
+        expect(FS.decodeString(b)).toBe('World');
+        expect(FS.decodeString(c)).toBe('o W');
+        expect(await handle.getPosition()).toBe(0);
+        expect(await handle.readString(5)).toBe('Hello');
+      } finally {
+        handle.close();
+      }
+      console.log('[File.harness] Test: handle readAt - DONE');
+    });
+
+    it('should write at an offset and reject append handles', async () => {
+      console.log('[File.harness] Test: handle writeAt');
+      const file = fs.file(testFilePath);
+      await file.writeString('Hello World');
+
+      const handle = fs.open(testFilePath, FileOpenMode.ReadWrite);
+      try {
+        expect(await handle.writeAt(6, FS.encodeString('There'))).toBe(5);
+        expect(await handle.getPosition()).toBe(0);
+        expect(FS.decodeString(await handle.readAt(0))).toBe('Hello There');
+      } finally {
+        handle.close();
+      }
+      expect(await file.readString()).toBe('Hello There');
+
+      const appender = fs.open(testFilePath, FileOpenMode.Append);
+      try {
+        await expect(
+          appender.writeAt(0, FS.encodeString('Oops'))
+        ).rejects.toBeDefined();
+      } finally {
+        appender.close();
+      }
+      expect(await file.readString()).toBe('Hello There');
+      console.log('[File.harness] Test: handle writeAt - DONE');
+    });
   });
 
   describe('Hash operations', () => {
@@ -251,6 +385,481 @@ describe('File', () => {
       );
       console.log('[File.harness] Test: SHA256 hash - DONE');
     });
+
+    it('should not delay a small read behind low-priority hashing', async () => {
+      console.log('[File.harness] Test: hash priority');
+      const file = fs.file(testFilePath);
+      await file.writeString('Hello');
+
+      const hashing = [1, 2, 3, 4].map(() =>
+        file.calcHash(HashAlgorithm.SHA256, { priority: TaskPriority.Low })
+      );
+      // Reads run on the interactive lane, not behind the hashes
+      expect(await file.readString()).toBe('Hello');
+      const hashes = await Promise.all(hashing);
+      expect(new Set(hashes).size).toBe(1);
+      expect(hashes[0]).toBe(
+        '185f8db32271fe25f561a6fc938b2e264306ec304eda518007d1764826381969'
+      );
+      console.log('[File.harness] Test: hash priority - DONE');
+    });
+
+    it('should resolve a burst of concurrent reads', async () => {
+      console.log('[File.harness] Test: completion burst');
+      const file = fs.file(testFilePath);
+      await file.writeString('Hello');
+
+      // Completions are delivered to JS in batched turns; every Promise
+      // must still settle with its own result
+      const reads = Array.from({ length: 300 }, (_, i) =>
+        i % 2 === 0 ? file.readString() : file.size()
+      );
+      const results = await Promise.all(reads);
+      results.forEach((result, i) => {
+        expect(result).toBe(i % 2 === 0 ? 'Hello' : 5);
+      });
+      console.log('[File.harness] Test: completion burst - DONE');
+    });
+
+    it('should calculate several hashes in one pass', async () => {
+      console.log('[File.harness] Test: multiple hashes');
+      const file = fs.file(testFilePath);
+      await file.writeString('Hello');
+
+      const hashes = await file.calcHashes([
+        HashAlgorithm.MD5,
+        HashAlgorithm.SHA256,
+        HashAlgorithm.CRC32,
+      ]);
+      expect(hashes[HashAlgorithm.MD5]).toBe('8b1a9953c4611296a827abf8c47804d7');
+      expect(hashes[HashAlgorithm.SHA256]).toBe(
+        '185f8db32271fe25f561a6fc938b2e264306ec304eda518007d1764826381969'
+      );
+      expect(hashes[HashAlgorithm.CRC32]).toBe('f7d18982');
+      console.log('[File.harness] Test: multiple hashes - DONE');
+    });
+
+    it('should report hash progress', async () => {
+      console.log('[File.harness] Test: hash progress');
+      const file = fs.file(testFilePath);
+      await file.writeString('Hello');
+
+      let lastProcessed = -1;
+      let lastTotal = -1;
+      const hash = await file.calcHash(HashAlgorithm.CRC32, {
+        onProgress: (processed, total) => {
+          lastProcessed = processed;
+          lastTotal = total;
+        },
+      });
+      expect(hash).toBe('f7d18982');
+      // Progress is delivered on the JS queue; give it a turn to flush
+      await new Promise((resolve) => setTimeout(resolve, 0));
+      expect(lastProcessed).toBe(5);
+      expect(lastTotal).toBe(5);
+      console.log('[File.harness] Test: hash progress - DONE');
+    });
+
+    it('should reject cancelled hash', async () => {
+      console.log('[File.harness] Test: hash cancel');
+      const file = fs.file(testFilePath);
+      await file.writeString('Hello');
+
+      const cancelToken = fs.createCancelToken();
+      cancelToken.cancel();
+      let error: unknown;
+      try {
+        await file.calcHash(HashAlgorithm.SHA256, { cancelToken });
+      } catch (e) {
+        error = e;
+      }
+      expect(error).toBeDefined();
+      console.log('[File.harness] Test: hash cancel - DONE');
+    });
+
+    it('should calculate chunked hash', async () => {
+      console.log('[File.harness] Test: chunked hash');
+      const file = fs.file(testFilePath);
+      await file.writeString('Hello World');
+
+      const crc = await file.calcChunkedHash(HashAlgorithm.CRC32, {
+        chunkSize: 4,
+      });
+      expect(crc.chunks.length).toBe(3);
+      expect(crc.chunkSize).toBe(4);
+      expect(crc.root).toBe(await file.calcHash(HashAlgorithm.CRC32));
+
+      const sha = await file.calcChunkedHash(HashAlgorithm.SHA256, {
+        chunkSize: 5,
+      });
+      expect(sha.chunks.length).toBe(3);
+      // first range is "Hello"
+      expect(sha.chunks[0]).toBe(
+        '185f8db32271fe25f561a6fc938b2e264306ec304eda518007d1764826381969'
+      );
+      expect(sha.root.length).toBe(64);
+      console.log('[File.harness] Test: chunked hash - DONE');
+    });
+  });
+
+  describe('Memory-mapped files', () => {
+    it('should map a file range', async () => {
+      console.log('[File.harness] Test: mmap range');
+      const file = fs.file(testBinaryPath);
+      await file.writeBytes(new Uint8Array([1, 2, 3, 4, 5, 6, 7, 8]).buffer);
+
+      const buffer = await fs.mmap(testBinaryPath, { offset: 2, length: 4 });
+      expect(Array.from(new Uint8Array(buffer))).toEqual([3, 4, 5, 6]);
+      // Stores into a read-only mapping stay private to it
+      new Uint8Array(buffer)[0] = 42;
+      expect(new Uint8Array(buffer)[0]).toBe(42);
+      expect(fs.unmap(buffer)).toBe(true);
+      expect(fs.unmap(buffer)).toBe(false);
+      expect(Array.from(new Uint8Array(await file.readBytes()))).toEqual([
+        1, 2, 3, 4, 5, 6, 7, 8,
+      ]);
+      console.log('[File.harness] Test: mmap range - DONE');
+    });
+
+    it('should write through a writable mapping', () => {
+      console.log('[File.harness] Test: mmap writable');
+      const file = fs.file(testBinaryPath);
+      file.writeBytesSync(new Uint8Array([0, 0, 0, 0]).buffer);
+
+      const buffer = fs.mmapSync(testBinaryPath, { writable: true });
+      new Uint8Array(buffer).set([9, 8, 7, 6]);
+      fs.msync(buffer);
+      fs.unmap(buffer);
+
+      expect(Array.from(new Uint8Array(file.readBytesSync()))).toEqual([
+        9, 8, 7, 6,
+      ]);
+      console.log('[File.harness] Test: mmap writable - DONE');
+    });
+  });
+
+  describe('Pipelines', () => {
+    it('should gzip a file while hashing it', async () => {
+      console.log('[File.harness] Test: pipe gzip');
+      const gzPath = `${tempDir}/rn-io-test-pipe.gz`;
+      const file = fs.file(testFilePath);
+      await file.writeString('Hello pipeline '.repeat(1000));
+
+      try {
+        const packed = await fs.pipe(testFilePath, gzPath, {
+          stages: [
+            { kind: PipeStageKind.Hash, param: HashAlgorithm.CRC32 },
+            { kind: PipeStageKind.Gzip },
+          ],
+        });
+        expect(packed.bytesRead).toBe(15000);
+        expect(packed.bytesWritten).toBeLessThan(15000);
+        expect(packed.digests).toEqual([
+          await file.calcHash(HashAlgorithm.CRC32),
+        ]);
+        expect(packed.data).toBeUndefined();
+
+        const unpacked = await fs.pipe(gzPath, null, {
+          stages: [{ kind: PipeStageKind.Gunzip }],
+        });
+        expect(FS.decodeString(unpacked.data!)).toBe(await file.readString());
+      } finally {
+        await fs.file(gzPath).delete();
+      }
+      console.log('[File.harness] Test: pipe gzip - DONE');
+    });
+
+    it('should base64-encode a range into memory', async () => {
+      console.log('[File.harness] Test: pipe base64');
+      await fs.file(testFilePath).writeString('xxHello');
+
+      const result = await fs.pipe(testFilePath, null, {
+        offset: 2,
+        stages: [{ kind: PipeStageKind.Base64Encode }],
+      });
+      expect(FS.decodeString(result.data!)).toBe('SGVsbG8=');
+      console.log('[File.harness] Test: pipe base64 - DONE');
+    });
+
+    it('should parse CSV and JSON lines natively', async () => {
+      console.log('[File.harness] Test: pipeLines');
+      const csvPath = `${tempDir}/rn-io-test-lines.csv`;
+      const plainPath = `${tempDir}/rn-io-test-lines.jsonl`;
+      const jsonPath = `${tempDir}/rn-io-test-lines.jsonl.gz`;
+      const outPath = `${tempDir}/rn-io-test-lines.out`;
+      await fs
+        .file(csvPath)
+        .writeString(
+          'name,age,city\r\nAda,36,"London, UK"\nBob,41,Paris\n"Q ""q""",7,Rome'
+        );
+      const json = Array.from({ length: 1000 }, (_, i) =>
+        JSON.stringify({
+          level: i % 10 === 0 ? 'error' : 'info',
+          timing: { ms: i },
+          msg: `caf\u00e9 ${i}`,
+        })
+      ).join('\n');
+      await fs.file(plainPath).writeString(json);
+      await fs.pipe(plainPath, jsonPath, {
+        stages: [{ kind: PipeStageKind.Gzip }],
+      });
+
+      try {
+        const csv = await fs.pipeLines(csvPath, {
+          stages: [
+            { kind: 'split', csv: true },
+            { kind: 'skip', count: 1 },
+          ],
+          output: { kind: 'columns' },
+        });
+        expect(csv.linesRead).toBe(4);
+        expect(csv.records).toBe(3);
+        expect(csv.columns![0]).toEqual(['Ada', 'Bob', 'Q "q"']);
+        expect(Array.from(csv.columns![1] as Float64Array)).toEqual([36, 41, 7]);
+        expect(csv.columns![2]).toEqual(['London, UK', 'Paris', 'Rome']);
+
+        const errors = await fs.pipeLines(jsonPath, {
+          decode: [{ kind: PipeStageKind.Gunzip }],
+          stages: [
+            { kind: 'json', fields: ['level', 'timing.ms', 'msg'] },
+            { kind: 'filter', equals: 'error', field: 0 },
+          ],
+          output: { kind: 'columns' },
+        });
+        expect(errors.records).toBe(100);
+        expect(errors.invalid).toBe(0);
+        expect((errors.columns![1] as Float64Array)[1]).toBe(10);
+        expect((errors.columns![2] as string[])[0]).toBe('café 0');
+
+        const levels = await fs.pipeLines(jsonPath, {
+          decode: [{ kind: PipeStageKind.Gunzip }],
+          stages: [{ kind: 'json', fields: ['level'] }],
+          output: { kind: 'countBy', field: 0 },
+        });
+        expect(levels.counts).toEqual({ error: 100, info: 900 });
+
+        const head = await fs.pipeLines(csvPath, {
+          stages: [
+            { kind: 'filter', prefix: 'name,', invert: true },
+            { kind: 'split', csv: true },
+            { kind: 'select', fields: [2, 0] },
+            { kind: 'limit', count: 2 },
+          ],
+          output: { kind: 'file', path: outPath, separator: ';' },
+        });
+        expect(head.records).toBe(2);
+        expect(await fs.file(outPath).readString()).toBe(
+          'London, UK;Ada\nParis;Bob\n'
+        );
+      } finally {
+        for (const path of [csvPath, plainPath, jsonPath, outPath]) {
+          const file = fs.file(path);
+          if (await file.exists()) {
+            await file.delete();
+          }
+        }
+      }
+      console.log('[File.harness] Test: pipeLines - DONE');
+    });
+  });
+
+  describe('Batch operations', () => {
+    it('should run operations in one batch', async () => {
+      console.log('[File.harness] Test: batch');
+      const results = await fs.batch([
+        { op: 'writeString', args: [testFilePath, 'Batch', 0, true], group: 'w' },
+        { op: 'readString', args: [testFilePath], group: 'w' },
+        { op: 'exists', args: [`${tempDir}/rn-io-missing-file`] },
+        { op: 'readString', args: [`${tempDir}/rn-io-missing-file`] },
+        { op: 'noSuchOperation' },
+      ]);
+
+      expect(results.length).toBe(5);
+      expect(results[0]!.ok).toBe(true);
+      expect(results[1]).toEqual({ ok: true, value: 'Batch' });
+      expect(results[2]).toEqual({ ok: true, value: false });
+      expect(results[3]!.ok).toBe(false);
+      expect(results[4]!.ok).toBe(false);
+      expect(await fs.batch([], { ordered: true })).toEqual([]);
+      console.log('[File.harness] Test: batch - DONE');
+    });
+  });
+
+  describe('Atomic writes', () => {
+    it('should replace files atomically, alone and in a batch', async () => {
+      console.log('[File.harness] Test: atomic writes');
+      const dir = `${tempDir}/rn-io-atomic`;
+      const file = fs.file(`${dir}/state.json`);
+      try {
+        await file.writeString('{"v":1}', WriteMode.Overwrite);
+        await file.writeString('{"v":2}', WriteMode.Atomic);
+        expect(await file.readString()).toBe('{"v":2}');
+
+        const bytes = new Uint8Array([1, 2, 3]).buffer as ArrayBuffer;
+        await fs.writeFiles(
+          [
+            { path: `${dir}/a.json`, content: '{"a":true}' },
+            { path: `${dir}/nested/b.bin`, content: bytes },
+            { path: `${dir}/state.json`, content: '{"v":3}' },
+          ],
+          { createParents: true }
+        );
+        expect(await fs.file(`${dir}/a.json`).readString()).toBe('{"a":true}');
+        expect(
+          new Uint8Array(await fs.file(`${dir}/nested/b.bin`).readBytes())
+        ).toEqual(new Uint8Array([1, 2, 3]));
+        expect(await file.readString()).toBe('{"v":3}');
+        // No temp files are left behind
+        const names = (await fs.directory(dir).list()).map((e) => e.name);
+        expect(names.some((n) => n.includes('rnio-tmp'))).toBe(false);
+
+        let error: unknown;
+        try {
+          await fs.writeFiles([{ path: `${dir}/missing/x.json`, content: 'x' }]);
+        } catch (e) {
+          error = e;
+        }
+        expect(String(error)).toContain('Failed to write file atomically');
+      } finally {
+        await fs.directory(dir).delete(true);
+      }
+      console.log('[File.harness] Test: atomic writes - DONE');
+    });
+  });
+
+  describe('Stat cache', () => {
+    it('should stay current with library writes and honour invalidation', async () => {
+      console.log('[File.harness] Test: stat cache');
+      const dir = `${tempDir}/rn-io-statcache`;
+      const file = fs.file(`${dir}/a.txt`);
+      FS.configureStatCache({ maxEntries: 256, ttlMs: 60000 });
+      try {
+        expect(file.existsSync()).toBe(false);
+        await file.writeString('hello', WriteMode.Overwrite);
+        expect(file.existsSync()).toBe(true);
+        expect(file.metadataSync().size).toBe(5);
+
+        await file.writeString(' world', WriteMode.Append);
+        expect(file.sizeSync()).toBe(11);
+        await file.move(`${dir}/b.txt`);
+        expect(fs.file(`${dir}/a.txt`).existsSync()).toBe(false);
+        expect(fs.file(`${dir}/b.txt`).isFileSync()).toBe(true);
+
+        await fs.directory(dir).delete(true);
+        expect(fs.file(`${dir}/b.txt`).existsSync()).toBe(false);
+        expect(fs.directory(dir).existsSync()).toBe(false);
+      } finally {
+        FS.configureStatCache({ maxEntries: 0 });
+        const d = fs.directory(dir);
+        if (await d.exists()) {
+          await d.delete(true);
+        }
+      }
+      console.log('[File.harness] Test: stat cache - DONE');
+    });
+  });
+
+  describe('Instrumentation', () => {
+    it('should record latencies and bytes per method', async () => {
+      console.log('[File.harness] Test: instrumentation');
+      const file = fs.file(`${tempDir}/rn-io-stats.txt`);
+      await file.writeString('x'.repeat(1000), WriteMode.Overwrite);
+      FS.configureStats({ enabled: true });
+      FS.resetStats();
+      try {
+        for (let i = 0; i < 20; i++) {
+          await file.readString();
+        }
+        await expect(fs.file(`${tempDir}/missing.txt`).readString()).rejects.toBeDefined();
+
+        const stats = FS.getStats();
+        expect(stats.enabled).toBe(true);
+        const read = stats.methods['fs.readString']!;
+        expect(read.calls).toBe(21);
+        expect(read.errors).toBe(1);
+        expect(read.bytesOut).toBe(20 * 1000);
+        expect(read.execute.count).toBe(21);
+        expect(read.execute.p50).toBeLessThanOrEqual(read.execute.p99);
+        expect(read.execute.p99).toBeLessThanOrEqual(read.execute.max);
+        expect(read.resolve.count).toBe(21);
+        expect(stats.lanes.interactive.threads).toBeGreaterThan(0);
+
+        FS.resetStats();
+        expect(FS.getStats().methods['fs.readString']).toBeUndefined();
+      } finally {
+        FS.configureStats({ enabled: false });
+        await file.delete();
+      }
+      console.log('[File.harness] Test: instrumentation - DONE');
+    });
+  });
+
+  describe('Benchmarks', () => {
+    it('should report every case of the selected suites', async () => {
+      console.log('[File.harness] Test: benchmarks');
+      const report = await FS.runBenchmarks({
+        suites: ['fs', 'hash', 'jsi'],
+        quick: true,
+        directory: tempDir,
+      });
+      expect(report.schema).toBe(1);
+      expect(report.quick).toBe(true);
+      expect(JSON.parse(JSON.stringify(report))).toEqual(report);
+
+      const names = report.results.map((r) => `${r.suite}:${r.name}`);
+      expect(names).toContain('fs:seqRead/1MB');
+      expect(names).toContain('fs:randWrite/4KB');
+      expect(names).toContain('hash:SHA256');
+      expect(names).toContain('hash:CRC32');
+      expect(names).toContain('jsi:asyncCall');
+      expect(names.some((n) => n.startsWith('codec:'))).toBe(false);
+      for (const result of report.results) {
+        expect(result.value).toBeGreaterThan(0);
+        expect(result.min).toBeLessThanOrEqual(result.value);
+        expect(result.value).toBeLessThanOrEqual(result.max);
+      }
+      expect(await fs.directory(`${tempDir}/rn-io-bench`).exists()).toBe(false);
+      console.log(`[File.harness] ${JSON.stringify(report)}`);
+      console.log('[File.harness] Test: benchmarks - DONE');
+    });
+  });
+
+  describe('Encodings', () => {
+    it('should convert strings and files between encodings', async () => {
+      console.log('[File.harness] Test: encodings');
+      const bytes = new Uint8Array([0x00, 0x7f, 0x80, 0xfb, 0xff, 0x41]);
+      const buffer = bytes.buffer as ArrayBuffer;
+
+      expect(FS.decodeString(buffer, 'base64')).toBe('AH+A+/9B');
+      expect(FS.decodeString(buffer, 'base64url')).toBe('AH-A-_9B');
+      expect(FS.decodeString(buffer, 'hex')).toBe('007f80fbff41');
+      expect(
+        new Uint8Array(FS.encodeString('AH-A-_9B', 'base64'))
+      ).toEqual(bytes);
+      expect(new Uint8Array(FS.encodeString('007F80FBFF41', 'hex'))).toEqual(
+        bytes
+      );
+      expect(() => FS.encodeString('abc', 'hex')).toThrow();
+
+      const text = 'héllo 🚀';
+      const utf16 = FS.encodeString(text, 'utf16le');
+      expect(utf16.byteLength).toBe(text.length * 2);
+      expect(FS.decodeString(utf16, 'utf16le')).toBe(text);
+      expect(FS.decodeString(FS.encodeString('héllo', 'latin1'), 'latin1')).toBe(
+        'héllo'
+      );
+      // Invalid UTF-8 decodes as U+FFFD
+      expect(
+        FS.decodeString(new Uint8Array([0x61, 0xc3]).buffer as ArrayBuffer)
+      ).toBe('a\ufffd');
+
+      const file = fs.file(testFilePath);
+      await file.writeString('AH+A+/9B', undefined, 'base64');
+      expect(new Uint8Array(await file.readBytes())).toEqual(bytes);
+      expect(await file.readString('hex')).toBe('007f80fbff41');
+      expect(file.readStringSync('base64')).toBe('AH+A+/9B');
+      console.log('[File.harness] Test: encodings - DONE');
+    });
   });
 
   describe('Sync operations', () => {
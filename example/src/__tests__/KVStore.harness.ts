@@ -0,0 +1,89 @@
+/**
+ * @file KVStore.harness.ts
+ * @description Harness tests for KVStore class - runs on real device/emulator
+ */
+
+import { describe, it, expect, beforeAll, afterAll } from 'react-native-harness';
+import { FS, KVStore, openFS, type FSContext } from 'react-native-io';
+
+describe('KVStore', () => {
+  let fs: FSContext;
+  let storeDir: string;
+
+  beforeAll(() => {
+    fs = openFS(1);
+    storeDir = `${FS.cacheDir}/rn-io-kvstore`;
+  });
+
+  afterAll(async () => {
+    const dir = fs.directory(storeDir);
+    if (await dir.exists()) {
+      await dir.delete(true);
+    }
+  });
+
+  it('should put, get and delete values', async () => {
+    console.log('[KVStore.harness] Test: put/get/delete');
+    const store = new KVStore(storeDir);
+    await store.put('user:1', '{"name":"Ada"}');
+    await store.put('bytes', new Uint8Array([1, 2, 3]).buffer as ArrayBuffer);
+
+    expect(await store.get('user:1')).toBe('{"name":"Ada"}');
+    expect(new Uint8Array((await store.getBytes('bytes'))!)).toEqual(
+      new Uint8Array([1, 2, 3])
+    );
+    expect(await store.get('missing')).toBeUndefined();
+    expect(await store.has('user:1')).toBe(true);
+
+    expect(await store.delete('user:1')).toBe(true);
+    expect(await store.delete('user:1')).toBe(false);
+    expect(await store.get('user:1')).toBeUndefined();
+    console.log('[KVStore.harness] Test: put/get/delete - DONE');
+  });
+
+  it('should batch writes and reads, and keep them across instances', async () => {
+    console.log('[KVStore.harness] Test: multiPut/multiGet');
+    const store = new KVStore(storeDir);
+    const entries: [string, string][] = [];
+    for (let i = 0; i < 500; i++) {
+      entries.push([`item:${i}`, JSON.stringify({ i, text: 'x'.repeat(100) })]);
+    }
+    await store.multiPut(entries);
+
+    const values = await store.multiGet(['item:0', 'nope', 'item:499']);
+    expect(JSON.parse(values[0]!).i).toBe(0);
+    expect(values[1]).toBeUndefined();
+    expect(JSON.parse(values[2]!).i).toBe(499);
+    expect((await store.keys('item:')).length).toBe(500);
+
+    // Another instance of the directory sees the same data
+    const other = new KVStore(storeDir);
+    expect(JSON.parse((await other.get('item:42'))!).i).toBe(42);
+    expect(await other.multiDelete(['item:1', 'item:2', 'nope'])).toBe(2);
+    expect(await store.has('item:1')).toBe(false);
+    console.log('[KVStore.harness] Test: multiPut/multiGet - DONE');
+  });
+
+  it('should reclaim overwritten values by compaction', async () => {
+    console.log('[KVStore.harness] Test: compaction');
+    const store = new KVStore(storeDir);
+    for (let round = 0; round < 5; round++) {
+      await store.multiPut(
+        Array.from({ length: 100 }, (_, i): [string, string] => [
+          `hot:${i}`,
+          `round ${round}`,
+        ])
+      );
+    }
+    const before = await store.getStats();
+    expect(before.deadBytes).toBeGreaterThan(0);
+
+    await store.compact();
+    const after = await store.getStats();
+    expect(after.deadBytes).toBe(0);
+    expect(after.liveBytes).toBe(before.liveBytes);
+    expect(after.keys).toBe(before.keys);
+    expect(await store.get('hot:7')).toBe('round 4');
+    console.log('[KVStore.harness] Test: compaction - DONE');
+  });
+});
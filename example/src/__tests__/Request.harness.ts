@@ -4,7 +4,16 @@
  */
 
 import { describe, it, expect, beforeEach } from 'react-native-harness';
-import { request, File, FS } from 'react-native-io';
+import {
+  request,
+  configureNetwork,
+  File,
+  FileOpenMode,
+  FS,
+  openFS,
+  TaskPriority,
+  type DownloadProgress,
+} from 'react-native-io';
 
 describe('HTTP Request', () => {
   let tempDir: string;
@@ -99,6 +108,61 @@ describe('HTTP Request', () => {
     });
   });
 
+  describe('Binary bodies', () => {
+    it('should send and receive large binary bodies intact', async () => {
+      const data = new Uint8Array(256 * 1024);
+      for (let i = 0; i < data.length; i++) {
+        data[i] = i & 0xff;
+      }
+      const sent = await request.post('https://httpbin.org/anything', {
+        data: data.buffer,
+        headers: { 'Content-Type': 'application/octet-stream' },
+      });
+      expect(sent.status).toBe(200);
+      const echoed = sent.json<{ headers: Record<string, string> }>();
+      expect(echoed.headers['Content-Length']).toBe(String(data.length));
+
+      const received = await request.get('https://httpbin.org/bytes/300000');
+      expect(received.status).toBe(200);
+      expect(received.arrayBuffer().byteLength).toBe(300000);
+    });
+  });
+
+  describe('Compression', () => {
+    it('should decode gzip and deflate responses', async () => {
+      const gzipped = await request.get('https://httpbin.org/gzip');
+      expect(gzipped.status).toBe(200);
+      expect(gzipped.json<{ gzipped: boolean }>().gzipped).toBe(true);
+
+      const deflated = await request.get('https://httpbin.org/deflate');
+      expect(deflated.status).toBe(200);
+      expect(deflated.json<{ deflated: boolean }>().deflated).toBe(true);
+    });
+
+    it('should decode a streamed response', async () => {
+      const chunks: Uint8Array[] = [];
+      await request.stream('GET', 'https://httpbin.org/gzip', {
+        onChunk: (chunk) => {
+          chunks.push(new Uint8Array(chunk));
+        },
+      });
+      // Decoded JSON, not the gzip magic bytes (1f 8b)
+      expect(chunks.length).toBeGreaterThan(0);
+      expect(chunks[0]![0]).toBe('{'.charCodeAt(0));
+    });
+
+    it('should gzip the request body', async () => {
+      const res = await request.post('https://httpbin.org/anything', {
+        body: 'x'.repeat(10000),
+        bodyEncoding: 'gzip',
+      });
+      expect(res.status).toBe(200);
+      const echoed = res.json<{ headers: Record<string, string> }>();
+      expect(echoed.headers['Content-Encoding']).toBe('gzip');
+      expect(Number(echoed.headers['Content-Length'])).toBeLessThan(10000);
+    });
+  });
+
   describe('PUT requests', () => {
     it('should make PUT request', async () => {
       const res = await request.put('https://httpbin.org/put', {
@@ -136,6 +200,52 @@ describe('HTTP Request', () => {
     });
   });
 
+  describe('Streaming', () => {
+    it('should deliver the body in chunks', async () => {
+      let total = 0;
+      let chunks = 0;
+      const res = await request.stream(
+        'GET',
+        'https://httpbin.org/stream-bytes/200000?chunk_size=8192',
+        {
+          highWaterMark: 16 * 1024,
+          onChunk: async (chunk) => {
+            chunks++;
+            total += chunk.byteLength;
+            await new Promise((resolve) => setTimeout(resolve, 1));
+          },
+        }
+      );
+
+      expect(res.status).toBe(200);
+      expect(res.arrayBuffer().byteLength).toBe(0);
+      expect(total).toBe(200000);
+      expect(chunks).toBeGreaterThan(1);
+    });
+
+    it('should write the body to a file handle', async () => {
+      const path = `${tempDir}/rn-io-stream-sink.bin`;
+      const file = new File(path);
+      const handle = openFS().open(path, FileOpenMode.Write);
+      try {
+        const res = await request.stream(
+          'GET',
+          'https://httpbin.org/bytes/50000',
+          { sink: handle }
+        );
+        handle.close();
+
+        expect(res.status).toBe(200);
+        expect((await file.readBytes()).byteLength).toBe(50000);
+      } finally {
+        handle.close();
+        try {
+          await file.delete();
+        } catch {}
+      }
+    });
+  });
+
   describe('Download', () => {
     it('should download a file', async () => {
       const downloadPath = `${tempDir}/rn-io-download-test.json`;
@@ -160,23 +270,60 @@ describe('HTTP Request', () => {
       }
     });
 
+    it('should download a file in parallel segments', async () => {
+      const downloadPath = `${tempDir}/rn-io-download-segments.bin`;
+      const file = new File(downloadPath);
+
+      try {
+        const result = await request.download(
+          'https://httpbin.org/range/102400',
+          downloadPath,
+          { segments: 3 }
+        );
+
+        if (result.ok) {
+          expect(result.fileSize).toBe(102400);
+          expect(await file.size()).toBe(102400);
+          // httpbin's range payload is the alphabet repeated
+          const bytes = new Uint8Array(await file.readBytes());
+          expect(bytes[0]).toBe(97);
+          expect(bytes[102399]).toBe(97 + (102399 % 26));
+          expect(await new File(`${downloadPath}.rnio-segments`).exists()).toBe(
+            false
+          );
+        }
+      } finally {
+        try {
+          await file.delete();
+        } catch {}
+      }
+    });
+
     it('should report download progress', async () => {
       const downloadPath = `${tempDir}/rn-io-download-progress.txt`;
       const file = new File(downloadPath);
 
       try {
+        const events: DownloadProgress[] = [];
         const result = await request.download(
           'https://httpbin.org/bytes/1024',
           downloadPath,
-          {
-            onProgress: (progress) => {
-              expect(progress.bytesReceived).toBeGreaterThanOrEqual(0);
-            },
-          }
+          { onProgress: (progress) => events.push(progress) }
         );
 
         // Just check result structure
         expect(typeof result.ok).toBe('boolean');
+        if (result.ok && events.length > 0) {
+          // Rate-limited but complete: ordered, final event before the result
+          for (let i = 1; i < events.length; i++) {
+            expect(events[i]!.bytesReceived).toBeGreaterThanOrEqual(
+              events[i - 1]!.bytesReceived
+            );
+          }
+          const last = events[events.length - 1]!;
+          expect(last.bytesReceived).toBe(result.fileSize);
+          expect(last.bytesPerSecond).toBeGreaterThanOrEqual(0);
+        }
       } finally {
         try {
           await file.delete();
@@ -185,6 +332,73 @@ describe('HTTP Request', () => {
     });
   });
 
+  describe('Upload', () => {
+    it('should send headers and form fields with the file', async () => {
+      const uploadPath = `${tempDir}/rn-io-upload-test.txt`;
+      const file = new File(uploadPath);
+      await file.writeString('upload body');
+
+      try {
+        const result = await request.upload(
+          'https://httpbin.org/post',
+          uploadPath,
+          {
+            headers: { 'X-Test-Header': 'upload' },
+            formFields: { description: 'My file' },
+          }
+        );
+
+        // Upload may fail due to network issues
+        if (result.ok && result.status === 200) {
+          const echo = JSON.parse(result.responseText);
+          expect(echo.form.description).toBe('My file');
+          expect(echo.headers['X-Test-Header']).toBe('upload');
+          expect(echo.files.file).toBe('upload body');
+        }
+      } finally {
+        try {
+          await file.delete();
+        } catch {}
+      }
+    });
+  });
+
+  describe('Multipart upload', () => {
+    it('should stream several files and report progress', async () => {
+      const firstPath = `${tempDir}/rn-io-upload-a.bin`;
+      const secondPath = `${tempDir}/rn-io-upload-b.txt`;
+      const first = new File(firstPath);
+      const second = new File(secondPath);
+      await first.writeBytes(new Uint8Array(512 * 1024).fill(0x61).buffer);
+      await second.writeString('second part');
+
+      try {
+        let lastSent = 0;
+        let lastTotal = 0;
+        const result = await request.upload('https://httpbin.org/post', firstPath, {
+          files: [{ path: secondPath, fieldName: 'extra', mimeType: 'text/plain' }],
+          onProgress: ({ bytesSent, totalBytes }) => {
+            expect(bytesSent).toBeGreaterThanOrEqual(lastSent);
+            lastSent = bytesSent;
+            lastTotal = totalBytes;
+          },
+        });
+
+        expect(result.ok).toBe(true);
+        const echo = JSON.parse(result.responseText);
+        expect(echo.files.file.length).toBe(512 * 1024);
+        expect(echo.files.extra).toBe('second part');
+        expect(lastTotal).toBeGreaterThan(512 * 1024);
+        expect(lastSent).toBe(lastTotal);
+      } finally {
+        try {
+          await first.delete();
+          await second.delete();
+        } catch {}
+      }
+    });
+  });
+
   describe('Timeout', () => {
     it('should respect timeout setting', async () => {
       // This endpoint delays response by 5 seconds
@@ -197,4 +411,75 @@ describe('HTTP Request', () => {
       expect(res.ok).toBe(false);
     });
   });
+
+  describe('Cache', () => {
+    it('should answer fresh responses from the cache', async () => {
+      configureNetwork({ cacheSize: 1024 * 1024 });
+      try {
+        // A new UUID per network response, cacheable for 60 seconds
+        const url = 'https://httpbin.org/cache/60';
+        const first = await request.get(url);
+        expect(first.status).toBe(200);
+
+        const second = await request.get(url);
+        expect(second.status).toBe(200);
+        expect(second.text()).toBe(first.text());
+
+        const bypass = await request.get(url, {
+          headers: { 'Cache-Control': 'no-store' },
+        });
+        expect(bypass.status).toBe(200);
+      } finally {
+        configureNetwork({ cacheSize: 0 });
+      }
+    });
+
+    it('should revalidate with the stored ETag', async () => {
+      configureNetwork({ cacheSize: 1024 * 1024 });
+      try {
+        const url = 'https://httpbin.org/etag/rnio-test';
+        const first = await request.get(url);
+        const second = await request.get(url);
+        // The server answers 304; the cache returns the stored 200
+        expect(second.status).toBe(200);
+        expect(second.text()).toBe(first.text());
+      } finally {
+        configureNetwork({ cacheSize: 0 });
+      }
+    });
+  });
+
+  describe('Scheduling', () => {
+    it('should start a high-priority request ahead of queued ones', async () => {
+      configureNetwork({ maxPerHost: 1 });
+      try {
+        const order: string[] = [];
+        const track = (name: string, p: Promise<unknown>) =>
+          p.then(() => {
+            order.push(name);
+          });
+
+        // The first takes the only slot, the others queue behind it
+        const low = [1, 2, 3].map((i) =>
+          track(
+            `low${i}`,
+            request.get('https://httpbin.org/delay/1', {
+              priority: TaskPriority.Low,
+            })
+          )
+        );
+        const high = track(
+          'high',
+          request.get('https://httpbin.org/get', {
+            priority: TaskPriority.High,
+          })
+        );
+        await Promise.all([...low, high]);
+
+        expect(order.indexOf('high')).toBeLessThan(2);
+      } finally {
+        configureNetwork({ maxPerHost: 0 });
+      }
+    });
+  });
 });
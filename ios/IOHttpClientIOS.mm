@@ -2,7 +2,9 @@
  * @file IOHttpClientIOS.mm
  * @brief iOS platform HTTP client implementation
  *
- * Uses NSURLSession for HTTP requests
+ * Uses NSURLSession for HTTP requests. All clients share one session, so
+ * connections (and HTTP/2 streams) are reused across requests; each task
+ * gets its own delegate (NSURLSessionTask.delegate, iOS 15+).
  *
  * Copyright (c) 2025 arcticfox
  */
@@ -10,20 +12,30 @@
 #if defined(__APPLE__)
 
 #include "IOHttpClientIOS.hpp"
+#include "IOUpload.hpp"
 #import <Foundation/Foundation.h>
 #include <dispatch/dispatch.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 // ============================================================================
 // Sync Request Delegate
 // ============================================================================
 
+/// Buffered bytes of a streamed response at which the task is suspended
+/// until the consumer has caught up
+static constexpr NSUInteger kStreamHighWaterMark = 1024 * 1024;
+
 @interface IOSyncRequestDelegate : NSObject <NSURLSessionDataDelegate>
 @property (nonatomic, strong) NSMutableData* receivedData;
+@property (nonatomic, assign) BOOL streaming;  // Signal per chunk; suspend when buffered
+@property (nonatomic, assign) BOOL paused;
 @property (nonatomic, strong) NSHTTPURLResponse* response;
 @property (nonatomic, strong) NSError* error;
 @property (nonatomic, assign) BOOL completed;
 @property (nonatomic, strong) dispatch_semaphore_t semaphore;
 @property (nonatomic, copy) void (^progressCallback)(int64_t, int64_t);
+@property (nonatomic, copy) void (^sendProgressCallback)(int64_t, int64_t);
 @end
 
 @implementation IOSyncRequestDelegate
@@ -50,6 +62,19 @@ didReceiveResponse:(NSURLResponse *)response
 - (void)URLSession:(NSURLSession *)session
           dataTask:(NSURLSessionDataTask *)dataTask
     didReceiveData:(NSData *)data {
+    if (self.streaming) {
+        // Hand over to the waiting request thread (see streamTask)
+        @synchronized (self) {
+            [self.receivedData appendData:data];
+            if (!self.paused && self.receivedData.length >= kStreamHighWaterMark) {
+                self.paused = YES;
+                [dataTask suspend];
+            }
+        }
+        dispatch_semaphore_signal(self.semaphore);
+        return;
+    }
+
     [self.receivedData appendData:data];
 
     if (self.progressCallback) {
@@ -62,8 +87,10 @@ didReceiveResponse:(NSURLResponse *)response
 - (void)URLSession:(NSURLSession *)session
               task:(NSURLSessionTask *)task
 didCompleteWithError:(NSError *)error {
-    self.error = error;
-    self.completed = YES;
+    @synchronized (self) {
+        self.error = error;
+        self.completed = YES;
+    }
     dispatch_semaphore_signal(self.semaphore);
 }
 
@@ -72,8 +99,8 @@ didCompleteWithError:(NSError *)error {
    didSendBodyData:(int64_t)bytesSent
     totalBytesSent:(int64_t)totalBytesSent
 totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend {
-    if (self.progressCallback) {
-        self.progressCallback(totalBytesSent, totalBytesExpectedToSend);
+    if (self.sendProgressCallback) {
+        self.sendProgressCallback(totalBytesSent, totalBytesExpectedToSend);
     }
 }
 
@@ -165,25 +192,27 @@ didCompleteWithError:(NSError *)error {
 
 namespace rct_io::network {
 
-IOHttpClientIOS::IOHttpClientIOS() {
-    @autoreleasepool {
-        NSURLSessionConfiguration* config = [NSURLSessionConfiguration defaultSessionConfiguration];
-        config.timeoutIntervalForRequest = 30.0;
-        config.timeoutIntervalForResource = 60.0;
-
-        delegateQueue_ = [[NSOperationQueue alloc] init];
-        delegateQueue_.maxConcurrentOperationCount = 4;
+/// Connections NSURLSession may open per host; the request scheduler
+/// applies the configured per-host limit before a task is created
+static constexpr NSInteger kMaxConnectionsPerHost = 16;
 
-        session_ = [NSURLSession sessionWithConfiguration:config
-                                                 delegate:nil
-                                            delegateQueue:delegateQueue_];
-    }
-}
-
-IOHttpClientIOS::~IOHttpClientIOS() {
-    @autoreleasepool {
-        [session_ invalidateAndCancel];
-    }
+NSURLSession* IOHttpClientIOS::sharedSession() {
+    static NSURLSession* session = nil;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        NSURLSessionConfiguration* config = [NSURLSessionConfiguration defaultSessionConfiguration];
+        config.HTTPMaximumConnectionsPerHost = kMaxConnectionsPerHost;
+
+        // Serial, so each task's delegate sees its callbacks in order
+        NSOperationQueue* delegateQueue = [[NSOperationQueue alloc] init];
+        delegateQueue.maxConcurrentOperationCount = 1;
+        delegateQueue.name = @"rct_io.http";
+
+        session = [NSURLSession sessionWithConfiguration:config
+                                                delegate:nil
+                                           delegateQueue:delegateQueue];
+    });
+    return session;
 }
 
 NSMutableURLRequest* IOHttpClientIOS::createRequest(const HttpRequestConfig& config) {
@@ -203,7 +232,7 @@ NSMutableURLRequest* IOHttpClientIOS::createRequest(const HttpRequestConfig& con
         }
 
         if (config.hasBody()) {
-            auto bodyBytes = config.getBodyBytes();
+            auto bodyBytes = config.bodyBytes();
             request.HTTPBody = [NSData dataWithBytes:bodyBytes.data() length:bodyBytes.size()];
         }
 
@@ -229,6 +258,14 @@ HttpResponse IOHttpClientIOS::convertResponse(NSHTTPURLResponse* response, NSDat
             NSString* value = headers[key];
             result.headers[[key UTF8String]] = [value UTF8String];
         }
+
+        // NSURLSession negotiates and decodes gzip, deflate and br itself; the
+        // headers should describe the decoded body that is handed on
+        auto encoding = findHeader(result.headers, "Content-Encoding");
+        if (encoding && (*encoding == "gzip" || *encoding == "deflate" || *encoding == "br")) {
+            eraseHeader(result.headers, "Content-Encoding");
+            eraseHeader(result.headers, "Content-Length");
+        }
     }
 
     if (data && [data length] > 0) {
@@ -240,6 +277,78 @@ HttpResponse IOHttpClientIOS::convertResponse(NSHTTPURLResponse* response, NSDat
     return result;
 }
 
+// ============================================================================
+// Task Wait
+// ============================================================================
+
+/**
+ * Block until the delegate signals completion. With a cancel check the wait
+ * wakes up every 100 ms and cancels the task once the check returns true;
+ * the delegate then completes with NSURLErrorCancelled.
+ */
+static void waitForTask(dispatch_semaphore_t semaphore, NSURLSessionTask* task,
+                        const TransferCancelCheck& isCancelled) {
+    if (!isCancelled) {
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+        return;
+    }
+    while (dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, 100 * NSEC_PER_MSEC)) != 0) {
+        if (isCancelled()) {
+            [task cancel];
+            dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+            return;
+        }
+    }
+}
+
+/**
+ * Deliver a streamed response to config.onBodyChunk on the calling thread.
+ *
+ * The delegate buffers what arrives and suspends the task once the buffer
+ * passes kStreamHighWaterMark; this loop drains the buffer into the
+ * callback (which may block) and resumes the task afterwards, so a slow
+ * consumer throttles the transfer instead of growing the buffer. The
+ * shared session's delegate queue is never blocked.
+ */
+static void streamTask(IOSyncRequestDelegate* delegate, NSURLSessionDataTask* task,
+                       const HttpRequestConfig& config) {
+    bool aborted = false;
+    while (true) {
+        dispatch_semaphore_wait(delegate.semaphore, dispatch_time(DISPATCH_TIME_NOW, 100 * NSEC_PER_MSEC));
+
+        NSData* chunk = nil;
+        BOOL completed = NO;
+        @synchronized (delegate) {
+            completed = delegate.completed;
+            if (delegate.receivedData.length > 0) {
+                chunk = delegate.receivedData;
+                delegate.receivedData = [NSMutableData data];
+            }
+        }
+
+        if (chunk && !aborted) {
+            const auto* bytes = static_cast<const uint8_t*>(chunk.bytes);
+            if (!config.onBodyChunk(std::vector<uint8_t>(bytes, bytes + chunk.length))) {
+                aborted = true;
+                [task cancel];
+            }
+        }
+        if (!aborted && config.isCancelled && config.isCancelled()) {
+            aborted = true;
+            [task cancel];
+        }
+        if (completed) {
+            return;
+        }
+        @synchronized (delegate) {
+            if (delegate.paused && !aborted) {
+                delegate.paused = NO;
+                [task resume];
+            }
+        }
+    }
+}
+
 // ============================================================================
 // HTTP Request
 // ============================================================================
@@ -254,20 +363,18 @@ HttpResponse IOHttpClientIOS::request(const HttpRequestConfig& config) {
         }
 
         IOSyncRequestDelegate* delegate = [[IOSyncRequestDelegate alloc] init];
+        delegate.streaming = config.onBodyChunk != nullptr;
 
-        NSURLSessionConfiguration* sessionConfig = [NSURLSessionConfiguration defaultSessionConfiguration];
-        sessionConfig.timeoutIntervalForRequest = config.timeoutMs / 1000.0;
-
-        NSURLSession* session = [NSURLSession sessionWithConfiguration:sessionConfig
-                                                              delegate:delegate
-                                                         delegateQueue:nil];
-
-        NSURLSessionDataTask* task = [session dataTaskWithRequest:request];
+        NSURLSessionDataTask* task = [sharedSession() dataTaskWithRequest:request];
+        task.delegate = delegate;
         [task resume];
 
-        dispatch_semaphore_wait(delegate.semaphore, DISPATCH_TIME_FOREVER);
+        if (delegate.streaming) {
+            streamTask(delegate, task, config);
+            return convertResponse(delegate.response, nil, delegate.error);
+        }
 
-        [session invalidateAndCancel];
+        waitForTask(delegate.semaphore, task, config.isCancelled);
 
         return convertResponse(delegate.response, delegate.receivedData, delegate.error);
     }
@@ -320,17 +427,11 @@ DownloadResult IOHttpClientIOS::download(const DownloadConfig& config,
             };
         }
 
-        NSURLSessionConfiguration* sessionConfig = [NSURLSessionConfiguration defaultSessionConfiguration];
-        NSURLSession* downloadSession = [NSURLSession sessionWithConfiguration:sessionConfig
-                                                                      delegate:delegate
-                                                                 delegateQueue:nil];
-
-        NSURLSessionDownloadTask* task = [downloadSession downloadTaskWithRequest:request];
+        NSURLSessionDownloadTask* task = [sharedSession() downloadTaskWithRequest:request];
+        task.delegate = delegate;
         [task resume];
 
-        dispatch_semaphore_wait(delegate.semaphore, DISPATCH_TIME_FOREVER);
-
-        [downloadSession invalidateAndCancel];
+        waitForTask(delegate.semaphore, task, config.isCancelled);
 
         result.success = delegate.success;
         result.statusCode = static_cast<int32_t>([delegate statusCode]);
@@ -349,77 +450,68 @@ DownloadResult IOHttpClientIOS::download(const DownloadConfig& config,
 // File Upload
 // ============================================================================
 
-NSData* IOHttpClientIOS::createMultipartBody(const UploadConfig& config, NSString** boundary) {
+NSURL* IOHttpClientIOS::spoolMultipartBody(const UploadConfig& config, std::string& contentType,
+                                           std::string& error) {
     @autoreleasepool {
-        *boundary = [NSString stringWithFormat:@"----IOHttpClientBoundary%lld",
-                     (long long)[[NSDate date] timeIntervalSince1970] * 1000];
-
-        NSMutableData* body = [NSMutableData data];
-
-        for (const auto& [key, value] : config.formFields) {
-            [body appendData:[[NSString stringWithFormat:@"--%@\r\n", *boundary]
-                             dataUsingEncoding:NSUTF8StringEncoding]];
-            [body appendData:[[NSString stringWithFormat:@"Content-Disposition: form-data; name=\"%s\"\r\n\r\n",
-                              key.c_str()] dataUsingEncoding:NSUTF8StringEncoding]];
-            [body appendData:[[NSString stringWithFormat:@"%s\r\n", value.c_str()]
-                             dataUsingEncoding:NSUTF8StringEncoding]];
-        }
-
-        NSString* filePath = [NSString stringWithUTF8String:config.filePath.c_str()];
-        NSData* fileData = [NSData dataWithContentsOfFile:filePath];
-
-        if (!fileData) {
+        NSString* name = [NSString stringWithFormat:@"rnio-upload-%@", [[NSUUID UUID] UUIDString]];
+        NSURL* spool = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:name]];
+        int fd = -1;
+        try {
+            MultipartBody body(config);
+            contentType = body.contentType();
+            fd = ::open(spool.path.UTF8String, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+            if (fd < 0) {
+                throw std::runtime_error(std::string("Failed to create upload spool: ") + std::strerror(errno));
+            }
+            std::vector<uint8_t> block(kUploadBlockSize);
+            while (auto count = body.read(block.data(), block.size())) {
+                if (config.isCancelled && config.isCancelled()) {
+                    throw std::runtime_error("Upload cancelled");
+                }
+                for (size_t written = 0; written < count;) {
+                    auto n = ::write(fd, block.data() + written, count - written);
+                    if (n < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    if (n < 0) {
+                        throw std::runtime_error(std::string("Failed to write upload spool: ") + std::strerror(errno));
+                    }
+                    written += static_cast<size_t>(n);
+                }
+            }
+            ::close(fd);
+            return spool;
+        } catch (const std::exception& e) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            [[NSFileManager defaultManager] removeItemAtURL:spool error:nil];
+            error = e.what();
             return nil;
         }
-
-        NSString* fileName = config.fileName.empty() ?
-            [filePath lastPathComponent] :
-            [NSString stringWithUTF8String:config.fileName.c_str()];
-
-        NSString* mimeType = config.mimeType.empty() ?
-            @"application/octet-stream" :
-            [NSString stringWithUTF8String:config.mimeType.c_str()];
-
-        NSString* fieldName = [NSString stringWithUTF8String:config.fieldName.c_str()];
-
-        [body appendData:[[NSString stringWithFormat:@"--%@\r\n", *boundary]
-                         dataUsingEncoding:NSUTF8StringEncoding]];
-        [body appendData:[[NSString stringWithFormat:@"Content-Disposition: form-data; name=\"%@\"; filename=\"%@\"\r\n",
-                          fieldName, fileName] dataUsingEncoding:NSUTF8StringEncoding]];
-        [body appendData:[[NSString stringWithFormat:@"Content-Type: %@\r\n\r\n", mimeType]
-                         dataUsingEncoding:NSUTF8StringEncoding]];
-        [body appendData:fileData];
-        [body appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
-
-        [body appendData:[[NSString stringWithFormat:@"--%@--\r\n", *boundary]
-                         dataUsingEncoding:NSUTF8StringEncoding]];
-
-        return body;
     }
 }
 
 UploadResult IOHttpClientIOS::upload(const UploadConfig& config,
                                       UploadProgressCallback progressCallback) {
+    if (config.resumable) {
+        return uploadResumable(*this, config, progressCallback);
+    }
+
     @autoreleasepool {
         UploadResult result;
 
-        NSFileManager* fileManager = [NSFileManager defaultManager];
-        NSString* filePath = [NSString stringWithUTF8String:config.filePath.c_str()];
-        if (![fileManager fileExistsAtPath:filePath]) {
-            result.errorMessage = "File not found: " + config.filePath;
-            return result;
-        }
-
         NSURL* url = [NSURL URLWithString:[NSString stringWithUTF8String:config.url.c_str()]];
         if (!url) {
             result.errorMessage = "Invalid URL: " + config.url;
             return result;
         }
 
-        NSString* boundary = nil;
-        NSData* body = createMultipartBody(config, &boundary);
-        if (!body) {
-            result.errorMessage = "Failed to read file: " + config.filePath;
+        // The body is written out in fixed-size blocks and NSURLSession streams
+        // it from disk, so no file is held in memory
+        std::string contentType;
+        NSURL* spool = spoolMultipartBody(config, contentType, result.errorMessage);
+        if (!spool) {
             return result;
         }
 
@@ -427,20 +519,17 @@ UploadResult IOHttpClientIOS::upload(const UploadConfig& config,
         request.HTTPMethod = @"POST";
         request.timeoutInterval = config.timeoutMs / 1000.0;
 
-        NSString* contentType = [NSString stringWithFormat:@"multipart/form-data; boundary=%@", boundary];
-        [request setValue:contentType forHTTPHeaderField:@"Content-Type"];
+        [request setValue:[NSString stringWithUTF8String:contentType.c_str()] forHTTPHeaderField:@"Content-Type"];
 
         for (const auto& [key, value] : config.headers) {
             [request setValue:[NSString stringWithUTF8String:value.c_str()]
            forHTTPHeaderField:[NSString stringWithUTF8String:key.c_str()]];
         }
 
-        request.HTTPBody = body;
-
         IOSyncRequestDelegate* delegate = [[IOSyncRequestDelegate alloc] init];
 
         if (progressCallback) {
-            delegate.progressCallback = ^(int64_t bytesSent, int64_t totalBytes) {
+            delegate.sendProgressCallback = ^(int64_t bytesSent, int64_t totalBytes) {
                 UploadProgress progress;
                 progress.bytesSent = bytesSent;
                 progress.totalBytes = totalBytes;
@@ -449,26 +538,21 @@ UploadResult IOHttpClientIOS::upload(const UploadConfig& config,
             };
         }
 
-        NSURLSessionConfiguration* sessionConfig = [NSURLSessionConfiguration defaultSessionConfiguration];
-        NSURLSession* uploadSession = [NSURLSession sessionWithConfiguration:sessionConfig
-                                                                    delegate:delegate
-                                                               delegateQueue:nil];
-
-        NSURLSessionDataTask* task = [uploadSession dataTaskWithRequest:request];
+        NSURLSessionUploadTask* task = [sharedSession() uploadTaskWithRequest:request fromFile:spool];
+        task.delegate = delegate;
         [task resume];
 
-        dispatch_semaphore_wait([delegate semaphore], DISPATCH_TIME_FOREVER);
-
-        [uploadSession invalidateAndCancel];
+        waitForTask([delegate semaphore], task, config.isCancelled);
+        [[NSFileManager defaultManager] removeItemAtURL:spool error:nil];
 
         NSError* error = [delegate error];
         if (error) {
             result.success = false;
             result.errorMessage = [[error localizedDescription] UTF8String];
         } else {
-            result.success = true;
             NSHTTPURLResponse* response = [delegate response];
             result.statusCode = static_cast<int32_t>([response statusCode]);
+            result.success = result.statusCode >= 200 && result.statusCode < 300;
 
             NSMutableData* receivedData = [delegate receivedData];
             if ([receivedData length] > 0) {
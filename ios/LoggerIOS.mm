@@ -2,7 +2,8 @@
  * @file LoggerIOS.mm
  * @brief iOS logging implementation
  *
- * Uses NSLog to output logs to Xcode console.
+ * Uses NSLog to output logs to Xcode console, and os_signpost for trace
+ * markers.
  *
  * Copyright (c) 2025 arcticfox
  */
@@ -11,6 +12,8 @@
 
 #include "Logger.h"
 #import <Foundation/Foundation.h>
+#import <os/log.h>
+#import <os/signpost.h>
 
 namespace rct_io {
 
@@ -49,6 +52,26 @@ void Logger::platformLog(LogLevel level, const std::string& tag, const std::stri
     NSLog(@"[%s/%@] %@", levelStr, tagStr, msgStr);
 }
 
+// Intervals show up in Instruments under Points of Interest
+static os_log_t traceLog() {
+    static os_log_t log = os_log_create("react-native-io", "PointsOfInterest");
+    return log;
+}
+
+bool Logger::tracing() {
+    return os_signpost_enabled(traceLog());
+}
+
+void Logger::traceBegin(const char* name, int32_t cookie) {
+    os_signpost_interval_begin(traceLog(), static_cast<os_signpost_id_t>(static_cast<uint32_t>(cookie)),
+                               "IO", "%{public}s", name);
+}
+
+void Logger::traceEnd(const char* name, int32_t cookie) {
+    os_signpost_interval_end(traceLog(), static_cast<os_signpost_id_t>(static_cast<uint32_t>(cookie)),
+                             "IO", "%{public}s", name);
+}
+
 } // namespace rct_io
 
 #endif // __APPLE__
@@ -0,0 +1,136 @@
+/**
+ * @file Benchmark.ts
+ * @description On-device benchmarks of React Native IO
+ *
+ * The fs, list, hash and codec suites run natively (the same runner as
+ * the host executable in cpp/bench); the jsi suite is timed here, since
+ * it measures the cost of crossing into native code from JS.
+ */
+
+import { Platform } from 'react-native';
+import type {
+  BenchmarkReport,
+  BenchmarkResult,
+  BenchmarkSuite,
+  CancelOptions,
+  IOFileSystem,
+} from './types';
+
+/**
+ * Options of FS.runBenchmarks()
+ */
+export interface BenchmarkOptions extends CancelOptions {
+  /** Suites to run (default: all) */
+  suites?: BenchmarkSuite[];
+  /** Small sizes only, for smoke tests (default: false) */
+  quick?: boolean;
+  /** Scratch space; a subdirectory is created and removed (default: FS.cacheDir) */
+  directory?: string;
+}
+
+const ALL_SUITES: BenchmarkSuite[] = ['fs', 'list', 'hash', 'codec', 'jsi'];
+const SAMPLES = 5;
+const MIN_SECONDS = 0.25;
+
+/**
+ * Time op like the native runner does: one warm-up call, then SAMPLES
+ * samples of equal iteration counts taking about MIN_SECONDS in total.
+ */
+async function measure(
+  name: string,
+  unit: 'us' | 'ops/s',
+  opsPerCall: number,
+  op: () => unknown
+): Promise<BenchmarkResult> {
+  let start = performance.now();
+  await op();
+  const once = Math.max(performance.now() - start, 0.0001);
+  const perSample = Math.max(
+    1,
+    Math.min(1e6, Math.floor((MIN_SECONDS * 1000) / SAMPLES / once))
+  );
+
+  const values: number[] = [];
+  for (let sample = 0; sample < SAMPLES; sample++) {
+    start = performance.now();
+    for (let i = 0; i < perSample; i++) {
+      await op();
+    }
+    const ms = Math.max(performance.now() - start, 0.000001);
+    const ops = perSample * opsPerCall;
+    values.push(unit === 'us' ? (ms * 1000) / ops : (ops * 1000) / ms);
+  }
+  values.sort((a, b) => a - b);
+
+  return {
+    suite: 'jsi',
+    name,
+    unit,
+    value: values[Math.floor(SAMPLES / 2)]!,
+    min: values[0]!,
+    max: values[SAMPLES - 1]!,
+    iterations: perSample * SAMPLES * opsPerCall,
+  };
+}
+
+async function runJsiSuite(fs: IOFileSystem): Promise<BenchmarkResult[]> {
+  const payload = 'x'.repeat(1024);
+  const inFlight = 64;
+  const results: BenchmarkResult[] = [];
+  results.push(await measure('syncCall', 'us', 1, () => fs.pingSync()));
+  results.push(
+    await measure('syncCall/1KB', 'us', 1, () => fs.pingSync(payload))
+  );
+  results.push(await measure('asyncCall', 'us', 1, () => fs.ping()));
+  results.push(
+    await measure('asyncCall/1KB', 'us', 1, () => fs.ping(payload))
+  );
+  results.push(
+    await measure(`asyncConcurrent/${inFlight}`, 'ops/s', inFlight, () =>
+      Promise.all(Array.from({ length: inFlight }, () => fs.ping()))
+    )
+  );
+  return results;
+}
+
+/**
+ * Run benchmarks and return a report
+ * @internal Use FS.runBenchmarks()
+ */
+export async function runBenchmarks(
+  fs: IOFileSystem,
+  defaultDirectory: string,
+  options: BenchmarkOptions = {}
+): Promise<BenchmarkReport> {
+  const suites = options.suites ?? ALL_SUITES;
+  const nativeSuites = suites.filter((suite) => suite !== 'jsi');
+  const quick = options.quick ?? false;
+
+  let report: BenchmarkReport = {
+    schema: 1,
+    platform: Platform.OS,
+    arch: 'unknown',
+    quick,
+    results: [],
+  };
+  if (nativeSuites.length > 0) {
+    const json = await fs.runBenchmarks(
+      options.directory ?? defaultDirectory,
+      nativeSuites,
+      quick,
+      options.cancelToken,
+      { timeout: options.timeout }
+    );
+    report = JSON.parse(json) as BenchmarkReport;
+  }
+  if (suites.includes('jsi')) {
+    if (options.cancelToken?.cancelled) {
+      throw Object.assign(new Error('Operation cancelled'), {
+        name: 'CancelledError',
+        code: 'ECANCELED',
+      });
+    }
+    report.results.push(...(await runJsiSuite(fs)));
+  }
+  return report;
+}
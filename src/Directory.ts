@@ -8,11 +8,22 @@
 
 import {
   EntityType,
+  type CancelOptions,
   type DirectoryEntry,
   type FileMetadata,
   type IOFileSystem,
+  type WatchEvent,
 } from './types';
 import { createFileSystem } from './NativeStdIO';
+import {
+  DirectoryIterator,
+  type DirectoryIteratorOptions,
+} from './DirectoryIterator';
+import {
+  DirectoryWatcher,
+  type DirectoryWatcherOptions,
+} from './DirectoryWatcher';
+import { EntryColumns, type ColumnarListOptions } from './EntryColumns';
 
 /**
  * Represents a directory on the filesystem.
@@ -221,10 +232,78 @@ export class Directory {
   /**
    * List directory contents
    * @param recursive List recursively
+   * @param options Cancellation options
    * @returns Array of directory entries
    */
-  list(recursive: boolean = false): Promise<DirectoryEntry[]> {
-    return this.fs().listDirectory(this._path, recursive);
+  list(
+    recursive: boolean = false,
+    options: CancelOptions = {}
+  ): Promise<DirectoryEntry[]> {
+    const { cancelToken, timeout } = options;
+    return this.fs().listDirectory(this._path, recursive, cancelToken, {
+      timeout,
+    });
+  }
+
+  /**
+   * List directory contents as columns
+   *
+   * Returns typed arrays instead of one object per entry, which is much
+   * cheaper for directories with many entries. Names are decoded on demand
+   * with `name(i)`.
+   *
+   * @param options Recursion and which columns to fetch
+   * @returns Columnar listing
+   */
+  async listColumnar(options: ColumnarListOptions = {}): Promise<EntryColumns> {
+    const {
+      recursive = false,
+      withSize = true,
+      withModifiedTime = true,
+      cancelToken,
+      timeout,
+    } = options;
+    const native = await this.fs().listDirectoryColumnar(
+      this._path,
+      recursive,
+      withSize,
+      withModifiedTime,
+      cancelToken,
+      { timeout }
+    );
+    return new EntryColumns(native);
+  }
+
+  /**
+   * Iterate over directory contents in batches
+   *
+   * Prefer this over list() for very large directories: entries are read
+   * and converted a batch at a time, and iteration can stop early.
+   *
+   * @param options Recursion, sizes and batch size
+   * @returns Iterator; close it if you stop before the end
+   */
+  iterate(options: DirectoryIteratorOptions = {}): DirectoryIterator {
+    return new DirectoryIterator(this.fs(), this._path, options);
+  }
+
+  /**
+   * Watch for changes to the directory's entries
+   *
+   * Replaces polling list() or metadata(): the native side sleeps until the
+   * OS reports a change, then delivers batches of merged changes. Keep a
+   * reference to the watcher; it stops when closed or garbage collected.
+   *
+   * @param listener Called with each batch of changes
+   * @param options Recursion and debounce interval
+   * @returns Watcher; close it when done
+   * @throws If the directory does not exist
+   */
+  watch(
+    listener: (events: WatchEvent[]) => void | Promise<void>,
+    options: DirectoryWatcherOptions = {}
+  ): DirectoryWatcher {
+    return new DirectoryWatcher(this.fs(), this._path, listener, options);
   }
 
   /**
@@ -262,8 +341,13 @@ export class Directory {
   /**
    * Check if directory is empty
    */
-  isEmpty(): Promise<boolean> {
-    return this.list().then((entries) => entries.length === 0);
+  async isEmpty(): Promise<boolean> {
+    const iterator = this.iterate();
+    try {
+      return (await iterator.next(1)).length === 0;
+    } finally {
+      iterator.close();
+    }
   }
 
   /**
@@ -0,0 +1,122 @@
+/**
+ * @file DirectoryIterator.ts
+ * @description Cursor-based directory listing
+ *
+ * Reads a directory in batches so very large directories can be listed
+ * without building the whole listing in memory, and abandoned early.
+ */
+
+import type {
+  DirectoryIteratorEntry,
+  DirectoryIteratorId,
+  IOFileSystem,
+} from './types';
+
+/**
+ * Options for Directory.iterate()
+ */
+export interface DirectoryIteratorOptions {
+  /** Descend into subdirectories (default: false) */
+  recursive?: boolean;
+  /** Fetch file sizes, one stat per file (default: false) */
+  withSize?: boolean;
+  /** Entries per batch for async iteration (default: 1000) */
+  batchSize?: number;
+}
+
+/**
+ * Cursor over the entries of a directory.
+ *
+ * Entry types come from the directory listing itself, so no per-entry stat
+ * is needed unless sizes are requested. The iterator closes itself once the
+ * listing is exhausted; call close() to stop early.
+ *
+ * @example
+ * ```typescript
+ * const iterator = fs.directory(cacheDir).iterate({ batchSize: 500 });
+ * for await (const batch of iterator) {
+ *   for (const entry of batch) {
+ *     if (entry.name.endsWith('.tmp')) { ... }
+ *   }
+ * }
+ * ```
+ */
+export class DirectoryIterator
+  implements AsyncIterable<DirectoryIteratorEntry[]>
+{
+  private _fs: IOFileSystem;
+  private _iterator: DirectoryIteratorId;
+  private _withSize: boolean;
+  private _batchSize: number;
+  private _closed: boolean = false;
+
+  /**
+   * @internal
+   * Use Directory.iterate() to create a DirectoryIterator.
+   */
+  constructor(
+    fs: IOFileSystem,
+    path: string,
+    options: DirectoryIteratorOptions = {}
+  ) {
+    const { recursive = false, withSize = false, batchSize = 1000 } = options;
+    this._fs = fs;
+    this._withSize = withSize;
+    this._batchSize = batchSize;
+    this._iterator = fs.openDirectoryIterator(path, recursive);
+  }
+
+  /**
+   * Read the next batch of entries.
+   *
+   * @param count Maximum number of entries (default: batchSize option)
+   * @returns Entries, empty array once the listing is exhausted
+   */
+  async next(
+    count: number = this._batchSize
+  ): Promise<DirectoryIteratorEntry[]> {
+    if (this._closed) {
+      return [];
+    }
+    const entries = await this._fs.readDirectoryBatch(
+      this._iterator,
+      count,
+      this._withSize
+    );
+    if (entries.length === 0) {
+      this.close();
+    }
+    return entries;
+  }
+
+  /**
+   * Release the native iterator. Safe to call more than once.
+   */
+  close(): void {
+    if (!this._closed) {
+      this._fs.closeDirectoryIterator(this._iterator);
+      this._closed = true;
+    }
+  }
+
+  /**
+   * Check if the iterator is closed.
+   */
+  get isClosed(): boolean {
+    return this._closed;
+  }
+
+  async *[Symbol.asyncIterator](): AsyncIterator<DirectoryIteratorEntry[]> {
+    try {
+      for (
+        let batch = await this.next();
+        batch.length > 0;
+        batch = await this.next()
+      ) {
+        yield batch;
+      }
+    } finally {
+      this.close();
+    }
+  }
+}
@@ -0,0 +1,96 @@
+/**
+ * @file DirectoryWatcher.ts
+ * @description Change notifications for a directory
+ *
+ * Backed by inotify on Android and kqueue on iOS, so nothing is polled:
+ * the native watcher sleeps until the kernel reports a change.
+ */
+
+import type { IOFileSystem, WatcherId, WatchEvent } from './types';
+
+/**
+ * Options for Directory.watch()
+ */
+export interface DirectoryWatcherOptions {
+  /** Watch subdirectories too, including ones created later (default: false) */
+  recursive?: boolean;
+  /**
+   * Quiet time in milliseconds before changes are delivered (default: 100,
+   * capped at one hour; must be a non-negative finite number).
+   * Changes that keep coming are still delivered at least every
+   * `max(10 * debounceMs, 1000)` ms.
+   */
+  debounceMs?: number;
+}
+
+/**
+ * Watches a directory until closed.
+ *
+ * Changes are collected natively, merged per path, and handed to the
+ * listener in batches once the directory has been quiet for `debounceMs`.
+ * A batch is delivered only after the listener has handled the previous
+ * one (an async listener counts as handled when its Promise settles);
+ * changes made meanwhile go into the next batch.
+ *
+ * @example
+ * ```typescript
+ * const watcher = fs.directory(inboxDir).watch((events) => {
+ *   for (const { type, path } of events) {
+ *     if (type === 'created') importFile(path);
+ *     if (type === 'overflow') rescanInbox();
+ *   }
+ * });
+ * // later
+ * watcher.close();
+ * ```
+ */
+export class DirectoryWatcher {
+  private _fs: IOFileSystem;
+  private _watcher: WatcherId;
+  private _path: string;
+  private _closed: boolean = false;
+
+  /**
+   * @internal
+   * Use Directory.watch() to create a DirectoryWatcher.
+   */
+  constructor(
+    fs: IOFileSystem,
+    path: string,
+    listener: (events: WatchEvent[]) => void | Promise<void>,
+    options: DirectoryWatcherOptions = {}
+  ) {
+    const { recursive = false, debounceMs = 100 } = options;
+    this._fs = fs;
+    this._path = path;
+    this._watcher = fs.watch(path, recursive, debounceMs, (events) => {
+      if (!this._closed) {
+        return listener(events);
+      }
+      return undefined;
+    });
+  }
+
+  /** Watched directory */
+  get path(): string {
+    return this._path;
+  }
+
+  /**
+   * Stop watching. Changes not delivered yet are dropped.
+   * Safe to call more than once.
+   */
+  close(): void {
+    if (!this._closed) {
+      this._fs.unwatch(this._watcher);
+      this._closed = true;
+    }
+  }
+
+  /**
+   * Check if the watcher is closed.
+   */
+  get isClosed(): boolean {
+    return this._closed;
+  }
+}
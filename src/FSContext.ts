@@ -3,15 +3,119 @@
  * @description File system context for React Native IO
  *
  * Provides a shared context for File and Directory operations,
- * allowing multiple operations to share a single thread pool.
+ * allowing multiple operations to share a single native client.
  */
 
 import { File } from './File';
 import { Directory } from './Directory';
 import { FileHandle } from './FileHandle';
+import { EntryColumns } from './EntryColumns';
 import { createFileSystem } from './NativeStdIO';
-import type { IOFileSystem } from './types';
-import { FileOpenMode } from './types';
+import type {
+  BatchOperation,
+  BatchResult,
+  CancelOptions,
+  CancelToken,
+  IOFileSystem,
+  LineOutput,
+  LineStage,
+  PipeLinesOptions,
+  PipeLinesResult,
+  PipeOptions,
+  PipeResult,
+  TaskPriority,
+} from './types';
+import { FileOpenMode, MapAdvice } from './types';
+
+/** Native spec of a record stage, see IORecordPipeline.hpp */
+function lineStageSpec(stage: LineStage): string[] {
+  switch (stage.kind) {
+    case 'filter': {
+      const modes = ['contains', 'prefix', 'suffix', 'equals'] as const;
+      const mode = modes.find((m) => stage[m] !== undefined);
+      if (!mode) {
+        throw new Error('pipeLines: filter stage without a pattern');
+      }
+      return [
+        'filter',
+        mode,
+        stage[mode]!,
+        String(stage.field ?? -1),
+        stage.invert ? '1' : '0',
+      ];
+    }
+    case 'split':
+      return ['split', stage.delimiter ?? ',', stage.csv ? '1' : '0'];
+    case 'json':
+      return ['json', ...stage.fields];
+    case 'select':
+      return ['select', ...stage.fields.map(String)];
+    case 'skip':
+    case 'limit':
+      return [stage.kind, String(stage.count)];
+  }
+}
+
+/** Native spec of a record output */
+function lineOutputSpec(output: LineOutput): string[] {
+  switch (output.kind) {
+    case 'lines':
+      return ['lines', output.separator ?? ','];
+    case 'countBy':
+      return ['countBy', String(output.field ?? -1)];
+    case 'file':
+      return [
+        'file',
+        output.path,
+        output.append ? '1' : '0',
+        output.separator ?? ',',
+      ];
+    default:
+      return [output.kind];
+  }
+}
+
+/**
+ * Options for FSContext.mmap()
+ */
+export interface MapOptions {
+  /** Start offset in bytes (default: 0) */
+  offset?: number;
+  /** Number of bytes to map (default: rest of the file) */
+  length?: number;
+  /** Map writable and shared with the file (default: false) */
+  writable?: boolean;
+}
+
+/**
+ * Options for FSContext.batch()
+ */
+export interface BatchOptions {
+  /** Run all operations one after another in array order (default: false) */
+  ordered?: boolean;
+  /** Scheduling priority of every operation (default: Normal) */
+  priority?: TaskPriority | number;
+}
+
+/**
+ * One file of FSContext.writeFiles()
+ */
+export interface FileWrite {
+  /** File path */
+  path: string;
+  /** UTF-8 text or binary data (binary data is read in place) */
+  content: string | ArrayBuffer;
+}
+
+/**
+ * Options for FSContext.writeFiles()
+ */
+export interface WriteFilesOptions {
+  /** Create parent directories if needed (default: false) */
+  createParents?: boolean;
+  /** Scheduling priority (default: Normal) */
+  priority?: TaskPriority | number;
+}
 
 /**
  * File system context for batch file operations.
@@ -48,8 +152,8 @@ import { FileOpenMode } from './types';
  *
  * @example
  * ```typescript
- * // With custom thread pool size for heavy parallel operations
- * const fs = openFS(4); // 4 worker threads
+ * // Parallel operations run on the shared executor
+ * const fs = openFS();
  *
  * const files = paths.map(p => fs.file(p));
  * const contents = await Promise.all(files.map(f => f.readString()));
@@ -59,13 +163,11 @@ export class FSContext {
   private _fs: IOFileSystem | null;
 
   /**
-   * Create a FSContext with a shared thread pool.
+   * Create a FSContext.
    * Prefer using `openFS()` function instead of direct constructor.
    *
-   * @param numThreads Number of worker threads for async operations.
-   *   - Default: 1 (single-threaded pool)
-   *   - A single thread is sufficient for most use cases
-   *   - Increase for better parallelism in concurrent file operations
+   * @param numThreads Ignored. Async operations of all contexts run on the
+   *   shared native executor; use `configureExecutor()` to size it.
    */
   constructor(numThreads?: number) {
     this._fs = createFileSystem(numThreads);
@@ -129,6 +231,295 @@ export class FSContext {
     return new FileHandle(this.fs, path, mode);
   }
 
+  /**
+   * Allocate a zero-filled ArrayBuffer backed by native memory.
+   *
+   * Async writes (`writeBytes`, `FileHandle.write`) read their buffer in place
+   * on the worker thread, so a natively allocated buffer can be filled once
+   * and written without any copy. Do not modify a buffer while a write using
+   * it is still pending.
+   *
+   * @param size Size in bytes
+   * @returns Native-backed ArrayBuffer
+   */
+  allocateBuffer(size: number): ArrayBuffer {
+    return this.fs.allocateBuffer(size);
+  }
+
+  /**
+   * Create a token to cancel long-running async operations (e.g. calcHash).
+   *
+   * @returns Token whose cancel() stops the operations it was passed to
+   */
+  createCancelToken(): CancelToken {
+    return this.fs.createCancelToken();
+  }
+
+  /**
+   * Map a file into memory and expose it as an ArrayBuffer.
+   *
+   * Pages are loaded lazily by the OS, so large files can be read randomly
+   * without copying them into the JS heap. Writable mappings write through
+   * to the file; stores into other mappings are private copies that never
+   * reach it. The mapping is released when the buffer is garbage
+   * collected, or immediately with unmap().
+   *
+   * @param path File path
+   * @param options Range and access options
+   * @returns ArrayBuffer backed by the mapping
+   *
+   * @example
+   * ```typescript
+   * const fs = openFS();
+   * const buffer = await fs.mmap('/path/to/large.bin', { offset: 4096 });
+   * fs.madvise(buffer, MapAdvice.Sequential);
+   * const header = new Uint8Array(buffer, 0, 16);
+   * fs.unmap(buffer);
+   * ```
+   */
+  mmap(path: string, options: MapOptions = {}): Promise<ArrayBuffer> {
+    const { offset = 0, length = -1, writable = false } = options;
+    return this.fs.mmapFile(path, offset, length, !writable);
+  }
+
+  /**
+   * Map a file into memory (sync)
+   * @see mmap
+   */
+  mmapSync(path: string, options: MapOptions = {}): ArrayBuffer {
+    const { offset = 0, length = -1, writable = false } = options;
+    return this.fs.mmapFileSync(path, offset, length, !writable);
+  }
+
+  /**
+   * Release a mapping without waiting for garbage collection.
+   *
+   * The buffer stays valid but reads as zeros afterwards.
+   *
+   * @returns false if the buffer is not a live mapping
+   */
+  unmap(buffer: ArrayBuffer): boolean {
+    return this.fs.unmap(buffer);
+  }
+
+  /**
+   * Hint the expected access pattern of a mapped buffer
+   */
+  madvise(buffer: ArrayBuffer, advice: MapAdvice): void {
+    this.fs.madvise(buffer, advice);
+  }
+
+  /**
+   * Flush changes of a writable mapping to the file
+   */
+  msync(buffer: ArrayBuffer): void {
+    this.fs.msync(buffer);
+  }
+
+  /**
+   * Get the metadata of many paths as columns.
+   *
+   * Entry `i` of the result describes `paths[i]`; paths that do not exist
+   * have type NotFound. The result has no names.
+   *
+   * @param paths File or directory paths
+   * @param options Cancellation options
+   * @returns Types, sizes and modified times as typed arrays
+   */
+  async getMetadataColumnar(
+    paths: string[],
+    options: CancelOptions = {}
+  ): Promise<EntryColumns> {
+    const { cancelToken, timeout } = options;
+    return new EntryColumns(
+      await this.fs.getMetadataColumnar(paths, cancelToken, { timeout })
+    );
+  }
+
+  /**
+   * Stream a file through native stages into a file, a handle or memory.
+   *
+   * The data is read in chunks on a worker thread, with the next chunk read
+   * while the current one runs through the stages, so large files never
+   * pass through JS and memory use stays bounded. Without a sink the
+   * output is returned as `data`.
+   *
+   * @param source Source file path or open FileHandle
+   * @param sink Destination path, open FileHandle, or null for memory
+   * @param options Range, stages, progress and cancellation
+   * @returns Byte counts, the digest of each Hash stage and optional data
+   *
+   * @example
+   * ```typescript
+   * const fs = openFS();
+   * // CRC32 of the original while writing a gzipped copy
+   * const { digests } = await fs.pipe('/path/log.txt', '/path/log.txt.gz', {
+   *   stages: [
+   *     { kind: PipeStageKind.Hash, param: HashAlgorithm.CRC32 },
+   *     { kind: PipeStageKind.Gzip },
+   *   ],
+   * });
+   * ```
+   */
+  pipe(
+    source: string | FileHandle,
+    sink: string | FileHandle | null,
+    options: PipeOptions = {}
+  ): Promise<PipeResult> {
+    const { offset, length, stages = [], append, onProgress, cancelToken } =
+      options;
+    return this.fs.pipe(
+      typeof source === 'string' ? source : source.id,
+      offset,
+      length,
+      stages.map((s) => (s.param === undefined ? [s.kind] : [s.kind, s.param])),
+      sink === null ? undefined : typeof sink === 'string' ? sink : sink.id,
+      append,
+      onProgress,
+      cancelToken,
+      { priority: options.priority, timeout: options.timeout }
+    );
+  }
+
+  /**
+   * Parse and aggregate a text file natively, line by line.
+   *
+   * Reads the source on a worker thread, optionally decodes it (e.g.
+   * gunzip), splits it into lines and runs each through the record
+   * stages - filters, CSV or JSON-lines field extraction - so that only
+   * the final result crosses to JS. Memory use is bounded by the output.
+   *
+   * @param source Source file path or open FileHandle
+   * @param options Range, byte and record stages, output, progress and cancellation
+   *
+   * @example
+   * ```typescript
+   * const fs = openFS();
+   * // Response times of failed requests in a gzipped JSON-lines log
+   * const { columns } = await fs.pipeLines('/path/requests.jsonl.gz', {
+   *   decode: [{ kind: PipeStageKind.Gunzip }],
+   *   stages: [
+   *     { kind: 'json', fields: ['status', 'timing.ms'] },
+   *     { kind: 'filter', prefix: '5', field: 0 },
+   *   ],
+   *   output: { kind: 'columns' },
+   * });
+   * const ms = columns![1] as Float64Array;
+   *
+   * // Lines per log level of a CSV file with a header
+   * const { counts } = await fs.pipeLines('/path/app.csv', {
+   *   stages: [{ kind: 'split', csv: true }, { kind: 'skip', count: 1 }],
+   *   output: { kind: 'countBy', field: 2 },
+   * });
+   * ```
+   */
+  async pipeLines(
+    source: string | FileHandle,
+    options: PipeLinesOptions = {}
+  ): Promise<PipeLinesResult> {
+    const {
+      offset,
+      length,
+      decode = [],
+      stages = [],
+      output = { kind: 'lines' },
+      onProgress,
+      cancelToken,
+    } = options;
+    const result = await this.fs.pipeLines(
+      typeof source === 'string' ? source : source.id,
+      offset,
+      length,
+      decode.map((s) => (s.param === undefined ? [s.kind] : [s.kind, s.param])),
+      stages.map(lineStageSpec),
+      lineOutputSpec(output),
+      onProgress,
+      cancelToken,
+      { priority: options.priority, timeout: options.timeout }
+    );
+    const { columns, ...rest } = result;
+    if (!columns) {
+      return rest;
+    }
+    return {
+      ...rest,
+      columns: columns.map((column) =>
+        column instanceof ArrayBuffer ? new Float64Array(column) : column
+      ),
+    };
+  }
+
+  /**
+   * Replace many files at once, each atomically and durably.
+   *
+   * Works like `WriteMode.Atomic` for every file, but the temp files are
+   * all written before any is flushed, and each directory is flushed only
+   * once, so saving dozens of small files costs about as much as one.
+   * Each file is replaced atomically; the batch as a whole is not, so a
+   * failure can leave the files before it replaced.
+   *
+   * @param files Paths and their new contents
+   * @param options Parent creation and priority
+   *
+   * @example
+   * ```typescript
+   * const fs = openFS();
+   * await fs.writeFiles([
+   *   { path: `${FS.documentDir}/state/session.json`, content: JSON.stringify(session) },
+   *   { path: `${FS.documentDir}/state/drafts.json`, content: JSON.stringify(drafts) },
+   * ], { createParents: true });
+   * ```
+   */
+  writeFiles(
+    files: FileWrite[],
+    options: WriteFilesOptions = {}
+  ): Promise<void> {
+    return this.fs.writeFilesAtomic(
+      files.map((f) => f.path),
+      files.map((f) => f.content),
+      options.createParents ?? false,
+      { priority: options.priority }
+    );
+  }
+
+  /**
+   * Run a list of native operations with a single Promise.
+   *
+   * Operations are dispatched on the thread pool together and the results
+   * come back to the JS thread in one step, which is cheaper than awaiting
+   * many small calls. Operations run in parallel unless they share a
+   * `group` or `ordered` is set. A failing operation does not fail the
+   * batch; its entry holds the error instead.
+   *
+   * @param operations Async IOFileSystem methods and their arguments
+   * @param options Ordering options
+   * @returns One result per operation, in the same order
+   *
+   * @example
+   * ```typescript
+   * const fs = openFS();
+   * const [a, b] = await fs.batch([
+   *   { op: 'readString', args: ['/path/a.txt'] },
+   *   { op: 'getFileSize', args: ['/path/b.bin'] },
+   * ]);
+   * if (a.ok) console.log(a.value);
+   * ```
+   */
+  batch(
+    operations: BatchOperation[],
+    options: BatchOptions = {}
+  ): Promise<BatchResult[]> {
+    const { ordered = false, priority } = options;
+    const ops =
+      priority === undefined
+        ? operations
+        : operations.map((o) => ({
+            ...o,
+            args: [...(o.args ?? []), { priority }],
+          }));
+    return this.fs.batch(ops, ordered);
+  }
+
   /**
    * Release the underlying IOFileSystem instance.
    *
@@ -145,23 +536,20 @@ export class FSContext {
 }
 
 /**
- * Open a file system context with a shared thread pool.
+ * Open a file system context.
  *
  * This is the preferred way to create an FSContext for batch file operations.
  * All File and Directory instances created from this context will share the
- * same native thread pool.
+ * same native client.
  *
- * @param numThreads Number of worker threads for async operations.
- *   When you need better concurrency for parallel file operations
- *   (e.g., reading/writing multiple files simultaneously with Promise.all),
- *   increase this value to enable true parallelism in the native layer.
- *   Default is 1, which is sufficient for sequential operations.
+ * @param numThreads Ignored, kept for compatibility. All contexts share one
+ *   process-wide executor with separate lanes for small I/O, bulk I/O,
+ *   hashing and network; size it with `configureExecutor()`.
  *
  * @returns FSContext instance
  *
  * @example
  * ```typescript
- * // Default single-threaded - good for sequential operations
  * const fs = openFS();
  * const file = fs.file('/path/to/file.txt');
  * const content = await file.readString();
@@ -170,8 +558,9 @@ export class FSContext {
  *
  * @example
  * ```typescript
- * // Multi-threaded for parallel file operations
- * const fs = openFS(4);
+ * // Parallel file operations; give hashing more threads if needed
+ * configureExecutor({ compute: 4 });
+ * const fs = openFS();
  * const files = paths.map(p => fs.file(p));
  * const contents = await Promise.all(files.map(f => f.readString()));
  * ```
@@ -9,7 +9,13 @@ import {
   HashAlgorithm,
   WriteMode,
   type FileMetadata,
+  type CopyOptions,
+  type HashOptions,
+  type HashResults,
+  type ChunkedHash,
+  type ChunkedHashOptions,
   type IOFileSystem,
+  type StringEncoding,
 } from './types';
 import { createFileSystem } from './NativeStdIO';
 
@@ -221,9 +227,13 @@ export class File {
   // Read Operations (Async - recommended)
   // ==========================================================================
 
-  /** Read file as UTF-8 string */
-  readString(): Promise<string> {
-    return this.fs().readString(this._path);
+  /**
+   * Read file as a string
+   * @param encoding Encoding of the file's bytes (default: utf8); `base64`
+   *                 and `hex` return the bytes in that text form
+   */
+  readString(encoding?: StringEncoding): Promise<string> {
+    return this.fs().readString(this._path, encoding);
   }
 
   /** Read file as binary data */
@@ -243,11 +253,12 @@ export class File {
   // ==========================================================================
 
   /**
-   * Read file as UTF-8 string (sync)
+   * Read file as a string (sync)
+   * @param encoding Encoding of the file's bytes (default: utf8)
    * @warning Blocks JS thread. Prefer `readString()` async version.
    */
-  readStringSync(): string {
-    return this.fs().readStringSync(this._path);
+  readStringSync(encoding?: StringEncoding): string {
+    return this.fs().readStringSync(this._path, encoding);
   }
 
   /**
@@ -276,12 +287,15 @@ export class File {
    * Write string to file
    * @param content String content to write
    * @param mode Write mode (default: Overwrite)
+   * @param encoding Bytes to write for the string (default: utf8); with
+   *                 `base64` or `hex` content is decoded to raw bytes
    */
   writeString(
     content: string,
-    mode: WriteMode = WriteMode.Overwrite
+    mode: WriteMode = WriteMode.Overwrite,
+    encoding?: StringEncoding
   ): Promise<void> {
-    return this.fs().writeString(this._path, content, mode, true);
+    return this.fs().writeString(this._path, content, mode, true, encoding);
   }
 
   /**
@@ -320,13 +334,15 @@ export class File {
    * Write string to file (sync)
    * @param content String content to write
    * @param mode Write mode (default: Overwrite)
+   * @param encoding Bytes to write for the string (default: utf8)
    * @warning Blocks JS thread. Prefer `writeString()` async version.
    */
   writeStringSync(
     content: string,
-    mode: WriteMode = WriteMode.Overwrite
+    mode: WriteMode = WriteMode.Overwrite,
+    encoding?: StringEncoding
   ): void {
-    this.fs().writeStringSync(this._path, content, mode, true);
+    this.fs().writeStringSync(this._path, content, mode, true, encoding);
   }
 
   /**
@@ -384,14 +400,30 @@ export class File {
 
   /**
    * Copy file to destination
+   *
+   * On APFS (iOS) the copy is a copy-on-write clone that completes instantly;
+   * elsewhere the data is copied inside the kernel where possible.
+   *
    * @param destinationPath Destination path
    * @param overwrite Overwrite if exists (default: true)
+   * @param options Progress callback, cancel token and timeout
    * @returns New File instance for the copy (shares the same IOFileSystem)
    */
-  copy(destinationPath: string, overwrite: boolean = true): Promise<File> {
+  copy(
+    destinationPath: string,
+    overwrite: boolean = true,
+    options: CopyOptions = {}
+  ): Promise<File> {
     const fsInstance = this.fs();
     return fsInstance
-      .copyFile(this._path, destinationPath, overwrite)
+      .copyFile(
+        this._path,
+        destinationPath,
+        overwrite,
+        options.onProgress,
+        options.cancelToken,
+        { priority: options.priority, timeout: options.timeout }
+      )
       .then(() => new File(destinationPath, fsInstance));
   }
 
@@ -409,10 +441,96 @@ export class File {
 
   /**
    * Calculate file hash
+   *
+   * The file is streamed through the hasher in chunks, so large files do not
+   * need to fit in memory.
+   *
+   * @param algorithm Hash algorithm (default: SHA256)
+   * @param options Progress callback and cancel token
+   *
+   * @example
+   * ```typescript
+   * const cancelToken = fs.createCancelToken();
+   * const hash = await file.calcHash(HashAlgorithm.SHA256, {
+   *   onProgress: (done, total) => console.log(`${done}/${total}`),
+   *   cancelToken,
+   * });
+   * ```
+   */
+  calcHash(
+    algorithm: HashAlgorithm = HashAlgorithm.SHA256,
+    options: HashOptions = {}
+  ): Promise<string> {
+    return this.fs().calcHash(
+      this._path,
+      algorithm,
+      options.onProgress,
+      options.cancelToken,
+      { priority: options.priority, timeout: options.timeout }
+    );
+  }
+
+  /**
+   * Calculate several hashes with a single read of the file
+   *
+   * @param algorithms Hash algorithms to compute
+   * @param options Progress callback and cancel token
+   * @returns Map of algorithm to hex digest
+   *
+   * @example
+   * ```typescript
+   * const hashes = await file.calcHashes([
+   *   HashAlgorithm.CRC32,
+   *   HashAlgorithm.MD5,
+   *   HashAlgorithm.SHA256,
+   * ]);
+   * console.log(hashes[HashAlgorithm.SHA256]);
+   * ```
+   */
+  calcHashes(
+    algorithms: HashAlgorithm[],
+    options: HashOptions = {}
+  ): Promise<HashResults> {
+    return this.fs().calcHashes(
+      this._path,
+      algorithms,
+      options.onProgress,
+      options.cancelToken,
+      { priority: options.priority, timeout: options.timeout }
+    );
+  }
+
+  /**
+   * Calculate a chunked (tree) hash, hashing ranges of the file in parallel
+   *
+   * Ranges are spread over the executor's compute lane, so give it several
+   * threads (e.g. `configureExecutor({ compute: 4 })`) to benefit.
+   * The per-range digests allow verifying or re-fetching parts of a file.
+   *
    * @param algorithm Hash algorithm (default: SHA256)
+   * @param options Chunk size, progress callback and cancel token
+   *
+   * @example
+   * ```typescript
+   * const fs = openFS();
+   * const { root, chunks } = await fs.file(path).calcChunkedHash(
+   *   HashAlgorithm.SHA256,
+   *   { chunkSize: 8 * 1024 * 1024 }
+   * );
+   * ```
    */
-  calcHash(algorithm: HashAlgorithm = HashAlgorithm.SHA256): Promise<string> {
-    return this.fs().calcHash(this._path, algorithm);
+  calcChunkedHash(
+    algorithm: HashAlgorithm = HashAlgorithm.SHA256,
+    options: ChunkedHashOptions = {}
+  ): Promise<ChunkedHash> {
+    return this.fs().calcHashChunked(
+      this._path,
+      algorithm,
+      options.chunkSize ?? 4 * 1024 * 1024,
+      options.onProgress,
+      options.cancelToken,
+      { priority: options.priority, timeout: options.timeout }
+    );
   }
 
   // ==========================================================================
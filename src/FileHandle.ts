@@ -6,8 +6,8 @@
  * reopening the file for each read/write.
  */
 
-import type { IOFileSystem } from './types';
-import { FileOpenMode, SeekOrigin } from './types';
+import type { FileHandleStats, HashOptions, IOFileSystem } from './types';
+import { FileOpenMode, HashAlgorithm, SeekOrigin } from './types';
 
 /**
  * File handle for streaming I/O operations.
@@ -78,6 +78,25 @@ export class FileHandle {
     return this._closed;
   }
 
+  /**
+   * @internal
+   * Native handle ID, for native APIs taking a handle (e.g. FSContext.pipe()).
+   */
+  get id(): number {
+    this.ensureOpen();
+    return this._handle;
+  }
+
+  /**
+   * Get the I/O counters of this handle (bytes and calls since open).
+   *
+   * @returns Snapshot of the counters
+   */
+  getStats(): FileHandleStats {
+    this.ensureOpen();
+    return this._fs.fileGetStats(this._handle);
+  }
+
   // ==========================================================================
   // Position Operations (Async)
   // ==========================================================================
@@ -184,6 +203,36 @@ export class FileHandle {
     return this._fs.fileReadLine(this._handle);
   }
 
+  /**
+   * Read a batch of lines in one call.
+   *
+   * Much faster than calling readLine() in a loop for large text files
+   * (e.g. NDJSON logs): the native side splits lines from a large buffer
+   * and returns many of them per bridge crossing.
+   *
+   * @param maxLines Maximum number of lines to return (default: 1000)
+   * @param maxBytes Stop once the lines add up to this many bytes; longer
+   *   lines are returned in pieces (default: 16 MiB)
+   * @returns Lines without line endings, empty array at end of file
+   *
+   * @example
+   * ```typescript
+   * const handle = fs.open(logPath);
+   * for (let batch = await handle.readLines(); batch.length > 0;
+   *      batch = await handle.readLines()) {
+   *   batch.forEach((line) => process(JSON.parse(line)));
+   * }
+   * handle.close();
+   * ```
+   */
+  readLines(
+    maxLines: number = 1000,
+    maxBytes: number = 16 * 1024 * 1024
+  ): Promise<string[]> {
+    this.ensureOpen();
+    return this._fs.fileReadLines(this._handle, maxLines, maxBytes);
+  }
+
   /**
    * Write bytes to file.
    *
@@ -195,6 +244,74 @@ export class FileHandle {
     return this._fs.fileWrite(this._handle, data);
   }
 
+  /**
+   * Read bytes at an absolute offset.
+   *
+   * Does not use or move the file position, so several reads of disjoint
+   * ranges can run in parallel on the native thread pool.
+   *
+   * @param offset Absolute offset in bytes
+   * @param size Number of bytes to read (default: read to end of file)
+   * @returns ArrayBuffer containing read data (shorter at end of file)
+   *
+   * @example
+   * ```typescript
+   * const chunks = await Promise.all([
+   *   handle.readAt(0, 65536),
+   *   handle.readAt(65536, 65536),
+   *   handle.readAt(131072, 65536),
+   * ]);
+   * ```
+   */
+  readAt(offset: number, size?: number): Promise<ArrayBuffer> {
+    this.ensureOpen();
+    return this._fs.fileReadAt(this._handle, offset, size);
+  }
+
+  /**
+   * Hash a byte range of the file.
+   *
+   * Does not use or move the file position. Useful for verifying chunks of a
+   * resumed download.
+   *
+   * @param offset Absolute offset in bytes
+   * @param length Number of bytes (default: to end of file)
+   * @param algorithm Hash algorithm (default: SHA256)
+   * @param options Progress callback and cancel token
+   * @returns Hex string of the hash
+   */
+  hashRange(
+    offset: number,
+    length: number = -1,
+    algorithm: HashAlgorithm = HashAlgorithm.SHA256,
+    options: HashOptions = {}
+  ): Promise<string> {
+    this.ensureOpen();
+    return this._fs.fileHashRange(
+      this._handle,
+      offset,
+      length,
+      algorithm,
+      options.onProgress,
+      options.cancelToken,
+      { priority: options.priority, timeout: options.timeout }
+    );
+  }
+
+  /**
+   * Write bytes at an absolute offset.
+   *
+   * Does not use or move the file position. Not available for append modes.
+   *
+   * @param offset Absolute offset in bytes
+   * @param data Data to write
+   * @returns Number of bytes written
+   */
+  writeAt(offset: number, data: ArrayBuffer): Promise<number> {
+    this.ensureOpen();
+    return this._fs.fileWriteAt(this._handle, offset, data);
+  }
+
   /**
    * Write string to file.
    *
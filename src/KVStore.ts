@@ -0,0 +1,195 @@
+/**
+ * @file KVStore.ts
+ * @description Native key-value store for React Native IO
+ *
+ * Keeps many small values in a few append-only files instead of one file
+ * per value.
+ */
+
+import type { IOKVStore, KVStoreStats, TaskPriority } from './types';
+import { createKVStore } from './NativeStdIO';
+
+/**
+ * Options of a KVStore
+ */
+export interface KVStoreOptions {
+  /**
+   * Size at which a segment file is closed and a new one started
+   * (default: 8 MB). Applies when the directory is first opened.
+   */
+  maxSegmentBytes?: number;
+  /**
+   * Flush every write to storage before its Promise resolves (default: false).
+   * Without it writes survive the app being killed, but a power loss can
+   * drop the latest ones unless `flush()` was called.
+   */
+  durable?: boolean;
+  /** Scheduling priority of reads and writes (default: Normal) */
+  priority?: TaskPriority | number;
+}
+
+/**
+ * Key-value store in a directory.
+ *
+ * Writes are appended to a segment file and an in-memory index maps each
+ * key to its latest value, so a put costs one native write and a get one
+ * hash lookup and a copy out of a memory map - much cheaper than a file
+ * per value. Overwritten and deleted values are reclaimed by a background
+ * compaction. All KVStore instances of a directory share one native store.
+ *
+ * Values are text (stored as UTF-8) or binary data.
+ *
+ * @example
+ * ```typescript
+ * const store = new KVStore(`${FS.documentDir}/blobs`);
+ *
+ * await store.put('user:1', JSON.stringify(user));
+ * const json = await store.get('user:1'); // string | undefined
+ *
+ * await store.multiPut([
+ *   ['user:2', JSON.stringify(a)],
+ *   ['user:3', JSON.stringify(b)],
+ * ]);
+ * const users = await store.multiGet(['user:2', 'user:3']);
+ *
+ * await store.delete('user:1');
+ * const ids = await store.keys('user:');
+ * ```
+ */
+export class KVStore {
+  private readonly _directory: string;
+  private readonly _options: KVStoreOptions;
+  private _store: IOKVStore | null = null;
+
+  /**
+   * Create a KVStore instance; the directory is opened on the first operation
+   * @param directory Store directory, created if missing
+   * @param options Segment size, durability and priority
+   */
+  constructor(directory: string, options: KVStoreOptions = {}) {
+    this._directory = directory;
+    this._options = options;
+  }
+
+  private store(): IOKVStore {
+    if (!this._store) {
+      this._store = createKVStore(
+        this._directory,
+        this._options.maxSegmentBytes ?? 0,
+        this._options.durable ?? false
+      );
+    }
+    return this._store;
+  }
+
+  private callOptions() {
+    return { priority: this._options.priority };
+  }
+
+  /**
+   * Release the native client. The store stays open while other
+   * instances of the directory use it.
+   */
+  dispose(): void {
+    this._store = null;
+  }
+
+  /** Store directory */
+  get directory(): string {
+    return this._directory;
+  }
+
+  /**
+   * Read a value as text
+   * @returns The value, or undefined if the key does not exist
+   */
+  get(key: string): Promise<string | undefined> {
+    return this.store().get(key, this.callOptions());
+  }
+
+  /**
+   * Read a value as binary data
+   * @returns The value, or undefined if the key does not exist
+   */
+  getBytes(key: string): Promise<ArrayBuffer | undefined> {
+    return this.store().getBytes(key, this.callOptions());
+  }
+
+  /**
+   * Read several values as text in one native call
+   * @returns Values in the order of keys, undefined for missing keys
+   */
+  multiGet(keys: string[]): Promise<(string | undefined)[]> {
+    return this.store().multiGet(keys, this.callOptions());
+  }
+
+  /** Check whether a key exists */
+  has(key: string): Promise<boolean> {
+    return this.store().has(key, this.callOptions());
+  }
+
+  /**
+   * List keys
+   * @param prefix Only keys starting with this prefix
+   * @returns Keys, sorted
+   */
+  keys(prefix?: string): Promise<string[]> {
+    return this.store().keys(prefix, this.callOptions());
+  }
+
+  /**
+   * Write a value
+   * @param key Non-empty key of up to 64 KB
+   * @param value Text or binary data
+   */
+  put(key: string, value: string | ArrayBuffer): Promise<void> {
+    return this.store().put(key, value, this.callOptions());
+  }
+
+  /**
+   * Write several values with a single append.
+   * A later entry for the same key wins.
+   */
+  multiPut(entries: [string, string | ArrayBuffer][]): Promise<void> {
+    return this.store().multiPut(
+      entries.map(([key]) => key),
+      entries.map(([, value]) => value),
+      this.callOptions()
+    );
+  }
+
+  /**
+   * Delete a key
+   * @returns Whether the key existed
+   */
+  delete(key: string): Promise<boolean> {
+    return this.store().delete(key, this.callOptions());
+  }
+
+  /**
+   * Delete several keys with a single append
+   * @returns Number of keys that existed
+   */
+  multiDelete(keys: string[]): Promise<number> {
+    return this.store().multiDelete(keys, this.callOptions());
+  }
+
+  /** Flush all writes so far to storage */
+  flush(): Promise<void> {
+    return this.store().flush();
+  }
+
+  /**
+   * Reclaim the space of overwritten and deleted values now.
+   * This also runs in the background once more than half of the
+   * store is garbage.
+   */
+  compact(): Promise<void> {
+    return this.store().compact();
+  }
+
+  /** Number of keys, bytes in use and reclaimable, and segment files */
+  getStats(): Promise<KVStoreStats> {
+    return this.store().getStats();
+  }
+}
@@ -1,10 +1,15 @@
 import { TurboModuleRegistry, type TurboModule } from 'react-native';
-import type { IOFileSystem, IORequest, IOPlatform } from './types';
+import type {
+  ExecutorConfig,
+  IOFileSystem,
+  IOKVStore,
+  IORequest,
+  IOPlatform,
+  NetworkConfig,
+  StringEncoding,
+} from './types';
 
-/**
- * String encoding types supported by native layer
- */
-export type StringEncoding = 'utf8' | 'ascii' | 'latin1';
+export type { StringEncoding } from './types';
 
 /**
  * @internal TurboModule Spec (not exported)
@@ -12,7 +17,27 @@ export type StringEncoding = 'utf8' | 'ascii' | 'latin1';
 interface Spec extends TurboModule {
   createFileSystem(numThreads: number): Object;
   createIORequest(): Object;
+  configureExecutor(
+    interactive: number,
+    bulk: number,
+    compute: number,
+    network: number,
+    completionBudgetMs: number
+  ): void;
+  configureNetwork(
+    maxConcurrent: number,
+    maxPerHost: number,
+    cacheSize: number,
+    memoryCacheSize: number,
+    progressInterval: number,
+    progressMinBytes: number
+  ): void;
   createPlatform(): Object;
+  createKVStore(
+    directory: string,
+    maxSegmentBytes: number,
+    durable: boolean
+  ): Object;
   installHttpClient(): void;
   // String encoding/decoding (Object is used because Codegen doesn't support ArrayBuffer)
   decodeString(buffer: Object, encoding: string): string;
@@ -23,13 +48,13 @@ const NativeModule = TurboModuleRegistry.getEnforcing<Spec>('NativeStdIO');
 
 /**
  * Create a new IOFileSystem instance.
- * Each call creates a new native file system client with its own thread pool.
+ * All instances run their async operations on the shared native executor.
  *
- * @param numThreads Number of worker threads for async operations (default: 1)
+ * @param numThreads Ignored, kept for compatibility (see configureExecutor)
  * @returns New IOFileSystem instance
  *
- * @internal This function is for internal use. Use FSContext/openFS() for
- *           configurable thread pools, or File/Directory classes directly.
+ * @internal This function is for internal use. Use FSContext/openFS() or
+ *           File/Directory classes directly.
  */
 export function createFileSystem(numThreads: number = 1): IOFileSystem {
   return NativeModule.createFileSystem(numThreads) as IOFileSystem;
@@ -37,7 +62,7 @@ export function createFileSystem(numThreads: number = 1): IOFileSystem {
 
 /**
  * Create a new IORequest instance.
- * Each call creates a new native HTTP client with its own thread pool.
+ * Requests run on the network lane of the shared native executor.
  *
  * @returns New IORequest instance
  */
@@ -45,6 +70,79 @@ export function createRequest(): IORequest {
   return NativeModule.createIORequest() as IORequest;
 }
 
+/**
+ * Set the thread counts of the shared native executor.
+ *
+ * Also sets how long the JS thread may spend per turn delivering completed
+ * async results; results beyond the budget are delivered in the next turn.
+ *
+ * The executor has separate lanes for interactive file I/O, bulk file I/O,
+ * hashing and network, so a large background hash or copy does not delay
+ * small reads. Call this early (e.g. at app start): instances created
+ * afterwards use the new threads, existing ones keep theirs.
+ *
+ * @param config Threads per lane (at most 64); omitted lanes keep their
+ *   current count. `completionBudgetMs` is capped at 1000. Values must be
+ *   finite numbers.
+ *
+ * @example
+ * ```typescript
+ * configureExecutor({ compute: 2, network: 6 });
+ * ```
+ */
+export function configureExecutor(config: ExecutorConfig): void {
+  NativeModule.configureExecutor(
+    config.interactive ?? 0,
+    config.bulk ?? 0,
+    config.compute ?? 0,
+    config.network ?? 0,
+    config.completionBudgetMs ?? -1
+  );
+}
+
+/**
+ * Limit how many HTTP transfers run at the same time, and set up the
+ * native HTTP cache.
+ *
+ * Requests, downloads and uploads of all clients share one native queue.
+ * A transfer starts when fewer than `maxConcurrent` are running and its
+ * host has fewer than `maxPerHost`; queued transfers start in priority
+ * order, so a high-priority request overtakes a burst of low-priority
+ * ones. Transfers to other hosts are not held up by a saturated host.
+ * Can be called at any time; running transfers are not interrupted.
+ *
+ * With `cacheSize` set, GET responses are cached on disk following their
+ * Cache-Control / Expires headers: fresh responses are answered without
+ * the network, stale ones are revalidated with their ETag or
+ * Last-Modified. Send `Cache-Control: no-cache` to force revalidation or
+ * `no-store` to bypass the cache.
+ *
+ * `progressInterval` and `progressMinBytes` thin out `onProgress` events
+ * of downloads and uploads; the first and the final event are always
+ * delivered, and events of all transfers are batched once per frame.
+ *
+ * @param config Limits; omitted values keep their current setting
+ *
+ * @example
+ * ```typescript
+ * configureNetwork({ maxConcurrent: 8, maxPerHost: 4 });
+ * configureExecutor({ network: 8 }); // enough threads for 8 transfers
+ *
+ * configureNetwork({ cacheSize: 20 * 1024 * 1024 });
+ * configureNetwork({ progressInterval: 250, progressMinBytes: 64 * 1024 });
+ * ```
+ */
+export function configureNetwork(config: NetworkConfig): void {
+  NativeModule.configureNetwork(
+    config.maxConcurrent ?? -1,
+    config.maxPerHost ?? -1,
+    config.cacheSize ?? -1,
+    config.memoryCacheSize ?? -1,
+    config.progressInterval ?? -1,
+    config.progressMinBytes ?? -1
+  );
+}
+
 /**
  * Create a new IOPlatform instance.
  * Provides platform-specific directory paths.
@@ -55,6 +153,28 @@ export function createPlatform(): IOPlatform {
   return NativeModule.createPlatform() as IOPlatform;
 }
 
+/**
+ * Create a native key-value store client for a directory.
+ * Clients of the same directory share one store.
+ *
+ * @param directory Store directory, created on first use
+ * @param maxSegmentBytes Segment file size (0 = default, 8 MB)
+ * @param durable Flush every write to storage before it resolves
+ *
+ * @internal This function is for internal use. Use the KVStore class.
+ */
+export function createKVStore(
+  directory: string,
+  maxSegmentBytes: number = 0,
+  durable: boolean = false
+): IOKVStore {
+  return NativeModule.createKVStore(
+    directory,
+    maxSegmentBytes,
+    durable
+  ) as IOKVStore;
+}
+
 /**
  * Install HTTP client (Android only).
  * Pre-warms JNI class caches for better performance.
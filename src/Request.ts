@@ -27,7 +27,13 @@
  */
 
 import { createRequest, installHttpClient, decodeString } from './NativeStdIO';
-import type { IORequest } from './types';
+import type {
+  BodyEncoding,
+  CancelToken,
+  IORequest,
+  TaskPriority,
+} from './types';
+import type { FileHandle } from './FileHandle';
 
 // Track if HTTP client has been installed (Android only)
 let httpClientInstalled = false;
@@ -46,6 +52,17 @@ export interface RequestOptions {
   timeout?: number;
   /** Whether to follow redirects (default: true) */
   followRedirects?: boolean;
+  /**
+   * Token to abort the request; the Promise rejects with a
+   * `CancelledError` (see `request.createCancelToken()`)
+   */
+  cancelToken?: CancelToken;
+  /**
+   * Position in the native transfer queue (default: Normal). Queued
+   * transfers start in priority order when a concurrency slot frees up
+   * (see `configureNetwork()`).
+   */
+  priority?: TaskPriority | number;
 }
 
 /**
@@ -56,8 +73,10 @@ export interface RequestOptionsWithBody extends RequestOptions {
   json?: object;
   /** String body */
   body?: string;
-  /** Binary body */
+  /** Binary body (sent in place; do not modify it until the request settles) */
   data?: ArrayBuffer;
+  /** Compress the body before sending ('gzip' sets Content-Encoding: gzip) */
+  bodyEncoding?: BodyEncoding;
 }
 
 /**
@@ -85,13 +104,41 @@ export interface Response {
   arrayBuffer(): ArrayBuffer;
 }
 
+/**
+ * Streaming request options
+ */
+export interface StreamOptions extends RequestOptionsWithBody {
+  /**
+   * Called with each chunk of the response body as it arrives. Returning a
+   * Promise holds the transfer back until it settles.
+   */
+  onChunk?: (chunk: ArrayBuffer) => void | Promise<unknown>;
+  /** Write the body to this file handle instead of calling onChunk */
+  sink?: FileHandle;
+  /**
+   * Bytes that may be received ahead of the chunks being handled
+   * (default: 1 MB); the transfer pauses when they are exceeded
+   */
+  highWaterMark?: number;
+}
+
 /**
  * Download options
  */
 export interface DownloadOptions extends RequestOptions {
   /** Resume download from existing file */
   resumable?: boolean;
-  /** Progress callback */
+  /**
+   * Download this many byte ranges in parallel (default: 1). Needs a server
+   * that supports Range requests, otherwise a single stream is used. With
+   * `resumable`, an interrupted download later fetches only the ranges it
+   * is missing.
+   */
+  segments?: number;
+  /**
+   * Progress callback, rate-limited (see `configureNetwork()`); the final
+   * event arrives before the Promise settles
+   */
   onProgress?: (progress: DownloadProgress) => void;
 }
 
@@ -105,6 +152,8 @@ export interface DownloadProgress {
   totalBytes: number;
   /** Progress percentage (0-1) */
   progress: number;
+  /** Receive rate since the previous event (0 for the first) */
+  bytesPerSecond: number;
 }
 
 /**
@@ -135,8 +184,36 @@ export interface UploadOptions extends RequestOptions {
   mimeType?: string;
   /** Additional form fields */
   formFields?: Record<string, string>;
-  /** Progress callback */
+  /** Further files sent in the same multipart body */
+  files?: UploadFilePart[];
+  /**
+   * Progress callback, rate-limited (see `configureNetwork()`); the final
+   * event arrives before the Promise settles
+   */
   onProgress?: (progress: UploadProgress) => void;
+  /**
+   * Send the file with the tus resumable upload protocol instead of
+   * multipart: `url` is the tus endpoint that creates uploads
+   */
+  resumable?: boolean;
+  /** `uploadUrl` of an earlier resumable attempt to continue */
+  resumeUrl?: string;
+  /** Bytes per resumable request (default: 4 MB) */
+  chunkSize?: number;
+}
+
+/**
+ * A further file part of a multipart upload
+ */
+export interface UploadFilePart {
+  /** Local file path */
+  path: string;
+  /** Form field name (default: "file") */
+  fieldName?: string;
+  /** File name in the form (default: last path component) */
+  fileName?: string;
+  /** MIME type (default: application/octet-stream) */
+  mimeType?: string;
 }
 
 /**
@@ -149,6 +226,8 @@ export interface UploadProgress {
   totalBytes: number;
   /** Progress percentage (0-1) */
   progress: number;
+  /** Send rate since the previous event (0 for the first) */
+  bytesPerSecond: number;
 }
 
 /**
@@ -163,6 +242,8 @@ export interface UploadResult {
   responseText: string;
   /** Error message (if failed) */
   error?: string;
+  /** tus upload URL (resumable uploads); pass as resumeUrl to continue */
+  uploadUrl?: string;
 }
 
 // ============================================================================
@@ -235,6 +316,25 @@ function createResponse(native: NativeResponse): Response {
   };
 }
 
+function requestBody(options?: RequestOptionsWithBody): {
+  headers: Record<string, string>;
+  body: string | ArrayBuffer | null;
+} {
+  const headers = { ...options?.headers };
+  let body: string | ArrayBuffer | null = null;
+
+  // Handle JSON body
+  if (options?.json) {
+    body = JSON.stringify(options.json);
+    headers['Content-Type'] = 'application/json';
+  } else if (options?.body) {
+    body = options.body;
+  } else if (options?.data) {
+    body = options.data;
+  }
+  return { headers, body };
+}
+
 // ============================================================================
 // Request Class
 // ============================================================================
@@ -297,6 +397,16 @@ class RequestClient {
     this._io = null;
   }
 
+  /**
+   * Create a token to abort requests, downloads and uploads.
+   *
+   * Pass it as `cancelToken` in the options. Transfers that are still queued
+   * are dropped; transfers in flight are aborted.
+   */
+  createCancelToken(): CancelToken {
+    return this.io().createCancelToken();
+  }
+
   // ==========================================================================
   // Core Request Methods
   // ==========================================================================
@@ -312,18 +422,7 @@ class RequestClient {
     url: string,
     options?: RequestOptionsWithBody
   ): Promise<Response> {
-    const headers = { ...options?.headers };
-    let body: string | ArrayBuffer | null = null;
-
-    // Handle JSON body
-    if (options?.json) {
-      body = JSON.stringify(options.json);
-      headers['Content-Type'] = 'application/json';
-    } else if (options?.body) {
-      body = options.body;
-    } else if (options?.data) {
-      body = options.data;
-    }
+    const { headers, body } = requestBody(options);
 
     const native = await this.io().request(
       url,
@@ -331,7 +430,60 @@ class RequestClient {
       headersToArray(headers),
       body,
       options?.timeout ?? 30000,
-      options?.followRedirects ?? true
+      options?.followRedirects ?? true,
+      options?.bodyEncoding,
+      options?.cancelToken,
+      { priority: options?.priority }
+    );
+
+    return createResponse(native);
+  }
+
+  /**
+   * Execute HTTP request, streaming the response body instead of buffering it
+   *
+   * Chunks are delivered in order. The returned Response has an empty body
+   * and resolves once every chunk has been handled.
+   *
+   * @example
+   * ```typescript
+   * let total = 0;
+   * await request.stream('GET', url, {
+   *   onChunk: (chunk) => { total += chunk.byteLength; },
+   * });
+   *
+   * // Straight into a file
+   * const handle = openFS().open(path, FileOpenMode.Write);
+   * await request.stream('GET', url, { sink: handle });
+   * handle.close();
+   * ```
+   */
+  async stream(
+    method: string,
+    url: string,
+    options: StreamOptions
+  ): Promise<Response> {
+    const sink = options.sink;
+    const onChunk = sink
+      ? (chunk: ArrayBuffer) => sink.write(chunk)
+      : options.onChunk;
+    if (!onChunk) {
+      throw new Error('stream: onChunk or sink is required');
+    }
+    const { headers, body } = requestBody(options);
+
+    const native = await this.io().requestStream(
+      url,
+      method,
+      headersToArray(headers),
+      body,
+      options.timeout ?? 30000,
+      options.followRedirects ?? true,
+      options.bodyEncoding,
+      options.highWaterMark,
+      onChunk,
+      options.cancelToken,
+      { priority: options.priority }
     );
 
     return createResponse(native);
@@ -422,13 +574,24 @@ class RequestClient {
     destinationPath: string,
     options?: DownloadOptions
   ): Promise<DownloadResult> {
-    // Note: Progress callback is not yet implemented in native layer
+    const onProgress = options?.onProgress;
     const native = await this.io().download(
       url,
       destinationPath,
       headersToArray(options?.headers),
       options?.timeout ?? 60000,
-      options?.resumable ?? false
+      options?.resumable ?? false,
+      options?.segments,
+      onProgress &&
+        ((bytesReceived, totalBytes, bytesPerSecond) =>
+          onProgress({
+            bytesReceived,
+            totalBytes,
+            progress: totalBytes > 0 ? bytesReceived / totalBytes : 0,
+            bytesPerSecond,
+          })),
+      options?.cancelToken,
+      { priority: options?.priority }
     );
 
     return {
@@ -483,6 +646,14 @@ class RequestClient {
       }
     }
 
+    const files = options?.files?.flatMap((file) => [
+      file.path,
+      file.fieldName ?? 'file',
+      file.fileName ?? '',
+      file.mimeType ?? '',
+    ]);
+    const onProgress = options?.onProgress;
+
     const native = await this.io().upload(
       url,
       filePath,
@@ -492,7 +663,21 @@ class RequestClient {
       headersToArray(options?.headers),
       formKeys,
       formValues,
-      options?.timeout ?? 60000
+      options?.timeout ?? 60000,
+      files,
+      options?.resumable,
+      options?.resumeUrl,
+      options?.chunkSize,
+      onProgress &&
+        ((bytesSent, totalBytes, bytesPerSecond) =>
+          onProgress({
+            bytesSent,
+            totalBytes,
+            progress: totalBytes > 0 ? bytesSent / totalBytes : 0,
+            bytesPerSecond,
+          })),
+      options?.cancelToken,
+      { priority: options?.priority }
     );
 
     return {
@@ -500,6 +685,7 @@ class RequestClient {
       status: native.statusCode,
       responseText: new TextDecoder().decode(native.responseBody),
       error: native.success ? undefined : native.errorMessage,
+      uploadUrl: native.uploadUrl || undefined,
     };
   }
 }
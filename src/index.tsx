@@ -49,22 +49,81 @@ export {
   HashAlgorithm,
   FileOpenMode,
   SeekOrigin,
+  MapAdvice,
+  TaskPriority,
+  PipeStageKind,
+  isCancelledError,
+  type ExecutorConfig,
+  type NetworkConfig,
+  type StatCacheConfig,
+  type StatsConfig,
+  type IOStats,
+  type MethodStats,
+  type LatencySummary,
+  type LaneStats,
+  type BenchmarkSuite,
+  type BenchmarkResult,
+  type BenchmarkReport,
+  type BodyEncoding,
   type FileHandleId,
+  type FileHandleStats,
   type FileMetadata,
   type DirectoryEntry,
+  type DirectoryIteratorEntry,
+  type WatchEvent,
+  type WatchEventType,
+  type CancelToken,
+  type CancelOptions,
+  type CancelledError,
+  type ProgressCallback,
+  type HashOptions,
+  type CopyOptions,
+  type HashResults,
+  type ChunkedHash,
+  type ChunkedHashOptions,
+  type BatchOperation,
+  type BatchResult,
+  type PipeStage,
+  type PipeOptions,
+  type PipeResult,
+  type LineStage,
+  type LineOutput,
+  type PipeLinesOptions,
+  type PipeLinesResult,
   type IOFileSystem,
   type IORequest,
+  type IOKVStore,
+  type KVStoreStats,
   type IOPlatform,
   type IOPlatformAndroid,
   type IOPlatformIOS,
 } from './types';
 export type { StringEncoding } from './NativeStdIO';
+export { configureExecutor, configureNetwork } from './NativeStdIO';
 
 // Export classes
 export { File } from './File';
 export { Directory } from './Directory';
 export { FileHandle } from './FileHandle';
-export { FSContext, openFS } from './FSContext';
+export {
+  DirectoryIterator,
+  type DirectoryIteratorOptions,
+} from './DirectoryIterator';
+export {
+  DirectoryWatcher,
+  type DirectoryWatcherOptions,
+} from './DirectoryWatcher';
+export { EntryColumns, type ColumnarListOptions } from './EntryColumns';
+export {
+  FSContext,
+  openFS,
+  type MapOptions,
+  type BatchOptions,
+  type FileWrite,
+  type WriteFilesOptions,
+} from './FSContext';
+export { KVStore, type KVStoreOptions } from './KVStore';
+export { type BenchmarkOptions } from './Benchmark';
 
 // Export HTTP Request API
 export {
@@ -72,11 +131,13 @@ export {
   Request,
   type RequestOptions,
   type RequestOptionsWithBody,
+  type StreamOptions,
   type Response,
   type DownloadOptions,
   type DownloadProgress,
   type DownloadResult,
   type UploadOptions,
+  type UploadFilePart,
   type UploadProgress,
   type UploadResult,
 } from './Request';
@@ -89,8 +150,17 @@ import {
   encodeString,
   type StringEncoding,
 } from './NativeStdIO';
-import type { IOPlatform, IOPlatformAndroid, IOPlatformIOS } from './types';
+import type {
+  IOPlatform,
+  IOPlatformAndroid,
+  IOPlatformIOS,
+  BenchmarkReport,
+  IOStats,
+  StatCacheConfig,
+  StatsConfig,
+} from './types';
 import { IOPlatformType } from './types';
+import { runBenchmarks, type BenchmarkOptions } from './Benchmark';
 
 // Internal fs instance for utility functions (lazy initialized)
 let _fs: ReturnType<typeof createFileSystem> | null = null;
@@ -262,6 +332,83 @@ export const FS = {
     return _getFs().joinPaths(...segments);
   },
 
+  // ==========================================================================
+  // Metadata Cache
+  // ==========================================================================
+
+  /**
+   * Cache the results of exists/isFile/isDirectory/getMetadata/size
+   * queries, so repeated checks of the same paths skip the kernel.
+   *
+   * Writes, deletes, moves and downloads made through this library update
+   * the cache of the paths they touch (file handles when flushed or
+   * closed). Changes made by other code show up after `ttlMs`, or at once
+   * after `invalidateStatCache()`. Off by default.
+   *
+   * @example
+   * ```typescript
+   * FS.configureStatCache({ maxEntries: 4096, ttlMs: 2000 });
+   * ```
+   */
+  configureStatCache: (config: StatCacheConfig): void => {
+    _getFs().configureStatCache(config.maxEntries, config.ttlMs);
+  },
+
+  /**
+   * Forget cached metadata of a path and everything below it, or of all
+   * paths when called without one
+   */
+  invalidateStatCache: (path?: string): void => {
+    _getFs().invalidateStatCache(path);
+  },
+
+  // ==========================================================================
+  // Instrumentation
+  // ==========================================================================
+
+  /**
+   * Time every native call in three phases - queued, executing, settling
+   * on the JS thread - so slow operations can be blamed on storage, a
+   * saturated thread pool or a busy JS thread. Off by default; when off
+   * it costs one atomic load per call.
+   *
+   * @example
+   * ```typescript
+   * FS.configureStats({ enabled: true });
+   * await runWorkload();
+   * const { methods, lanes } = FS.getStats();
+   * console.log(methods['fs.readString']?.execute.p99, lanes.bulk.peakQueued);
+   * ```
+   */
+  configureStats: (config: StatsConfig): void => {
+    _getFs().configureStats(config.enabled, config.trace);
+  },
+
+  /** Per-method latencies and counters, and executor lane load */
+  getStats: (): IOStats => {
+    return _getFs().getStats();
+  },
+
+  /** Start counting from zero */
+  resetStats: (): void => {
+    _getFs().resetStats();
+  },
+
+  /**
+   * Measure file, directory listing, hash, codec and JSI call performance
+   * on this device. A full run takes about a minute and needs some 100 MB
+   * of scratch space; `quick` takes a few seconds.
+   *
+   * @example
+   * ```typescript
+   * const report = await FS.runBenchmarks({ suites: ['hash', 'jsi'] });
+   * console.log(JSON.stringify(report));
+   * ```
+   */
+  runBenchmarks: (options?: BenchmarkOptions): Promise<BenchmarkReport> => {
+    return runBenchmarks(_getFs(), FS.cacheDir, options);
+  },
+
   // ==========================================================================
   // Storage Information
   // ==========================================================================
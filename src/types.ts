@@ -39,6 +39,12 @@ export enum WriteMode {
   Overwrite = 0,
   /** Append to existing file */
   Append = 1,
+  /**
+   * Replace the file atomically and durably: the data goes to a temp file
+   * next to it, which is flushed to storage and renamed over the target.
+   * After a crash the file has its old or its new contents.
+   */
+  Atomic = 2,
 }
 
 /**
@@ -101,6 +107,22 @@ export enum SeekOrigin {
   End = 2,
 }
 
+/**
+ * Access pattern hint for memory-mapped buffers (see IOFileSystem.madvise)
+ */
+export enum MapAdvice {
+  /** No special treatment */
+  Normal = 0,
+  /** Pages will be read in order - read ahead aggressively */
+  Sequential = 1,
+  /** Pages will be read in random order - disable read-ahead */
+  Random = 2,
+  /** Pages will be needed soon - start paging in now */
+  WillNeed = 3,
+  /** Pages will not be needed soon - they may be dropped */
+  DontNeed = 4,
+}
+
 // ============================================================================
 // Data Types
 // ============================================================================
@@ -113,6 +135,20 @@ export enum SeekOrigin {
  */
 export type FileHandleId = number;
 
+/**
+ * I/O counters of an open file handle
+ */
+export interface FileHandleStats {
+  /** Bytes read from the file, including line read-ahead */
+  bytesRead: number;
+  /** Bytes written to the file */
+  bytesWritten: number;
+  /** Number of read calls */
+  readOps: number;
+  /** Number of write calls */
+  writeOps: number;
+}
+
 /**
  * File or directory metadata
  */
@@ -139,6 +175,554 @@ export interface DirectoryEntry {
   size: number;
 }
 
+/**
+ * Entry returned by DirectoryIterator
+ *
+ * `size` is only present when the iterator was opened with `withSize`.
+ */
+export type DirectoryIteratorEntry = Omit<DirectoryEntry, 'size'> & {
+  size?: number;
+};
+
+/**
+ * Columnar listing as returned by the native module
+ *
+ * Each field is one ArrayBuffer; see EntryColumns for the layout.
+ * @internal
+ */
+export interface NativeEntryColumns {
+  count: number;
+  names: ArrayBuffer;
+  nameOffsets: ArrayBuffer;
+  types: ArrayBuffer;
+  sizes: ArrayBuffer;
+  modifiedTimes: ArrayBuffer;
+}
+
+/**
+ * Directory iterator handle (returned by openDirectoryIterator)
+ */
+export type DirectoryIteratorId = number;
+
+/**
+ * Directory watcher handle (returned by watch)
+ */
+export type WatcherId = number;
+
+/**
+ * Kind of change reported by a directory watcher
+ *
+ * `'overflow'` means changes were lost (too many at once, or out of
+ * kernel watches); its path is the watched directory, list it again.
+ */
+export type WatchEventType = 'created' | 'modified' | 'deleted' | 'overflow';
+
+/**
+ * One change in a watched directory
+ *
+ * Changes to a path within one batch are merged: a file created and then
+ * written is one `'created'`, one created and deleted again is dropped.
+ */
+export interface WatchEvent {
+  type: WatchEventType;
+  /** Full path of the changed entry */
+  path: string;
+}
+
+/**
+ * Cancellation token for long-running async operations
+ *
+ * Created with `createCancelToken()`. Cancelling drops the operation if it
+ * has not started yet, or makes it stop at its next checkpoint, and the
+ * Promise rejects with a `CancelledError`.
+ */
+export interface CancelToken {
+  /** Request cancellation */
+  cancel(): void;
+  /** Whether cancel() has been called */
+  readonly cancelled: boolean;
+}
+
+/**
+ * Cancellation options of long-running async operations
+ */
+export interface CancelOptions {
+  /** Token to cancel the operation */
+  cancelToken?: CancelToken;
+  /**
+   * Give up after this many milliseconds, counted from the call; the
+   * Promise rejects with code 'ETIMEDOUT'
+   */
+  timeout?: number;
+}
+
+/**
+ * Error a cancelled or timed out async operation rejects with
+ */
+export interface CancelledError extends Error {
+  name: 'CancelledError';
+  /** 'ECANCELED' for a cancelled token, 'ETIMEDOUT' for an expired timeout */
+  code: 'ECANCELED' | 'ETIMEDOUT';
+}
+
+/**
+ * Check whether an error comes from cancellation or a timeout
+ * rather than from a failed operation
+ */
+export function isCancelledError(error: unknown): error is CancelledError {
+  return error instanceof Error && error.name === 'CancelledError';
+}
+
+/**
+ * Byte encoding of a string, for reading and writing text and for
+ * `encodeString()` / `decodeString()`
+ *
+ * - `utf8`: invalid bytes decode as U+FFFD
+ * - `ascii`, `latin1`: one byte per character; characters outside the
+ *   range encode as `?`
+ * - `utf16le`: two bytes per UTF-16 code unit
+ * - `base64`, `base64url`, `hex`: the string is the text form of the
+ *   bytes (decoding base64 accepts either alphabet and whitespace)
+ */
+export type StringEncoding =
+  | 'utf8'
+  | 'ascii'
+  | 'latin1'
+  | 'utf16le'
+  | 'base64'
+  | 'base64url'
+  | 'hex';
+
+/**
+ * Progress callback: bytes processed so far and total bytes
+ */
+export type ProgressCallback = (processed: number, total: number) => void;
+
+/**
+ * Digests returned by calcHashes, keyed by algorithm
+ */
+export type HashResults = Partial<Record<HashAlgorithm, string>>;
+
+/**
+ * Scheduling priority of an async operation
+ *
+ * Operations queued on the same native lane start in priority order; any
+ * integer from -128 to 127 is accepted.
+ */
+export enum TaskPriority {
+  Low = -64,
+  Normal = 0,
+  High = 64,
+}
+
+/**
+ * Per-call scheduling options understood by every async native method
+ * (passed as a trailing plain object)
+ * @internal
+ */
+export interface NativeCallOptions {
+  priority?: number;
+  /** Milliseconds until the call is cancelled */
+  timeout?: number;
+}
+
+/**
+ * Thread counts of the shared native executor
+ *
+ * All FSContext, File, Directory and request instances share one executor
+ * with a thread pool per lane. Omitted or 0 values keep the current count.
+ */
+export interface ExecutorConfig {
+  /** Small latency-sensitive file operations (default: 2) */
+  interactive?: number;
+  /** Copies, moves, recursive listings and deletes (default: 2) */
+  bulk?: number;
+  /** Hashing (default: half the CPU cores) */
+  compute?: number;
+  /** HTTP requests, downloads and uploads (default: 4) */
+  network?: number;
+  /**
+   * Time in ms one JS-thread turn may spend resolving completed Promises
+   * (default: 4). Completions are queued per object and delivered in
+   * batches; 0 delivers everything pending in a single turn.
+   */
+  completionBudgetMs?: number;
+}
+
+/**
+ * Concurrency limits of HTTP requests, downloads and uploads
+ *
+ * Transfers over a limit wait in a native queue in priority order (see
+ * `RequestOptions.priority`) without holding a network thread. Omitted
+ * values keep the current limit; 0 removes it.
+ */
+export interface NetworkConfig {
+  /**
+   * Transfers running at the same time across all hosts
+   * (default: 0, i.e. the network lane's thread count)
+   */
+  maxConcurrent?: number;
+  /** Transfers running at the same time to one host (default: 0, no limit) */
+  maxPerHost?: number;
+  /**
+   * Bytes of GET responses kept on disk in the cache directory
+   * (default: 0, no cache). 0 turns the cache off and removes its files.
+   */
+  cacheSize?: number;
+  /** Bytes of small cached responses also kept in memory (default: 1 MB) */
+  memoryCacheSize?: number;
+  /** Least milliseconds between two progress events of a transfer (default: 100) */
+  progressInterval?: number;
+  /** Least bytes between two progress events of a transfer (default: 0) */
+  progressMinBytes?: number;
+}
+
+/**
+ * Process-wide cache of file metadata (see `FS.configureStatCache`)
+ */
+export interface StatCacheConfig {
+  /**
+   * Paths kept, least recently used dropped first (0 = cache off, the default;
+   * capped at 10,000,000)
+   */
+  maxEntries: number;
+  /**
+   * Milliseconds an entry is trusted before the path is checked again,
+   * which bounds how long a change made outside this library goes unseen
+   * (default: 1000, 0 = until invalidated, capped at one day)
+   */
+  ttlMs?: number;
+}
+
+/**
+ * Performance instrumentation (see `FS.configureStats`)
+ */
+export interface StatsConfig {
+  /** Record latencies of every native call (default: false) */
+  enabled: boolean;
+  /**
+   * Also mark each async call as an interval for systrace/Perfetto
+   * (Android) or Instruments (iOS, os_signpost) (default: false)
+   */
+  trace?: boolean;
+}
+
+/**
+ * Distribution of one phase of a method's calls, in milliseconds.
+ * Percentiles are at most 1/16 above the exact value.
+ */
+export interface LatencySummary {
+  count: number;
+  mean: number;
+  p50: number;
+  p90: number;
+  p99: number;
+  max: number;
+}
+
+/**
+ * Statistics of one native method since stats were enabled or reset
+ */
+export interface MethodStats {
+  calls: number;
+  /** Calls that rejected or threw, cancellations excluded */
+  errors: number;
+  cancelled: number;
+  /** Bytes of strings and buffers passed in */
+  bytesIn: number;
+  /** Bytes of strings and buffers returned */
+  bytesOut: number;
+  /** Waiting for a worker thread */
+  queue: LatencySummary;
+  /** Running on a worker (sync methods: on the JS thread) */
+  execute: LatencySummary;
+  /** Waiting for the JS thread to settle the Promise */
+  resolve: LatencySummary;
+}
+
+/**
+ * Load of one executor lane
+ */
+export interface LaneStats {
+  threads: number;
+  /** Tasks waiting now */
+  queued: number;
+  /** Tasks running now */
+  running: number;
+  /** Most tasks waiting at once since the last reset */
+  peakQueued: number;
+}
+
+/**
+ * Snapshot returned by `FS.getStats()`
+ */
+export interface IOStats {
+  enabled: boolean;
+  /** Keyed by "scope.method", e.g. "fs.readString", "kv.get", "request.fetch" */
+  methods: Record<string, MethodStats>;
+  lanes: Record<'interactive' | 'bulk' | 'compute' | 'network', LaneStats>;
+}
+
+/**
+ * Benchmark suites of `FS.runBenchmarks`
+ *   - fs: sequential and random read/write throughput
+ *   - list: listing directories of 10k and 100k entries
+ *   - hash: MB/s of every HashAlgorithm
+ *   - codec: encodeString/decodeString throughput
+ *   - jsi: cost of a sync call and round trip of an async call
+ */
+export type BenchmarkSuite = 'fs' | 'list' | 'hash' | 'codec' | 'jsi';
+
+/**
+ * One measured case of a benchmark run; value is the median of 5 samples
+ */
+export interface BenchmarkResult {
+  suite: BenchmarkSuite;
+  /** Case name, e.g. "seqRead/1MB", "SHA256", "decode/utf8/mixed", "asyncCall" */
+  name: string;
+  /** "MB/s" (10^6 bytes), "ops/s" and "entries/s" (higher is better) or "us" per call (lower is better) */
+  unit: string;
+  value: number;
+  min: number;
+  max: number;
+  /** Operations run over all samples */
+  iterations: number;
+}
+
+/**
+ * Machine-readable benchmark report; `JSON.stringify` it to track results across releases
+ */
+export interface BenchmarkReport {
+  /** Version of this format */
+  schema: number;
+  /** Operating system the native suites ran on ("android", "ios", ...) */
+  platform: string;
+  /** CPU architecture of the native code ("arm64", "x86_64", ...) */
+  arch: string;
+  quick: boolean;
+  results: BenchmarkResult[];
+}
+
+/**
+ * Options for hashing operations
+ */
+export interface HashOptions extends CancelOptions {
+  /** Called after each chunk is hashed */
+  onProgress?: ProgressCallback;
+  /** Scheduling priority relative to other hashing work (default: Normal) */
+  priority?: TaskPriority | number;
+}
+
+/**
+ * Options for File.copy()
+ */
+export interface CopyOptions extends CancelOptions {
+  /** Called as data is copied with (bytesCopied, totalBytes) */
+  onProgress?: ProgressCallback;
+  /** Scheduling priority relative to other bulk work (default: Normal) */
+  priority?: TaskPriority | number;
+}
+
+/**
+ * Options for File.calcChunkedHash()
+ */
+export interface ChunkedHashOptions extends HashOptions {
+  /** Range size in bytes (default: 4 MiB) */
+  chunkSize?: number;
+}
+
+/**
+ * Transform stage of a native pipeline (see FSContext.pipe())
+ */
+export enum PipeStageKind {
+  /** Pass data through and digest it; param = HashAlgorithm (default SHA256) */
+  Hash = 0,
+  /** Base64-encode; param 1 = URL-safe alphabet without padding */
+  Base64Encode = 1,
+  /** Base64-decode (standard or URL-safe, whitespace is skipped) */
+  Base64Decode = 2,
+  /** Gzip-compress; param = level 0-9 (default 6) */
+  Gzip = 3,
+  /** Decompress gzip or zlib data */
+  Gunzip = 4,
+}
+
+/**
+ * One pipeline stage
+ */
+export interface PipeStage {
+  kind: PipeStageKind;
+  /** Stage parameter, see PipeStageKind */
+  param?: number;
+}
+
+/**
+ * Options for FSContext.pipe()
+ */
+export interface PipeOptions extends HashOptions {
+  /** Start offset in the source (default: 0) */
+  offset?: number;
+  /** Number of source bytes (default: to the end of the file) */
+  length?: number;
+  /** Stages applied in order (default: none, a plain copy) */
+  stages?: PipeStage[];
+  /** Append to a sink path instead of replacing it (default: false) */
+  append?: boolean;
+}
+
+/**
+ * Outcome of FSContext.pipe()
+ */
+export interface PipeResult {
+  /** Bytes read from the source */
+  bytesRead: number;
+  /** Bytes written to the sink */
+  bytesWritten: number;
+  /** Hex digest of each Hash stage, in stage order */
+  digests: string[];
+  /** Output of a pipeline without sink */
+  data?: ArrayBuffer;
+}
+
+/**
+ * Record stage of FSContext.pipeLines(). Each line is a record; `split`
+ * and `json` turn it into fields, which later stages address by index
+ * (`field`, counting from 0; omitted = the whole line).
+ *
+ * - filter: keep records whose line or field matches one of `contains`,
+ *   `prefix`, `suffix` or `equals` (plain text, no regular expressions);
+ *   `invert` keeps the others
+ * - split: cut at a one-character `delimiter` (default ","); with `csv`,
+ *   fields may be quoted as in RFC 4180 (quoted fields cannot contain
+ *   line breaks)
+ * - json: parse each line as a JSON object and take the values at
+ *   `fields` ("user.id" descends into objects); other lines are dropped
+ *   and counted as `invalid`
+ * - select: keep and reorder fields by index
+ * - skip: drop the first `count` records (e.g. a CSV header)
+ * - limit: keep the first `count` records
+ */
+export type LineStage =
+  | {
+      kind: 'filter';
+      contains?: string;
+      prefix?: string;
+      suffix?: string;
+      equals?: string;
+      field?: number;
+      invert?: boolean;
+    }
+  | { kind: 'split'; delimiter?: string; csv?: boolean }
+  | { kind: 'json'; fields: string[] }
+  | { kind: 'select'; fields: number[] }
+  | { kind: 'skip'; count: number }
+  | { kind: 'limit'; count: number };
+
+/**
+ * What FSContext.pipeLines() returns the records as
+ *
+ * - lines: each record as a string, fields joined by `separator` (default ",")
+ * - columns: one array per field. A column whose values are all numbers
+ *   (and not JSON strings or quoted CSV) is a Float64Array with NaN for
+ *   missing values; other columns hold strings, undefined for missing ones
+ * - count: just the number of records
+ * - countBy: number of records per value of `field` (default: the whole line)
+ * - file: write the lines to `path`, one per line
+ */
+export type LineOutput =
+  | { kind: 'lines'; separator?: string }
+  | { kind: 'columns' }
+  | { kind: 'count' }
+  | { kind: 'countBy'; field?: number }
+  | { kind: 'file'; path: string; append?: boolean; separator?: string };
+
+/**
+ * Options for FSContext.pipeLines()
+ */
+export interface PipeLinesOptions extends HashOptions {
+  /** Start offset in the source (default: 0) */
+  offset?: number;
+  /** Number of source bytes (default: to the end of the file) */
+  length?: number;
+  /** Byte stages applied before the data is split into lines, e.g. Gunzip */
+  decode?: PipeStage[];
+  /** Record stages applied in order to every line */
+  stages?: LineStage[];
+  /** Default: `{ kind: 'lines' }` */
+  output?: LineOutput;
+}
+
+/**
+ * Outcome of FSContext.pipeLines(); the field matching the output kind is set
+ */
+export interface PipeLinesResult {
+  /** Bytes read from the source */
+  bytesRead: number;
+  /** Lines in the (decoded) source */
+  linesRead: number;
+  /** Records that reached the output */
+  records: number;
+  /** Lines a json stage could not parse */
+  invalid: number;
+  lines?: string[];
+  columns?: (Float64Array | (string | undefined)[])[];
+  counts?: Record<string, number>;
+  bytesWritten?: number;
+}
+
+/**
+ * Result of IOFileSystem.pipeLines(), before numeric columns are wrapped
+ */
+export interface NativePipeLinesResult extends Omit<PipeLinesResult, 'columns'> {
+  columns?: (ArrayBuffer | (string | undefined)[])[];
+}
+
+/**
+ * Chunked (two-level tree) digest of a file
+ *
+ * The file is split into consecutive ranges of `chunkSize` bytes (the last
+ * one may be shorter), each hashed on its own:
+ * - CRC32: `chunks` are the CRC32 of each range and `root` is the CRC32 of
+ *   the whole file (same as calcHash)
+ * - other algorithms: `chunks` are the digests of each range and `root` is
+ *   the digest of all chunk digests concatenated as raw bytes
+ *
+ * An empty file has no chunks.
+ */
+export interface ChunkedHash {
+  /** Root digest (hex) */
+  root: string;
+  /** Range size used, in bytes */
+  chunkSize: number;
+  /** Hex digest of each range, in file order */
+  chunks: string[];
+}
+
+/**
+ * One operation of a batch call
+ *
+ * `op` is the name of an async IOFileSystem method and `args` are its
+ * arguments, e.g. `{ op: 'readString', args: ['/path/file.txt'] }`.
+ */
+export interface BatchOperation {
+  /** Async IOFileSystem method to run */
+  op: string;
+  /** Arguments of the method (default: none) */
+  args?: unknown[];
+  /**
+   * Operations with the same group run one after another in array order;
+   * operations without a group may run in parallel
+   */
+  group?: string;
+}
+
+/**
+ * Outcome of one batch operation
+ */
+export type BatchResult<T = unknown> =
+  | { ok: true; value: T }
+  | { ok: false; error: string };
+
 // ============================================================================
 // Native Module Interface
 // ============================================================================
@@ -147,7 +731,8 @@ export interface DirectoryEntry {
  * Native IOFileSystem interface (exposed via JSI)
  *
  * All methods ending with 'Sync' are synchronous and block the JS thread.
- * Methods without 'Sync' suffix return Promises and run on a thread pool.
+ * Methods without 'Sync' suffix return Promises and run on the shared
+ * native executor; each accepts a trailing `{ priority }` object.
  */
 export interface IOFileSystem {
   // ========================================================================
@@ -179,9 +764,16 @@ export interface IOFileSystem {
    */
   openFile(path: string, mode?: FileOpenMode): FileHandleId;
 
-  /** Close file handle */
+  /**
+   * Close file handle.
+   * The ID is invalidated: later calls with it fail even after the
+   * native slot is reused by another handle.
+   */
   fileClose(handle: FileHandleId): void;
 
+  /** Get the I/O counters of an open handle */
+  fileGetStats(handle: FileHandleId): FileHandleStats;
+
   /** Seek to position */
   fileSeek(
     handle: FileHandleId,
@@ -216,9 +808,33 @@ export interface IOFileSystem {
   /** Read single line (async) */
   fileReadLine(handle: FileHandleId): Promise<string>;
 
-  /** Write bytes (async) */
+  /** Read a batch of lines (async, empty array at EOF) */
+  fileReadLines(
+    handle: FileHandleId,
+    maxLines?: number,
+    maxBytes?: number
+  ): Promise<string[]>;
+
+  /** Write bytes (async, data must not be modified until the Promise settles) */
   fileWrite(handle: FileHandleId, data: ArrayBuffer): Promise<number>;
 
+  /** Read bytes at an absolute offset without moving the file position (async, safe to run in parallel) */
+  fileReadAt(handle: FileHandleId, offset: number, size?: number): Promise<ArrayBuffer>;
+
+  /** Hash a byte range without moving the file position (length -1 = to end of file) */
+  fileHashRange(
+    handle: FileHandleId,
+    offset: number,
+    length: number,
+    algorithm: HashAlgorithm,
+    onProgress?: ProgressCallback,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
+  ): Promise<string>;
+
+  /** Write bytes at an absolute offset without moving the file position (async, safe to run in parallel) */
+  fileWriteAt(handle: FileHandleId, offset: number, data: ArrayBuffer): Promise<number>;
+
   /** Write string (async) */
   fileWriteString(handle: FileHandleId, content: string): Promise<number>;
 
@@ -245,6 +861,13 @@ export interface IOFileSystem {
   getMetadata(path: string): Promise<FileMetadata>;
   getMetadataSync(path: string): FileMetadata;
 
+  /** Get metadata of several paths as columns (missing paths have type NotFound) */
+  getMetadataColumnar(
+    paths: string[],
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
+  ): Promise<NativeEntryColumns>;
+
   /** Get file size in bytes */
   getFileSize(path: string): Promise<number>;
   getFileSizeSync(path: string): number;
@@ -253,13 +876,25 @@ export interface IOFileSystem {
   getModifiedTime(path: string): Promise<number>;
   getModifiedTimeSync(path: string): number;
 
+  /** Cache metadata queries process-wide; maxEntries 0 turns the cache off */
+  configureStatCache(maxEntries: number, ttlMs?: number): void;
+  /** Drop cached metadata of a path and everything below it, or of all paths */
+  invalidateStatCache(path?: string): void;
+
+  /** Record per-method latencies process-wide; trace adds platform trace intervals */
+  configureStats(enabled: boolean, trace?: boolean): void;
+  /** Latencies and counters per method, and executor lane load */
+  getStats(): IOStats;
+  /** Clear all counters, histograms and lane peaks */
+  resetStats(): void;
+
   // ========================================================================
   // File Read Operations
   // ========================================================================
 
-  /** Read file as UTF-8 string */
-  readString(path: string): Promise<string>;
-  readStringSync(path: string): string;
+  /** Read file as a string (default encoding: utf8) */
+  readString(path: string, encoding?: StringEncoding): Promise<string>;
+  readStringSync(path: string, encoding?: StringEncoding): string;
 
   /** Read file as binary data */
   readBytes(path: string): Promise<ArrayBuffer>;
@@ -275,24 +910,28 @@ export interface IOFileSystem {
    * @param content String content
    * @param mode Write mode (default: Overwrite)
    * @param createParents Create parent directories if needed
+   * @param encoding Bytes to write for the string (default: utf8)
    */
   writeString(
     path: string,
     content: string,
     mode?: WriteMode,
-    createParents?: boolean
+    createParents?: boolean,
+    encoding?: StringEncoding
   ): Promise<void>;
   writeStringSync(
     path: string,
     content: string,
     mode?: WriteMode,
-    createParents?: boolean
+    createParents?: boolean,
+    encoding?: StringEncoding
   ): void;
 
   /**
    * Write binary data to file
    * @param path File path
-   * @param data Binary data
+   * @param data Binary data (read in place by the worker thread; do not
+   *             modify it until the returned Promise settles)
    * @param mode Write mode (default: Overwrite)
    * @param createParents Create parent directories if needed
    */
@@ -309,6 +948,17 @@ export interface IOFileSystem {
     createParents?: boolean
   ): void;
 
+  /**
+   * Replace many files like WriteMode.Atomic, sharing the flushes
+   * @param contents UTF-8 text or binary data, one per path
+   */
+  writeFilesAtomic(
+    paths: string[],
+    contents: (string | ArrayBuffer)[],
+    createParents?: boolean,
+    options?: NativeCallOptions
+  ): Promise<void>;
+
   // ========================================================================
   // File Management
   // ========================================================================
@@ -321,12 +971,20 @@ export interface IOFileSystem {
   deleteFile(path: string): Promise<boolean>;
   deleteFileSync(path: string): boolean;
 
-  /** Copy file */
+  /**
+   * Copy file (cloned where the filesystem supports it, else copied in the kernel)
+   * @param onProgress Called as data is copied with (bytesCopied, totalBytes)
+   * @param cancelToken Token to cancel the copy; the partial copy is removed
+   * @returns Number of bytes copied
+   */
   copyFile(
     sourcePath: string,
     destinationPath: string,
-    overwrite?: boolean
-  ): Promise<void>;
+    overwrite?: boolean,
+    onProgress?: ProgressCallback,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
+  ): Promise<number>;
   copyFileSync(
     sourcePath: string,
     destinationPath: string,
@@ -350,13 +1008,91 @@ export interface IOFileSystem {
   deleteDirectorySync(path: string, recursive?: boolean): number;
 
   /** List directory contents */
-  listDirectory(path: string, recursive?: boolean): Promise<DirectoryEntry[]>;
+  listDirectory(
+    path: string,
+    recursive?: boolean,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
+  ): Promise<DirectoryEntry[]>;
   listDirectorySync(path: string, recursive?: boolean): DirectoryEntry[];
 
+  /** List directory contents as columns (names relative to path) */
+  listDirectoryColumnar(
+    path: string,
+    recursive: boolean,
+    withSize: boolean,
+    withTime: boolean,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
+  ): Promise<NativeEntryColumns>;
+
+  /** Open a cursor over a directory (sync, cheap) */
+  openDirectoryIterator(
+    path: string,
+    recursive?: boolean
+  ): DirectoryIteratorId;
+
+  /** Read the next entries of a directory iterator (empty array when done) */
+  readDirectoryBatch(
+    iterator: DirectoryIteratorId,
+    count: number,
+    withSize?: boolean
+  ): Promise<DirectoryIteratorEntry[]>;
+
+  /** Release a directory iterator */
+  closeDirectoryIterator(iterator: DirectoryIteratorId): void;
+
+  /** Watch a directory; listener gets batches of changes (sync, cheap) */
+  watch(
+    path: string,
+    recursive: boolean,
+    debounceMs: number,
+    listener: (events: WatchEvent[]) => void | Promise<void>
+  ): WatcherId;
+
+  /** Stop a directory watcher */
+  unwatch(watcher: WatcherId): void;
+
   /** Move/rename directory */
   moveDirectory(sourcePath: string, destinationPath: string): Promise<void>;
   moveDirectorySync(sourcePath: string, destinationPath: string): void;
 
+  // ========================================================================
+  // Buffers
+  // ========================================================================
+
+  /**
+   * Allocate a zero-filled ArrayBuffer backed by native memory
+   * @param size Size in bytes
+   */
+  allocateBuffer(size: number): ArrayBuffer;
+
+  /** Create a token to cancel long-running async operations */
+  createCancelToken(): CancelToken;
+
+  // ========================================================================
+  // Memory-Mapped Files
+  // ========================================================================
+
+  /**
+   * Map a file range into memory and expose it as an ArrayBuffer
+   * @param path File path
+   * @param offset Start offset in bytes
+   * @param length Number of bytes, -1 for the rest of the file
+   * @param readOnly Private copy-on-write mapping, or shared read-write mapping
+   */
+  mmapFile(path: string, offset: number, length: number, readOnly: boolean): Promise<ArrayBuffer>;
+  mmapFileSync(path: string, offset: number, length: number, readOnly: boolean): ArrayBuffer;
+
+  /** Release a mapping early (returns false if buffer is not a live mapping) */
+  unmap(buffer: ArrayBuffer): boolean;
+
+  /** Give the kernel an access pattern hint for a mapping */
+  madvise(buffer: ArrayBuffer, advice: MapAdvice): void;
+
+  /** Flush a writable mapping to its file */
+  msync(buffer: ArrayBuffer): void;
+
   // ========================================================================
   // Path Operations (Pure - no I/O)
   // ========================================================================
@@ -401,17 +1137,142 @@ export interface IOFileSystem {
   // ========================================================================
 
   /**
-   * Calculate file hash
+   * Calculate file hash (streamed, constant memory)
    * @param path File path
    * @param algorithm Hash algorithm (default: SHA256)
+   * @param onProgress Called after each chunk with (bytesHashed, fileSize)
+   * @param cancelToken Token to cancel hashing
+   */
+  calcHash(
+    path: string,
+    algorithm?: HashAlgorithm,
+    onProgress?: ProgressCallback,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
+  ): Promise<string>;
+
+  /**
+   * Calculate several hashes of a file in a single read pass
+   * @param path File path
+   * @param algorithms Hash algorithms to compute
+   * @param onProgress Called after each chunk with (bytesHashed, fileSize)
+   * @param cancelToken Token to cancel hashing
+   * @returns Map of algorithm to hex digest
+   */
+  calcHashes(
+    path: string,
+    algorithms: HashAlgorithm[],
+    onProgress?: ProgressCallback,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
+  ): Promise<HashResults>;
+
+  /**
+   * Hash a file as ranges in parallel on the compute lane
+   * @param path File path
+   * @param algorithm Hash algorithm for chunks and root
+   * @param chunkSize Range size in bytes
+   * @param onProgress Called as ranges are hashed with (bytesHashed, fileSize)
+   * @param cancelToken Token to cancel hashing
+   */
+  calcHashChunked(
+    path: string,
+    algorithm: HashAlgorithm,
+    chunkSize: number,
+    onProgress?: ProgressCallback,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
+  ): Promise<ChunkedHash>;
+
+  // ========================================================================
+  // Pipelines
+  // ========================================================================
+
+  /**
+   * Stream a file range through native stages into a sink
+   * @param source Source path or open handle
+   * @param offset Start offset in the source
+   * @param length Number of bytes, -1 or undefined for the rest of the file
+   * @param stages [kind, param?] per stage
+   * @param sink Sink path or open handle; undefined returns the data
+   * @param append Append to a sink path
+   * @param onProgress Called as source bytes are read with (read, total)
+   * @param cancelToken Token to cancel the pipeline
+   */
+  pipe(
+    source: string | FileHandleId,
+    offset: number | undefined,
+    length: number | undefined,
+    stages: number[][],
+    sink: string | FileHandleId | undefined,
+    append: boolean | undefined,
+    onProgress?: ProgressCallback,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
+  ): Promise<PipeResult>;
+
+  /**
+   * Split a source into lines and run them through record stages natively
+   * @param stages [kind, param?] per byte stage, applied before splitting
+   * @param recordStages Record stage specs, e.g. ["filter", "contains", "ERROR"]
+   * @param output Output spec, e.g. ["columns"] or ["file", path, "0", ","]
+   * @param onProgress Called as source bytes are read with (read, total)
+   * @param cancelToken Token to cancel the pipeline
+   */
+  pipeLines(
+    source: string | FileHandleId,
+    offset: number | undefined,
+    length: number | undefined,
+    stages: number[][],
+    recordStages: string[][],
+    output: string[],
+    onProgress?: ProgressCallback,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
+  ): Promise<NativePipeLinesResult>;
+
+  // ========================================================================
+  // Batch
+  // ========================================================================
+
+  /**
+   * Run several async methods with one Promise
+   * @param operations Methods to run and their arguments
+   * @param ordered Run all operations in array order
+   * @returns One result per operation, in the same order
    */
-  calcHash(path: string, algorithm?: HashAlgorithm): Promise<string>;
+  batch(operations: BatchOperation[], ordered: boolean): Promise<BatchResult[]>;
+
+  // ========================================================================
+  // Benchmarks
+  // ========================================================================
+
+  /** Resolve with the payload length; measures an async round trip */
+  ping(payload?: string): Promise<number>;
+  /** Return the payload length; measures a sync call */
+  pingSync(payload?: string): number;
+
+  /** Run native benchmark suites in a scratch directory; resolves with a JSON BenchmarkReport */
+  runBenchmarks(
+    directory: string,
+    suites: string[],
+    quick?: boolean,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
+  ): Promise<string>;
 }
 
 // ============================================================================
 // HTTP Request Types
 // ============================================================================
 
+/**
+ * Content coding applied to a request body before it is sent.
+ * Responses are decoded automatically (gzip and deflate everywhere, plus
+ * br on iOS).
+ */
+export type BodyEncoding = 'gzip' | 'identity';
+
 /**
  * Native HTTP response
  * @internal
@@ -427,6 +1288,17 @@ export interface NativeHttpResponse {
   headerValues: string[];
 }
 
+/**
+ * Transfer progress from native code: bytes so far, total bytes (-1 if
+ * unknown) and the rate since the previous event
+ * @internal
+ */
+export type NativeProgressCallback = (
+  bytes: number,
+  total: number,
+  bytesPerSecond: number
+) => void;
+
 /**
  * Native download result
  * @internal
@@ -448,6 +1320,7 @@ export interface NativeUploadResult {
   statusCode: number;
   responseBody: ArrayBuffer;
   errorMessage: string;
+  uploadUrl: string;
 }
 
 // ============================================================================
@@ -552,6 +1425,7 @@ export interface IORequest {
    * @param body Request body (string or ArrayBuffer)
    * @param timeout Timeout in milliseconds
    * @param followRedirects Whether to follow redirects
+   * @param bodyEncoding 'gzip' to compress the body natively before sending
    */
   request(
     url: string,
@@ -559,22 +1433,56 @@ export interface IORequest {
     headers: string[],
     body: string | ArrayBuffer | null,
     timeout: number,
-    followRedirects: boolean
+    followRedirects: boolean,
+    bodyEncoding: BodyEncoding | undefined,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
+  ): Promise<NativeHttpResponse>;
+
+  /**
+   * Execute HTTP request, passing the response body to onChunk as it arrives
+   * @param highWaterMark Bytes allowed to run ahead of onChunk (default: 1 MB)
+   * @param onChunk Called with each body chunk; a returned Promise holds
+   *   the transfer back until it settles
+   */
+  requestStream(
+    url: string,
+    method: string,
+    headers: string[],
+    body: string | ArrayBuffer | null,
+    timeout: number,
+    followRedirects: boolean,
+    bodyEncoding: BodyEncoding | undefined,
+    highWaterMark: number | undefined,
+    onChunk: (chunk: ArrayBuffer) => unknown,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
   ): Promise<NativeHttpResponse>;
 
   /**
    * Download file
+   * @param segments Parallel Range connections (1 or undefined = single stream)
+   * @param onProgress Called with (bytesReceived, totalBytes, bytesPerSecond), rate-limited
    */
   download(
     url: string,
     destinationPath: string,
     headers: string[],
     timeout: number,
-    resumable: boolean
+    resumable: boolean,
+    segments: number | undefined,
+    onProgress: NativeProgressCallback | undefined,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
   ): Promise<NativeDownloadResult>;
 
   /**
    * Upload file
+   * @param files Further parts as flat [path, fieldName, fileName, mimeType, ...]
+   * @param resumable Send filePath with the tus protocol instead of multipart
+   * @param resumeUrl tus upload URL of an earlier attempt to continue
+   * @param chunkSize Bytes per tus PATCH request (default: 4 MB)
+   * @param onProgress Called with (bytesSent, totalBytes, bytesPerSecond), rate-limited
    */
   upload(
     url: string,
@@ -585,6 +1493,64 @@ export interface IORequest {
     headers: string[],
     formKeys: string[],
     formValues: string[],
-    timeout: number
+    timeout: number,
+    files: string[] | undefined,
+    resumable: boolean | undefined,
+    resumeUrl: string | undefined,
+    chunkSize: number | undefined,
+    onProgress: NativeProgressCallback | undefined,
+    cancelToken?: CancelToken,
+    options?: NativeCallOptions
   ): Promise<NativeUploadResult>;
+
+  /** Create a token to cancel requests, downloads and uploads */
+  createCancelToken(): CancelToken;
+}
+
+/**
+ * Size and garbage of a key-value store
+ */
+export interface KVStoreStats {
+  /** Keys in the store */
+  keys: number;
+  /** Bytes of the latest record of every key */
+  liveBytes: number;
+  /** Bytes of overwritten and deleted records, reclaimed by compaction */
+  deadBytes: number;
+  /** Segment files on disk */
+  segments: number;
+  /** Compactions run since the store was opened */
+  compactions: number;
+}
+
+/**
+ * Native IOKVStore interface (exposed via JSI)
+ * @internal
+ */
+export interface IOKVStore {
+  /** Directory of the store */
+  readonly directory: string;
+
+  /** Value as UTF-8 text, undefined if the key does not exist */
+  get(key: string, options?: NativeCallOptions): Promise<string | undefined>;
+  /** Value as bytes, undefined if the key does not exist */
+  getBytes(key: string, options?: NativeCallOptions): Promise<ArrayBuffer | undefined>;
+  multiGet(keys: string[], options?: NativeCallOptions): Promise<(string | undefined)[]>;
+  has(key: string, options?: NativeCallOptions): Promise<boolean>;
+  /** Keys starting with prefix, sorted */
+  keys(prefix?: string, options?: NativeCallOptions): Promise<string[]>;
+
+  put(key: string, value: string | ArrayBuffer, options?: NativeCallOptions): Promise<void>;
+  /** Write all values with a single append */
+  multiPut(keys: string[], values: (string | ArrayBuffer)[], options?: NativeCallOptions): Promise<void>;
+  /** @returns Whether the key existed */
+  delete(key: string, options?: NativeCallOptions): Promise<boolean>;
+  /** @returns Number of keys that existed */
+  multiDelete(keys: string[], options?: NativeCallOptions): Promise<number>;
+
+  /** Flush all writes so far to storage */
+  flush(): Promise<void>;
+  /** Rewrite the store without overwritten and deleted records */
+  compact(): Promise<void>;
+  getStats(): Promise<KVStoreStats>;
 }